@@ -0,0 +1,120 @@
+#pragma once
+#include "SkrAnim/resources/animation_resource.hpp"
+#include "SkrAnim/resources/skeleton_resource.hpp"
+#include "SkrAnim/ozz/base/maths/soa_transform.h"
+#include "SkrAnim/ozz/base/maths/simd_math.h"
+#include "SkrAnim/ozz/sampling_job.h"
+#include "SkrContainersDef/vector.hpp"
+#include "SkrContainersDef/hashmap.hpp"
+
+namespace skr
+{
+// per instance playback state for update-rate lod, keep it alive with the instance
+struct SKR_ANIM_API AnimPlaybackState
+{
+    // frames between two samplings, chosen from importance every update
+    uint32_t period = 0;
+    uint32_t frames_since_update = 0;
+    const skr::AnimResource* animation = nullptr;
+    // poses sampled at the last update and one period ahead, skipped frames blend between them
+    skr::Vector<ozz::math::SoaTransform> from;
+    skr::Vector<ozz::math::SoaTransform> to;
+};
+
+// evaluates the model space pose of many instances at once:
+//  - instances playing the same animation at the same quantized time share one sampling
+//  - instances with low importance are sampled every N-th frame and interpolated in between
+//  - sampling, blending and local to model jobs run in parallel batches, sampling contexts
+//    are pooled and reused across frames
+struct SKR_ANIM_API AnimEvaluator
+{
+    struct Request
+    {
+        const skr::AnimResource* animation = nullptr;
+        const skr::SkeletonResource* skeleton = nullptr;
+        // playback time in seconds, wrapped into the animation duration
+        float time = 0.f;
+        // playback time advanced per frame, used to sample ahead for lod instances
+        float delta = 0.f;
+        // 1 updates every frame, 1/N updates every N-th frame (clamped by max_period)
+        float importance = 1.f;
+        // optional, without a state the instance updates every frame
+        AnimPlaybackState* state = nullptr;
+        skr::Vector<ozz::math::Float4x4>* output = nullptr;
+    };
+
+    struct Stats
+    {
+        uint32_t requests = 0;
+        uint32_t samplings = 0;
+        uint32_t skipped = 0;
+    };
+
+    AnimEvaluator();
+    ~AnimEvaluator();
+    AnimEvaluator(const AnimEvaluator&) = delete;
+    AnimEvaluator& operator=(const AnimEvaluator&) = delete;
+
+    // importance falling off linearly with distance beyond full_rate_distance
+    static float ImportanceFromDistance(float distance, float full_rate_distance);
+
+    void add(const Request& request);
+    // blocks until every output is written
+    void evaluate();
+    void clear();
+
+    const Stats& stats() const { return _stats; }
+
+    // samples per second used to quantize playback time, 0 shares only identical times
+    float sample_rate = 60.f;
+    uint32_t max_period = 8;
+    uint32_t samples_per_task = 16;
+    uint32_t instances_per_task = 32;
+
+private:
+    struct SampleKey
+    {
+        const skr::AnimResource* animation;
+        const skr::SkeletonResource* skeleton;
+        int64_t tick;
+        bool operator==(const SampleKey& other) const
+        {
+            return animation == other.animation && skeleton == other.skeleton && tick == other.tick;
+        }
+    };
+    struct SampleKeyHasher
+    {
+        size_t operator()(const SampleKey& key) const;
+    };
+    struct Sample
+    {
+        SampleKey key;
+        float ratio;
+        uint32_t local_offset;
+        uint32_t model_offset;
+        bool need_model;
+    };
+    struct Instance
+    {
+        Request request;
+        // sample shown this frame (update frames and full rate instances)
+        uint32_t current = UINT32_MAX;
+        // sample one period ahead (update frames of lod instances)
+        uint32_t ahead = UINT32_MAX;
+        float alpha = 0.f;
+        bool lod = false;
+    };
+
+    uint32_t find_or_add_sample(const skr::AnimResource* animation, const skr::SkeletonResource* skeleton, float time, bool need_model);
+
+    skr::Vector<Instance> instances;
+    skr::Vector<Sample> samples;
+    skr::FlatHashMap<SampleKey, uint32_t, SampleKeyHasher> sample_map;
+    skr::Vector<ozz::math::SoaTransform> local_poses;
+    skr::Vector<ozz::math::Float4x4> model_poses;
+    skr::Vector<ozz::animation::SamplingJob::Context*> contexts;
+    skr::Vector<skr::Vector<ozz::math::SoaTransform>> blend_poses;
+    uint32_t next_phase = 0;
+    Stats _stats;
+};
+} // namespace skr
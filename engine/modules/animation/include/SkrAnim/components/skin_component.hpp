@@ -3,6 +3,7 @@
 #include "SkrRenderer/primitive_draw.h"
 #include "SkrAnim/resources/skin_resource.hpp"
 #include "SkrAnim/ozz/base/maths/simd_math.h"
+#include "SkrAnim/ozz/geometry/skinning_job.h"
 #ifndef __meta__
     #include "SkrAnim/components/skin_component.generated.h" // IWYU pragma: export
 #endif
@@ -38,6 +39,10 @@ AnimComponent
 {
     ~AnimComponent();
     bool use_dynamic_buffer = false;
+    // with use_dynamic_buffer, CPUSkinBatch writes straight into the persistently mapped vertex
+    // buffer and skr_init_anim_buffers skips its upload copy
+    sattr(serde = @disable)
+    bool skin_in_place = false;
 
     sattr(serde = @disable)
     skr::Vector<ozz::math::Float4x4>
@@ -56,6 +61,43 @@ AnimComponent
         views;
 };
 
+// skins many instances at once: skin matrices are built per instance, then every primitive is split
+// into fixed size vertex ranges which run the ozz simd skinning job on the task scheduler
+struct SKR_ANIM_API CPUSkinBatch
+{
+    static constexpr uint32_t kDefaultVerticesPerTask = 2048;
+
+    void add(skr::SkinComponent* skin, const skr::AnimComponent* anim, const skr::MeshResource* mesh);
+    // adds every ready instance of a query with SkinComponent, AnimComponent and MeshComponent
+    // gather(query) reads the components outside of any ecs task, so the caller must make sure
+    // no job writing AnimComponent is in flight; inside a job prefer gather(view)
+    void gather(sugoi_query_t* query);
+    void gather(sugoi_chunk_view_t* view);
+    // blocks until every instance is skinned
+    void run(uint32_t vertices_per_task = kDefaultVerticesPerTask);
+    void clear();
+
+private:
+    struct Instance
+    {
+        skr::SkinComponent* skin;
+        const skr::AnimComponent* anim;
+        const skr::MeshResource* mesh;
+    };
+    struct WorkItem
+    {
+        uint32_t job;
+        uint32_t begin;
+        uint32_t count;
+    };
+    void prepare_jobs(const Instance& instance);
+
+    uint32_t vertices_per_task = kDefaultVerticesPerTask;
+    skr::Vector<Instance> instances;
+    skr::Vector<ozz::geometry::SkinningJob> jobs;
+    skr::Vector<WorkItem> work_items;
+};
+
 } // namespace skr
 
 SKR_ANIM_API void skr_init_skin_component(skr::SkinComponent* component, const skr::SkeletonResource* skeleton);
@@ -1,7 +1,7 @@
 #pragma once
 #include "SkrAnim/ozz/skeleton.h"
 #include "SkrBase/types.h"
-#include "SkrBase/types.h"
+#include "SkrContainersDef/vector.hpp"
 #include "SkrRT/resource/resource_factory.h"
 #ifndef __meta__
     #include "SkrAnim/resources/skeleton_resource.generated.h" // IWYU pragma: export
@@ -13,6 +13,16 @@ sreflect_struct(guid = "1876BF35-E4DC-450B-B9D4-09259397F4BA")
 SkeletonResource
 {
     ozz::animation::Skeleton skeleton;
+
+    // hashes of the joint names in ascending order and the joints they belong to, built on load
+    sattr(serde = @disable)
+    skr::Vector<uint64_t> joint_name_hashes;
+    sattr(serde = @disable)
+    skr::Vector<uint16_t> joint_name_indices;
+
+    void build_joint_lookup();
+    // returns -1 if the skeleton has no joint of this name
+    int32_t find_joint(const char* name) const;
 };
 
 template <>
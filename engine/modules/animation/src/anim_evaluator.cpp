@@ -0,0 +1,296 @@
+#include "SkrAnim/anim_evaluator.hpp"
+#include "SkrAnim/ozz/local_to_model_job.h"
+#include "SkrAnim/ozz/blending_job.h"
+#include "SkrBase/misc/hash.h"
+#include "SkrCore/log.h"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrProfile/profile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace skr
+{
+static float wrap_time(float time, float duration)
+{
+    if (duration <= 0.f)
+        return 0.f;
+    time = std::fmod(time, duration);
+    return time < 0.f ? time + duration : time;
+}
+
+size_t AnimEvaluator::SampleKeyHasher::operator()(const SampleKey& key) const
+{
+    return skr_hash64_of(&key, sizeof(SampleKey));
+}
+
+AnimEvaluator::AnimEvaluator() = default;
+
+AnimEvaluator::~AnimEvaluator()
+{
+    for (auto context : contexts)
+        SkrDelete(context);
+    contexts.clear();
+}
+
+float AnimEvaluator::ImportanceFromDistance(float distance, float full_rate_distance)
+{
+    if (distance <= full_rate_distance || distance <= 0.f)
+        return 1.f;
+    return full_rate_distance / distance;
+}
+
+void AnimEvaluator::add(const Request& request)
+{
+    SKR_ASSERT(request.animation && request.skeleton && request.output);
+    instances.add({ request });
+}
+
+void AnimEvaluator::clear()
+{
+    instances.clear();
+    samples.clear();
+    sample_map.clear();
+}
+
+uint32_t AnimEvaluator::find_or_add_sample(const skr::AnimResource* animation, const skr::SkeletonResource* skeleton, float time, bool need_model)
+{
+    const float duration = animation->animation.duration();
+    time = wrap_time(time, duration);
+    SampleKey key = {};
+    key.animation = animation;
+    key.skeleton = skeleton;
+    if (sample_rate > 0.f)
+    {
+        key.tick = (int64_t)std::llround(time * sample_rate);
+        time = (float)key.tick / sample_rate;
+    }
+    else
+    {
+        uint32_t bits;
+        memcpy(&bits, &time, sizeof(bits));
+        key.tick = bits;
+    }
+
+    auto found = sample_map.find(key);
+    if (found != sample_map.end())
+    {
+        samples[found->second].need_model |= need_model;
+        return found->second;
+    }
+    const auto index = (uint32_t)samples.size();
+    Sample sample = {};
+    sample.key = key;
+    sample.ratio = duration > 0.f ? std::clamp(time / duration, 0.f, 1.f) : 0.f;
+    sample.need_model = need_model;
+    samples.add(sample);
+    sample_map.emplace(key, index);
+    return index;
+}
+
+void AnimEvaluator::evaluate()
+{
+    SkrZoneScopedN("AnimEvaluator");
+    _stats = {};
+    _stats.requests = (uint32_t)instances.size();
+    samples.clear();
+    sample_map.clear();
+
+    // plan: which instances sample this frame and which only blend
+    {
+        SkrZoneScopedN("PlanSamples");
+        for (auto& instance : instances)
+        {
+            const auto& request = instance.request;
+            auto state = request.state;
+            uint32_t period = 1;
+            if (state && request.importance < 1.f)
+            {
+                const float importance = std::max(request.importance, 1.f / (float)std::max(max_period, 1u));
+                period = std::clamp((uint32_t)std::ceil(1.f / importance), 1u, std::max(max_period, 1u));
+            }
+            if (period == 1)
+            {
+                if (state)
+                {
+                    state->period = 1;
+                    state->frames_since_update = 0;
+                    state->animation = nullptr;
+                    state->from.clear();
+                    state->to.clear();
+                }
+                instance.current = find_or_add_sample(request.animation, request.skeleton, request.time, true);
+                continue;
+            }
+
+            instance.lod = true;
+            const auto soa_joints = (uint64_t)request.skeleton->skeleton.num_soa_joints();
+            const bool valid = state->animation == request.animation && state->to.size() == soa_joints;
+            if (valid && state->frames_since_update + 1 < state->period)
+            {
+                state->frames_since_update += 1;
+                instance.alpha = (float)state->frames_since_update / (float)state->period;
+                _stats.skipped += 1;
+                continue;
+            }
+            if (!valid)
+            {
+                // stagger the first cycle so instances don't update on the same frames
+                period -= next_phase++ % period;
+                state->animation = request.animation;
+                instance.current = find_or_add_sample(request.animation, request.skeleton, request.time, false);
+            }
+            state->period = period;
+            state->frames_since_update = 0;
+            instance.ahead = find_or_add_sample(request.animation, request.skeleton, request.time + request.delta * (float)period, false);
+        }
+
+        uint32_t local_size = 0, model_size = 0;
+        for (auto& sample : samples)
+        {
+            const auto& skeleton = sample.key.skeleton->skeleton;
+            sample.local_offset = local_size;
+            local_size += (uint32_t)skeleton.num_soa_joints();
+            sample.model_offset = model_size;
+            if (sample.need_model)
+                model_size += (uint32_t)skeleton.num_joints();
+        }
+        local_poses.resize_unsafe(local_size);
+        model_poses.resize_unsafe(model_size);
+        _stats.samplings = (uint32_t)samples.size();
+    }
+
+    // sample, one pooled context per task; sorting by animation and time keeps the context caches warm
+    {
+        SkrZoneScopedN("SampleAnimations");
+        skr::Vector<uint32_t> order;
+        order.resize_unsafe(samples.size());
+        for (uint32_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            const auto& ka = samples[a].key;
+            const auto& kb = samples[b].key;
+            if (ka.animation != kb.animation)
+                return ka.animation < kb.animation;
+            return ka.tick < kb.tick;
+        });
+        const auto batch = std::max(samples_per_task, 1u);
+        const auto task_count = (order.size() + batch - 1) / batch;
+        while (contexts.size() < task_count)
+            contexts.add(SkrNew<ozz::animation::SamplingJob::Context>());
+
+        auto first = order.data();
+        skr::parallel_for(order.begin(), order.end(), batch,
+            [this, first, batch](auto begin, auto end) {
+                SkrZoneScopedN("SampleBatch");
+                auto context = contexts[(&*begin - first) / batch];
+                for (auto it = begin; it != end; ++it)
+                {
+                    const auto& sample = samples[*it];
+                    const auto& animation = sample.key.animation->animation;
+                    const auto& skeleton = sample.key.skeleton->skeleton;
+                    if (context->max_tracks() < animation.num_tracks())
+                        context->Resize(animation.num_tracks());
+                    const auto local = ozz::span{ local_poses.data() + sample.local_offset, (size_t)skeleton.num_soa_joints() };
+
+                    ozz::animation::SamplingJob sampling_job;
+                    sampling_job.animation = &animation;
+                    sampling_job.context = context;
+                    sampling_job.ratio = sample.ratio;
+                    sampling_job.output = local;
+                    if (!sampling_job.Run())
+                    {
+                        SKR_LOG_ERROR(u8"Failed to sample animation %s.", animation.name());
+                        continue;
+                    }
+                    if (!sample.need_model)
+                        continue;
+
+                    ozz::animation::LocalToModelJob ltm_job;
+                    ltm_job.skeleton = &skeleton;
+                    ltm_job.input = local;
+                    ltm_job.output = ozz::span{ model_poses.data() + sample.model_offset, (size_t)skeleton.num_joints() };
+                    if (!ltm_job.Run())
+                        SKR_LOG_ERROR(u8"Failed to convert local space to model space %s.", animation.name());
+                }
+            });
+    }
+
+    // outputs: shared model poses are copied, lod instances blend their two poses
+    {
+        SkrZoneScopedN("ResolveInstances");
+        const auto batch = std::max(instances_per_task, 1u);
+        const auto task_count = (instances.size() + batch - 1) / batch;
+        if (blend_poses.size() < task_count)
+            blend_poses.resize_default(task_count);
+
+        auto first = instances.data();
+        skr::parallel_for(instances.begin(), instances.end(), batch,
+            [this, first, batch](auto begin, auto end) {
+                SkrZoneScopedN("ResolveBatch");
+                auto& blended = blend_poses[(&*begin - first) / batch];
+                for (auto it = begin; it != end; ++it)
+                {
+                    const auto& instance = *it;
+                    const auto& request = instance.request;
+                    const auto& skeleton = request.skeleton->skeleton;
+                    const auto num_joints = (uint64_t)skeleton.num_joints();
+                    const auto num_soa_joints = (uint64_t)skeleton.num_soa_joints();
+                    auto output = request.output;
+                    output->resize_unsafe(num_joints);
+
+                    auto state = request.state;
+                    if (!instance.lod)
+                    {
+                        const auto& sample = samples[instance.current];
+                        memcpy(output->data(), model_poses.data() + sample.model_offset, sizeof(ozz::math::Float4x4) * num_joints);
+                        continue;
+                    }
+
+                    if (instance.ahead != UINT32_MAX)
+                    {
+                        if (instance.current != UINT32_MAX)
+                        {
+                            const auto& current = samples[instance.current];
+                            state->from.clear();
+                            state->from.append(local_poses.data() + current.local_offset, num_soa_joints);
+                        }
+                        else
+                        {
+                            std::swap(state->from, state->to);
+                        }
+                        const auto& ahead = samples[instance.ahead];
+                        state->to.clear();
+                        state->to.append(local_poses.data() + ahead.local_offset, num_soa_joints);
+                    }
+
+                    auto input = ozz::span<const ozz::math::SoaTransform>{ state->from.data(), state->from.size() };
+                    if (instance.alpha > 0.f)
+                    {
+                        blended.resize_unsafe(num_soa_joints);
+                        ozz::animation::BlendingJob::Layer layers[2];
+                        layers[0].weight = 1.f - instance.alpha;
+                        layers[0].transform = input;
+                        layers[1].weight = instance.alpha;
+                        layers[1].transform = { state->to.data(), state->to.size() };
+
+                        ozz::animation::BlendingJob blend_job;
+                        blend_job.layers = ozz::span<const ozz::animation::BlendingJob::Layer>{ layers, 2 };
+                        blend_job.rest_pose = skeleton.joint_rest_poses();
+                        blend_job.output = ozz::span{ blended.data(), blended.size() };
+                        if (blend_job.Run())
+                            input = { blended.data(), blended.size() };
+                        else
+                            SKR_LOG_ERROR(u8"Failed to blend animation %s.", request.animation->animation.name());
+                    }
+
+                    ozz::animation::LocalToModelJob ltm_job;
+                    ltm_job.skeleton = &skeleton;
+                    ltm_job.input = input;
+                    ltm_job.output = ozz::span{ output->data(), output->size() };
+                    if (!ltm_job.Run())
+                        SKR_LOG_ERROR(u8"Failed to convert local space to model space %s.", request.animation->animation.name());
+                }
+            });
+    }
+}
+} // namespace skr
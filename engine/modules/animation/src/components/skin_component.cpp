@@ -6,6 +6,7 @@
 #include "SkrAnim/components/skeleton_component.hpp"
 #include "SkrAnim/ozz/geometry/skinning_job.h"
 #include "SkrAnim/ozz/base/span.h"
+#include "SkrTask/parallel_for.hpp"
 
 #include "SkrProfile/profile.h"
 
@@ -29,15 +30,10 @@ void skr_init_skin_component(skr::SkinComponent* component, const skr::SkeletonR
     component->joint_remaps.resize_zeroed(skin->joint_remaps.size());
     for (size_t i = 0; i < skin->joint_remaps.size(); ++i)
     {
-        for (size_t j = 0; j < skeleton->skeleton.num_joints(); ++j)
-        {
-            auto remap = (const char*)skin->joint_remaps[i].data();
-            if (strcmp(skeleton->skeleton.joint_names()[j], remap) == 0)
-            {
-                component->joint_remaps[i] = static_cast<uint32_t>(j);
-                break;
-            }
-        }
+        auto remap = (const char*)skin->joint_remaps[i].data();
+        const auto joint = skeleton->find_joint(remap);
+        if (joint >= 0)
+            component->joint_remaps[i] = static_cast<uint16_t>(joint);
     }
 }
 
@@ -181,7 +177,7 @@ void skr_init_anim_buffers(CGPUDeviceId device, skr::AnimComponent* anim, const
         }
         const auto vertex_size = anim->buffers[j]->get_size();
 
-        if (use_dynamic_buffer)
+        if (use_dynamic_buffer && !anim->skin_in_place)
         {
             SkrZoneScopedN("CVVUpdateVB");
 
@@ -270,3 +266,182 @@ void skr_cpu_skin(skr::SkinComponent* skin, const skr::AnimComponent* anim, cons
         // memcpy(skin_buf, mesh_buf, 3 * vertex_count * sizeof(float));
     }
 }
+
+// batched skinning
+
+namespace skr
+{
+template <typename T>
+inline ozz::span<T> slice_vertices(ozz::span<T> span, size_t stride, uint32_t begin, uint32_t count)
+{
+    if (span.empty())
+        return span;
+    // the last vertex may be shorter than its stride
+    const size_t first = stride * begin / sizeof(T);
+    const size_t size = std::min(stride * count / sizeof(T), span.size() - first);
+    return { span.data() + first, size };
+}
+
+void CPUSkinBatch::add(skr::SkinComponent* skin, const skr::AnimComponent* anim, const skr::MeshResource* mesh)
+{
+    instances.add({ skin, anim, mesh });
+}
+
+void CPUSkinBatch::gather(sugoi_chunk_view_t* view)
+{
+    const auto meshes = sugoi::get_component_ro<skr::MeshComponent>(view);
+    const auto anims = sugoi::get_component_ro<skr::AnimComponent>(view);
+    auto skins = sugoi::get_owned_rw<skr::SkinComponent>(view);
+    for (uint32_t i = 0; i < view->count; i++)
+    {
+        auto mesh_resource = meshes[i].mesh_resource.get_resolved();
+        if (!mesh_resource)
+            continue;
+        if (!skins[i].joint_remaps.is_empty() && !anims[i].buffers.is_empty())
+            add(skins + i, anims + i, mesh_resource);
+    }
+}
+
+void CPUSkinBatch::gather(sugoi_query_t* query)
+{
+    auto collect = [&](sugoi_chunk_view_t* view) { gather(view); };
+    sugoiQ_get_views(query, SUGOI_LAMBDA(collect));
+}
+
+void CPUSkinBatch::clear()
+{
+    instances.clear();
+    jobs.clear();
+    work_items.clear();
+}
+
+void CPUSkinBatch::prepare_jobs(const Instance& instance)
+{
+    auto skin = instance.skin;
+    auto anim = instance.anim;
+    auto mesh = instance.mesh;
+    SKR_ASSERT(skin->joint_remaps.size() <= anim->joint_matrices.size());
+    skin->skin_matrices.resize_zeroed(anim->joint_matrices.size());
+
+    auto output = [&](const VertexBufferEntry& entry, uint32_t comps, uint32_t vertex_count) {
+        uint8_t* base = nullptr;
+        if (anim->skin_in_place && anim->use_dynamic_buffer && entry.buffer_index < anim->vbs.size() && anim->vbs[entry.buffer_index])
+            base = (uint8_t*)anim->vbs[entry.buffer_index]->info->cpu_mapped_address;
+        if (!base)
+            base = anim->buffers[entry.buffer_index]->get_data();
+        return ozz::span<float>{ (float*)(base + entry.offset), vertex_count * comps };
+    };
+
+    for (size_t i = 0; i < mesh->primitives.size(); ++i)
+    {
+        auto& prim = mesh->primitives[i];
+        auto vertex_count = prim.vertex_count;
+        const VertexBufferEntry *joints_buffer = nullptr, *weights_buffer = nullptr, *positions_buffer = nullptr, *normals_buffer = nullptr, *tangents_buffer = nullptr;
+        for (auto& view : prim.vertex_buffers)
+        {
+            if (view.attribute == EVertexAttribute::JOINTS)
+                joints_buffer = &view;
+            else if (view.attribute == EVertexAttribute::WEIGHTS)
+                weights_buffer = &view;
+            else if (view.attribute == EVertexAttribute::POSITION)
+                positions_buffer = &view;
+            else if (view.attribute == EVertexAttribute::NORMAL)
+                normals_buffer = &view;
+            else if (view.attribute == EVertexAttribute::TANGENT)
+                tangents_buffer = &view;
+        }
+        SKR_ASSERT(joints_buffer && weights_buffer && positions_buffer);
+
+        auto buffer_span = [&](const VertexBufferEntry* buffer, auto t, uint32_t comps = 1) {
+            using T = typename decltype(t)::type;
+            SKR_ASSERT(buffer->stride == sizeof(T) * comps);
+            auto offset = mesh->bins[buffer->buffer_index].blob->get_data() + buffer->offset;
+            return ozz::span<const T>{ (T*)offset, vertex_count * comps };
+        };
+
+        const auto& skprim = anim->primitives[i];
+        ozz::geometry::SkinningJob job;
+        job.joint_matrices = { skin->skin_matrices.data(), skin->skin_matrices.size() };
+        job.influences_count = 4;
+        job.vertex_count = vertex_count;
+        job.joint_weights = buffer_span(weights_buffer, skr::type_t<float>(), 4);
+        job.joint_weights_stride = weights_buffer->stride;
+        job.joint_indices = buffer_span(joints_buffer, skr::type_t<uint16_t>(), 4);
+        job.joint_indices_stride = joints_buffer->stride;
+        job.in_positions = buffer_span(positions_buffer, skr::type_t<float>(), 3);
+        job.in_positions_stride = positions_buffer->stride;
+        job.out_positions = output(skprim.position, 3, vertex_count);
+        job.out_positions_stride = skprim.position.stride;
+        if (normals_buffer)
+        {
+            job.in_normals = buffer_span(normals_buffer, skr::type_t<float>(), 3);
+            job.in_normals_stride = normals_buffer->stride;
+            job.out_normals = output(skprim.normal, 3, vertex_count);
+            job.out_normals_stride = skprim.normal.stride;
+            if (tangents_buffer && tangents_buffer->stride)
+            {
+                job.in_tangents = buffer_span(tangents_buffer, skr::type_t<float>(), 4);
+                job.in_tangents_stride = tangents_buffer->stride;
+                job.out_tangents = output(skprim.tangent, 4, vertex_count);
+                job.out_tangents_stride = skprim.tangent.stride;
+            }
+        }
+
+        const auto job_index = static_cast<uint32_t>(jobs.size());
+        jobs.add(job);
+        for (uint32_t begin = 0; begin < vertex_count; begin += vertices_per_task)
+            work_items.add({ job_index, begin, std::min(vertices_per_task, vertex_count - begin) });
+    }
+}
+
+void CPUSkinBatch::run(uint32_t vertices_per_task_)
+{
+    SkrZoneScopedN("CPUSkinBatch");
+    vertices_per_task = vertices_per_task_ ? vertices_per_task_ : kDefaultVerticesPerTask;
+    jobs.clear();
+    work_items.clear();
+    {
+        SkrZoneScopedN("PrepareSkinJobs");
+        for (const auto& instance : instances)
+            prepare_jobs(instance);
+    }
+    // skin matrices, instance ranges split across idle workers
+    skr::parallel_for_adaptive(instances.begin(), instances.end(),
+        [](auto begin, auto end) {
+            SkrZoneScopedN("SkinMatrices");
+            for (auto it = begin; it != end; ++it)
+            {
+                auto skin = it->skin;
+                auto anim = it->anim;
+                auto skin_resource = skin->skin_resource.get_resolved();
+                for (size_t i = 0; i < skin->joint_remaps.size(); ++i)
+                {
+                    auto inverse = skin_resource->inverse_bind_poses[i];
+                    skin->skin_matrices[i] = anim->joint_matrices[skin->joint_remaps[i]] * (ozz::math::Float4x4&)inverse;
+                }
+            }
+        });
+    // vertices, fixed size ranges of every primitive
+    skr::parallel_for(work_items.begin(), work_items.end(), 1,
+        [this](auto begin, auto end) {
+            SkrZoneScopedN("SkinVertices");
+            for (auto it = begin; it != end; ++it)
+            {
+                const auto& whole = jobs[it->job];
+                ozz::geometry::SkinningJob job = whole;
+                job.vertex_count = static_cast<int>(it->count);
+                job.joint_weights = slice_vertices(whole.joint_weights, whole.joint_weights_stride, it->begin, it->count);
+                job.joint_indices = slice_vertices(whole.joint_indices, whole.joint_indices_stride, it->begin, it->count);
+                job.in_positions = slice_vertices(whole.in_positions, whole.in_positions_stride, it->begin, it->count);
+                job.in_normals = slice_vertices(whole.in_normals, whole.in_normals_stride, it->begin, it->count);
+                job.in_tangents = slice_vertices(whole.in_tangents, whole.in_tangents_stride, it->begin, it->count);
+                job.out_positions = slice_vertices(whole.out_positions, whole.out_positions_stride, it->begin, it->count);
+                job.out_normals = slice_vertices(whole.out_normals, whole.out_normals_stride, it->begin, it->count);
+                job.out_tangents = slice_vertices(whole.out_tangents, whole.out_tangents_stride, it->begin, it->count);
+                auto result = job.Run();
+                SKR_ASSERT(result);
+                (void)result;
+            }
+        });
+}
+} // namespace skr
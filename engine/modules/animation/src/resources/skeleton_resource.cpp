@@ -1,5 +1,7 @@
 #include "SkrAnim/resources/skeleton_resource.hpp"
 #include "SkrAnim/ozz/base/io/archive.h"
+#include "SkrBase/misc/hash.h"
+#include <algorithm>
 
 namespace skr
 {
@@ -8,6 +10,7 @@ bool BinSerde<skr::SkeletonResource>::read(SBinaryReader* r, skr::SkeletonResour
     ozz::io::SkrStream stream(r, nullptr);
     ozz::io::IArchive archive(&stream);
     archive >> v.skeleton;
+    v.build_joint_lookup();
     return true;
 }
 bool BinSerde<skr::SkeletonResource>::write(SBinaryWriter* w, const skr::SkeletonResource& v)
@@ -21,6 +24,50 @@ bool BinSerde<skr::SkeletonResource>::write(SBinaryWriter* w, const skr::Skeleto
 
 namespace skr
 {
+void SkeletonResource::build_joint_lookup()
+{
+    const auto names = skeleton.joint_names();
+    const auto count = static_cast<uint32_t>(names.size());
+    skr::Vector<uint64_t> hashes;
+    hashes.resize_unsafe(count);
+    joint_name_indices.resize_unsafe(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        hashes[i] = skr_hash64_of(names[i], strlen(names[i]));
+        joint_name_indices[i] = static_cast<uint16_t>(i);
+    }
+    std::sort(joint_name_indices.begin(), joint_name_indices.end(), [&](uint16_t a, uint16_t b) {
+        return hashes[a] < hashes[b];
+    });
+    joint_name_hashes.resize_unsafe(count);
+    for (uint32_t i = 0; i < count; ++i)
+        joint_name_hashes[i] = hashes[joint_name_indices[i]];
+}
+
+int32_t SkeletonResource::find_joint(const char* name) const
+{
+    const auto names = skeleton.joint_names();
+    if (joint_name_hashes.size() != names.size())
+    {
+        // lookup not built, e.g. the skeleton was not loaded through serde
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            if (strcmp(names[i], name) == 0)
+                return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+    const auto hash = skr_hash64_of(name, strlen(name));
+    auto it = std::lower_bound(joint_name_hashes.begin(), joint_name_hashes.end(), hash);
+    for (; it != joint_name_hashes.end() && *it == hash; ++it)
+    {
+        const auto joint = joint_name_indices[it - joint_name_hashes.begin()];
+        if (strcmp(names[joint], name) == 0)
+            return joint;
+    }
+    return -1;
+}
+
 skr_guid_t SkelFactory::GetResourceType()
 {
     return ::skr::type_id_of<skr::SkeletonResource>();
@@ -20,6 +20,9 @@ public:
 	// Unlock the unique lock.
 	void unlock() SKR_NOEXCEPT;
 
+	// Acquire the unique lock only if no thread holds or waits for any lock, never blocks.
+	bool try_lock() SKR_NOEXCEPT;
+
 	// Upgrade a previously-acquired shared lock to the unique lock.
 	void upgrade() SKR_NOEXCEPT;
 
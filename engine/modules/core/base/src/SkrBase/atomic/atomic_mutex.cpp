@@ -25,6 +25,13 @@ void shared_atomic_mutex::unlock() SKR_NOEXCEPT
     skr_atomic_fetch_sub(&_bitfield, one_unique_flag + one_unique_thread);
 }
 
+bool shared_atomic_mutex::try_lock() SKR_NOEXCEPT
+{
+    // Count this thread as the only unique waiter and set the unique lock flag in one step.
+    bitfield_t expected = 0;
+    return skr_atomic_compare_exchange_strong_explicit(&_bitfield, &expected, one_unique_thread + one_unique_flag, skr_memory_order_acquire, skr_memory_order_relaxed);
+}
+
 void shared_atomic_mutex::upgrade() SKR_NOEXCEPT
 {
     static_assert(one_unique_thread > one_shared_thread, "This section of code assumes one_unique_thread > one_shared_thread for subtraction");
@@ -1,8 +1,20 @@
 #pragma once
 #include "SkrContainers/vector.hpp"
+#include "SkrOS/thread.h"
+#include <atomic>
 
 namespace skr
 {
+struct StackAllocatorStats
+{
+    uint64_t epoch = 0;
+    uint32_t thread_count = 0; // arenas that allocated in this epoch
+    uint32_t arena_count = 0;
+    size_t allocation_count = 0;
+    size_t used_bytes = 0;     // including alignment padding
+    size_t reserved_bytes = 0; // chunk memory held by all arenas
+};
+
 template <typename T>
 struct StackAllocator
 {
@@ -94,9 +106,12 @@ struct StackAllocator
     
     skr::Vector<MemoryChunk> chunks_;
     size_t current_chunk_size_ = T::kDefaultChunkSize;
+    // chunks before this one are full for the current frame
+    uint64_t current_chunk_ = 0;
     
     // 统计信息
     size_t total_allocated_bytes_ = 0;
+    size_t used_bytes_ = 0;
     size_t peak_used_bytes_ = 0;
     size_t allocation_count_ = 0;
     
@@ -117,13 +132,14 @@ struct StackAllocator
         // 确保对齐至少是默认对齐
         align = std::max(align, T::kAlignment);
         
-        // 尝试从现有chunks分配
-        for (auto& chunk : chunks_)
+        // 从当前chunk向后分配，之前的chunk在本帧内视为已满
+        for (; current_chunk_ < chunks_.size(); ++current_chunk_)
         {
+            auto& chunk = chunks_[current_chunk_];
+            const size_t used_before = chunk.used;
             if (void* ptr = chunk.allocate(requested_size, align))
             {
-                ++allocation_count_;
-                update_peak_usage();
+                on_allocated(chunk.used - used_before);
                 return ptr;
             }
         }
@@ -131,14 +147,14 @@ struct StackAllocator
         // 需要新的chunk
         size_t chunk_size = std::max(current_chunk_size_, requested_size + align);
         chunks_.add(chunk_size);
+        current_chunk_ = chunks_.size() - 1;
         
         total_allocated_bytes_ += chunk_size;
         
         void* ptr = chunks_.back().allocate(requested_size, align);
         SKR_ASSERT(ptr && "Failed to allocate from newly created chunk");
         
-        ++allocation_count_;
-        update_peak_usage();
+        on_allocated(chunks_.back().used);
         
         return ptr;
     }
@@ -150,25 +166,181 @@ struct StackAllocator
         {
             chunk.reset();
         }
+        current_chunk_ = 0;
+        used_bytes_ = 0;
     }
     
     void finalize()
     {
         chunks_.clear();
+        current_chunk_ = 0;
         total_allocated_bytes_ = 0;
+        used_bytes_ = 0;
         allocation_count_ = 0;
         peak_used_bytes_ = 0;
     }
     
 private:
-    void update_peak_usage()
+    void on_allocated(size_t bytes)
+    {
+        ++allocation_count_;
+        used_bytes_ += bytes;
+        peak_used_bytes_ = std::max(peak_used_bytes_, used_bytes_);
+    }
+};
+
+// StackAllocator<T> arenas owned by each allocating thread, so allocation never takes a lock.
+// reset() starts a new frame epoch, every arena rewinds itself on its first allocation in the new epoch.
+// free is a no-op as with StackAllocator, memory from any arena can be dropped on any thread.
+// Only one instance per T may be alive at a time, threads find their arena through a thread_local slot.
+template <typename T>
+struct ThreadLocalStackAllocator
+{
+    using Stats = StackAllocatorStats;
+
+    ThreadLocalStackAllocator()
+    {
+        skr_init_mutex(&arenas_mutex_);
+        instance_id_.store(next_instance_id().fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        live_instance_id().store(instance_id_.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    ~ThreadLocalStackAllocator()
+    {
+        finalize();
+        live_instance_id().store(0, std::memory_order_release);
+        skr_destroy_mutex(&arenas_mutex_);
+    }
+
+    void* allocate(size_t requested_size, size_t align)
+    {
+        Arena* arena = acquire_arena();
+        const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        if (arena->epoch.load(std::memory_order_relaxed) != epoch)
+        {
+            arena->allocator.reset();
+            arena->epoch.store(epoch, std::memory_order_relaxed);
+            arena->allocation_count.store(0, std::memory_order_relaxed);
+        }
+        void* ptr = arena->allocator.allocate(requested_size, align);
+        // only the owning thread writes, the atomics are for get_stats()
+        arena->allocation_count.store(arena->allocation_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        arena->used_bytes.store(arena->allocator.used_bytes_, std::memory_order_relaxed);
+        arena->reserved_bytes.store(arena->allocator.total_allocated_bytes_, std::memory_order_relaxed);
+        return ptr;
+    }
+
+    // memory from earlier epochs must not be used any more, same contract as StackAllocator::reset()
+    void reset()
+    {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void finalize()
+    {
+        SMutexLock lock(arenas_mutex_);
+        for (auto arena : arenas_)
+            SkrDelete(arena);
+        arenas_.clear();
+        // slots of other threads still point at the deleted arenas, a new id makes them acquire again
+        const uint64_t new_id = next_instance_id().fetch_add(1, std::memory_order_relaxed) + 1;
+        instance_id_.store(new_id, std::memory_order_release);
+        live_instance_id().store(new_id, std::memory_order_release);
+    }
+
+    Stats get_stats() const
+    {
+        Stats stats;
+        stats.epoch = epoch_.load(std::memory_order_acquire);
+        SMutexLock lock(arenas_mutex_);
+        stats.arena_count = (uint32_t)arenas_.size();
+        for (auto arena : arenas_)
+        {
+            stats.reserved_bytes += arena->reserved_bytes.load(std::memory_order_relaxed);
+            // the owner may be rewinding concurrently, the epoch check keeps stale arenas out
+            if (arena->epoch.load(std::memory_order_relaxed) != stats.epoch)
+                continue;
+            stats.thread_count += 1;
+            stats.allocation_count += arena->allocation_count.load(std::memory_order_relaxed);
+            stats.used_bytes += arena->used_bytes.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+private:
+    struct alignas(64) Arena
+    {
+        StackAllocator<T> allocator;
+        std::atomic<uint64_t> epoch = 0;
+        std::atomic_bool owned = false;
+        std::atomic<size_t> allocation_count = 0;
+        std::atomic<size_t> used_bytes = 0;
+        std::atomic<size_t> reserved_bytes = 0;
+    };
+
+    struct ThreadSlot
     {
-        size_t current_used = 0;
-        for (const auto& chunk : chunks_)
+        uint64_t instance_id = 0;
+        Arena* arena = nullptr;
+
+        // hands the arena (and its chunks) over to the next thread that needs one
+        ~ThreadSlot()
         {
-            current_used += chunk.used;
+            if (arena && instance_id == live_instance_id().load(std::memory_order_acquire))
+                arena->owned.store(false, std::memory_order_release);
         }
-        peak_used_bytes_ = std::max(peak_used_bytes_, current_used);
+    };
+
+    static ThreadSlot& thread_slot()
+    {
+        static thread_local ThreadSlot slot;
+        return slot;
     }
+    static std::atomic<uint64_t>& next_instance_id()
+    {
+        static std::atomic<uint64_t> id = 0;
+        return id;
+    }
+    static std::atomic<uint64_t>& live_instance_id()
+    {
+        static std::atomic<uint64_t> id = 0;
+        return id;
+    }
+
+    Arena* acquire_arena()
+    {
+        auto& slot = thread_slot();
+        const uint64_t instance_id = instance_id_.load(std::memory_order_acquire);
+        if (slot.instance_id == instance_id) [[likely]]
+            return slot.arena;
+
+        // first allocation of this thread, the only path that locks
+        SMutexLock lock(arenas_mutex_);
+        Arena* arena = nullptr;
+        for (auto candidate : arenas_)
+        {
+            bool expected = false;
+            if (candidate->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                arena = candidate;
+                break;
+            }
+        }
+        if (!arena)
+        {
+            arena = SkrNew<Arena>();
+            arena->owned.store(true, std::memory_order_relaxed);
+            arena->epoch.store(epoch_.load(std::memory_order_acquire), std::memory_order_relaxed);
+            arenas_.add(arena);
+        }
+        slot.instance_id = instance_id;
+        slot.arena = arena;
+        return arena;
+    }
+
+    std::atomic<uint64_t> epoch_ = 0;
+    std::atomic<uint64_t> instance_id_ = 0;
+    mutable SMutex arenas_mutex_;
+    skr::Vector<Arena*> arenas_;
 };
 } // namespace skr
\ No newline at end of file
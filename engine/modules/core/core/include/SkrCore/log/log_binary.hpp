@@ -0,0 +1,244 @@
+#pragma once
+#include "SkrCore/log.hpp"
+#include "SkrContainersDef/function_ref.hpp"
+#include <atomic>
+#include <cstring>
+
+namespace skr
+{
+namespace logging
+{
+
+// tag in front of every serialized argument, 0 terminates the argument list
+enum class EBinaryLogArg : uint8_t
+{
+    kEnd = 0,
+    kInt64,
+    kUInt64,
+    kDouble,
+    kBool,
+    kString,
+};
+
+// special site ids, every other id refers to a call site registered with BinaryLog::RegisterSite()
+enum EBinaryLogRecord : uint32_t
+{
+    kBinaryLogPadding = 0xFFFFFFFF, // ring buffer wrap, never written to sinks
+    kBinaryLogSite    = 0xFFFFFFFE, // payload: site id, level, format, file, func, line
+    kBinaryLogClock   = 0xFFFFFFFD, // payload: ns of the header timestamp, ns per tsc tick
+    kBinaryLogThread  = 0xFFFFFFFC, // payload: thread name
+    kBinaryLogDropped = 0xFFFFFFFB, // payload: count of records dropped because the ring was full
+};
+
+// stream layout: BinaryLogFileHeader, then records, all records are 8 bytes aligned
+struct BinaryLogFileHeader {
+    char     magic[8]    = { 'S', 'K', 'R', 'B', 'L', 'O', 'G', '\0' };
+    uint32_t version     = 1;
+    uint32_t header_size = sizeof(BinaryLogFileHeader);
+};
+
+struct BinaryLogRecordHeader {
+    uint32_t size;      // whole record with header and padding
+    uint32_t site_id;   // call site or EBinaryLogRecord
+    int64_t  timestamp; // tscns ticks
+    uint64_t thread_id;
+};
+
+// receives raw records drained from the thread rings, called from one thread at a time
+struct SKR_CORE_API LogBinarySink {
+    virtual ~LogBinarySink() SKR_NOEXCEPT;
+    virtual void write(const uint8_t* data, uint64_t size) SKR_NOEXCEPT = 0;
+    virtual void flush() SKR_NOEXCEPT {}
+};
+
+// appends records to a memory mapped file, the mapping grows by doubling and the file is
+// truncated to the written size when the sink is destroyed
+struct SKR_CORE_API LogBinaryFileSink : public LogBinarySink {
+    LogBinaryFileSink(const char8_t* path, uint64_t initial_size = 16 * 1024 * 1024) SKR_NOEXCEPT;
+    ~LogBinaryFileSink() SKR_NOEXCEPT override;
+
+    void write(const uint8_t* data, uint64_t size) SKR_NOEXCEPT override;
+    void flush() SKR_NOEXCEPT override;
+    bool is_open() const SKR_NOEXCEPT { return mapped_ != nullptr; }
+
+protected:
+    bool remap(uint64_t size) SKR_NOEXCEPT;
+
+    uint8_t* mapped_      = nullptr;
+    uint64_t mapped_size_ = 0;
+    uint64_t written_     = 0;
+#ifdef _WIN32
+    void* file_    = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+};
+
+// one decoded record of a binary log stream
+struct BinaryLogEntry {
+    LogLevel        level;
+    int64_t         ns;
+    uint64_t        thread_id;
+    skr::StringView thread_name;
+    skr::StringView file;
+    skr::StringView func;
+    skr::StringView line;
+    skr::StringView message;
+};
+
+struct SKR_CORE_API BinaryLog {
+    // call sites keep their format, level and source location here and records only carry the id,
+    // format must outlive the logger (string literals from SKR_LOG_BIN_XXX)
+    static uint32_t RegisterSite(int level, const char8_t* format, const char* file, const char* func, const char* line) SKR_NOEXCEPT;
+
+    // starts the binary mode, each thread writes into its own ring of ring_size bytes
+    static void Open(skr::UPtr<LogBinarySink> sink, uint32_t ring_size = 64 * 1024) SKR_NOEXCEPT;
+    // drains every ring and releases the sink
+    static void Close() SKR_NOEXCEPT;
+    // drains every ring into the sink, done by the log worker or inline without one
+    static void Drain() SKR_NOEXCEPT;
+    SKR_FORCEINLINE static bool IsOpen() SKR_NOEXCEPT { return gOpened.load(std::memory_order_relaxed); }
+
+    // larger records go to the text sinks instead of the rings
+    static constexpr uint32_t kMaxArgsSize = 4096;
+
+    // reserves a record in the ring of the calling thread, nullptr (and counted as dropped) when the ring is full
+    static uint8_t* BeginRecord(uint32_t site_id, uint32_t args_size) SKR_NOEXCEPT;
+    static void     EndRecord() SKR_NOEXCEPT;
+
+    // formats a stream written by the sinks, format specs apply to each argument separately
+    static bool Decode(const uint8_t* data, uint64_t size, FunctionRef<void(const BinaryLogEntry& entry)> func) SKR_NOEXCEPT;
+
+    template <typename... Args>
+    static void Log(uint32_t site_id, int level, const char* file, const char* func, const char* line, const char8_t* format, Args&&... args) SKR_NOEXCEPT;
+
+    static std::atomic<bool> gOpened;
+};
+
+template <typename T>
+struct BinaryLogArg {
+    using Type = std::decay_t<T>;
+    static constexpr bool kIsString =
+        std::is_same_v<Type, const char*> || std::is_same_v<Type, char*> ||
+        std::is_same_v<Type, const char8_t*> || std::is_same_v<Type, char8_t*> ||
+        std::is_same_v<Type, skr::StringView> || std::is_same_v<Type, skr::String>;
+    static constexpr bool kIsScalar =
+        std::is_arithmetic_v<Type> || std::is_enum_v<Type>;
+    static_assert(kIsString || kIsScalar, "binary log only serializes numbers, enums and utf-8 strings");
+
+    SKR_FORCEINLINE static skr::StringView view(const Type& v)
+    {
+        if constexpr (std::is_same_v<Type, skr::StringView>)
+            return v;
+        else if constexpr (std::is_same_v<Type, skr::String>)
+            return v.view();
+        else
+            return v ? skr::StringView((const char8_t*)v) : skr::StringView();
+    }
+
+    SKR_FORCEINLINE static uint32_t size(const Type& v)
+    {
+        if constexpr (kIsString)
+            return 1 + sizeof(uint32_t) + (uint32_t)view(v).length_buffer();
+        else
+            return 1 + sizeof(uint64_t);
+    }
+
+    SKR_FORCEINLINE static void write(uint8_t*& p, const Type& v)
+    {
+        if constexpr (kIsString)
+        {
+            const auto     str = view(v);
+            const uint32_t len = (uint32_t)str.length_buffer();
+            *p++               = (uint8_t)EBinaryLogArg::kString;
+            std::memcpy(p, &len, sizeof(len));
+            std::memcpy(p + sizeof(len), str.data(), len);
+            p += sizeof(len) + len;
+            return;
+        }
+        else
+        {
+            EBinaryLogArg tag;
+            uint64_t      bits;
+            if constexpr (std::is_same_v<Type, bool>)
+            {
+                tag  = EBinaryLogArg::kBool;
+                bits = v ? 1 : 0;
+            }
+            else if constexpr (std::is_floating_point_v<Type>)
+            {
+                const double d = (double)v;
+                tag            = EBinaryLogArg::kDouble;
+                std::memcpy(&bits, &d, sizeof(d));
+            }
+            else if constexpr (std::is_enum_v<Type>)
+            {
+                tag  = EBinaryLogArg::kInt64;
+                bits = (uint64_t)(int64_t)v;
+            }
+            else if constexpr (std::is_signed_v<Type>)
+            {
+                tag  = EBinaryLogArg::kInt64;
+                bits = (uint64_t)(int64_t)v;
+            }
+            else
+            {
+                tag  = EBinaryLogArg::kUInt64;
+                bits = (uint64_t)v;
+            }
+            *p++ = (uint8_t)tag;
+            std::memcpy(p, &bits, sizeof(bits));
+            p += sizeof(bits);
+        }
+    }
+
+    // text fallback, enums are logged as their values there too and c strings as views like in the rings
+    SKR_FORCEINLINE static decltype(auto) text(const Type& v)
+    {
+        if constexpr (std::is_enum_v<Type>)
+            return (int64_t)v;
+        else if constexpr (kIsString && std::is_pointer_v<Type>)
+            return view(v);
+        else
+            return (v);
+    }
+};
+
+template <typename... Args>
+SKR_FORCEINLINE void BinaryLog::Log(uint32_t site_id, int level, const char* file, const char* func, const char* line, const char8_t* format, Args&&... args) SKR_NOEXCEPT
+{
+    const auto kLogLevel = LogConstants::kLogLevelsLUT[level];
+    if (kLogLevel < LogConstants::gLogLevel) return;
+
+    // errors stay visible on the text sinks
+    if (IsOpen() && kLogLevel < LogLevel::kError)
+    {
+        const uint32_t args_size = (0u + ... + BinaryLogArg<Args>::size(args));
+        if (args_size <= kMaxArgsSize)
+        {
+            if (auto p = BeginRecord(site_id, args_size))
+            {
+                (BinaryLogArg<Args>::write(p, args), ...);
+                EndRecord();
+            }
+            return;
+        }
+    }
+    skr_log_log_cxx(level, file, func, line, format, BinaryLogArg<Args>::text(args)...);
+}
+
+} // namespace logging
+} // namespace skr
+
+#define SKR_LOG_BIN_WITH_LEVEL(level, fmt, ...)                                                                                                         \
+    do                                                                                                                                                  \
+    {                                                                                                                                                   \
+        static const uint32_t _skr_log_bin_site = ::skr::logging::BinaryLog::RegisterSite((level), (fmt), __FILE__, __LOG_FUNC__, SKR_MAKE_STRING(__LINE__)); \
+        ::skr::logging::BinaryLog::Log(_skr_log_bin_site, (level), __FILE__, __LOG_FUNC__, SKR_MAKE_STRING(__LINE__), (fmt) __VA_OPT__(, ) __VA_ARGS__);  \
+    } while (0)
+#define SKR_LOG_BIN_TRACE(fmt, ...) SKR_LOG_BIN_WITH_LEVEL(SKR_LOG_LEVEL_TRACE, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define SKR_LOG_BIN_DEBUG(fmt, ...) SKR_LOG_BIN_WITH_LEVEL(SKR_LOG_LEVEL_DEBUG, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define SKR_LOG_BIN_INFO(fmt, ...) SKR_LOG_BIN_WITH_LEVEL(SKR_LOG_LEVEL_INFO, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define SKR_LOG_BIN_WARN(fmt, ...) SKR_LOG_BIN_WITH_LEVEL(SKR_LOG_LEVEL_WARN, fmt __VA_OPT__(, ) __VA_ARGS__)
+#define SKR_LOG_BIN_ERROR(fmt, ...) SKR_LOG_BIN_WITH_LEVEL(SKR_LOG_LEVEL_ERROR, fmt __VA_OPT__(, ) __VA_ARGS__)
@@ -6,6 +6,7 @@
 #include "SkrRTTR/enum_tools.hpp"
 #include "SkrRTTR/export/export_data.hpp"
 #include <SkrRTTR/export/export_accessor.hpp>
+#include <atomic>
 
 // !!!! RTTR 不考虑动态类型建立(从脚本建立), 一切类型都是 CPP 静态注册的 loader !!!!
 namespace skr
@@ -63,6 +64,8 @@ using RTTRInvokerEqual       = ExportExternMethodInvoker<bool(const void*, const
 using RTTRInvokerHash        = ExportExternMethodInvoker<skr_hash(const void*)>;
 using RTTRInvokerSwap        = ExportExternMethodInvoker<void(void*, void*)>;
 
+struct RTTRTypeOptimizeData;
+
 struct SKR_CORE_API RTTRType final {
     // ctor & dtor
     RTTRType();
@@ -94,10 +97,9 @@ struct SKR_CORE_API RTTRType final {
     void build_record(FunctionRef<void(RTTRRecordData* data)> func);
     void build_enum(FunctionRef<void(RTTREnumData* data)> func);
 
-    // TODO. build optimize data
-    //  1. fast base find table
-    //  2. fast method/field table
-    // void build_optimize_data();
+    // optimize data, flattened method/field tables (bases included) indexed by name hash
+    // called by the type registry once the type and its loader are done, until then find_xxx() scan the export data
+    void build_optimize_data();
 
     // TODO. check phase, used to check data conflict
     // void validate_export_data() const;
@@ -174,8 +176,9 @@ private:
     bool _build_caster(RTTRTypeCaster& caster, const GUID& type_id) const;
 
 private:
-    ERTTRTypeCategory _type_category = ERTTRTypeCategory::Invalid;
-    String            _module        = {};
+    ERTTRTypeCategory                  _type_category = ERTTRTypeCategory::Invalid;
+    String                             _module        = {};
+    std::atomic<RTTRTypeOptimizeData*> _optimize_data = nullptr;
     union
     {
         RTTRPrimitiveTable _primitive_data;
@@ -2,4 +2,5 @@
 #include "log/log_pattern.cpp"
 #include "log/log_sink.cpp"
 #include "log/log_manager.cpp"
-#include "log/log_worker.cpp"
\ No newline at end of file
+#include "log/log_worker.cpp"
+#include "log/log_binary.cpp"
\ No newline at end of file
@@ -0,0 +1,725 @@
+#include "SkrCore/log/log_binary.hpp"
+#include "SkrContainersDef/vector.hpp"
+#include "SkrContainersDef/hashmap.hpp"
+#include "SkrOS/thread.h"
+#include "log_manager.hpp"
+
+#include "SkrProfile/profile.h"
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace skr
+{
+namespace logging
+{
+
+std::atomic<bool> BinaryLog::gOpened = false;
+
+namespace
+{
+static constexpr uint64_t kBinaryLogMinRingSize = 16 * 1024;
+
+SKR_FORCEINLINE uint64_t binary_log_align(uint64_t size)
+{
+    return (size + 7) & ~uint64_t(7);
+}
+
+struct BinaryLogSite {
+    int            level;
+    const char8_t* format;
+    const char*    file;
+    const char*    func;
+    const char*    line;
+};
+
+// SPSC ring of records, written by its thread and drained under the drain lock
+struct BinaryLogRing {
+    BinaryLogRing(uint64_t capacity) SKR_NOEXCEPT
+        : capacity(capacity)
+        , thread_id(skr_current_thread_id())
+    {
+        data = (uint8_t*)sakura_mallocN(capacity, kLogMemoryName);
+        if (auto name = skr_current_thread_get_name())
+            thread_name = name;
+    }
+    ~BinaryLogRing() SKR_NOEXCEPT
+    {
+        sakura_freeN(data, kLogMemoryName);
+    }
+
+    uint8_t*              data     = nullptr;
+    const uint64_t        capacity = 0; // power of two
+    std::atomic<uint64_t> head     = 0; // written by the producer
+    std::atomic<uint64_t> tail     = 0; // written by the drainer
+    std::atomic<uint64_t> dropped  = 0;
+    std::atomic<bool>     wake     = false; // producer asked the worker for a drain
+    std::atomic<bool>     orphaned = false; // thread exited, freed once drained
+    uint64_t              reserved = 0;     // end of the record being written, producer only
+    bool                  announced = false; // thread record written, drainer only
+    uint64_t              thread_id = 0;
+    skr::String           thread_name;
+};
+
+struct BinaryLogState {
+    ~BinaryLogState() SKR_NOEXCEPT
+    {
+        for (auto ring : rings)
+            SkrDelete(ring);
+    }
+
+    SMutexObject                sites_mutex;
+    skr::Vector<BinaryLogSite>  sites;
+    uint32_t                    written_sites = 0;
+
+    SMutexObject                rings_mutex;
+    skr::Vector<BinaryLogRing*> rings;
+    std::atomic<uint64_t>       ring_size = 64 * 1024;
+
+    SMutexObject                drain_mutex;
+    skr::UPtr<LogBinarySink>    sink;
+    skr::Vector<BinaryLogRing*> drain_rings;
+    skr::Vector<uint8_t>        scratch;
+};
+
+BinaryLogState& binary_log_state()
+{
+    static BinaryLogState state;
+    return state;
+}
+
+// marks the ring of an exited thread so the drainer can free it
+struct BinaryLogThreadRing {
+    ~BinaryLogThreadRing() SKR_NOEXCEPT
+    {
+        if (ring)
+            ring->orphaned.store(true, std::memory_order_release);
+    }
+    BinaryLogRing* ring = nullptr;
+};
+static thread_local BinaryLogThreadRing tls_binary_log_ring;
+
+BinaryLogRing* binary_log_acquire_ring()
+{
+    auto& tls = tls_binary_log_ring;
+    if (!tls.ring)
+    {
+        auto& state = binary_log_state();
+        tls.ring    = SkrNew<BinaryLogRing>(state.ring_size.load(std::memory_order_relaxed));
+        SMutexLock lock(state.rings_mutex.mMutex);
+        state.rings.add(tls.ring);
+    }
+    return tls.ring;
+}
+
+// special records are built in scratch and written straight to the sink
+struct BinaryLogRecordBuilder {
+    BinaryLogRecordBuilder(skr::Vector<uint8_t>& buffer, uint32_t site_id, int64_t timestamp, uint64_t thread_id)
+        : buffer(buffer)
+    {
+        buffer.clear();
+        BinaryLogRecordHeader header = { 0, site_id, timestamp, thread_id };
+        buffer.append((const uint8_t*)&header, sizeof(header));
+    }
+    template <typename T>
+    void add(const T& v)
+    {
+        buffer.append((const uint8_t*)&v, sizeof(T));
+    }
+    void add_string(const char8_t* str)
+    {
+        const auto     view = str ? skr::StringView(str) : skr::StringView();
+        const uint32_t len  = (uint32_t)view.length_buffer();
+        add(len);
+        buffer.append((const uint8_t*)view.data(), len);
+    }
+    void write(LogBinarySink* sink)
+    {
+        const uint32_t size = (uint32_t)binary_log_align(buffer.size());
+        buffer.resize_zeroed(size);
+        std::memcpy(buffer.data(), &size, sizeof(size));
+        sink->write(buffer.data(), size);
+    }
+    skr::Vector<uint8_t>& buffer;
+};
+
+void binary_log_write_header(LogBinarySink* sink)
+{
+    BinaryLogFileHeader header = {};
+    sink->write((const uint8_t*)&header, sizeof(header));
+}
+} // namespace
+
+// sink
+LogBinarySink::~LogBinarySink() SKR_NOEXCEPT
+{
+}
+
+LogBinaryFileSink::LogBinaryFileSink(const char8_t* path, uint64_t initial_size) SKR_NOEXCEPT
+{
+#ifdef _WIN32
+    const int wlen = ::MultiByteToWideChar(CP_UTF8, 0, (const char*)path, -1, nullptr, 0);
+    skr::Vector<wchar_t> wpath;
+    wpath.resize_zeroed(wlen);
+    ::MultiByteToWideChar(CP_UTF8, 0, (const char*)path, -1, wpath.data(), wlen);
+    auto handle = ::CreateFileW(wpath.data(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+    {
+        SKR_LOG_ERROR(u8"failed to create binary log file %s", path);
+        return;
+    }
+    file_ = handle;
+#else
+    file_ = ::open((const char*)path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file_ < 0)
+    {
+        SKR_LOG_ERROR(u8"failed to create binary log file %s", path);
+        return;
+    }
+#endif
+    remap(binary_log_align(initial_size ? initial_size : 4096));
+}
+
+LogBinaryFileSink::~LogBinaryFileSink() SKR_NOEXCEPT
+{
+    flush();
+#ifdef _WIN32
+    if (mapped_)
+        ::UnmapViewOfFile(mapped_);
+    if (mapping_)
+        ::CloseHandle(mapping_);
+    if (file_)
+    {
+        // drop the unused tail of the mapping
+        LARGE_INTEGER end;
+        end.QuadPart = (LONGLONG)written_;
+        ::SetFilePointerEx(file_, end, nullptr, FILE_BEGIN);
+        ::SetEndOfFile(file_);
+        ::CloseHandle(file_);
+    }
+#else
+    if (mapped_)
+        ::munmap(mapped_, mapped_size_);
+    if (file_ >= 0)
+    {
+        // drop the unused tail of the mapping
+        [[maybe_unused]] auto _ = ::ftruncate(file_, (off_t)written_);
+        ::close(file_);
+    }
+#endif
+    mapped_ = nullptr;
+}
+
+bool LogBinaryFileSink::remap(uint64_t size) SKR_NOEXCEPT
+{
+#ifdef _WIN32
+    if (mapped_)
+        ::UnmapViewOfFile(mapped_);
+    if (mapping_)
+        ::CloseHandle(mapping_);
+    mapped_  = nullptr;
+    mapping_ = ::CreateFileMappingW(file_, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), nullptr);
+    if (mapping_)
+        mapped_ = (uint8_t*)::MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size);
+#else
+    if (mapped_)
+        ::munmap(mapped_, mapped_size_);
+    mapped_ = nullptr;
+    if (::ftruncate(file_, (off_t)size) == 0)
+    {
+        auto address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_, 0);
+        if (address != MAP_FAILED)
+            mapped_ = (uint8_t*)address;
+    }
+#endif
+    if (!mapped_)
+    {
+        SKR_LOG_ERROR(u8"failed to map binary log file with %llu bytes", size);
+        mapped_size_ = 0;
+        return false;
+    }
+    mapped_size_ = size;
+    return true;
+}
+
+void LogBinaryFileSink::write(const uint8_t* data, uint64_t size) SKR_NOEXCEPT
+{
+    if (!mapped_)
+        return;
+    if (written_ + size > mapped_size_)
+    {
+        SkrZoneScopedN("BinaryLogRemap");
+        if (!remap(std::max(mapped_size_ * 2, binary_log_align(written_ + size))))
+            return;
+    }
+    std::memcpy(mapped_ + written_, data, size);
+    written_ += size;
+}
+
+void LogBinaryFileSink::flush() SKR_NOEXCEPT
+{
+    if (!mapped_)
+        return;
+#ifdef _WIN32
+    ::FlushViewOfFile(mapped_, 0);
+#else
+    ::msync(mapped_, mapped_size_, MS_ASYNC);
+#endif
+}
+
+// binary log
+uint32_t BinaryLog::RegisterSite(int level, const char8_t* format, const char* file, const char* func, const char* line) SKR_NOEXCEPT
+{
+    auto&      state = binary_log_state();
+    SMutexLock lock(state.sites_mutex.mMutex);
+    state.sites.add({ level, format, file, func, line });
+    return (uint32_t)state.sites.size() - 1;
+}
+
+void BinaryLog::Open(skr::UPtr<LogBinarySink> sink, uint32_t ring_size) SKR_NOEXCEPT
+{
+    Close();
+
+    auto& state = binary_log_state();
+    {
+        uint64_t size = kBinaryLogMinRingSize;
+        while (size < ring_size)
+            size <<= 1;
+        state.ring_size.store(size, std::memory_order_relaxed);
+    }
+    {
+        SMutexLock lock(state.drain_mutex.mMutex);
+        state.sink = std::move(sink);
+        binary_log_write_header(state.sink.get());
+        // a new stream needs every site and thread again
+        {
+            SMutexLock sites_lock(state.sites_mutex.mMutex);
+            state.written_sites = 0;
+        }
+        SMutexLock rings_lock(state.rings_mutex.mMutex);
+        for (auto ring : state.rings)
+            ring->announced = false;
+    }
+    gOpened.store(true, std::memory_order_release);
+}
+
+void BinaryLog::Close() SKR_NOEXCEPT
+{
+    if (!gOpened.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    Drain();
+    auto&      state = binary_log_state();
+    SMutexLock lock(state.drain_mutex.mMutex);
+    if (state.sink)
+    {
+        state.sink->flush();
+        state.sink.reset();
+    }
+}
+
+uint8_t* BinaryLog::BeginRecord(uint32_t site_id, uint32_t args_size) SKR_NOEXCEPT
+{
+    auto           ring = binary_log_acquire_ring();
+    const uint64_t mask = ring->capacity - 1;
+    // header, args and the end tag
+    const uint64_t size = binary_log_align(sizeof(BinaryLogRecordHeader) + args_size + 1);
+    if (size > ring->capacity / 2)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint64_t head       = ring->head.load(std::memory_order_relaxed);
+    uint64_t contiguous = ring->capacity - (head & mask);
+    uint64_t padding    = contiguous < size ? contiguous : 0;
+    if (head + padding + size - ring->tail.load(std::memory_order_acquire) > ring->capacity)
+    {
+        // no worker to drain for us, do it inline
+        if (LogManagerImpl::gLogManager->TryGetWorker() == nullptr)
+            Drain();
+        if (head + padding + size - ring->tail.load(std::memory_order_acquire) > ring->capacity)
+        {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    if (padding)
+    {
+        // records never wrap, skip the end of the ring
+        const uint32_t padding_header[2] = { (uint32_t)padding, kBinaryLogPadding };
+        std::memcpy(ring->data + (head & mask), padding_header, sizeof(padding_header));
+        head += padding;
+    }
+
+    auto                  record = ring->data + (head & mask);
+    BinaryLogRecordHeader header = {
+        (uint32_t)size,
+        site_id,
+        TSCNS::rdtsc(),
+        ring->thread_id
+    };
+    std::memcpy(record, &header, sizeof(header));
+    // zero the end tag and alignment
+    const uint64_t args_end = sizeof(header) + args_size;
+    std::memset(record + args_end, 0, size - args_end);
+
+    ring->reserved = head + size;
+    return record + sizeof(header);
+}
+
+void BinaryLog::EndRecord() SKR_NOEXCEPT
+{
+    auto ring = tls_binary_log_ring.ring;
+    ring->head.store(ring->reserved, std::memory_order_release);
+
+    // wake the worker early when the ring is filling up, otherwise it drains on its own cadence
+    if (ring->reserved - ring->tail.load(std::memory_order_relaxed) > ring->capacity / 2 &&
+        !ring->wake.exchange(true, std::memory_order_relaxed))
+    {
+        if (auto worker = LogManagerImpl::gLogManager->TryGetWorker())
+            worker->awake();
+    }
+}
+
+void BinaryLog::Drain() SKR_NOEXCEPT
+{
+    auto&      state = binary_log_state();
+    SMutexLock lock(state.drain_mutex.mMutex);
+    auto       sink = state.sink.get();
+
+    {
+        SMutexLock rings_lock(state.rings_mutex.mMutex);
+        state.drain_rings = state.rings;
+    }
+
+    // skip the clock record when there is nothing to write
+    bool pending = false;
+    {
+        SMutexLock sites_lock(state.sites_mutex.mMutex);
+        pending = state.written_sites < state.sites.size();
+    }
+    for (auto ring : state.drain_rings)
+    {
+        if (ring->head.load(std::memory_order_acquire) != ring->tail.load(std::memory_order_relaxed) ||
+            ring->dropped.load(std::memory_order_relaxed) != 0 || !ring->announced)
+        {
+            pending = true;
+            break;
+        }
+    }
+    if (!pending)
+        return;
+
+    SkrZoneScopedN("BinaryLogDrain");
+    auto& tscns = LogManagerImpl::gLogManager->tscns_;
+    if (sink)
+    {
+        // clock sync, records are converted with the latest one before them
+        const auto             tsc = TSCNS::rdtsc();
+        BinaryLogRecordBuilder clock(state.scratch, kBinaryLogClock, tsc, 0);
+        clock.add(tscns.tsc2ns(tsc));
+        clock.add(1.0 / tscns.getTscGhz());
+        clock.write(sink);
+
+        // call sites registered since the last drain
+        SMutexLock sites_lock(state.sites_mutex.mMutex);
+        for (; state.written_sites < state.sites.size(); ++state.written_sites)
+        {
+            const auto&            site = state.sites[state.written_sites];
+            BinaryLogRecordBuilder record(state.scratch, kBinaryLogSite, tsc, 0);
+            record.add(state.written_sites);
+            record.add((uint32_t)site.level);
+            record.add_string(site.format);
+            record.add_string((const char8_t*)site.file);
+            record.add_string((const char8_t*)site.func);
+            record.add_string((const char8_t*)site.line);
+            record.write(sink);
+        }
+    }
+
+    for (auto ring : state.drain_rings)
+    {
+        const uint64_t mask = ring->capacity - 1;
+        uint64_t       tail = ring->tail.load(std::memory_order_relaxed);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (sink && !ring->announced)
+        {
+            BinaryLogRecordBuilder record(state.scratch, kBinaryLogThread, TSCNS::rdtsc(), ring->thread_id);
+            record.add_string(ring->thread_name.c_str());
+            record.write(sink);
+            ring->announced = true;
+        }
+        while (tail < head)
+        {
+            auto     record = ring->data + (tail & mask);
+            uint32_t size, site_id;
+            std::memcpy(&size, record, sizeof(size));
+            std::memcpy(&site_id, record + sizeof(size), sizeof(site_id));
+            if (sink && site_id != kBinaryLogPadding)
+                sink->write(record, size);
+            tail += size;
+        }
+        ring->tail.store(tail, std::memory_order_release);
+        ring->wake.store(false, std::memory_order_relaxed);
+
+        if (const auto dropped = ring->dropped.exchange(0, std::memory_order_relaxed); dropped && sink)
+        {
+            BinaryLogRecordBuilder record(state.scratch, kBinaryLogDropped, TSCNS::rdtsc(), ring->thread_id);
+            record.add(dropped);
+            record.write(sink);
+        }
+    }
+
+    // free rings of exited threads
+    {
+        SMutexLock rings_lock(state.rings_mutex.mMutex);
+        for (uint64_t i = 0; i < state.rings.size();)
+        {
+            auto ring = state.rings[i];
+            if (ring->orphaned.load(std::memory_order_acquire) &&
+                ring->head.load(std::memory_order_acquire) == ring->tail.load(std::memory_order_relaxed))
+            {
+                SkrDelete(ring);
+                state.rings.remove_at_swap(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+}
+
+// decode
+namespace
+{
+struct BinaryLogReader {
+    BinaryLogReader(const uint8_t* data, uint64_t size)
+        : p(data)
+        , end(data + size)
+    {
+    }
+    template <typename T>
+    bool read(T& v)
+    {
+        if ((uint64_t)(end - p) < sizeof(T))
+            return false;
+        std::memcpy(&v, p, sizeof(T));
+        p += sizeof(T);
+        return true;
+    }
+    bool read_string(skr::StringView& v)
+    {
+        uint32_t len;
+        if (!read(len) || (uint64_t)(end - p) < len)
+            return false;
+        v = skr::StringView((const char8_t*)p, len);
+        p += len;
+        return true;
+    }
+    const uint8_t* p;
+    const uint8_t* end;
+};
+
+struct BinaryLogDecodedSite {
+    LogLevel        level;
+    skr::StringView format;
+    skr::StringView file;
+    skr::StringView func;
+    skr::StringView line;
+};
+
+template <typename F>
+bool binary_log_each_record(const uint8_t* data, uint64_t size, F&& func)
+{
+    BinaryLogFileHeader expected = {};
+    BinaryLogFileHeader header;
+    if (size < sizeof(header))
+        return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version)
+        return false;
+
+    uint64_t offset = header.header_size;
+    while (offset + sizeof(BinaryLogRecordHeader) <= size)
+    {
+        BinaryLogRecordHeader record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        // zero size is the unwritten tail of a mapping that wasn't truncated (crash)
+        if (record.size < sizeof(record) || offset + record.size > size)
+            break;
+        func(record, BinaryLogReader(data + offset + sizeof(record), record.size - sizeof(record)));
+        offset += record.size;
+    }
+    return true;
+}
+
+void binary_log_format_arg(skr::String& out, BinaryLogReader& args, skr::StringView spec)
+{
+    uint8_t tag = 0;
+    if (!args.read(tag) || tag == (uint8_t)EBinaryLogArg::kEnd)
+    {
+        out.append(u8"{?}");
+        return;
+    }
+
+    skr::String fmt = u8"{";
+    if (!spec.is_empty())
+    {
+        fmt.append(u8":");
+        fmt.append(spec);
+    }
+    fmt.append(u8"}");
+
+    uint64_t bits = 0;
+    switch ((EBinaryLogArg)tag)
+    {
+    case EBinaryLogArg::kString: {
+        skr::StringView str;
+        if (args.read_string(str))
+            skr::format_to(out, fmt.view(), str);
+        return;
+    }
+    case EBinaryLogArg::kInt64:
+        args.read(bits);
+        skr::format_to(out, fmt.view(), (int64_t)bits);
+        return;
+    case EBinaryLogArg::kUInt64:
+        args.read(bits);
+        skr::format_to(out, fmt.view(), bits);
+        return;
+    case EBinaryLogArg::kDouble: {
+        args.read(bits);
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        skr::format_to(out, fmt.view(), d);
+        return;
+    }
+    case EBinaryLogArg::kBool:
+        args.read(bits);
+        skr::format_to(out, fmt.view(), bits != 0);
+        return;
+    default:
+        out.append(u8"{?}");
+        return;
+    }
+}
+
+void binary_log_format(skr::String& out, skr::StringView format, BinaryLogReader& args)
+{
+    const auto     str = format.data();
+    const uint64_t len = format.length_buffer();
+    for (uint64_t i = 0; i < len; ++i)
+    {
+        const auto c = str[i];
+        if ((c == u8'{' || c == u8'}') && i + 1 < len && str[i + 1] == c)
+        {
+            out.append(&str[i], 1);
+            ++i;
+        }
+        else if (c == u8'{')
+        {
+            uint64_t close = i + 1;
+            while (close < len && str[close] != u8'}')
+                ++close;
+            // positional indices are dropped, args are consumed in order
+            uint64_t spec_begin = i + 1;
+            while (spec_begin < close && str[spec_begin] != u8':')
+                ++spec_begin;
+            if (spec_begin < close)
+                ++spec_begin;
+            binary_log_format_arg(out, args, skr::StringView(str + spec_begin, close - spec_begin));
+            i = close;
+        }
+        else
+        {
+            out.append(&str[i], 1);
+        }
+    }
+}
+} // namespace
+
+bool BinaryLog::Decode(const uint8_t* data, uint64_t size, FunctionRef<void(const BinaryLogEntry& entry)> func) SKR_NOEXCEPT
+{
+    // sites and thread names may be written after their first records, collect them first
+    skr::FlatHashMap<uint32_t, BinaryLogDecodedSite> sites;
+    skr::FlatHashMap<uint64_t, skr::StringView>      threads;
+    bool                                             valid = binary_log_each_record(data, size, [&](const BinaryLogRecordHeader& record, BinaryLogReader reader) {
+        if (record.site_id == kBinaryLogSite)
+        {
+            uint32_t             id, level;
+            BinaryLogDecodedSite site;
+            if (reader.read(id) && reader.read(level) && reader.read_string(site.format) &&
+                reader.read_string(site.file) && reader.read_string(site.func) && reader.read_string(site.line))
+            {
+                site.level = LogConstants::kLogLevelsLUT[std::min(level, (uint32_t)LogLevel::kCount - 1)];
+                sites.insert_or_assign(id, site);
+            }
+        }
+        else if (record.site_id == kBinaryLogThread)
+        {
+            skr::StringView name;
+            if (reader.read_string(name))
+                threads.insert_or_assign(record.thread_id, name);
+        }
+    });
+    if (!valid)
+        return false;
+
+    int64_t     clock_tsc = 0, clock_ns = 0;
+    double      ns_per_tsc = 0.0;
+    skr::String message;
+    binary_log_each_record(data, size, [&](const BinaryLogRecordHeader& record, BinaryLogReader reader) {
+        if (record.site_id == kBinaryLogClock)
+        {
+            clock_tsc = record.timestamp;
+            reader.read(clock_ns);
+            reader.read(ns_per_tsc);
+            return;
+        }
+
+        BinaryLogEntry entry = {};
+        entry.ns             = clock_ns + (int64_t)((double)(record.timestamp - clock_tsc) * ns_per_tsc);
+        entry.thread_id      = record.thread_id;
+        if (auto thread = threads.find(record.thread_id); thread != threads.end())
+            entry.thread_name = thread->second;
+
+        message.clear();
+        if (record.site_id == kBinaryLogDropped)
+        {
+            uint64_t dropped = 0;
+            reader.read(dropped);
+            skr::format_to(message, u8"{} binary log records dropped, ring buffer was full", dropped);
+            entry.level = LogLevel::kWarning;
+        }
+        else if (auto site = sites.find(record.site_id); site != sites.end())
+        {
+            binary_log_format(message, site->second.format, reader);
+            entry.level = site->second.level;
+            entry.file  = site->second.file;
+            entry.func  = site->second.func;
+            entry.line  = site->second.line;
+        }
+        else
+        {
+            // site, thread and unknown special records
+            return;
+        }
+        entry.message = message.view();
+        func(entry);
+    });
+    return true;
+}
+
+} // namespace logging
+} // namespace skr
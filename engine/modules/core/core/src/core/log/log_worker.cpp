@@ -1,5 +1,6 @@
 #include "SkrCore/log.h"
 #include "SkrCore/log/logger.hpp"
+#include "SkrCore/log/log_binary.hpp"
 #include "SkrCore/async/wait_timeout.hpp"
 #include "./log_manager.hpp"
 
@@ -275,6 +276,10 @@ void LogWorker::flush(SThreadID tid) SKR_NOEXCEPT
 
 skr::AsyncResult LogWorker::serve() SKR_NOEXCEPT
 {
+    // binary records are drained on every wake, at most sleep_time apart
+    if (BinaryLog::IsOpen())
+        BinaryLog::Drain();
+
     if (!predicate())
     {
         setServiceStatus(SKR_ASYNC_SERVICE_STATUS_SLEEPING);
@@ -335,6 +340,10 @@ void skr_log_flush()
         auto tid = skr_current_thread_id();
         worker->flush(tid);
     }    
+    if (skr::logging::BinaryLog::IsOpen())
+    {
+        skr::logging::BinaryLog::Drain();
+    }
 }
 
 SKR_EXTERN_C
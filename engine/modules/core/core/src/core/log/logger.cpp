@@ -1,5 +1,6 @@
 #include "SkrCore/log.h"
 #include "SkrCore/log/logger.hpp"
+#include "SkrCore/log/log_binary.hpp"
 #include "./log_manager.hpp"
 
 #include <thread>
@@ -159,6 +160,7 @@ void skr_log_finalize_async_worker()
     {
         if (auto worker = skr::logging::LogManagerImpl::gLogManager->TryGetWorker())
             worker->drain();
+        skr::logging::BinaryLog::Drain();
     }
     skr::logging::LogManagerImpl::gLogManager->FinalizeAsyncWorker();
 
@@ -1,15 +1,93 @@
 #include "SkrRTTR/type.hpp"
 #include "SkrCore/log.hpp"
 #include "SkrRTTR/export/extern_methods.hpp"
+#include "SkrContainersDef/map.hpp"
+#include "SkrBase/misc/hash.h"
 
 namespace skr
 {
+// optimize data
+template <typename T>
+struct RTTRMemberIndex {
+    static constexpr uint32_t npos = ~uint32_t(0);
+
+    inline static skr_hash name_hash(StringView name)
+    {
+        return skr_hash_of(name.data(), name.size());
+    }
+
+    // items must come in each_xxx() order, self members first
+    void build()
+    {
+        next.resize_unsafe(items.size());
+        for (uint32_t i = (uint32_t)items.size(); i > 0; --i)
+        {
+            const auto index = i - 1;
+            const auto hash  = name_hash(items[index]->name.view());
+            auto       head  = heads.find(hash);
+            if (head)
+            {
+                next[index]  = head.value();
+                head.value() = index;
+            }
+            else
+            {
+                next[index] = npos;
+                heads.add(hash, index);
+            }
+        }
+    }
+
+    // same result as a linear scan over self then bases, but only walks members sharing the name hash
+    template <typename Filter>
+    const T* find(const RTTRTypeFindConfig& config, Filter&& filter) const
+    {
+        const uint32_t end = config.include_bases ? (uint32_t)items.size() : self_count;
+        if (config.name)
+        {
+            auto head = heads.find(name_hash(config.name.value()));
+            if (head)
+            {
+                for (uint32_t i = head.value(); i != npos && i < end; i = next[i])
+                {
+                    if (filter(items[i])) { return items[i]; }
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t i = 0; i < end; ++i)
+            {
+                if (filter(items[i])) { return items[i]; }
+            }
+        }
+        return nullptr;
+    }
+
+    Vector<const T*>        items      = {};
+    Vector<uint32_t>        next       = {}; // next item with the same name hash
+    Map<skr_hash, uint32_t> heads      = {}; // first item of each name hash
+    uint32_t                self_count = 0;
+};
+struct RTTRTypeOptimizeData {
+    RTTRMemberIndex<RTTRMethodData>       methods        = {};
+    RTTRMemberIndex<RTTRFieldData>        fields         = {};
+    RTTRMemberIndex<RTTRStaticMethodData> static_methods = {};
+    RTTRMemberIndex<RTTRStaticFieldData>  static_fields  = {};
+    RTTRMemberIndex<RTTRExternMethodData> extern_methods = {};
+};
+
 // ctor & dtor
 RTTRType::RTTRType()
 {
 }
 RTTRType::~RTTRType()
 {
+    if (auto optimize_data = _optimize_data.load(std::memory_order_relaxed))
+    {
+        SkrDelete(optimize_data);
+    }
+
     switch (_type_category)
     {
     case ERTTRTypeCategory::Invalid:
@@ -76,6 +154,37 @@ void RTTRType::build_enum(FunctionRef<void(RTTREnumData* data)> func)
     func(&_enum_data);
 }
 
+// optimize data
+void RTTRType::build_optimize_data()
+{
+    if (_optimize_data.load(std::memory_order_acquire)) { return; }
+
+    auto data    = SkrNew<RTTRTypeOptimizeData>();
+    auto collect = [this](auto& index) {
+        return [this, &index](const auto* member, const RTTRType* owner) {
+            index.items.add(member);
+            if (owner == this) { ++index.self_count; }
+        };
+    };
+    each_method(collect(data->methods));
+    each_field(collect(data->fields));
+    each_static_method(collect(data->static_methods));
+    each_static_field(collect(data->static_fields));
+    each_extern_method(collect(data->extern_methods));
+    data->methods.build();
+    data->fields.build();
+    data->static_methods.build();
+    data->static_fields.build();
+    data->extern_methods.build();
+
+    // another thread may have built it meanwhile
+    RTTRTypeOptimizeData* expected = nullptr;
+    if (!_optimize_data.compare_exchange_strong(expected, data, std::memory_order_acq_rel))
+    {
+        SkrDelete(data);
+    }
+}
+
 // caster
 bool RTTRType::based_on(GUID type_id, uint32_t* out_cast_count) const
 {
@@ -434,6 +543,14 @@ void RTTRType::each_extern_method(FunctionRef<void(const RTTRExternMethodData* m
             each_func(method, this);
         }
     }
+    else if (_type_category == ERTTRTypeCategory::Enum)
+    {
+        // each self
+        for (const auto& method : _enum_data.extern_methods)
+        {
+            each_func(method, this);
+        }
+    }
 }
 
 // find method & field
@@ -480,6 +597,12 @@ const RTTRMethodData* RTTRType::find_method(RTTRTypeFindConfig config) const
             return true;
         };
 
+        // fast path
+        if (auto optimize_data = _optimize_data.load(std::memory_order_acquire))
+        {
+            return optimize_data->methods.find(config, find_func);
+        }
+
         // find self
         auto result = _record_data.methods.find_if(find_func);
         if (result)
@@ -530,6 +653,12 @@ const RTTRFieldData* RTTRType::find_field(RTTRTypeFindConfig config) const
             return true;
         };
 
+        // fast path
+        if (auto optimize_data = _optimize_data.load(std::memory_order_acquire))
+        {
+            return optimize_data->fields.find(config, find_func);
+        }
+
         // find self
         auto result = _record_data.fields.find_if(find_func);
         if (result)
@@ -580,6 +709,12 @@ const RTTRStaticMethodData* RTTRType::find_static_method(RTTRTypeFindConfig conf
             return true;
         };
 
+        // fast path
+        if (auto optimize_data = _optimize_data.load(std::memory_order_acquire))
+        {
+            return optimize_data->static_methods.find(config, find_func);
+        }
+
         // find self
         auto result = _record_data.static_methods.find_if(find_func);
         if (result)
@@ -630,6 +765,12 @@ const RTTRStaticFieldData* RTTRType::find_static_field(RTTRTypeFindConfig config
             return true;
         };
 
+        // fast path
+        if (auto optimize_data = _optimize_data.load(std::memory_order_acquire))
+        {
+            return optimize_data->static_fields.find(config, find_func);
+        }
+
         // find self
         auto result = _record_data.static_fields.find_if(find_func);
         if (result)
@@ -678,6 +819,12 @@ const RTTRExternMethodData* RTTRType::find_extern_method(RTTRTypeFindConfig conf
         return true;
     };
 
+    // fast path
+    if (auto optimize_data = _optimize_data.load(std::memory_order_acquire))
+    {
+        return optimize_data->extern_methods.find(config, find_func);
+    }
+
     if (_type_category == ERTTRTypeCategory::Record)
     {
         // find self
@@ -717,7 +864,7 @@ const RTTRExternMethodData* RTTRType::find_extern_method(RTTRTypeFindConfig conf
             return result.ref();
         }
     }
-    else if (_type_category == ERTTRTypeCategory::Record)
+    else if (_type_category == ERTTRTypeCategory::Enum)
     {
         // find self
         auto result = _enum_data.extern_methods.find_if(find_func);
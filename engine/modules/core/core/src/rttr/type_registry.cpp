@@ -6,6 +6,7 @@
 #include "SkrRTTR/type.hpp"
 #include "SkrBase/misc.h"
 #include <SkrOS/thread.h>
+#include <atomic>
 
 namespace skr
 {
@@ -22,11 +23,90 @@ static Map<GUID, RTTRType*>& loaded_types()
 }
 static auto& load_type_mutex()
 {
-    // TODO. use shared_atomic_mutex for better performance
     static SMutexObject s_load_type_mutex;
     return s_load_type_mutex;
 }
 
+// lock-free index of loaded types, insert only, readers never take load_type_mutex
+// writers publish under load_type_mutex, full indices are replaced by a grown copy and retired until unload
+struct LoadedTypeIndex {
+    struct Slot {
+        Slot() = default;
+        Slot(const Slot& other)
+            : type(other.type.load(std::memory_order_relaxed))
+            , guid(other.guid)
+        {
+        }
+
+        std::atomic<RTTRType*> type = nullptr;
+        GUID                   guid = {};
+    };
+
+    RTTRType* find(const GUID& guid) const
+    {
+        const uint64_t mask = slots.size() - 1;
+        for (uint64_t i = guid.get_hash() & mask;; i = (i + 1) & mask)
+        {
+            auto type = slots[i].type.load(std::memory_order_acquire);
+            if (!type) { return nullptr; }
+            if (slots[i].guid == guid) { return type; }
+        }
+    }
+    void add(const GUID& guid, RTTRType* type)
+    {
+        const uint64_t mask = slots.size() - 1;
+        for (uint64_t i = guid.get_hash() & mask;; i = (i + 1) & mask)
+        {
+            if (!slots[i].type.load(std::memory_order_relaxed))
+            {
+                // guid must be visible before the type
+                slots[i].guid = guid;
+                slots[i].type.store(type, std::memory_order_release);
+                ++count;
+                return;
+            }
+        }
+    }
+
+    Vector<Slot> slots = {};
+    uint64_t     count = 0;
+};
+static std::atomic<LoadedTypeIndex*>& loaded_type_index()
+{
+    static std::atomic<LoadedTypeIndex*> s_index = nullptr;
+    return s_index;
+}
+static Vector<LoadedTypeIndex*>& retired_type_indices()
+{
+    static Vector<LoadedTypeIndex*> s_retired;
+    return s_retired;
+}
+static void publish_type(const GUID& guid, RTTRType* type)
+{
+    // must be called with load_type_mutex locked
+    auto index = loaded_type_index().load(std::memory_order_relaxed);
+    if (!index || (index->count + 1) * 2 > index->slots.size())
+    {
+        // keep load factor below 1/2, readers of the old index still see all types published before
+        auto new_index = SkrNew<LoadedTypeIndex>();
+        new_index->slots.resize_default(index ? index->slots.size() * 2 : 256);
+        if (index)
+        {
+            for (const auto& slot : index->slots)
+            {
+                if (auto slot_type = slot.type.load(std::memory_order_relaxed))
+                {
+                    new_index->add(slot.guid, slot_type);
+                }
+            }
+            retired_type_indices().add(index);
+        }
+        loaded_type_index().store(new_index, std::memory_order_release);
+        index = new_index;
+    }
+    index->add(guid, type);
+}
+
 // auto unload
 SKR_EXEC_STATIC_DTOR
 {
@@ -55,52 +135,88 @@ void unregister_type_loader(const GUID& guid, RTTRTypeLoaderFunc load_func)
 // get type (after register)
 RTTRType* get_type_from_guid(const GUID& guid)
 {
-    SMutexLock _lock(load_type_mutex().mMutex);
-
-    auto loaded_result = loaded_types().find(guid);
-    if (loaded_result)
+    // fast path, type is published after it's fully loaded
+    if (auto index = loaded_type_index().load(std::memory_order_acquire))
     {
-        return loaded_result.value();
+        if (auto type = index->find(guid))
+        {
+            return type;
+        }
     }
-    else
+
+    RTTRType* loaded_type = nullptr;
     {
-        auto loader_result = type_load_funcs().find(guid);
-        if (loader_result)
-        {
-            // create type
-            auto type = SkrNew<RTTRType>();
-            loaded_types().add(guid, type);
+        SMutexLock _lock(load_type_mutex().mMutex);
 
-            // load type
-            loader_result.value()(type);
+        auto loaded_result = loaded_types().find(guid);
+        if (loaded_result)
+        {
+            return loaded_result.value();
+        }
+        else
+        {
+            auto loader_result = type_load_funcs().find(guid);
+            if (loader_result)
+            {
+                // create type
+                loaded_type = SkrNew<RTTRType>();
+                loaded_types().add(guid, loaded_type);
 
-            // TODO. build optimize data?
-            return type;
+                // load type
+                loader_result.value()(loaded_type);
+                publish_type(guid, loaded_type);
+            }
         }
     }
 
-    return nullptr;
+    // optimize data walks bases through get_type_from_guid, so build it out of the lock
+    if (loaded_type)
+    {
+        loaded_type->build_optimize_data();
+    }
+    return loaded_type;
 }
 void load_all_types()
 {
-    SMutexLock _lock(load_type_mutex().mMutex);
-    for (const auto& [type_id, type_loader] : type_load_funcs())
+    Vector<RTTRType*> new_types;
     {
-        if (!loaded_types().contains(type_id))
+        SMutexLock _lock(load_type_mutex().mMutex);
+        for (const auto& [type_id, type_loader] : type_load_funcs())
         {
-            // create type
-            auto type = SkrNew<RTTRType>();
-            loaded_types().add(type_id, type);
+            if (!loaded_types().contains(type_id))
+            {
+                // create type
+                auto type = SkrNew<RTTRType>();
+                loaded_types().add(type_id, type);
 
-            // load type
-            type_loader(type);
+                // load type
+                type_loader(type);
+                publish_type(type_id, type);
+                new_types.add(type);
+            }
         }
     }
+
+    for (auto type : new_types)
+    {
+        type->build_optimize_data();
+    }
 }
 void unload_all_types()
 {
     SMutexLock _lock(load_type_mutex().mMutex);
 
+    // release lookup index
+    if (auto index = loaded_type_index().exchange(nullptr, std::memory_order_acq_rel))
+    {
+        SkrDelete(index);
+    }
+    for (auto index : retired_type_indices())
+    {
+        SkrDelete(index);
+    }
+    retired_type_indices().clear();
+
     // release type memory
     for (auto& type : loaded_types())
     {
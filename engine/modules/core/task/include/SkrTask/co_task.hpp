@@ -33,11 +33,24 @@ namespace task2
     using state_ptr_t = SP<T>;
     template<class T>
     using state_weak_ptr_t = SPWeak<T>;
+    // workers drain and steal the lanes in this order, so bulk work never delays the lanes above it
+    enum class task_priority_t : uint8_t
+    {
+        high = 0,   // latency sensitive work, e.g. io completions and render submission
+        normal,
+        background, // bulk work that only runs when nothing else is queued
+        count
+    };
     struct SKR_TASK_API scheudler_config_t
     {
         scheudler_config_t();
+        // pins each worker group to the cores it was created for, only when there is more than one group:
+        // a single group gains nothing from pinning and would be kept off the other cores
         bool setAffinity = true;
         uint32_t numThreads = 0;
+        // workers sharing a last level cache / numa node, idle workers steal inside their group first
+        // 0 picks a default from the core count
+        uint32_t workersPerGroup = 0;
     };
 #ifdef SKR_PROFILE_ENABLE
     struct skr_task_name_t
@@ -72,6 +85,8 @@ namespace task2
 
             void* operator new(size_t size) { return sakura_malloc(size); }
             void operator delete(void* ptr, size_t size) { sakura_free(ptr); }
+            // lane the coroutine is queued in, also when it resumes after a co_wait
+            task_priority_t priority = task_priority_t::normal;
 #ifdef SKR_PROFILE_ENABLE
             const char* name = nullptr;
 #endif
@@ -238,8 +253,8 @@ namespace task2
         void unbind();
         void shutdown();
         static scheduler_t* instance();
-        void schedule(skr_task_t&& task);
-        void schedule(skr::stl_function<void()>&& function);
+        void schedule(skr_task_t&& task, task_priority_t priority = task_priority_t::normal);
+        void schedule(skr::stl_function<void()>&& function, task_priority_t priority = task_priority_t::normal);
         struct SKR_TASK_API EventAwaitable
         {
             EventAwaitable(scheduler_t& s, event_t event, int workerIdx = -1);
@@ -262,23 +277,30 @@ namespace task2
         };
         void sync(event_t event);
         void sync(counter_t counter);
+        // worker group layout, valid after initialize
+        uint32_t group_of(uint32_t worker) const;
+        // workers a worker steals from: its own group first, then the nearest groups
+        void steal_order(uint32_t worker, skr::Vector<uint32_t>& victims) const;
+        // the cores a group is pinned to when setAffinity is on and there are several groups
+        uint64_t group_affinity_mask(uint32_t group, uint32_t core_count) const;
         skr::Array<std::atomic<int>, 8> spinningWorkers;
         std::atomic<unsigned int> nextSpinningWorkerIdx = {0x8000000};
         std::atomic<unsigned int> nextEnqueueIndex = {0};
         skr::Array<void*, 256> workers;
         void* mainWorker = nullptr;
+        uint32_t numGroups = 0;
         scheudler_config_t config;
         bool initialized = false;
         bool binded = false;
     };
 
-    inline void schedule(skr_task_t&& task)
+    inline void schedule(skr_task_t&& task, task_priority_t priority = task_priority_t::normal)
     {
-        scheduler_t::instance()->schedule(std::move(task));
+        scheduler_t::instance()->schedule(std::move(task), priority);
     }
-    inline void schedule(skr::stl_function<void()>&& function)
+    inline void schedule(skr::stl_function<void()>&& function, task_priority_t priority = task_priority_t::normal)
     {
-        scheduler_t::instance()->schedule(std::move(function));
+        scheduler_t::instance()->schedule(std::move(function), priority);
     }
     SKR_TASK_API scheduler_t::EventAwaitable co_wait(event_t event, bool pinned = false);
     SKR_TASK_API scheduler_t::CounterAwaitable co_wait(counter_t counter, bool pinned = false);
@@ -106,6 +106,9 @@ namespace skr::task
         friend scheduler_t;
     };
 
+    // threads the bound scheduler runs tasks on, at least 1
+    SKR_TASK_API uint32_t worker_count();
+
     struct SKR_TASK_API scheduler_t
     {
         using internal_t = ftl::TaskScheduler*;
@@ -141,6 +144,7 @@ namespace skr::task
         ftl::TaskSchedulerInitOptions options;
         friend struct counter_t;
         friend struct event_t;
+        friend uint32_t worker_count();
     };
 
     template<typename F>
@@ -159,6 +163,7 @@ namespace skr::task
         template<typename F>
         friend void wait(bool pin, F&& lambda);
         friend void* current_fiber();
+        friend uint32_t worker_count();
     };
 
     template<typename F>
@@ -280,6 +285,13 @@ namespace skr::task
 
     inline void* current_fiber() { return marl::Scheduler::Fiber::current(); }
 
+    // threads the bound scheduler runs tasks on, at least 1
+    inline uint32_t worker_count()
+    {
+        auto scheduler = marl::Scheduler::get();
+        return (scheduler && scheduler->config().workerThread.count > 0) ? (uint32_t)scheduler->config().workerThread.count : 1u;
+    }
+
     template<class F>
     void schedule(F&& lambda, event_t* event, const char* name = nullptr)
     {
@@ -2,7 +2,9 @@
 #include "SkrCore/memory/memory.h"
 #include "SkrTask/fib_task.hpp"
 #include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <thread>
 /*
 The api parallel_for and concurrent is similar but distinguishable, due to marl's dispatch philosophy, scheduled tasks scramble physical logic core. Thus "parallel_for" schedule tasks as much as arguments' required to ensure later tasks' responding performance. But "concurrent" schedule fixed tasks to ensure less stack-frame pointers' cutover for maximum computing performance, which may cause later tasks' latency.
 */
@@ -268,4 +270,296 @@ void concurrent(Iter begin, Iter end, size_t batch, F f, size_t inplace_batch_th
         counter.wait(true);
     }
 }
-} // namespace skr
\ No newline at end of file
+namespace parallel_detail
+{
+// entries written by different tasks, each on its own cache line
+template <typename T>
+struct PaddedArray {
+    struct alignas(64) Item {
+        T value;
+    };
+    template <typename... Args>
+    PaddedArray(size_t count, const Args&... args)
+        : count(count)
+    {
+        items = (Item*)sakura_malloc_aligned(sizeof(Item) * count, alignof(Item));
+        for (size_t i = 0; i < count; ++i)
+            new (items + i) Item{ T(args...) };
+    }
+    ~PaddedArray()
+    {
+        for (size_t i = 0; i < count; ++i)
+            items[i].~Item();
+        sakura_free_aligned(items, alignof(Item));
+    }
+    PaddedArray(const PaddedArray&)            = delete;
+    PaddedArray& operator=(const PaddedArray&) = delete;
+    T&           operator[](size_t i) { return items[i].value; }
+
+    Item*  items = nullptr;
+    size_t count = 0;
+};
+
+// [first, last) index ranges, one per task, packed in a single atomic so the owner can take grains from the front
+// while idle tasks split the back half off (lazy binary splitting: ranges are only split when someone runs dry)
+struct AdaptiveRanges {
+    static uint64_t pack(uint32_t first, uint32_t last) { return ((uint64_t)first << 32) | last; }
+    static uint32_t first_of(uint64_t range) { return (uint32_t)(range >> 32); }
+    static uint32_t last_of(uint64_t range) { return (uint32_t)range; }
+
+    AdaptiveRanges(uint32_t count, uint32_t grain, uint32_t task_count)
+        : grain(grain)
+        , task_count(task_count)
+        , ranges(task_count, 0)
+    {
+        for (uint32_t i = 0; i < task_count; ++i)
+        {
+            const auto first = (uint32_t)((uint64_t)count * i / task_count);
+            const auto last  = (uint32_t)((uint64_t)count * (i + 1) / task_count);
+            ranges[i].store(pack(first, last), std::memory_order_relaxed);
+        }
+    }
+
+    // the next grain from the front of the task's own range
+    bool claim(uint32_t task, uint32_t& first, uint32_t& last)
+    {
+        auto&    range = ranges[task];
+        uint64_t value = range.load(std::memory_order_relaxed);
+        while (first_of(value) < last_of(value))
+        {
+            const uint32_t begin = first_of(value);
+            const uint32_t end   = last_of(value);
+            const uint32_t next  = end - begin > grain ? begin + grain : end;
+            if (range.compare_exchange_weak(value, pack(next, end), std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                first = begin;
+                last  = next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // refills the task's empty range from the others: halves of ranges bigger than a grain first,
+    // then whole leftovers of tasks that have not started yet
+    bool steal(uint32_t task)
+    {
+        for (uint32_t pass = 0; pass < 2; ++pass)
+        {
+            for (uint32_t i = 1; i < task_count; ++i)
+            {
+                auto&    range = ranges[(task + i) % task_count];
+                uint64_t value = range.load(std::memory_order_relaxed);
+                while (last_of(value) - first_of(value) > (pass == 0 ? grain : 0u))
+                {
+                    const uint32_t begin = first_of(value);
+                    const uint32_t end   = last_of(value);
+                    const uint32_t mid   = pass == 0 ? begin + (end - begin) / 2 : begin;
+                    if (range.compare_exchange_weak(value, pack(begin, mid), std::memory_order_acq_rel, std::memory_order_relaxed))
+                    {
+                        // only the owner writes an empty range, thieves skip it
+                        ranges[task].store(pack(mid, end), std::memory_order_release);
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // f(first, last) until no range has anything left
+    template <class F>
+    void drain(uint32_t task, F&& f)
+    {
+        uint32_t first = 0, last = 0;
+        do
+        {
+            while (claim(task, first, last))
+                f(first, last);
+        } while (steal(task));
+    }
+
+    const uint32_t                     grain;
+    const uint32_t                     task_count;
+    PaddedArray<std::atomic<uint64_t>> ranges;
+};
+
+// ranges are packed as 32-bit indices, longer ones are processed in slices of this size
+inline constexpr size_t kMaxAdaptiveRange = UINT32_MAX;
+
+// tasks and grain for count items, the grain grows with the range so every task has about 32 grains to share
+inline void adaptive_layout(size_t count, size_t min_grain, uint32_t& task_count, uint32_t& out_grain)
+{
+    constexpr size_t kGrainsPerTask = 32;
+    const size_t     workers        = task::worker_count();
+    const size_t     grain          = std::max({ min_grain, count / (workers * kGrainsPerTask), (size_t)1 });
+    task_count = (uint32_t)std::min(workers, (count + grain - 1) / grain);
+    out_grain  = (uint32_t)std::min<size_t>(grain, UINT32_MAX);
+}
+
+// body(task) on task_count tasks, the calling thread runs task 0 and helps until the range is drained
+template <class Body>
+void adaptive_dispatch(uint32_t task_count, Body& body)
+{
+    task::counter_t counter;
+    counter.add(task_count - 1);
+    for (uint32_t i = 1; i < task_count; ++i)
+    {
+        skr::task::schedule([counter, &body, i]() mutable {
+            SKR_DEFER({ counter.decrement(); });
+            body(i);
+        },
+                            nullptr);
+    }
+    body(0);
+    counter.wait(true);
+}
+} // namespace parallel_detail
+
+// parallel_for without a batch size: starts with one task per worker and splits ranges only when a task runs dry,
+// so neither tiny batches (scheduling storms) nor huge ones (imbalance) have to be tuned per machine.
+// min_grain is the fewest items one f(l, r) call gets, it keeps cheap bodies on small ranges from fanning out
+template <class F, class Iter>
+requires(std::is_invocable_v<F, Iter, Iter>)
+void parallel_for_adaptive(Iter begin, Iter end, F f, size_t min_grain = 1)
+{
+    const auto n = (size_t)_distance(begin, end);
+    if (n == 0)
+        return;
+    if (n > parallel_detail::kMaxAdaptiveRange)
+    {
+        for (size_t first = 0; first < n; first += parallel_detail::kMaxAdaptiveRange)
+        {
+            auto l = begin;
+            _advance(l, first);
+            auto r = l;
+            _advance(r, std::min(parallel_detail::kMaxAdaptiveRange, n - first));
+            parallel_for_adaptive(l, r, f, min_grain);
+        }
+        return;
+    }
+    uint32_t task_count, task_grain;
+    parallel_detail::adaptive_layout(n, min_grain, task_count, task_grain);
+    if (task_count <= 1)
+    {
+        f(begin, end);
+        return;
+    }
+    parallel_detail::AdaptiveRanges ranges((uint32_t)n, task_grain, task_count);
+    auto                            body = [&](uint32_t task) {
+        ranges.drain(task, [&](uint32_t first, uint32_t last) {
+            auto l = begin;
+            _advance(l, first);
+            auto r = l;
+            _advance(r, last - first);
+            f(l, r);
+        });
+    };
+    parallel_detail::adaptive_dispatch(task_count, body);
+}
+
+// map(l, r) -> T for every piece handed out by parallel_for_adaptive, folded with reduce(T, T) -> T.
+// pieces are not visited in order, reduce must be associative and commutative
+template <class T, class Map, class Reduce, class Iter>
+requires(std::is_invocable_r_v<T, Map, Iter, Iter> && std::is_invocable_r_v<T, Reduce, T, T>)
+[[nodiscard]] T parallel_reduce(Iter begin, Iter end, T identity, Map map, Reduce reduce, size_t min_grain = 1)
+{
+    const auto n = (size_t)_distance(begin, end);
+    if (n == 0)
+        return identity;
+    if (n > parallel_detail::kMaxAdaptiveRange)
+    {
+        T result = identity;
+        for (size_t first = 0; first < n; first += parallel_detail::kMaxAdaptiveRange)
+        {
+            auto l = begin;
+            _advance(l, first);
+            auto r = l;
+            _advance(r, std::min(parallel_detail::kMaxAdaptiveRange, n - first));
+            result = reduce(std::move(result), parallel_reduce(l, r, identity, map, reduce, min_grain));
+        }
+        return result;
+    }
+    uint32_t task_count, task_grain;
+    parallel_detail::adaptive_layout(n, min_grain, task_count, task_grain);
+    if (task_count <= 1)
+        return reduce(std::move(identity), map(begin, end));
+    parallel_detail::AdaptiveRanges ranges((uint32_t)n, task_grain, task_count);
+    parallel_detail::PaddedArray<T> partials(task_count, identity);
+    auto                            body = [&](uint32_t task) {
+        T local = identity;
+        ranges.drain(task, [&](uint32_t first, uint32_t last) {
+            auto l = begin;
+            _advance(l, first);
+            auto r = l;
+            _advance(r, last - first);
+            local = reduce(std::move(local), map(l, r));
+        });
+        partials[task] = std::move(local);
+    };
+    parallel_detail::adaptive_dispatch(task_count, body);
+    T result = std::move(identity);
+    for (uint32_t i = 0; i < task_count; ++i)
+        result = reduce(std::move(result), std::move(partials[i]));
+    return result;
+}
+
+// inclusive scan, out[i] = op(in[0], ..., in[i]); op must be associative.
+// two passes over blocks: block totals in parallel, an exclusive scan of the totals, then every block rescanned
+// from its offset. in and out may be the same range
+template <class T, class Op, class InIter, class OutIter>
+requires(std::is_invocable_r_v<T, Op, T, decltype(*std::declval<InIter>())>)
+void parallel_scan(InIter begin, InIter end, OutIter out, T identity, Op op, size_t min_grain = 1)
+{
+    const auto n = (size_t)_distance(begin, end);
+    if (n == 0)
+        return;
+    auto scan_block = [&](size_t first, size_t last, T acc) {
+        auto in = begin;
+        _advance(in, first);
+        auto o = out;
+        _advance(o, first);
+        for (size_t i = first; i < last; ++i, ++in, ++o)
+        {
+            acc = op(std::move(acc), *in);
+            *o  = acc;
+        }
+    };
+    uint32_t task_count, block_size;
+    parallel_detail::adaptive_layout(n, min_grain, task_count, block_size);
+    if (task_count <= 1)
+    {
+        scan_block(0, n, identity);
+        return;
+    }
+    // blocks are written by different tasks, the padding keeps them off each other's cache lines
+    const size_t                    block_count = (n + block_size - 1) / block_size;
+    parallel_detail::PaddedArray<T> offsets(block_count, identity);
+    auto                            block_first = [&](size_t block) { return block * block_size; };
+    auto                            block_last  = [&](size_t block) { return std::min(n, (block + 1) * block_size); };
+    auto                            sum_blocks  = [&](size_t block_begin, size_t block_end) {
+        for (size_t block = block_begin; block < block_end; ++block)
+        {
+            auto in = begin;
+            _advance(in, block_first(block));
+            T total = identity;
+            for (size_t i = block_first(block); i < block_last(block); ++i, ++in)
+                total = op(std::move(total), *in);
+            offsets[block] = std::move(total);
+        }
+    };
+    auto scan_blocks = [&](size_t block_begin, size_t block_end) {
+        for (size_t block = block_begin; block < block_end; ++block)
+            scan_block(block_first(block), block_last(block), offsets[block]);
+    };
+    parallel_for_adaptive((size_t)0, block_count, sum_blocks, 1);
+    T running = identity;
+    for (size_t block = 0; block < block_count; ++block)
+    {
+        T total        = std::move(offsets[block]);
+        offsets[block] = running;
+        running        = op(std::move(running), std::move(total));
+    }
+    parallel_for_adaptive((size_t)0, block_count, scan_blocks, 1);
+}
+} // namespace skr
@@ -0,0 +1,123 @@
+#pragma once
+#include "SkrCore/memory/memory.h"
+#include "SkrContainers/vector.hpp"
+#include <atomic>
+
+namespace skr
+{
+namespace task2
+{
+    // Chase-Lev deque (https://fzn.fr/readings/ppopp13.pdf), only the owning worker pushes and pops at the bottom (LIFO),
+    // thieves take from the top (FIFO) and get the oldest, usually largest pieces of work
+    template <class T>
+    struct WorkStealingDeque
+    {
+        static constexpr const char* kDequeName = "WorkStealingDeque";
+        static constexpr int64_t kInitialCapacity = 256;
+
+        struct Ring
+        {
+            Ring(int64_t capacity)
+                : capacity(capacity)
+                , mask(capacity - 1)
+            {
+                slots = (std::atomic<T*>*)sakura_mallocN(sizeof(std::atomic<T*>) * capacity, kDequeName);
+                for (int64_t i = 0; i < capacity; ++i)
+                    new (slots + i) std::atomic<T*>(nullptr);
+            }
+            ~Ring() { sakura_freeN(slots, kDequeName); }
+            T* get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+            void put(int64_t i, T* item) { slots[i & mask].store(item, std::memory_order_relaxed); }
+
+            const int64_t capacity;
+            const int64_t mask;
+            std::atomic<T*>* slots = nullptr;
+        };
+
+        WorkStealingDeque()
+        {
+            ring.store(SkrNew<Ring>(kInitialCapacity), std::memory_order_relaxed);
+        }
+
+        ~WorkStealingDeque()
+        {
+            Ring* r = ring.load(std::memory_order_relaxed);
+            for (int64_t i = top.load(std::memory_order_relaxed); i < bottom.load(std::memory_order_relaxed); ++i)
+                SkrDelete(r->get(i));
+            SkrDelete(r);
+            for (auto old : retired)
+                SkrDelete(old);
+        }
+
+        // owner only
+        void push(T* item)
+        {
+            int64_t b = bottom.load(std::memory_order_relaxed);
+            int64_t t = top.load(std::memory_order_acquire);
+            Ring* r = ring.load(std::memory_order_relaxed);
+            if (b - t > r->capacity - 1)
+                r = grow(r, t, b);
+            r->put(b, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // owner only
+        T* pop()
+        {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            Ring* r = ring.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            T* item = r->get(b);
+            if (t == b)
+            {
+                // last item, thieves may race for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    item = nullptr;
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        }
+
+        // any thread, nullptr when empty or when another thread won the race
+        T* steal()
+        {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b)
+                return nullptr;
+            Ring* r = ring.load(std::memory_order_acquire);
+            T* item = r->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr;
+            return item;
+        }
+
+    private:
+        Ring* grow(Ring* old, int64_t t, int64_t b)
+        {
+            Ring* r = SkrNew<Ring>(old->capacity * 2);
+            for (int64_t i = t; i < b; ++i)
+                r->put(i, old->get(i));
+            // thieves may still read from the old ring, keep it until the deque dies
+            retired.add(old);
+            ring.store(r, std::memory_order_release);
+            return r;
+        }
+
+        alignas(64) std::atomic<int64_t> top = 0;
+        alignas(64) std::atomic<int64_t> bottom = 0;
+        std::atomic<Ring*> ring = nullptr;
+        skr::Vector<Ring*> retired;
+    };
+
+}
+}
@@ -75,6 +75,12 @@ void* current_fiber()
 {
     return details::get_scheduler()->current_fiber();
 }
+
+uint32_t worker_count()
+{
+    const auto count = details::get_scheduler()->options.ThreadPoolSize;
+    return count ? count : 1u;
+}
 #else
 void scheduler_t::initialize(const scheudler_config_t& config)
 {
@@ -8,6 +8,7 @@
 #include "SkrContainersDef/atomic_queue/atomic_queue.h"
 #include "SkrContainers/concurrent_queue.hpp"
 #include "SkrTask/co_task.hpp"
+#include "SkrTask/work_stealing_deque.hpp"
 
 #if defined(_WIN32)
 #include <intrin.h>
@@ -21,20 +22,6 @@ inline void nop() {
 #endif
 }
 
-// https://en.wikipedia.org/wiki/Xorshift
-class FastRnd {
-    public:
-    inline uint64_t operator()() {
-    x ^= x << 13;
-    x ^= x >> 7;
-    x ^= x << 17;
-    return x;
-    }
-
-    private:
-    uint64_t x = std::chrono::system_clock::now().time_since_epoch().count();
-};
-
 namespace skr
 {
 namespace task2
@@ -71,12 +58,14 @@ namespace task2
     {
         skr::stl_function<void()> func;
         std::coroutine_handle<skr_task_t::promise_type> coro;
+        task_priority_t priority = task_priority_t::normal;
 
         Task() {}
         Task(nullptr_t) {}
 
-        Task(skr::stl_function<void()>&& func)
+        Task(skr::stl_function<void()>&& func, task_priority_t priority = task_priority_t::normal)
             : func(std::move(func))
+            , priority(priority)
         {
         }
 
@@ -84,12 +73,14 @@ namespace task2
             : coro(std::move(coro))
         {
             SKR_ASSERT(!this->coro.done());
+            priority = this->coro.promise().priority;
             coro = nullptr;
         }
 
         Task(Task&& other)
             : func(std::move(other.func))
             , coro(std::move(other.coro))
+            , priority(other.priority)
         {
             SKR_ASSERT(func || !this->coro.done());
             other.coro = nullptr;
@@ -99,6 +90,7 @@ namespace task2
         {
             func = std::move(other.func);
             coro = std::move(other.coro);
+            priority = other.priority;
             SKR_ASSERT(func || !this->coro.done());
             other.coro = nullptr;
             return *this;
@@ -153,6 +145,8 @@ namespace task2
 #endif
     };
 
+    static constexpr uint32_t kLaneCount = (uint32_t)task_priority_t::count;
+
     void enqueue(Task&& task, int workerIdx);
     thread_local struct Worker* currentWorker = nullptr;
     struct Worker
@@ -209,28 +203,49 @@ namespace task2
             }
         }
 
-        int stealWork(int rand)
+        void buildStealOrder()
         {
-            Task stolen(nullptr);
-            auto numThreads = scheduler->config.numThreads;
-            if(numThreads > 1)
-            {
-                SkrZoneScopedN("Worker::StealWork");
-                // Try to steal from other workers
-                while(rand == id)
-                    rand = rnd() % numThreads;
-                auto& worker = *(Worker*)scheduler->workers[rand];
-                if(worker.steal(stolen))
+            scheduler->steal_order(id, victims);
+            // the main worker only runs tasks inside sync(), never wake it up to help
+            peers.clear();
+            for (auto idx : victims)
+            {
+                if (idx != 0 && scheduler->group_of(idx) == group)
+                    peers.add(idx);
+            }
+            if (peers.is_empty())
+            {
+                for (auto idx : victims)
                 {
-                    stolen();
-                    return rand;
+                    if (idx != 0)
+                        peers.add(idx);
                 }
-                else 
+            }
+        }
+
+        // higher lanes are searched on every victim before lower lanes, so a high priority task anywhere wins
+        // over background work next door
+        bool stealWork()
+        {
+            if (victims.is_empty())
+                return false;
+            SkrZoneScopedN("Worker::StealWork");
+            Task stolen(nullptr);
+            for (uint32_t lane = 0; lane < kLaneCount; ++lane)
+            {
+                for (auto idx : victims)
                 {
-                    return id;
+                    auto& victim = *(Worker*)scheduler->workers[idx];
+                    if (victim.work.num.load(std::memory_order_relaxed) == 0)
+                        continue;
+                    if (victim.steal(stolen, lane))
+                    {
+                        stolen();
+                        return true;
+                    }
                 }
             }
-            return id;
+            return false;
         }
 
         void spinForWork()
@@ -238,30 +253,31 @@ namespace task2
             SkrZoneScopedN("Worker::SpinForWork");
             constexpr auto duration = std::chrono::milliseconds(1);
             auto start = std::chrono::high_resolution_clock::now();
-            int lastStolen = id;
             while (std::chrono::high_resolution_clock::now() - start < duration) 
             {
                 if (work.num > 0) {
                     return;
                 }
-                if(lastStolen == id)
+                if (stealWork())
                 {
-                    //spin
-                    for (int i = 0; i < 256; i++)  // Empirically picked magic number!
-                    {
-                        // atomic_queue::spin_loop_pause();
-                        // clang-format off
-                        nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
-                        nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
-                        nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
-                        nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
-                        // clang-format on
-                        if (work.num > 0) {
-                            return;
-                        }
+                    // keep looking while there is something to steal
+                    start = std::chrono::high_resolution_clock::now();
+                    continue;
+                }
+                //spin
+                for (int i = 0; i < 256; i++)  // Empirically picked magic number!
+                {
+                    // atomic_queue::spin_loop_pause();
+                    // clang-format off
+                    nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
+                    nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
+                    nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
+                    nop(); nop(); nop(); nop(); nop(); nop(); nop(); nop();
+                    // clang-format on
+                    if (work.num > 0) {
+                        return;
                     }
                 }
-                lastStolen = stealWork(lastStolen);
                 std::this_thread::yield();
             }
         }
@@ -278,9 +294,12 @@ namespace task2
                 spinForWork();
                 skr_mutex_acquire(&work.mutex);
             }
-            work.wait([this]() {
-                return work.num > 0 || shutdown;
-            });
+            work.wait([this]() { return hasWork(); });
+        }
+
+        bool hasWork()
+        {
+            return work.num > 0 || shutdown || work.stealRequested.exchange(false, std::memory_order_relaxed);
         }
 
         void runUntilIdle() 
@@ -297,9 +316,8 @@ namespace task2
             }
             skr_mutex_release(&work.mutex);
             Task task(nullptr);
-            while(work.tasks.pop(task))
+            while(popLocal(task))
             {
-                work.num--;
                 task();
             }
             skr_mutex_acquire(&work.mutex);
@@ -310,9 +328,7 @@ namespace task2
             if (!isMainThread)
             {
                 //initial with wait to avoid spinning
-                work.wait([this]() {
-                    return work.num > 0 || shutdown;
-                });
+                work.wait([this]() { return hasWork(); });
             }
             while(!shutdown || work.num > 0)
             {
@@ -327,7 +343,7 @@ namespace task2
             {
                 work.num++;
                 auto notify = work.notifyAdded;
-                work.tasks.push(std::move(task));
+                work.queues[(uint32_t)task.priority].push(std::move(task));
                 if (notify)
                 {
                     skr_wake_condition_var(&work.added);
@@ -354,14 +370,72 @@ namespace task2
             }
         }
 
-        bool steal(Task& out) 
+        // tasks spawned by this worker, kept local and left for idle workers to steal
+        void push(Task&& task)
+        {
+            const auto lane = (uint32_t)task.priority;
+            work.num++;
+            work.deques[lane].push(SkrNew<Task>(std::move(task)));
+            requestThief();
+        }
+
+        // makes sure the work pushed to the deque gets picked up while this worker is busy
+        void requestThief()
+        {
+            auto i = --scheduler->nextSpinningWorkerIdx % scheduler->spinningWorkers.size();
+            if (scheduler->spinningWorkers[i].exchange(-1) >= 0)
+                return; // a spinning worker finds it by stealing
+            if (peers.is_empty())
+                return;
+            auto& peer = *(Worker*)scheduler->workers[peers[nextPeer++ % peers.size()]];
+            peer.wakeToSteal();
+        }
+
+        void wakeToSteal()
+        {
+            work.stealRequested.store(true, std::memory_order_relaxed);
+            if (work.notifyAdded)
+            {
+                skr_wake_condition_var(&work.added);
+            }
+        }
+
+        // highest lane first, the own deque before tasks queued by other threads
+        bool popLocal(Task& out)
         {
-            bool result = work.tasks.steal(out);
-            if (result) 
+            for (uint32_t lane = 0; lane < kLaneCount; ++lane)
             {
+                if (Task* task = work.deques[lane].pop())
+                {
+                    out = std::move(*task);
+                    SkrDelete(task);
+                    work.num--;
+                    return true;
+                }
+                if (work.queues[lane].pop(out))
+                {
+                    work.num--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool steal(Task& out, uint32_t lane) 
+        {
+            if (Task* task = work.deques[lane].steal())
+            {
+                out = std::move(*task);
+                SkrDelete(task);
                 work.num--;
+                return true;
             }
-            return result;
+            if (work.queues[lane].steal(out))
+            {
+                work.num--;
+                return true;
+            }
+            return false;
         }
 
         Worker()
@@ -377,7 +451,10 @@ namespace task2
         {
             std::atomic<uint64_t> num = 0;
             skr::stl_deque<Task> pinnedTask;
-            WorkQueue tasks;
+            // one per task_priority_t, the deque holds tasks pushed by the worker itself, the queue tasks from other threads
+            WorkStealingDeque<Task> deques[kLaneCount];
+            WorkQueue queues[kLaneCount];
+            std::atomic<bool> stealRequested = false;
             bool notifyAdded = true;
             SConditionVariable added;
             SMutex mutex;
@@ -409,7 +486,10 @@ namespace task2
         scheduler_t* scheduler = nullptr;
         bool shutdown = false;
         uint32_t id;
-        FastRnd rnd;
+        uint32_t group = 0;
+        skr::Vector<uint32_t> victims;
+        skr::Vector<uint32_t> peers;
+        uint32_t nextPeer = 0;
     };
     
 
@@ -419,6 +499,13 @@ namespace task2
         scheduler_t* scheduler = scheduler_t::instance();
         SKR_ASSERT(scheduler != nullptr);
         size_t workerCount = scheduler->config.numThreads;
+        // spawned by a worker: keep it in the worker's own deque where it is still hot in cache
+        auto current = currentWorker;
+        if(workerIdx < 0 && current != nullptr && current->scheduler == scheduler)
+        {
+            current->push(std::move(task));
+            return;
+        }
         while(true)
         {
             int idx = 0;
@@ -448,15 +535,16 @@ namespace task2
         }
     }
 
-    void scheduler_t::schedule(skr::stl_function<void ()>&& function)
+    void scheduler_t::schedule(skr::stl_function<void ()>&& function, task_priority_t priority)
     {
-        enqueue(Task(std::move(function)), -1);
+        enqueue(Task(std::move(function), priority), -1);
     }
 
-    void scheduler_t::schedule(skr_task_t&& task)
+    void scheduler_t::schedule(skr_task_t&& task, task_priority_t priority)
     {
         std::coroutine_handle<skr_task_t::promise_type> coroutine = task.coroutine;
         task.coroutine = nullptr;
+        coroutine.promise().priority = priority;
         enqueue(Task(std::move(coroutine)), -1);
     }
 
@@ -551,11 +639,10 @@ namespace task2
         SKR_ASSERT(worker == nullptr);
         worker = (Worker*)mainWorker;
         SMutexLock guard(worker->work.mutex);
-        int i = 0;
         while(!event.done())
         {
             skr_mutex_release(&worker->work.mutex);
-            i = worker->stealWork(i);
+            worker->stealWork();
             skr_mutex_acquire(&worker->work.mutex);
             worker->runUntilIdle();
         }
@@ -568,11 +655,10 @@ namespace task2
         SKR_ASSERT(worker == nullptr);
         worker = (Worker*)mainWorker;
         SMutexLock guard(worker->work.mutex);
-        int i = 0;
         while(!counter.done())
         {
             skr_mutex_release(&worker->work.mutex);
-            i = worker->stealWork(i);
+            worker->stealWork();
             skr_mutex_acquire(&worker->work.mutex);
             worker->runUntilIdle();
         }
@@ -648,23 +734,85 @@ namespace task2
         return false;
     }
 
+    uint32_t scheduler_t::group_of(uint32_t worker) const
+    {
+        return worker / config.workersPerGroup;
+    }
+
+    // victims own group first, then the nearest groups, neighbouring groups usually share a socket
+    // each list is rotated by the worker id so thieves of one group do not all hit the same victim first
+    void scheduler_t::steal_order(uint32_t worker, skr::Vector<uint32_t>& victims) const
+    {
+        const uint32_t numThreads = config.numThreads;
+        const uint32_t workersPerGroup = config.workersPerGroup;
+        const uint32_t group = group_of(worker);
+        auto addGroup = [&](uint32_t g) {
+            const uint32_t first = g * workersPerGroup;
+            const uint32_t count = std::min(workersPerGroup, numThreads - first);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const uint32_t idx = first + (worker + 1 + i) % count;
+                if (idx != worker)
+                    victims.add(idx);
+            }
+        };
+        victims.clear();
+        addGroup(group);
+        for (uint32_t distance = 1; distance < numGroups; ++distance)
+        {
+            if (group + distance < numGroups)
+                addGroup(group + distance);
+            if (group >= distance)
+                addGroup(group - distance);
+        }
+    }
+
+    // the whole group shares the cores of its cluster, wrapping around when there are more workers than cores
+    uint64_t scheduler_t::group_affinity_mask(uint32_t group, uint32_t core_count) const
+    {
+        uint64_t mask = 0;
+        for (uint32_t core = 0; core < config.workersPerGroup; ++core)
+            mask |= 1ull << ((group * config.workersPerGroup + core) % core_count);
+        return mask;
+    }
+
     void scheduler_t::initialize(const scheudler_config_t & cfg)
     {
         SkrZoneScopedN("Scheduler::Initialize");
         config = cfg;
+        const uint32_t numCores = skr_cpu_cores_count();
+        if(config.workersPerGroup == 0)
+        {
+            // SkrOS has no cache / numa topology query, assume 8 core clusters (CCX, socket slices) on big machines
+            config.workersPerGroup = config.numThreads <= 16 ? config.numThreads : 8;
+        }
+        config.workersPerGroup = std::max(config.workersPerGroup, 1u);
+        numGroups = (config.numThreads + config.workersPerGroup - 1) / config.workersPerGroup;
         for(size_t i = 0; i < spinningWorkers.size(); ++i)
             spinningWorkers[i] = -1;
         for(size_t i = 0; i < cfg.numThreads; ++i)
         {
             auto worker = SkrNew<Worker>();
             worker->id = (uint32_t)i;
+            worker->group = group_of((uint32_t)i);
             worker->scheduler = this;
             worker->isMainThread = i == 0;
             worker->shutdown = false;
             workers[i] = worker;
         }
         for(size_t i = 0; i < cfg.numThreads; ++i)
-            ((Worker*)workers[i])->start();
+            ((Worker*)workers[i])->buildStealOrder();
+        const bool pinGroups = config.setAffinity && numGroups > 1 && numCores > 0 && numCores <= 64;
+        for(size_t i = 0; i < cfg.numThreads; ++i)
+        {
+            auto worker = (Worker*)workers[i];
+            worker->start();
+            // the whole group shares the cores of its cluster, the os balances inside it
+            if(pinGroups && !worker->isMainThread)
+            {
+                skr_thread_set_affinity(worker->handle, group_affinity_mask(worker->group, numCores));
+            }
+        }
         mainWorker = (Worker*)workers[0];
         initialized = true;
     }
@@ -10,6 +10,8 @@ public static class SkrRT
             .Depend(Visibility.Public, "SkrTask")
             .Depend(Visibility.Public, "SkrGraphics")
             .IncludeDirs(Visibility.Public, "include")
+            .Require("LibDeflate", new PackageConfig { Version = new Version(1, 24, 0) })
+            .Depend(Visibility.Private, "LibDeflate@LibDeflate")
             .AddCppFiles("src/**/build.*.cpp")
             .AddCodegenScript("meta/ecs.ts")
             .AddNatvisFiles("dbg/*.natvis");
@@ -0,0 +1,113 @@
+#pragma once
+#include "SkrRT/ecs/world.hpp"
+#include "SkrBase/atomic/atomic_mutex.hpp"
+
+namespace skr::ecs
+{
+
+// Records structural changes from inside dispatched tasks and plays them back at a sync point.
+// Recording is thread safe, each worker thread writes into its own stripe. Playback sorts the
+// commands so that casts sharing (src group, dst group) and destroys sharing a chunk are applied
+// as contiguous chunk views.
+struct SKR_RUNTIME_API EntityCommandBuffer
+{
+public:
+    static constexpr uint32_t kStripeCount = 16;
+    static constexpr uint32_t kValueBlockSize = 64 * 1024;
+
+    EntityCommandBuffer(ECSWorld& World) SKR_NOEXCEPT;
+    ~EntityCommandBuffer() SKR_NOEXCEPT;
+    EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+    EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+    // the returned id is reserved immediately and can be used by later commands of any buffer
+    Entity create_entity(skr::span<const TypeIndex> Components);
+
+    template <class... Cs>
+    Entity create_entity()
+    {
+        const TypeIndex Components[] = { sugoi_id_of<Cs>::get()... };
+        return create_entity({ Components, sizeof...(Cs) });
+    }
+
+    void destroy_entity(Entity ToDestroy);
+    void add_component(Entity Target, TypeIndex Component);
+    void remove_component(Entity Target, TypeIndex Component);
+
+    template <class C>
+    void add_component(Entity Target)
+    {
+        add_component(Target, sugoi_id_of<C>::get());
+    }
+
+    template <class C>
+    void remove_component(Entity Target)
+    {
+        remove_component(Target, sugoi_id_of<C>::get());
+    }
+
+    // the component must exist on the entity after structural changes are applied
+    template <class C>
+    void set_component(Entity Target, C&& Value)
+    {
+        using Type = std::remove_cv_t<std::remove_reference_t<C>>;
+        static_assert(sugoi_array_count<Type> == 0, "array components can not be set by command buffer");
+        auto Apply = +[](void* Dst, void* Src) {
+            *(Type*)Dst = std::move(*(Type*)Src);
+        };
+        auto Destroy = +[](void* Src) {
+            ((Type*)Src)->~Type();
+        };
+        void* Data = _record_set(Target, sugoi_id_of<Type>::get(), sizeof(Type), alignof(Type), Apply, Destroy);
+        new (Data) Type(std::forward<C>(Value));
+    }
+
+    // must not overlap with recording
+    void playback() SKR_NOEXCEPT;
+    void reset() SKR_NOEXCEPT;
+    bool empty() const SKR_NOEXCEPT;
+
+protected:
+    using ApplyFn = void (*)(void* Dst, void* Src);
+    using DestroyFn = void (*)(void* Src);
+    void* _record_set(Entity Target, TypeIndex Component, uint32_t Size, uint32_t Align, ApplyFn Apply, DestroyFn Destroy);
+
+    struct CreateCommand {
+        sugoi_entity_t entity;
+        uint32_t type_offset;
+        uint32_t type_count;
+    };
+    struct AlterCommand {
+        sugoi_entity_t entity;
+        TypeIndex type;
+        bool add;
+    };
+    struct SetCommand {
+        sugoi_entity_t entity;
+        TypeIndex type;
+        void* data;
+        ApplyFn apply;
+        DestroyFn destroy;
+    };
+    struct alignas(64) Stripe {
+        skr::shared_atomic_mutex mtx;
+        skr::Vector<CreateCommand> creates;
+        skr::Vector<TypeIndex> create_types;
+        skr::Vector<sugoi_entity_t> destroys;
+        skr::Vector<AlterCommand> alters;
+        skr::Vector<SetCommand> sets;
+        skr::Vector<uint8_t*> blocks;
+        uint32_t block_used = kValueBlockSize;
+    };
+    Stripe& _local_stripe();
+
+    void _playback_creates();
+    void _playback_alters(skr::span<const sugoi_entity_t> Destroyed);
+    void _playback_sets(skr::span<const sugoi_entity_t> Destroyed);
+    void _playback_destroys(skr::Vector<sugoi_entity_t>& Destroyed);
+
+    ECSWorld& World;
+    Stripe stripes[kStripeCount];
+};
+
+} // namespace skr::ecs
\ No newline at end of file
@@ -13,6 +13,7 @@ namespace skr::ecs
 struct Task;
 struct TaskSignature;
 struct StaticDependencyAnalyzer;
+struct TaskGraphRecorder;
 
 enum class EDependencySyncMode
 {
@@ -84,6 +85,8 @@ struct ComponentAccess
 struct TaskOptions
 {
     skr::InlineVector<skr::task::weak_event_t, 4> on_finishes;
+    // work outside the ecs scheduler the task runs after, every work unit depends on these counters
+    skr::InlineVector<skr::task::weak_counter_t, 4> dependencies;
     bool no_parallelization = false;
 };
 
@@ -101,6 +104,8 @@ public:
     const sugoi_query_t* query = nullptr;
     uint32_t thread_affinity = ~0;
     bool self_confict = false;
+    // with changed filter: shrink chunk views to rows written since last run
+    bool clip_dirty_rows = false;
     skr::Optional<TaskOptions> opts;
 
 protected:
@@ -119,11 +124,18 @@ protected:
     skr::task::event_t _finish;
 
     std::atomic_uint32_t _exec_counter = 0;
+
+    friend struct TaskGraphRecorder;
+    // position in the frame, tasks are numbered from 0 after every TaskScheduler::sync_all()
+    uint32_t _dispatch_index = 0;
 };
 
 struct SKR_RUNTIME_API StaticDependencyAnalyzer
 {
-    void process(skr::RC<TaskSignature> task);
+    // all_dependencies: also receives the dependencies on tasks that have already finished
+    void process(skr::RC<TaskSignature> task, StackVector<TaskDependency>* all_dependencies = nullptr);
+    // only records the accesses of a task whose dependencies are known, so later tasks can depend on it
+    void track(skr::RC<TaskSignature> task);
 
     struct AccessInfo
     {
@@ -135,7 +147,68 @@ struct SKR_RUNTIME_API StaticDependencyAnalyzer
 
 struct SKR_RUNTIME_API WorkUnitGenerator
 {
-    void process(skr::RC<TaskSignature> task);
+    // groups_ready: the work groups and their dependencies are replayed already, only chunks are collected
+    void process(skr::RC<TaskSignature> task, bool groups_ready = false);
+};
+
+// Records the task graph of a frame and replays it for the next frames while the same tasks are dispatched in
+// the same order: static dependencies are not analyzed again, and while the storage has the same groups, query
+// tasks reuse their groups and per group dependencies. Chunks of each group are still partitioned every frame,
+// so entities added to or removed from existing groups need no new recording.
+struct SKR_RUNTIME_API TaskGraphRecorder
+{
+    struct Stats
+    {
+        uint64_t replayed_tasks = 0;
+        uint64_t replayed_groups = 0;
+        uint64_t recorded_tasks = 0;
+    };
+    struct RecordedDependency
+    {
+        uint32_t task; // dispatch index
+        EDependencySyncMode mode;
+    };
+    struct RecordedGroup
+    {
+        sugoi_group_t* group;
+        skr::Vector<RecordedDependency> dependencies;
+    };
+    struct RecordedTask
+    {
+        uint64_t key = 0;
+        // words hashed into the key, a hit compares them in full
+        skr::Vector<uint64_t> key_words;
+        bool self_confict = false;
+        skr::Vector<RecordedDependency> dependencies;
+        // query tasks only
+        bool has_groups = false;
+        sugoi_timestamp_t groups_timestamp = 0;
+        skr::Vector<RecordedGroup> groups;
+    };
+
+    // accesses, query filters and options of the task, everything its dependencies and groups are derived from
+    static uint64_t KeyOf(const TaskSignature& task, skr::Vector<uint64_t>& words);
+
+    // the recording at the dispatch index of the task if it is the same task, otherwise nullptr
+    RecordedTask* find(const TaskSignature& task);
+    void replay_dependencies(const RecordedTask& recorded, TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched);
+    // fills the work groups without their units, false if the groups of the storage changed since recording
+    bool replay_groups(const RecordedTask& recorded, TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched);
+
+    // all_dependencies as returned by StaticDependencyAnalyzer, recordings after the task are dropped
+    RecordedTask& record(const TaskSignature& task, skr::span<const TaskDependency> all_dependencies);
+    // groups after WorkUnitGenerator processed the task
+    void record_groups(RecordedTask& recorded, const TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched);
+
+    void clear();
+    const Stats& get_stats() const { return stats; }
+
+    bool enabled = false;
+
+private:
+    skr::Vector<RecordedTask> tasks;
+    skr::Vector<uint64_t> scratch_words;
+    Stats stats;
 };
 
 struct SKR_RUNTIME_API TaskScheduler : protected AsyncService
@@ -150,6 +223,11 @@ public:
     void sync_all();
     void stop_and_exit();
 
+    // replays the task graph recorded by the last frames while the same tasks are dispatched, see TaskGraphRecorder
+    // only switch it between sync_all() and the next dispatch
+    void set_task_graph_replay(bool enable);
+    const TaskGraphRecorder::Stats& get_task_graph_replay_stats() const { return _recorder.get_stats(); }
+
     TaskScheduler(const ServiceThreadDesc& desc, skr::task::scheduler_t& scheduler) SKR_NOEXCEPT;
     ~TaskScheduler();
 
@@ -172,6 +250,9 @@ protected:
 
     StaticDependencyAnalyzer _analyzer;
     WorkUnitGenerator _generator;
+    TaskGraphRecorder _recorder;
+    // dispatched tasks whose accesses the analyzer knows, replayed tasks are tracked lazily
+    uint32_t _analyzed_tasks = 0;
     skr::task::scheduler_t& _scheduler;
 };
 
@@ -88,6 +88,30 @@ public:
         return *this;
     }
 
+    // only visit chunks whose component is written since last run of the query
+    inline AccessBuilder& changed(TypeIndex type)
+    {
+        _add_has_filter(type, false);
+        _access(type, false, EAccessMode::Seq, kInvalidFieldPtr);
+        if (!changes.contains(type))
+            changes.add(type);
+        return *this;
+    }
+
+    template <class... Cs>
+    AccessBuilder& changed()
+    {
+        (changed(sugoi_id_of<Cs>::get()), ...);
+        return *this;
+    }
+
+    // with changed filter: only visit rows written since last run of the query
+    inline AccessBuilder& clip_to_dirty_rows()
+    {
+        clip_dirty_rows = true;
+        return *this;
+    }
+
     template <class T, class C>
     AccessBuilder& read(ComponentView<C> T::* Member)
     {
@@ -173,6 +197,7 @@ protected:
 
     skr::Vector<TypeIndex> all;
     skr::Vector<TypeIndex> nones;
+    skr::Vector<TypeIndex> changes;
 };
 
 struct TaskContext
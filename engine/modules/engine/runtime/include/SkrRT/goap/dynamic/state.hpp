@@ -70,6 +70,23 @@ struct DynamicWorldState {
         return true;
     }
 
+    // exact compare, operator== only checks the variables existing in other
+    bool identical_to(const DynamicWorldState& other) const SKR_NOEXCEPT
+    {
+        return variables_.size() == other.variables_.size() && *this == other;
+    }
+
+    // consistent with identical_to(), order independent since map order depends on insertion history
+    skr_hash get_hash() const SKR_NOEXCEPT
+    {
+        skr_hash hash = 0;
+        for (const auto& [k, v] : variables_)
+        {
+            hash += skr::hash_combine(skr::Hash<Identifier>{}(k), skr::Hash<ValueStoreType>{}(v));
+        }
+        return hash;
+    }
+
     void dump(const char8_t* what, int level = SKR_LOG_LEVEL_INFO) const
     {
         SKR_LOG_FMT_WITH_LEVEL(level, u8"{} DynamicWorldState: {}", what, name_);
@@ -1,6 +1,9 @@
 #pragma once
 #include "SkrContainers/vector.hpp"
-#include "SkrContainers/stl_vector.hpp"
+#include "SkrContainers/hashmap.hpp"
+#include "SkrContainers/span.hpp"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrProfile/profile.h"
 #include "SkrRT/goap/dynamic/state.hpp"
 #include "SkrRT/goap/action.hpp"
 
@@ -20,69 +23,161 @@ struct Planner {
     template <> struct PlanTypeSelector<false> { using Type = skr::Vector<ActionType>; };
     template <bool WithState> using PlanType = typename PlanTypeSelector<WithState>::Type;
 
+    struct BatchRequest {
+        const StateType*               start   = nullptr;
+        const StateType*               goal    = nullptr;
+        const skr::Vector<ActionType>* actions = nullptr;
+    };
+
+    Planner() = default;
+    Planner(const Planner&) = delete;
+    Planner& operator=(const Planner&) = delete;
+    ~Planner()
+    {
+        for (auto worker : batch_workers_)
+            SkrDelete(worker);
+    }
+
     template <bool WithState = false>
     SKR_NOINLINE PlanType<WithState> plan(const StateType& start, const StateType& goal, const skr::Vector<ActionType>& actions) SKR_NOEXCEPT;
 
+    // plans every request on the task scheduler, out_plans[i] receives the plan of requests[i]
+    // each task plans requests_per_task requests with its own worker planner, workers are kept for the next call
+    template <bool WithState = false>
+    void plan_batch(skr::span<const BatchRequest> requests, skr::span<PlanType<WithState>> out_plans, uint32_t requests_per_task = 8) SKR_NOEXCEPT;
+
     // void dumpOpenList() const SKR_NOEXCEPT;
     // void dumpCloseList() const SKR_NOEXCEPT;
 
 protected:
+    static constexpr uint32_t kInvalidNode = UINT32_MAX;
+
     struct Node {
         StateType         ws_;
-        NodeId            id_        = 0;
-        NodeId            parent_id_ = 0;
+        skr_hash          hash_      = 0;
+        uint32_t          parent_    = kInvalidNode;
+        uint32_t          next_      = kInvalidNode; // next node with the same state hash
+        uint32_t          heap_pos_  = kInvalidNode; // position in open_, kInvalidNode once closed
         CostType          g_         = 0;       // The A* cost from 'start' to 'here'
         CostType          h_         = 0;       // The estimated remaining cost to 'goal' form 'here'
         const ActionType* action_    = nullptr; // The action that got us here (for replay purposes)
 
-        Node() { id_ = ++Global::last_id_; }
-        Node(const StateType state, CostType g, CostType h, NodeId parent_id, const ActionType* action)
+        Node(const StateType& state, skr_hash hash, CostType g, CostType h, uint32_t parent, const ActionType* action)
             : ws_(state)
-            , parent_id_(parent_id)
+            , hash_(hash)
+            , parent_(parent)
             , g_(g)
             , h_(h)
             , action_(action)
         {
-            id_ = ++Global::last_id_;
         }
 
         // F -- which is simply G+H -- is autocalculated
         auto f() const { return g_ + h_; }
-
-        bool operator<(const Node& rhs) const { return f() < rhs.f(); }
+        bool closed() const { return heap_pos_ == kInvalidNode; }
     };
-    skr::stl_vector<Node> open_;
-    skr::stl_vector<Node> closed_;
+    // node arena, cleared but not shrunk between plans
+    skr::Vector<Node> nodes_;
+    // binary min heap of node indices ordered by F
+    skr::Vector<uint32_t> open_;
+    // state hash -> first node with that hash, chained through Node::next_
+    skr::FlatHashMap<skr_hash, uint32_t> lookup_;
+    skr::Vector<Planner*> batch_workers_;
 
     CostType heuristic(const StateType& now, const StateType& goal) const SKR_NOEXCEPT
     {
         return now.distance_to(goal);
     }
 
-    void addToOpenList(Node&& node)
+    bool heapLess(uint32_t a, uint32_t b) const SKR_NOEXCEPT
+    {
+        const auto& na = nodes_[a];
+        const auto& nb = nodes_[b];
+        // prefer nodes closer to the goal when F ties
+        return na.f() < nb.f() || (na.f() == nb.f() && na.h_ < nb.h_);
+    }
+
+    void heapPlace(uint32_t pos, uint32_t node) SKR_NOEXCEPT
     {
-        // insert maintaining sort order
-        auto it = std::lower_bound(begin(open_), end(open_), node);
-        open_.emplace(it, std::move(node));
+        open_[pos]              = node;
+        nodes_[node].heap_pos_ = pos;
     }
 
-    Node& popAndClose()
+    void siftUp(uint32_t pos) SKR_NOEXCEPT
     {
-        SKR_ASSERT(!open_.empty());
-        closed_.emplace_back(std::move(open_.front()));
-        open_.erase(open_.begin());
-        return closed_.back();
+        const uint32_t node = open_[pos];
+        while (pos > 0)
+        {
+            const uint32_t parent = (pos - 1) / 2;
+            if (!heapLess(node, open_[parent]))
+                break;
+            heapPlace(pos, open_[parent]);
+            pos = parent;
+        }
+        heapPlace(pos, node);
     }
 
-    bool memberOfClosed(const StateType& ws) const SKR_NOEXCEPT
+    void siftDown(uint32_t pos) SKR_NOEXCEPT
     {
-        auto&& found = std::find_if(begin(closed_), end(closed_), [&](const Node& n) { return n.ws_ == ws; });
-        return found != end(closed_);
+        const uint32_t count = (uint32_t)open_.size();
+        const uint32_t node  = open_[pos];
+        while (true)
+        {
+            uint32_t child = pos * 2 + 1;
+            if (child >= count)
+                break;
+            if (child + 1 < count && heapLess(open_[child + 1], open_[child]))
+                child += 1;
+            if (!heapLess(open_[child], node))
+                break;
+            heapPlace(pos, open_[child]);
+            pos = child;
+        }
+        heapPlace(pos, node);
     }
 
-    auto memberOfOpen(const StateType& ws) SKR_NOEXCEPT
+    uint32_t addToOpenList(const StateType& ws, skr_hash hash, CostType g, CostType h, uint32_t parent, const ActionType* action)
     {
-        return std::find_if(begin(open_), end(open_), [&](const Node& n) { return n.ws_ == ws; });
+        const auto index = (uint32_t)nodes_.size();
+        nodes_.add(Node(ws, hash, g, h, parent, action));
+
+        auto [head, inserted] = lookup_.try_emplace(hash, index);
+        if (!inserted)
+        {
+            nodes_[index].next_ = head->second;
+            head->second        = index;
+        }
+
+        open_.add(index);
+        siftUp((uint32_t)open_.size() - 1);
+        return index;
+    }
+
+    uint32_t popAndClose() SKR_NOEXCEPT
+    {
+        SKR_ASSERT(!open_.is_empty());
+        const uint32_t top  = open_[0];
+        const uint32_t last = open_.pop_back_get();
+        if (!open_.is_empty())
+        {
+            open_[0] = last;
+            siftDown(0);
+        }
+        nodes_[top].heap_pos_ = kInvalidNode;
+        return top;
+    }
+
+    uint32_t findNode(const StateType& ws, skr_hash hash) const SKR_NOEXCEPT
+    {
+        auto found = lookup_.find(hash);
+        if (found == lookup_.end())
+            return kInvalidNode;
+        for (uint32_t i = found->second; i != kInvalidNode; i = nodes_[i].next_)
+        {
+            if (nodes_[i].ws_.identical_to(ws))
+                return i;
+        }
+        return kInvalidNode;
     }
 };
 
@@ -95,75 +190,55 @@ SKR_NOINLINE auto Planner<StateType, ActionType>::plan(const StateType& start, c
     if (start.meets_goal(goal))
         return RetType();
 
-    // Feasible we'd re-use a planner, so clear out the prior results
+    // Feasible we'd re-use a planner, so clear out the prior results (the storage is kept)
+    nodes_.clear();
     open_.clear();
-    closed_.clear();
+    lookup_.clear();
 
-    Node starting_node(start, 0, heuristic(start, goal), 0, nullptr);
+    addToOpenList(start, start.get_hash(), 0, heuristic(start, goal), kInvalidNode, nullptr);
 
-    open_.emplace_back(std::move(starting_node));
-
-    while (open_.size() > 0)
+    while (!open_.is_empty())
     {
-        // Look for Node with the lowest-F-score on the open list. Switch it to closed,
-        // and hang onto it -- this is our latest node.
-        Node& current(popAndClose());
+        // Take the node with the lowest-F-score from the open list and close it
+        // nodes_ may grow below, so keep the index instead of a reference
+        const uint32_t current = popAndClose();
         // Is our current state the goal state? If so, we've found a path, yay.
-        if (current.ws_.meets_goal(goal))
+        if (nodes_[current].ws_.meets_goal(goal))
         {
             auto the_plan = RetType();
-            do
+            for (uint32_t i = current; nodes_[i].action_ != nullptr; i = nodes_[i].parent_)
             {
                 if constexpr (WithState)
-                    the_plan.emplace(*current.action_, current.ws_);
+                    the_plan.emplace(*nodes_[i].action_, nodes_[i].ws_);
                 else
-                    the_plan.emplace(*current.action_);
-                
-                auto itr = std::find_if(begin(open_), end(open_), [&](const Node& n) { return n.id_ == current.parent_id_; });
-                if (itr == end(open_))
-                {
-                    itr = std::find_if(begin(closed_), end(closed_), [&](const Node& n) { return n.id_ == current.parent_id_; });
-                }
-                current = *itr;
-            } while (current.parent_id_ != 0);
+                    the_plan.emplace(*nodes_[i].action_);
+            }
             return the_plan;
         }
 
         // Check each node REACHABLE from current -- in other words, where can we go from here?
         for (const auto& potential_action : actions)
         {
-            if (potential_action.operable_on(current.ws_))
+            if (potential_action.operable_on(nodes_[current].ws_))
             {
-                StateType outcome = potential_action.act_on(current.ws_);
-
-                // Skip if already closed
-                if (memberOfClosed(outcome))
-                    continue;
-
-                // Look for a Node with this WorldState on the open list.
-                auto p_outcome_node = memberOfOpen(outcome);
-                if (p_outcome_node == end(open_))
-                { // not a member of open list
-                    // Make a new node, with current as its parent, recording G & H
-                    Node found(outcome, current.g_ + potential_action.cost(), heuristic(outcome, goal), current.id_, &potential_action);
-                    // Add it to the open list (maintaining sort-order therein)
-                    addToOpenList(std::move(found));
+                StateType  outcome = potential_action.act_on(nodes_[current].ws_);
+                const auto hash    = outcome.get_hash();
+                const auto g       = nodes_[current].g_ + potential_action.cost();
+
+                const auto found = findNode(outcome, hash);
+                if (found == kInvalidNode)
+                {
+                    // not visited yet, make a new node with current as its parent, recording G & H
+                    addToOpenList(outcome, hash, g, heuristic(outcome, goal), current, &potential_action);
                 }
-                else
-                { // already a member of the open list
-                    // check if the current G is better than the recorded G
-                    if (current.g_ + potential_action.cost() < p_outcome_node->g_)
-                    {
-                        // std::cout << "My path to " << p_outcome_node->ws_ << " using " << potential_action.name() << " (combined cost " << current.g_ + potential_action.cost() << ") is better than existing (cost " <<  p_outcome_node->g_ << "\n";
-                        p_outcome_node->parent_id_ = current.id_;                          // make current its parent
-                        p_outcome_node->g_         = current.g_ + potential_action.cost(); // recalc G & H
-                        p_outcome_node->h_         = heuristic(outcome, goal);
-                        p_outcome_node->action_    = &potential_action;
-
-                        // resort open list to account for the new F
-                        // sorting likely invalidates the p_outcome_node iterator, but we don't need it anymore
-                        std::sort(begin(open_), end(open_));
-                    }
+                else if (!nodes_[found].closed() && g < nodes_[found].g_)
+                {
+                    // already on the open list and the current path is better, H doesn't change with the path
+                    auto& node   = nodes_[found];
+                    node.parent_ = current;
+                    node.g_      = g;
+                    node.action_ = &potential_action;
+                    siftUp(node.heap_pos_);
                 }
             }
         }
@@ -174,4 +249,29 @@ SKR_NOINLINE auto Planner<StateType, ActionType>::plan(const StateType& start, c
     return RetType();
 }
 
+template <concepts::WorldState StateType, typename ActionType>
+    requires(std::is_base_of_v<Action<StateType>, ActionType> || std::is_same_v<ActionType, Action<StateType>>)
+template <bool WithState>
+void Planner<StateType, ActionType>::plan_batch(skr::span<const BatchRequest> requests, skr::span<PlanType<WithState>> out_plans, uint32_t requests_per_task) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("GoapPlanBatch");
+    SKR_ASSERT(out_plans.size() >= requests.size());
+    const uint32_t count = (uint32_t)requests.size();
+    const uint32_t batch = std::max(requests_per_task, 1u);
+    const uint32_t tasks = (count + batch - 1) / batch;
+    while (batch_workers_.size() < tasks)
+        batch_workers_.add(SkrNew<Planner>());
+
+    skr::parallel_for(0u, count, batch, [this, batch, requests, out_plans](uint32_t begin, uint32_t end) {
+        SkrZoneScopedN("GoapPlanTask");
+        auto worker = batch_workers_[begin / batch];
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const auto& request = requests[i];
+            SKR_ASSERT(request.start && request.goal && request.actions);
+            out_plans[i] = worker->template plan<WithState>(*request.start, *request.goal, *request.actions);
+        }
+    });
+}
+
 } // namespace skr::goap
\ No newline at end of file
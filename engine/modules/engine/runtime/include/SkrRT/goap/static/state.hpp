@@ -104,6 +104,31 @@ struct StaticWorldState : public StaticWorldStateProxy<T> {
         return !fail;
     }
 
+    // exact compare, operator== only checks the atoms existing in other
+    bool identical_to(const StaticWorldState& other) const SKR_NOEXCEPT
+    {
+        bool same = true;
+        other.foreachAtomMemory([&](const auto i, const auto& atom) {
+            const auto& mine = getAtom(static_cast<uint32_t>(i));
+            if (mine.exist != atom.exist || (atom.exist && Compare<decltype(atom.value)>::NotEqual(atom.value, mine.value)))
+                same = false;
+            return same;
+        });
+        return same;
+    }
+
+    // consistent with identical_to()
+    skr_hash get_hash() const SKR_NOEXCEPT
+    {
+        skr_hash hash = 0;
+        foreachAtomMemory([&](const auto i, const auto& atom) {
+            if (atom.exist)
+                hash = skr::hash_combine(hash, skr::Hash<uint64_t>{}(static_cast<uint64_t>(i) << 32 | atom.value));
+            return true;
+        });
+        return hash;
+    }
+
     void dump(const char8_t* what, int level = SKR_LOG_LEVEL_INFO) const
     {
         SKR_LOG_FMT_WITH_LEVEL(level, u8"{} StaticWorldState: {}", what, Literal.view());
@@ -4,6 +4,7 @@
 #ifdef __cplusplus
     #include "SkrCore/memory/rc.hpp"
     #include "SkrContainers/span.hpp"
+    #include "SkrContainers/vector.hpp"
 #endif
 
 #define SKR_IO_SERVICE_MAX_TASK_COUNT 32
@@ -41,18 +42,31 @@ typedef enum ESkrIOFinishPoint
     SKR_IO_FINISH_POINT_MAX_ENUM = UINT32_MAX
 } ESkrIOFinishPoint;
 
+// why a request ended as cancelled without being asked to
+typedef enum ESkrIOError
+{
+    SKR_IO_ERROR_NONE,
+    SKR_IO_ERROR_INVALID_REQUEST, // rejected while resolving, e.g. a destination too small or a malformed chunked container
+    SKR_IO_ERROR_DECOMPRESS_FAILED,
+    SKR_IO_ERROR_MAX_ENUM = UINT32_MAX
+} ESkrIOError;
+
 typedef skr_guid_t skr_io_decompress_method_t;
 typedef skr_guid_t skr_io_request_resolve_pass_t;
 
 typedef struct skr_io_future_t {
     SAtomicU32 status         SKR_IF_CPP(= 0);
     SAtomicU32 request_cancel SKR_IF_CPP(= 0);
+    SAtomicU32 error          SKR_IF_CPP(= 0);
 #ifdef __cplusplus
     SKR_RUNTIME_API bool        is_ready() const SKR_NOEXCEPT;
     SKR_RUNTIME_API bool        is_enqueued() const SKR_NOEXCEPT;
     SKR_RUNTIME_API bool        is_cancelled() const SKR_NOEXCEPT;
     SKR_RUNTIME_API bool        is_loading() const SKR_NOEXCEPT;
+    // failed requests end as cancelled with an error other than SKR_IO_ERROR_NONE
+    SKR_RUNTIME_API bool        is_failed() const SKR_NOEXCEPT;
     SKR_RUNTIME_API ESkrIOStage get_status() const SKR_NOEXCEPT;
+    SKR_RUNTIME_API ESkrIOError get_error() const SKR_NOEXCEPT;
 #endif
 } skr_io_future_t;
 
@@ -68,6 +82,36 @@ typedef struct skr_io_compressed_block_t {
     skr_io_decompress_method_t decompress_method;
 } skr_io_compressed_block_t;
 
+// decode src into exactly dst_size bytes of dst, must be thread safe
+typedef bool (*skr_io_decompress_fn_t)(void* usrdata, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size);
+// returns written bytes, 0 if dst_capacity is not enough
+typedef uint64_t (*skr_io_compress_fn_t)(void* usrdata, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_capacity);
+typedef uint64_t (*skr_io_compress_bound_fn_t)(void* usrdata, uint64_t src_size);
+
+typedef struct skr_io_decompress_method_desc_t {
+    skr_io_decompress_fn_t decompress         SKR_IF_CPP(= nullptr);
+    // optional, only needed by tools writing compressed files
+    skr_io_compress_fn_t compress             SKR_IF_CPP(= nullptr);
+    skr_io_compress_bound_fn_t compress_bound SKR_IF_CPP(= nullptr);
+    void* usrdata                             SKR_IF_CPP(= nullptr);
+} skr_io_decompress_method_desc_t;
+
+// chunked container layout:
+//   skr_io_chunked_header_t
+//   uint32_t compressed_sizes[chunk_count], SKR_IO_CHUNK_STORED_BIT marks a chunk stored uncompressed
+//   chunk data, in chunk order
+// every chunk but the last one decodes to chunk_size bytes, so chunks are decoded in parallel.
+// a compressed block with compressed_size == 0 refers to a chunked container starting at its offset.
+#define SKR_IO_CHUNKED_MAGIC 0x5A43534Bu // "SKCZ"
+#define SKR_IO_CHUNK_STORED_BIT 0x80000000u
+typedef struct skr_io_chunked_header_t {
+    uint32_t magic;
+    uint32_t chunk_count;
+    uint64_t chunk_size;
+    uint64_t uncompressed_size;
+    skr_io_decompress_method_t method;
+} skr_io_chunked_header_t;
+
 typedef void (*skr_io_callback_t)(skr_io_future_t* future, skr_io_request_t* request, void* data);
 
 #ifdef __cplusplus
@@ -77,6 +121,18 @@ namespace skr
 namespace io
 {
 
+// built-in methods, lz4 block format and raw deflate
+SKR_RUNTIME_API extern const skr_io_decompress_method_t kDecompressMethodStore;
+SKR_RUNTIME_API extern const skr_io_decompress_method_t kDecompressMethodLZ4;
+SKR_RUNTIME_API extern const skr_io_decompress_method_t kDecompressMethodDeflate;
+
+// methods are global, register them before any request using them is submitted
+SKR_RUNTIME_API void register_decompress_method(const skr_io_decompress_method_t& method, const skr_io_decompress_method_desc_t& desc) SKR_NOEXCEPT;
+SKR_RUNTIME_API void unregister_decompress_method(const skr_io_decompress_method_t& method) SKR_NOEXCEPT;
+SKR_RUNTIME_API bool decompress(const skr_io_decompress_method_t& method, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size) SKR_NOEXCEPT;
+// write src as a chunked container, chunks that do not shrink are stored
+SKR_RUNTIME_API bool compress_chunked(const skr_io_decompress_method_t& method, const uint8_t* src, uint64_t size, uint64_t chunk_size, skr::Vector<uint8_t>& out) SKR_NOEXCEPT;
+
 using IOBlock           = skr_io_block_t;
 using IOCompressedBlock = skr_io_compressed_block_t;
 using IOFuture          = skr_io_future_t;
@@ -122,7 +178,10 @@ struct SKR_RUNTIME_API IIOBatch : public skr::IRCAble {
 using IOBatchId = RC<IIOBatch>;
 
 struct SKR_RUNTIME_API IIORequestResolver : public skr::IRCAble {
+    // called by the chain around the requests of each batch
+    virtual void begin_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
     virtual void resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT;
+    virtual void end_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
 
     virtual ~IIORequestResolver() SKR_NOEXCEPT;
 };
@@ -11,6 +11,7 @@ typedef struct skr_ram_io_service_desc_t {
     skr_job_queue_id callback_job_queue SKR_IF_CPP(= nullptr);
     bool awake_at_request               SKR_IF_CPP(= true);
     bool use_dstorage                   SKR_IF_CPP(= true);
+    bool use_io_uring                   SKR_IF_CPP(= true); // linux only, falls back to vfs reads if unavailable
 } skr_ram_io_service_desc_t;
 
 namespace skr
@@ -47,8 +48,9 @@ struct SKR_RUNTIME_API IBlocksRAMRequest : public IIORequest {
 #pragma endregion
 
 #pragma region CompressedBlocksComponent
+    // blocks are decoded in order into the destination buffer, add_compressed_block({}) reads a whole chunked container
     virtual skr::span<skr_io_compressed_block_t> get_compressed_blocks() SKR_NOEXCEPT = 0;
-    virtual void add_compressed_block(const skr_io_block_t& block) SKR_NOEXCEPT = 0;
+    virtual void add_compressed_block(const skr_io_compressed_block_t& block) SKR_NOEXCEPT = 0;
     virtual void reset_compressed_blocks() SKR_NOEXCEPT = 0;
 #pragma endregion
 };
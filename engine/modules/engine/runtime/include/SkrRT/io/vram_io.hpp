@@ -70,7 +70,7 @@ struct SKR_RUNTIME_API IBlocksVRAMRequest : public IVRAMIORequest
 
 #pragma region CompressedBlocksComponent
     virtual skr::span<skr_io_compressed_block_t> get_compressed_blocks() SKR_NOEXCEPT = 0;
-    virtual void add_compressed_block(const skr_io_block_t& block) SKR_NOEXCEPT = 0;
+    virtual void add_compressed_block(const skr_io_compressed_block_t& block) SKR_NOEXCEPT = 0;
     virtual void reset_compressed_blocks() SKR_NOEXCEPT = 0;
 #pragma endregion
 
@@ -0,0 +1,103 @@
+#pragma once
+#include "SkrRT/resource/resource_system.h"
+#include "SkrRT/resource/resource_header.hpp"
+#include "SkrContainersDef/string.hpp"
+#include "SkrContainersDef/span.hpp"
+
+struct skr_vfs_t;
+
+// resource pack: one file holding the cooked data of many resources. the table of contents
+// (header, buckets, entries, dependencies) is a flat pod image at the beginning of the file, so
+// it can be read with a single read or mapped as is. data blobs follow the table of contents.
+//
+// entries are bucketed by the top bits of a guid hash and sorted by guid within a bucket,
+// a lookup scans only [buckets[b], buckets[b + 1])
+#define SKR_RESOURCE_PACK_MAGIC 0x4B505253u // 'SRPK'
+#define SKR_RESOURCE_PACK_VERSION 1u
+#define SKR_RESOURCE_PACK_DATA_ALIGNMENT 64u
+
+typedef struct SResourcePackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t bucket_bits;
+    uint32_t dependency_count;
+    uint32_t reserved;
+    uint64_t toc_size;
+} SResourcePackHeader;
+
+typedef struct SResourcePackEntry {
+    skr_guid_t guid;
+    skr_guid_t type;
+    uint32_t version;
+    uint32_t dependency_offset;
+    uint32_t dependency_count;
+    uint32_t reserved;
+    uint64_t data_offset;
+    uint64_t data_size;
+} SResourcePackEntry;
+static_assert(sizeof(SResourcePackHeader) == 32);
+static_assert(sizeof(SResourcePackEntry) == 64);
+
+namespace skr
+{
+// stable across platforms and builds, pack files store its bucketing
+SKR_RUNTIME_API uint64_t ResourcePackHash(const skr_guid_t& guid);
+
+// collects cooked resources and writes them into a pack
+struct SKR_RUNTIME_API ResourcePackBuilder
+{
+    void Add(const SResourceHeader& header, skr::span<const uint8_t> data);
+    // adds a resource cooked as <guid>.rh + <guid>.bin, the data is copied when the pack is written
+    bool AddLooseResource(skr_vfs_t* vfs, skr_guid_t guid);
+    bool Write(skr_vfs_t* vfs, const char8_t* path) const;
+
+private:
+    struct Item {
+        skr_guid_t guid;
+        skr_guid_t type;
+        uint32_t version;
+        skr::Vector<skr_guid_t> dependencies;
+        skr::Vector<uint8_t> data;
+        skr_vfs_t* source_vfs = nullptr;
+        skr::String source_path;
+        uint64_t data_size = 0;
+    };
+    skr::Vector<Item> items;
+};
+
+// answers header and dependency queries from the tables of contents of mounted packs without
+// opening files, data is read from the pack with the ram io service.
+// mounting must not overlap with resource requests
+struct SKR_RUNTIME_API PackResourceRegistry : ResourceRegistry
+{
+    // resources missing from every pack are forwarded to fallback (e.g. a LocalResourceRegistry)
+    PackResourceRegistry(skr_vfs_t* vfs, ResourceRegistry* fallback = nullptr);
+    virtual ~PackResourceRegistry();
+
+    // packs mounted later shadow resources of earlier ones
+    bool Mount(const char8_t* path);
+    void UnmountAll();
+
+    bool FindHeader(skr_guid_t guid, SResourceHeader& header) const;
+    bool RequestResourceFile(ResourceRequest* request) override;
+    void CancelRequestFile(ResourceRequest* requst) override;
+
+    skr_vfs_t* vfs;
+    ResourceRegistry* fallback;
+
+protected:
+    struct Pack {
+        skr::String path;
+        uint8_t* toc = nullptr;
+        const SResourcePackHeader* header = nullptr;
+        const uint32_t* buckets = nullptr;
+        const SResourcePackEntry* entries = nullptr;
+        const skr_guid_t* dependencies = nullptr;
+    };
+    const SResourcePackEntry* Find(const skr_guid_t& guid, const Pack** pack) const;
+    void FillHeader(const Pack& pack, const SResourcePackEntry& entry, SResourceHeader& header) const;
+
+    skr::Vector<Pack> packs;
+};
+} // namespace skr
@@ -1,5 +1,6 @@
 #pragma once
 #include "SkrCore/platform/vfs.h"
+#include "SkrCore/async/async_service.h"
 #include "SkrRT/resource/resource_handle.h"
 #include "SkrRT/resource/resource_header.hpp"
 
@@ -82,7 +83,10 @@ public:
     virtual bool RequestResourceFile(ResourceRequest* request) = 0;
     virtual void CancelRequestFile(ResourceRequest* requst) = 0;
 
-    void FillRequest(ResourceRequest* request, SResourceHeader header, skr_vfs_t* vfs, const char8_t* uri);
+    static constexpr uint64_t kReadToEnd = UINT64_MAX;
+    // offset & size select the data range inside uri (e.g. a resource pack), kReadToEnd reads to the end
+    // of the file, size 0 is an empty resource and issues no io
+    void FillRequest(ResourceRequest* request, SResourceHeader header, skr_vfs_t* vfs, const char8_t* uri, uint64_t offset = 0, uint64_t size = kReadToEnd);
 };
 
 struct SKR_RUNTIME_API ResourceSystem
@@ -99,6 +103,9 @@ public:
     virtual void Quit() = 0;
 
     virtual void LoadResource(SResourceHandle& handle, bool requireInstalled, uint64_t requester, ESkrRequesterType) = 0;
+    // loads a set of roots (e.g. a level) as one batch, the io of the whole dependency graph is issued
+    // within one update at the given priority, deepest dependencies first
+    virtual void LoadResources(skr::span<SResourceHandle> handles, bool requireInstalled, uint64_t requester, ESkrRequesterType, SkrAsyncServicePriority priority = SKR_ASYNC_SERVICE_PRIORITY_NORMAL) = 0;
     virtual void UnloadResource(SResourceHandle& handle) = 0;
     virtual void FlushResource(SResourceHandle& handle) = 0;
     virtual ESkrLoadingStatus GetResourceStatus(const skr_guid_t& handle) = 0;
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include "SkrBase/atomic/atomic_mutex.hpp"
 #include "SkrRT/sugoi/sugoi_types.h" // IWYU pragma: keep
 #include "SkrRT/sugoi/archetype.hpp" // IWYU pragma: keep
@@ -29,6 +30,23 @@ private:
 static_assert(sizeof(slice_data_t) == sizeof(uint64_t), 
     "Per slice data is 8 bytes, which is the same size as a single 64-bit integer"
 );
+
+// rows written at slice_data_t::timestamp, [start, end)
+// prev is the timestamp of the last write before this range was opened,
+// so readers whose last run is older than prev can not trust the range
+// jobs on different views of one chunk mark concurrently: the range is packed into one word and
+// widened with cas, the first writer of a new timestamp opens it while holding opening
+struct slice_dirty_t
+{
+    static constexpr uint64_t pack(EIndex start, EIndex end) { return uint64_t(start) | (uint64_t(end) << 32); }
+    static constexpr EIndex start_of(uint64_t range) { return EIndex(range); }
+    static constexpr EIndex end_of(uint64_t range) { return EIndex(range >> 32); }
+
+    std::atomic<uint64_t> range = 0;
+    std::atomic<sugoi_timestamp_t> version = 0;
+    std::atomic<bool> opening = false;
+    sugoi_timestamp_t prev = 0;
+};
 }
 
 struct sugoi_chunk_t {
@@ -52,6 +70,9 @@ struct sugoi_chunk_t {
     RSlice s_lock(const sugoi_type_index_t& type, const sugoi_chunk_view_t& view) const;
     void x_unlock(const sugoi_type_index_t& type, const sugoi_chunk_view_t& view);
     void s_unlock(const sugoi_type_index_t& type, const sugoi_chunk_view_t& view) const;
+    // exclusively lock every slice without waiting, fails if any slice is held by a task
+    bool try_x_lock_all();
+    void x_unlock_all();
 
     SUGOI_FORCEINLINE EIndex get_capacity()
     {
@@ -88,6 +109,71 @@ struct sugoi_chunk_t {
         return set_timestamp_at(idx, ts);
     }
 
+    SUGOI_FORCEINLINE void mark_dirty_at(uint32_t at, EIndex start, EIndex count, sugoi_timestamp_t ts)
+    {
+        using dirty_t = sugoi::slice_dirty_t;
+        auto& data = getSliceData()[at];
+        auto& dirty = getSliceDirty()[at];
+        const auto added = dirty_t::pack(start, start + count);
+        while (dirty.version.load(std::memory_order_acquire) != ts)
+        {
+            if (dirty.opening.exchange(true, std::memory_order_acquire))
+                continue; // another job is opening the range, it only takes a few stores
+            const bool first = dirty.version.load(std::memory_order_relaxed) != ts;
+            if (first)
+            {
+                dirty.prev = data.timestamp;
+                dirty.range.store(added, std::memory_order_relaxed);
+                data.timestamp = ts;
+                dirty.version.store(ts, std::memory_order_release);
+            }
+            dirty.opening.store(false, std::memory_order_release);
+            if (first)
+                return;
+        }
+        auto range = dirty.range.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto merged = (dirty_t::start_of(range) == dirty_t::end_of(range)) ?
+                added :
+                dirty_t::pack(std::min(dirty_t::start_of(range), start), std::max(dirty_t::end_of(range), start + count));
+            if (merged == range || dirty.range.compare_exchange_weak(range, merged, std::memory_order_relaxed))
+                break;
+        }
+    }
+
+    SUGOI_FORCEINLINE void mark_dirty(EIndex start, EIndex count, sugoi_timestamp_t ts)
+    {
+        for (uint32_t i = 0; i < structure->type.length; ++i)
+            mark_dirty_at(i, start, count, ts);
+    }
+
+    SUGOI_FORCEINLINE bool changed_since_at(uint32_t at, sugoi_timestamp_t since) const
+    {
+        return (int32_t)(get_timestamp_at(at) - since) > 0;
+    }
+
+    // returns false if the slice is not written after since
+    // otherwise [start, end) covers every row written after since (may be the whole chunk)
+    SUGOI_FORCEINLINE bool get_dirty_range_at(uint32_t at, sugoi_timestamp_t since, EIndex& start, EIndex& end) const
+    {
+        if (!changed_since_at(at, since))
+            return false;
+        const auto& dirty = getSliceDirty()[at];
+        const auto range = dirty.range.load(std::memory_order_relaxed);
+        if ((int32_t)(dirty.prev - since) > 0 || sugoi::slice_dirty_t::start_of(range) == sugoi::slice_dirty_t::end_of(range))
+        {
+            start = 0;
+            end = count;
+        }
+        else
+        {
+            start = sugoi::slice_dirty_t::start_of(range);
+            end = std::min(sugoi::slice_dirty_t::end_of(range), count);
+        }
+        return true;
+    }
+
     SUGOI_FORCEINLINE RWSlice get_unsafe(const sugoi_type_index_t& type, const sugoi_chunk_view_t& view)
     {
         EIndex offset = 0;
@@ -126,6 +212,16 @@ private:
         return (sugoi::slice_data_t*)(data() + structure->sliceDataOffsets[pt]);
     }
 
+    SUGOI_FORCEINLINE sugoi::slice_dirty_t const* getSliceDirty() const noexcept
+    {
+        return (sugoi::slice_dirty_t const*)(getSliceData() + structure->type.length);
+    }
+
+    SUGOI_FORCEINLINE sugoi::slice_dirty_t* getSliceDirty() noexcept
+    {
+        return (sugoi::slice_dirty_t*)(getSliceData() + structure->type.length);
+    }
+
     SUGOI_FORCEINLINE sugoi::slice_lock_t& getSliceLock(const sugoi_type_index_t& type) const noexcept
     {
         const auto id = structure->index(type);
@@ -1,4 +1,6 @@
 #pragma once
+#include <atomic>
+#include "SkrBase/atomic/atomic_mutex.hpp"
 #include "SkrContainersDef/vector.hpp"
 #include "SkrContainersDef/span.hpp"
 #include "SkrContainersDef/optional.hpp"
@@ -7,7 +9,19 @@
 namespace sugoi
 {
 struct SKR_RUNTIME_API EntityRegistry {
-    EntityRegistry() = default;
+    // entries are stored in fixed size pages which are never moved or freed while in use,
+    // so try_get_entry stays valid while other threads allocate new ids
+    static constexpr EIndex kEntryPageShift = 12;
+    static constexpr EIndex kEntryPageSize = 1u << kEntryPageShift;
+    static constexpr EIndex kEntryPageMask = kEntryPageSize - 1;
+    static constexpr EIndex kMaxEntryPages = (SUGOI_ENTITY_ID_MASK + 1u) >> kEntryPageShift;
+    // free ids released by *_concurrent are cached per thread stripe and exchanged with
+    // the shared free list in batches
+    static constexpr uint32_t kFreeCacheCount = 16;
+    static constexpr EIndex kFreeCacheBatch = 256;
+
+    EntityRegistry();
+    ~EntityRegistry();
     EntityRegistry(const EntityRegistry& rhs);
     EntityRegistry& operator=(const EntityRegistry& rhs);
 
@@ -27,6 +41,13 @@ struct SKR_RUNTIME_API EntityRegistry {
     void move_entities(const sugoi_chunk_view_t& view, const sugoi_chunk_t* src, EIndex srcIndex);
     void move_entities(const sugoi_chunk_view_t& view, EIndex srcIndex);
 
+    // thread safe against each other and against try_get_entry, must not overlap with the
+    // other (exclusive) mutations above
+    void new_entities_concurrent(sugoi_entity_t* dst, EIndex count);
+    void free_entities_concurrent(const sugoi_entity_t* src, EIndex count);
+    // move ids cached by free_entities_concurrent back to the shared free list, exclusive
+    void flush_free_caches();
+
     void serialize(SBinaryWriter* s);
     void deserialize(SBinaryReader* s);
 
@@ -36,13 +57,26 @@ struct SKR_RUNTIME_API EntityRegistry {
         uint32_t version : 8;
     };
 
+    SKR_FORCEINLINE EIndex size() const
+    {
+        return entryCount.load(std::memory_order_acquire);
+    }
+
+    // f(skr::span<const Entry> page, EIndex firstId) is called for each page in id order,
+    // pages new_entities_concurrent has not published yet only hold unused ids and are skipped
     template<typename F>
     void visit_entries(const F& f) const
     {
-        skr::span<const Entry> entries_view = entries;
-        f(entries_view);
+        const EIndex count = size();
+        for (EIndex first = 0; first < count; first += kEntryPageSize)
+        {
+            const Entry* page = pages[first >> kEntryPageShift].load(std::memory_order_acquire);
+            if (page == nullptr)
+                continue;
+            f(skr::span<const Entry>(page, std::min(kEntryPageSize, count - first)), first);
+        }
     }
-    
+
     template<typename F>
     void visit_free_entries(const F& f) const
     {
@@ -53,29 +87,40 @@ struct SKR_RUNTIME_API EntityRegistry {
     SKR_FORCEINLINE skr::Optional<Entry> try_get_entry(sugoi_entity_t e) const
     {
         const auto id = e_id(e);
-        if (id < entries.size()) [[likely]]
-            return entries[id];
+        if (id < size()) [[likely]]
+        {
+            // the id may be handed out before its page is published
+            if (const Entry* page = pages[id >> kEntryPageShift].load(std::memory_order_acquire))
+                return page[id & kEntryPageMask];
+        }
         return {};
     }
 
 private:
     friend struct ::sugoi_storage_t;
-    skr::Vector<Entry> entries;
+    SKR_FORCEINLINE Entry& at(EIndex id)
+    {
+        return pages[id >> kEntryPageShift].load(std::memory_order_relaxed)[id & kEntryPageMask];
+    }
+    SKR_FORCEINLINE const Entry& at(EIndex id) const
+    {
+        return pages[id >> kEntryPageShift].load(std::memory_order_relaxed)[id & kEntryPageMask];
+    }
+    void ensure_pages(EIndex size);
+    void release_pages(EIndex firstPage);
+
+    struct alignas(64) FreeCache {
+        skr::shared_atomic_mutex mtx;
+        skr::Vector<EIndex> ids;
+    };
+    FreeCache& local_free_cache();
+
+    std::atomic<Entry*> pages[kMaxEntryPages] = {};
+    std::atomic<EIndex> entryCount = 0;
     skr::Vector<EIndex> freeEntries;
+    skr::shared_atomic_mutex freeMtx;
+    FreeCache freeCaches[kFreeCacheCount];
     EIndex externalReserved = 0;
 };
 
-inline EntityRegistry::EntityRegistry(const EntityRegistry& rhs)
-    : entries(rhs.entries), freeEntries(rhs.freeEntries)
-{
-
-}
-
-inline EntityRegistry& EntityRegistry::operator=(const EntityRegistry& rhs)
-{
-    entries = rhs.entries;
-    freeEntries = rhs.freeEntries;
-    return *this;
-}
-
 } // namespace sugoi
\ No newline at end of file
@@ -110,6 +110,8 @@ struct SKR_RUNTIME_API sugoi_storage_t {
     void serialize_view(sugoi_group_t* group, sugoi_chunk_view_t& v, SBinaryWriter* s, SBinaryReader* ds, bool withEntities = true);
     void serialize(SBinaryWriter* s);
     void deserialize(SBinaryReader* s);
+    void serialize_image(SBinaryWriter* s);
+    bool deserialize_image(const void* data, size_t size);
 
     void merge(sugoi_storage_t& src);
     sugoi_storage_t* clone();
@@ -117,6 +119,8 @@ struct SKR_RUNTIME_API sugoi_storage_t {
     void validate_meta();
     void validate(sugoi_entity_set_t& meta);
     void defragment();
+    EIndex defragment_incremental(const sugoi_defragment_budget_t& budget);
+    void get_occupancy(sugoi_occupancy_callback_t callback, void* u);
     void pack_entities();
     void redirect(sugoi_entity_t* ents, sugoi_entity_t* newEnts, EIndex n);
 
@@ -125,6 +129,12 @@ struct SKR_RUNTIME_API sugoi_storage_t {
     // getters
     EIndex count(bool includeDisabled, bool includeDead);
     sugoi_timestamp_t timestamp() const;
+    sugoi_timestamp_t advance_timestamp();
+    sugoi_timestamp_t groups_timestamp() const;
+    // ecs tasks queued or running on this storage, counted by skr::ecs::TaskScheduler
+    void begin_task();
+    void end_task();
+    uint32_t running_tasks() const;
     sugoi::EntityRegistry& getEntityRegistry();
     void buildQueryOverloads();
 
@@ -149,7 +159,7 @@ private:
     void buildQueryCache(sugoi_query_t* query);
     void updateQueryCache(sugoi_group_t* group, bool isAdd);
 
-    void structuralChange(sugoi_group_t* group, sugoi_chunk_t* chunk);
+    void structuralChange(const sugoi_chunk_view_t& view);
     void freeView(const sugoi_chunk_view_t& view);
     void castImpl(const sugoi_chunk_view_t& view, sugoi_group_t* group, sugoi_cast_callback_t callback, void* u);
 };
\ No newline at end of file
@@ -196,6 +196,28 @@ typedef struct sugoi_meta_filter_t
     uint64_t timestamp;
 } sugoi_meta_filter_t;
 
+/**
+ * @brief limits the work done by one sugoiS_defragment_incremental call
+ * zero means unlimited
+ */
+typedef struct sugoi_defragment_budget_t
+{
+    EIndex max_rows;
+    uint32_t max_microseconds;
+    // groups whose entity count / chunk capacity is not below this are left alone, zero means every group
+    float occupancy_threshold;
+} sugoi_defragment_budget_t;
+
+// fill state of one group, reported by sugoiS_get_occupancy
+typedef struct sugoi_group_occupancy_t
+{
+    sugoi_group_t* group;
+    sugoi_entity_type_t type;
+    EIndex entity_count;
+    EIndex capacity;
+    uint32_t chunk_count;
+} sugoi_group_occupancy_t;
+
 // header data of a array component
 typedef struct sugoi_array_comp_t sugoi_array_comp_t;
 
@@ -233,6 +255,7 @@ typedef void (*sugoi_cast_callback_t)(void* u, sugoi_chunk_view_t* new_view, sug
 typedef void (*sugoi_type_callback_t)(void* u, sugoi_type_index_t t);
 typedef void (*sugoi_destroy_callback_t)(void* u, sugoi_chunk_view_t* view, sugoi_view_callback_t callback, void* u2);
 typedef bool (*sugoi_custom_filter_callback_t)(void* u, sugoi_chunk_view_t* view);
+typedef void (*sugoi_occupancy_callback_t)(void* u, const sugoi_group_occupancy_t* occupancy);
 
 /**
  * @brief calculate buffer component size
@@ -478,6 +501,27 @@ SKR_RUNTIME_API void sugoiS_all(sugoi_storage_t* storage, bool includeDisabled,
  * @return EIndex
  */
 SKR_RUNTIME_API EIndex sugoiS_count(sugoi_storage_t* storage, bool includeDisabled, bool includeDead);
+/**
+ * @brief get current timestamp of storage, component writes are stamped with it
+ *
+ * @param storage
+ * @return sugoi_timestamp_t
+ */
+SKR_RUNTIME_API sugoi_timestamp_t sugoiS_get_timestamp(sugoi_storage_t* storage);
+/**
+ * @brief advance timestamp of storage, writes after this call are newer than the returned timestamp
+ *
+ * @param storage
+ * @return timestamp before advance
+ */
+SKR_RUNTIME_API sugoi_timestamp_t sugoiS_advance_timestamp(sugoi_storage_t* storage);
+/**
+ * @brief get version of the group set of storage, changes whenever a group is created or destroyed
+ *
+ * @param storage
+ * @return sugoi_timestamp_t
+ */
+SKR_RUNTIME_API sugoi_timestamp_t sugoiS_get_groups_timestamp(sugoi_storage_t* storage);
 /**
  * @brief get all groups matching given filter
  *
@@ -522,6 +566,25 @@ SKR_RUNTIME_API void sugoiS_serialize(sugoi_storage_t* storage, SBinaryWriter* v
  * @see sugoi_serializer_v
  */
 SKR_RUNTIME_API void sugoiS_deserialize(sugoi_storage_t* storage, SBinaryReader* v);
+/**
+ * @brief serialize the storage as chunk images
+ * every chunk is written as a page aligned raw image plus a relocation blob for array components,
+ * groups with custom serialized components fall back to the stream format inside the image
+ * @param storage
+ * @param v serializer callback
+ * @see sugoiS_deserialize_image
+ */
+SKR_RUNTIME_API void sugoiS_serialize_image(sugoi_storage_t* storage, SBinaryWriter* v);
+/**
+ * @brief deserialize the storage from chunk images
+ * the image is read in place (e.g. from a memory mapped file) and copied into chunks without per entity work,
+ * the image must be produced by the same build since chunk layout is not portable
+ * @param storage empty storage
+ * @param data image data, page aligned data gives aligned chunk copies
+ * @param size image size
+ * @return 0 if the image is invalid
+ */
+SKR_RUNTIME_API int sugoiS_deserialize_image(sugoi_storage_t* storage, const void* data, size_t size);
 /**
  * @brief test if given entity exist in storage
  * entity can be invalid(id not exist) or be dead(version mismatch)
@@ -578,6 +641,25 @@ SKR_RUNTIME_API void sugoiS_validate_meta(sugoi_storage_t* storage);
  * @param storage
  */
 SKR_RUNTIME_API void sugoiS_defragement(sugoi_storage_t* storage);
+/**
+ * @brief move entities from sparse chunks into denser chunks of the same group, within a budget
+ * groups are compacted in parallel, least occupied first. call it repeatedly (e.g. once per frame) to converge.
+ * must be called at a sync point: skr::ecs::TaskScheduler tasks do not lock slices, so no task may be queued or running
+ * on the storage (call TaskScheduler::sync_all() first), otherwise nothing is moved and an error is reported.
+ * chunks with a locked slice (e.g. components being copied into them) are skipped.
+ * @param storage
+ * @param budget null means unlimited
+ * @return count of moved entities
+ */
+SKR_RUNTIME_API EIndex sugoiS_defragment_incremental(sugoi_storage_t* storage, const sugoi_defragment_budget_t* budget);
+/**
+ * @brief report fill state of every group
+ *
+ * @param storage
+ * @param callback
+ * @param u
+ */
+SKR_RUNTIME_API void sugoiS_get_occupancy(sugoi_storage_t* storage, sugoi_occupancy_callback_t callback, void* u);
 /**
  * @brief pack entity id
  * when we destroy an entity, we don't "delete" it's id, we just left a hole awaiting reuse.
@@ -647,6 +729,14 @@ SKR_RUNTIME_API void sugoiQ_get(sugoi_query_t* query, sugoi_filter_t* filter, su
  * @param meta pass nullptr to clear meta
  */
 SKR_RUNTIME_API void sugoiQ_set_meta(sugoi_query_t* query, const sugoi_meta_filter_t* meta);
+/**
+ * @brief set timestamp used by changed filter, chunks whose changed components are not written after it are skipped
+ *
+ * @param query
+ * @param timestamp
+ */
+SKR_RUNTIME_API void sugoiQ_set_timestamp(sugoi_query_t* query, sugoi_timestamp_t timestamp);
+SKR_RUNTIME_API sugoi_timestamp_t sugoiQ_get_timestamp(const sugoi_query_t* query);
 /**
  * @brief set custom filter callback for a query
  * note: query does not own userdata
@@ -820,6 +910,17 @@ SKR_RUNTIME_API sugoi_storage_t* sugoiC_get_storage(const sugoi_chunk_t* chunk);
  * @param chunk
  */
 SKR_RUNTIME_API uint32_t sugoiC_get_count(const sugoi_chunk_t* chunk);
+/**
+ * @brief get rows of a component written after a timestamp
+ *
+ * @param chunk
+ * @param type
+ * @param since
+ * @param start first dirty row, may be null
+ * @param count dirty row count, may be null
+ * @return if the component is written after since, [start, start + count) covers every written row
+ */
+SKR_RUNTIME_API int sugoiC_get_dirty_range(const sugoi_chunk_t* chunk, sugoi_type_index_t type, sugoi_timestamp_t since, EIndex* start, EIndex* count);
 /**
  * @brief lock xlock component in chunk
  *
@@ -1,3 +1,4 @@
 #include "./world.cpp"
 #include "./scheduler.cpp"
-#include "./stack_allocator.cpp"
\ No newline at end of file
+#include "./stack_allocator.cpp"
+#include "./command_buffer.cpp"
@@ -0,0 +1,342 @@
+#include "SkrRT/ecs/command_buffer.hpp"
+#include "SkrOS/thread.h"
+
+namespace skr::ecs
+{
+static constexpr uint32_t kCommandValueAlign = 64;
+
+EntityCommandBuffer::EntityCommandBuffer(ECSWorld& World) SKR_NOEXCEPT
+    : World(World)
+{
+}
+
+EntityCommandBuffer::~EntityCommandBuffer() SKR_NOEXCEPT
+{
+    reset();
+}
+
+EntityCommandBuffer::Stripe& EntityCommandBuffer::_local_stripe()
+{
+    const auto tid = (uint64_t)skr_current_thread_id();
+    return stripes[(tid ^ (tid >> 7)) % kStripeCount];
+}
+
+Entity EntityCommandBuffer::create_entity(skr::span<const TypeIndex> Components)
+{
+    sugoi_entity_t Reserved;
+    World.get_storage()->getEntityRegistry().new_entities_concurrent(&Reserved, 1);
+
+    auto& Stripe = _local_stripe();
+    Stripe.mtx.lock();
+    SKR_DEFER({ Stripe.mtx.unlock(); });
+    CreateCommand& Cmd = Stripe.creates.add_default().ref();
+    Cmd.entity = Reserved;
+    Cmd.type_offset = (uint32_t)Stripe.create_types.size();
+    Cmd.type_count = (uint32_t)Components.size();
+    Stripe.create_types.append(Components.data(), Components.size());
+    // sugoi types are sorted sets
+    std::sort(Stripe.create_types.begin() + Cmd.type_offset, Stripe.create_types.end());
+    return Entity(Reserved);
+}
+
+void EntityCommandBuffer::destroy_entity(Entity ToDestroy)
+{
+    auto& Stripe = _local_stripe();
+    Stripe.mtx.lock();
+    Stripe.destroys.add((sugoi_entity_t)ToDestroy);
+    Stripe.mtx.unlock();
+}
+
+void EntityCommandBuffer::add_component(Entity Target, TypeIndex Component)
+{
+    auto& Stripe = _local_stripe();
+    Stripe.mtx.lock();
+    Stripe.alters.add({ (sugoi_entity_t)Target, Component, true });
+    Stripe.mtx.unlock();
+}
+
+void EntityCommandBuffer::remove_component(Entity Target, TypeIndex Component)
+{
+    auto& Stripe = _local_stripe();
+    Stripe.mtx.lock();
+    Stripe.alters.add({ (sugoi_entity_t)Target, Component, false });
+    Stripe.mtx.unlock();
+}
+
+void* EntityCommandBuffer::_record_set(Entity Target, TypeIndex Component, uint32_t Size, uint32_t Align, ApplyFn Apply, DestroyFn Destroy)
+{
+    SKR_ASSERT(Align <= kCommandValueAlign);
+    auto& Stripe = _local_stripe();
+    Stripe.mtx.lock();
+    SKR_DEFER({ Stripe.mtx.unlock(); });
+
+    void* Data = nullptr;
+    if (Size > kValueBlockSize)
+    {
+        // dedicated block, the current one stays open for small values
+        auto Block = (uint8_t*)sakura_malloc_aligned(Size, kCommandValueAlign);
+        if (Stripe.blocks.is_empty())
+            Stripe.blocks.add(Block);
+        else
+            Stripe.blocks.add_at(Stripe.blocks.size() - 1, Block);
+        Data = Block;
+    }
+    else
+    {
+        uint32_t Offset = (Stripe.block_used + Align - 1) & ~(Align - 1);
+        if (Stripe.blocks.is_empty() || Offset + Size > kValueBlockSize)
+        {
+            Stripe.blocks.add((uint8_t*)sakura_malloc_aligned(kValueBlockSize, kCommandValueAlign));
+            Offset = 0;
+        }
+        Data = Stripe.blocks.at_last() + Offset;
+        Stripe.block_used = Offset + Size;
+    }
+    Stripe.sets.add({ (sugoi_entity_t)Target, Component, Data, Apply, Destroy });
+    return Data;
+}
+
+bool EntityCommandBuffer::empty() const SKR_NOEXCEPT
+{
+    for (const auto& Stripe : stripes)
+    {
+        if (!Stripe.creates.is_empty() || !Stripe.destroys.is_empty() || !Stripe.alters.is_empty() || !Stripe.sets.is_empty())
+            return false;
+    }
+    return true;
+}
+
+void EntityCommandBuffer::reset() SKR_NOEXCEPT
+{
+    auto& Registry = World.get_storage()->getEntityRegistry();
+    for (auto& Stripe : stripes)
+    {
+        // ids reserved by commands which are never played back
+        for (const auto& Cmd : Stripe.creates)
+            Registry.free_entities_concurrent(&Cmd.entity, 1);
+        for (auto& Cmd : Stripe.sets)
+            Cmd.destroy(Cmd.data);
+        for (auto Block : Stripe.blocks)
+            sakura_free_aligned(Block, kCommandValueAlign);
+        Stripe.creates.clear();
+        Stripe.create_types.clear();
+        Stripe.destroys.clear();
+        Stripe.alters.clear();
+        Stripe.sets.clear();
+        Stripe.blocks.clear();
+        Stripe.block_used = kValueBlockSize;
+    }
+}
+
+void EntityCommandBuffer::playback() SKR_NOEXCEPT
+{
+    SkrZoneScopedN("EntityCommandBuffer::playback");
+
+    skr::Vector<sugoi_entity_t> Destroyed;
+    for (auto& Stripe : stripes)
+        Destroyed.append(Stripe.destroys);
+    Destroyed.sort();
+    Destroyed.remove_all_if([&, Last = sugoi::kEntityNull](sugoi_entity_t E) mutable {
+        const bool Dup = (E == Last);
+        Last = E;
+        return Dup;
+    });
+
+    _playback_creates();
+    _playback_alters(Destroyed);
+    _playback_sets(Destroyed);
+    _playback_destroys(Destroyed);
+
+    for (auto& Stripe : stripes)
+    {
+        Stripe.creates.clear();
+        Stripe.create_types.clear();
+    }
+    reset();
+}
+
+void EntityCommandBuffer::_playback_creates()
+{
+    SkrZoneScopedN("EntityCommandBuffer::creates");
+
+    struct Creation {
+        sugoi_entity_t entity;
+        skr::span<const TypeIndex> types;
+    };
+    skr::Vector<Creation> Creations;
+    for (auto& Stripe : stripes)
+    {
+        for (const auto& Cmd : Stripe.creates)
+            Creations.add({ Cmd.entity, { Stripe.create_types.data() + Cmd.type_offset, Cmd.type_count } });
+    }
+    if (Creations.is_empty())
+        return;
+    auto SameType = [](const Creation& A, const Creation& B) {
+        return std::equal(A.types.begin(), A.types.end(), B.types.begin(), B.types.end());
+    };
+    Creations.sort([](const Creation& A, const Creation& B) {
+        return std::lexicographical_compare(A.types.begin(), A.types.end(), B.types.begin(), B.types.end());
+    });
+
+    // one reserved allocation per archetype, rows are filled contiguously
+    auto Storage = World.get_storage();
+    skr::Vector<sugoi_entity_t> Entities;
+    for (uint64_t Begin = 0; Begin < Creations.size();)
+    {
+        uint64_t End = Begin + 1;
+        while (End < Creations.size() && SameType(Creations[Begin], Creations[End]))
+            ++End;
+        Entities.clear();
+        for (uint64_t i = Begin; i < End; ++i)
+            Entities.add(Creations[i].entity);
+        sugoi_entity_type_t EntityType = {};
+        EntityType.type = { Creations[Begin].types.data(), (SIndex)Creations[Begin].types.size() };
+        Storage->allocate_reserved(Storage->get_group(EntityType), Entities.data(), (EIndex)Entities.size(), nullptr, nullptr);
+        Begin = End;
+    }
+}
+
+void EntityCommandBuffer::_playback_alters(skr::span<const sugoi_entity_t> Destroyed)
+{
+    SkrZoneScopedN("EntityCommandBuffer::alters");
+
+    skr::Vector<AlterCommand> Alters;
+    for (auto& Stripe : stripes)
+        Alters.append(Stripe.alters);
+    if (Alters.is_empty())
+        return;
+    // stable: commands on the same entity keep their recording order inside a stripe
+    std::stable_sort(Alters.begin(), Alters.end(), [](const AlterCommand& A, const AlterCommand& B) {
+        return A.entity < B.entity;
+    });
+
+    struct CastTarget {
+        sugoi_entity_t entity;
+        sugoi_chunk_t* chunk;
+        EIndex index;
+        sugoi_group_t* src;
+        sugoi_group_t* dst;
+    };
+    skr::Vector<CastTarget> Targets;
+    skr::Vector<TypeIndex> Added, Removed;
+    skr::Vector<TypeIndex> LastAdded, LastRemoved;
+    sugoi_group_t* LastSrc = nullptr;
+    sugoi_group_t* LastDst = nullptr;
+    auto Storage = World.get_storage();
+    for (uint64_t Begin = 0; Begin < Alters.size();)
+    {
+        const auto E = Alters[Begin].entity;
+        uint64_t End = Begin + 1;
+        while (End < Alters.size() && Alters[End].entity == E)
+            ++End;
+        SKR_DEFER({ Begin = End; });
+        if (std::binary_search(Destroyed.begin(), Destroyed.end(), E) || !Storage->alive(E))
+            continue;
+
+        // fold the commands into a single delta, later commands win
+        Added.clear();
+        Removed.clear();
+        for (uint64_t i = Begin; i < End; ++i)
+        {
+            const auto& Cmd = Alters[i];
+            auto& To = Cmd.add ? Added : Removed;
+            auto& From = Cmd.add ? Removed : Added;
+            From.remove(Cmd.type);
+            if (!To.contains(Cmd.type))
+                To.add(Cmd.type);
+        }
+        Added.sort();
+        Removed.sort();
+
+        const auto View = Storage->entity_view(E);
+        auto Src = View.chunk->group;
+        if (Src != LastSrc || Added != LastAdded || Removed != LastRemoved)
+        {
+            sugoi_delta_type_t Delta = {};
+            Delta.added.type = { Added.data(), (SIndex)Added.size() };
+            Delta.removed.type = { Removed.data(), (SIndex)Removed.size() };
+            LastSrc = Src;
+            LastDst = Storage->cast(Src, Delta);
+            LastAdded = Added;
+            LastRemoved = Removed;
+        }
+        if (LastDst != Src)
+            Targets.add({ E, View.chunk, View.start, Src, LastDst });
+    }
+    if (Targets.is_empty())
+        return;
+
+    // entities moving between the same pair of groups in chunk order, so batch yields the longest runs
+    Targets.sort([](const CastTarget& A, const CastTarget& B) {
+        if (A.src != B.src)
+            return A.src < B.src;
+        if (A.dst != B.dst)
+            return A.dst < B.dst;
+        if (A.chunk != B.chunk)
+            return A.chunk < B.chunk;
+        return A.index < B.index;
+    });
+    skr::Vector<sugoi_entity_t> Entities;
+    for (uint64_t Begin = 0; Begin < Targets.size();)
+    {
+        const auto Src = Targets[Begin].src;
+        const auto Dst = Targets[Begin].dst;
+        uint64_t End = Begin + 1;
+        while (End < Targets.size() && Targets[End].src == Src && Targets[End].dst == Dst)
+            ++End;
+        Entities.clear();
+        for (uint64_t i = Begin; i < End; ++i)
+            Entities.add(Targets[i].entity);
+        auto CastRun = [&](sugoi_chunk_view_t* View) {
+            Storage->cast(*View, Dst, nullptr, nullptr);
+        };
+        Storage->batch(Entities.data(), (EIndex)Entities.size(), SUGOI_LAMBDA(CastRun));
+        Begin = End;
+    }
+}
+
+void EntityCommandBuffer::_playback_sets(skr::span<const sugoi_entity_t> Destroyed)
+{
+    SkrZoneScopedN("EntityCommandBuffer::sets");
+
+    skr::Vector<SetCommand> Sets;
+    for (auto& Stripe : stripes)
+        Sets.append(Stripe.sets);
+    if (Sets.is_empty())
+        return;
+    std::stable_sort(Sets.begin(), Sets.end(), [](const SetCommand& A, const SetCommand& B) {
+        return A.entity < B.entity;
+    });
+
+    auto Storage = World.get_storage();
+    for (auto& Cmd : Sets)
+    {
+        if (std::binary_search(Destroyed.begin(), Destroyed.end(), Cmd.entity) || !Storage->alive(Cmd.entity))
+            continue;
+        auto View = Storage->entity_view(Cmd.entity);
+        if (auto Dst = sugoiV_get_owned_rw(&View, Cmd.type))
+            Cmd.apply(Dst, Cmd.data);
+    }
+}
+
+void EntityCommandBuffer::_playback_destroys(skr::Vector<sugoi_entity_t>& Destroyed)
+{
+    SkrZoneScopedN("EntityCommandBuffer::destroys");
+
+    auto Storage = World.get_storage();
+    Destroyed.remove_all_if([&](sugoi_entity_t E) {
+        return !Storage->alive(E);
+    });
+    if (Destroyed.is_empty())
+        return;
+    Destroyed.sort([&](sugoi_entity_t A, sugoi_entity_t B) {
+        const auto VA = Storage->entity_view(A);
+        const auto VB = Storage->entity_view(B);
+        if (VA.chunk != VB.chunk)
+            return VA.chunk < VB.chunk;
+        return VA.start < VB.start;
+    });
+    sugoiS_destroy_entities(Storage, Destroyed.data(), (EIndex)Destroyed.size());
+}
+
+} // namespace skr::ecs
\ No newline at end of file
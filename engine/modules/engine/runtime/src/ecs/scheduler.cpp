@@ -1,6 +1,8 @@
 #include "SkrRT/ecs/scheduler.hpp"
 #include "SkrCore/async/wait_timeout.hpp"
 #include "SkrCore/memory/sp.hpp"
+#include "SkrRT/sugoi/chunk.hpp"
+#include "SkrRT/sugoi/storage.hpp"
 #include "./../sugoi/impl/query.hpp"
 
 namespace skr::ecs
@@ -29,11 +31,17 @@ inline static bool HasSelfConfictReadWrite(skr::RC<TaskSignature> task, Componen
     return false;
 }
 
-void StaticDependencyAnalyzer::process(skr::RC<TaskSignature> new_task)
+void StaticDependencyAnalyzer::process(skr::RC<TaskSignature> new_task, StackVector<TaskDependency>* all_dependencies)
 {
     SkrZoneScopedN("StaticDependencyAnalyzer::Process");
 
     StackVector<TaskDependency> _collector;
+    const auto collect = [&](const skr::RC<TaskSignature>& task, EDependencySyncMode mode) {
+        if (all_dependencies)
+            all_dependencies->emplace(task, mode);
+        if (!task->_finish.test())
+            _collector.emplace(task, mode);
+    };
     bool HasSelfConflict = false;
     for (auto read : new_task->reads)
     {
@@ -43,8 +51,7 @@ void StaticDependencyAnalyzer::process(skr::RC<TaskSignature> new_task)
         if (access.already_exist() && access.value().last_writer.first) // RAW
         {
             auto&& [writer, mode] = access.value().last_writer;
-            if (!writer->_finish.test())
-                _collector.emplace(writer, TaskSignature::DeterminSyncMode(new_task.get(), read.mode, writer.get(), mode));
+            collect(writer, TaskSignature::DeterminSyncMode(new_task.get(), read.mode, writer.get(), mode));
         }
         access.value().readers.add(new_task, read.mode);
     }
@@ -60,15 +67,13 @@ void StaticDependencyAnalyzer::process(skr::RC<TaskSignature> new_task)
                 if (reader == new_task)
                     continue; // skip self
 
-                if (!reader->_finish.test())
-                    _collector.emplace(reader, TaskSignature::DeterminSyncMode(new_task.get(), write.mode, reader.get(), mode));
+                collect(reader, TaskSignature::DeterminSyncMode(new_task.get(), write.mode, reader.get(), mode));
             }
         }
         if (access.already_exist() && access.value().last_writer.first) // WAW
         {
             auto&& [writer, mode] = access.value().last_writer;
-            if (!writer->_finish.test())
-                _collector.emplace(writer, TaskSignature::DeterminSyncMode(new_task.get(), write.mode, writer.get(), mode));
+            collect(writer, TaskSignature::DeterminSyncMode(new_task.get(), write.mode, writer.get(), mode));
         }
         access.value().last_writer = { new_task, write.mode };
         access.value().readers.clear();
@@ -77,7 +82,45 @@ void StaticDependencyAnalyzer::process(skr::RC<TaskSignature> new_task)
     new_task->self_confict = HasSelfConflict;
 }
 
-void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
+void StaticDependencyAnalyzer::track(skr::RC<TaskSignature> task)
+{
+    for (auto read : task->reads)
+    {
+        accesses.try_add_default(read.type).value().readers.add(task, read.mode);
+    }
+    for (auto write : task->writes)
+    {
+        auto& access = accesses.try_add_default(write.type).value();
+        access.last_writer = { task, write.mode };
+        access.readers.clear();
+    }
+}
+
+template <typename F>
+static void ForeachGroupDependency(const sugoi_group_t* group, skr::span<const TaskDependency> dependencies, F&& func)
+{
+    for (const auto& dependency : dependencies)
+    {
+        // can't be optimized, usually because of random accesses
+        if (dependency.mode == EDependencySyncMode::WholeTask)
+        {
+            func(dependency);
+        }
+        if (dependency.task->query) // from query, if two systems never operate on a same group. we can skip the denepdnecy
+        {
+            if (bool confict = sugoiQ_match_group(dependency.task->query, group))
+            {
+                func(dependency);
+            }
+        }
+        else // from workgroup
+        {
+            func(dependency);
+        }
+    }
+}
+
+void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task, bool groups_ready)
 {
     SkrZoneScopedN("WorkUnitGenerator::Process");
 
@@ -91,11 +134,23 @@ void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
         WorkGroup* work_group = nullptr;
         uint64_t total_units = 0;
         uint64_t total_jobs = 0;
+        bool filter_changed = false;
+        sugoi_timestamp_t since = 0;
     } ctx;
     ctx.query = new_task->query;
     ctx._this = this;
     ctx.new_task = new_task;
 
+    // changed filter: chunks not written since last run of the query are skipped
+    sugoi_timestamp_t now = 0;
+    if (ctx.query && ctx.query->pimpl->meta.changed.length)
+    {
+        ctx.filter_changed = true;
+        ctx.since = sugoiQ_get_timestamp(ctx.query);
+        // writes after this point are stamped newer than now and will be seen by next run
+        now = sugoiS_advance_timestamp(new_task->storage);
+    }
+
     static const auto collect_units = +[](void* usr_data, sugoi_chunk_view_t* view) {
         if (view->count == 0)
             return;
@@ -112,6 +167,12 @@ void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
             ctx->total_units += 1;
             ctx->last_unit_finish_counter = unit.finish;
 
+            if (ctx->new_task->opts)
+            {
+                for (auto dependency : ctx->new_task->opts->dependencies)
+                    unit.dependencies.add(dependency);
+            }
+
             for (auto [dependency, mode] : ctx->work_group->dependencies)
             {
                 if (mode == EDependencySyncMode::WholeTask)
@@ -135,6 +196,79 @@ void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
         ctx->total_jobs += 1;
     };
 
+    // writers dispatched before us may not have run yet, so their chunks are not stamped
+    static const auto has_pending_writer = +[](const CollectContext& ctx, const sugoi_chunk_t* chunk) {
+        const auto& changed = ctx.query->pimpl->meta.changed;
+        for (auto [dependency, mode] : ctx.work_group->dependencies)
+        {
+            if (dependency->_finish.test())
+                continue;
+            bool write_changed = false;
+            for (auto write : dependency->writes)
+                write_changed |= std::binary_search(changed.data, changed.data + changed.length, write.type);
+            if (!write_changed)
+                continue;
+            if (mode == EDependencySyncMode::WholeTask)
+                return true;
+            if (auto depend_group = dependency->_work_groups.find(ctx.work_group->group))
+            {
+                if (depend_group.value().units.find(chunk))
+                    return true;
+            }
+        }
+        return false;
+    };
+
+    static const auto collect_changed_units = +[](void* usr_data, sugoi_chunk_view_t* view) {
+        CollectContext* ctx = (CollectContext*)usr_data;
+        if (has_pending_writer(*ctx, view->chunk))
+            return collect_units(usr_data, view);
+
+        const auto chunk = view->chunk;
+        const auto& changed = ctx->query->pimpl->meta.changed;
+        bool dirty = false;
+        EIndex dirty_start = view->start + view->count, dirty_end = view->start;
+        for (SIndex i = 0; i < changed.length; ++i)
+        {
+            const auto slot = chunk->structure->index(changed.data[i]);
+            EIndex start, end;
+            if (slot != sugoi::kInvalidSIndex && chunk->get_dirty_range_at(slot, ctx->since, start, end))
+            {
+                dirty = true;
+                dirty_start = std::min(dirty_start, start);
+                dirty_end = std::max(dirty_end, end);
+            }
+        }
+        if (!dirty)
+            return;
+        if (!ctx->new_task->clip_dirty_rows)
+            return collect_units(usr_data, view);
+
+        auto clipped = *view;
+        clipped.start = std::max(view->start, dirty_start);
+        const auto clipped_end = std::min(view->start + view->count, dirty_end);
+        if (clipped_end <= clipped.start)
+            return;
+        clipped.count = clipped_end - clipped.start;
+        collect_units(usr_data, &clipped);
+    };
+
+    static const auto collect_group = +[](CollectContext& ctx, sugoi_group_t* group) {
+        if (ctx.filter_changed)
+        {
+            // chunk filtering is done by collect_changed_units, so we can see pending writers
+            const auto& q = *ctx.query->pimpl;
+            auto meta = q.meta;
+            meta.changed = { nullptr, 0 };
+            if (q.storage->match_group(q.filter, meta, group))
+                q.storage->filter_in_single_group(&q.parameters, group, q.filter, meta, q.customFilter, q.customFilterUserData, collect_changed_units, &ctx);
+        }
+        else
+        {
+            sugoiQ_in_group(ctx.query, group, collect_units, &ctx);
+        }
+    };
+
     if (new_task->_is_run_with)
     {
         static const auto batch_wgp = +[](void* u, sugoi_chunk_view_t* v) -> void {
@@ -142,25 +276,10 @@ void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
             auto group = v->chunk->group;
             ctx.work_group = &ctx.new_task->_work_groups.try_add_default(group).value();
             ctx.work_group->group = group;
-            for (auto dependency : ctx.new_task->_static_dependencies)
-            {
-                // can't be optimized, usually because of random accesses
-                if (dependency.mode == EDependencySyncMode::WholeTask)
-                {
-                    ctx.work_group->dependencies.add(dependency);
-                }
-                if (dependency.task->query) // from query, if two systems never operate on a same group. we can skip the denepdnecy
-                {
-                    if (bool confict = sugoiQ_match_group(dependency.task->query, group))
-                    {
-                        ctx.work_group->dependencies.add(dependency);
-                    }
-                }
-                else // from workgroup
-                {
-                    ctx.work_group->dependencies.add(dependency);
-                }
-            }
+            const auto& dependencies = ctx.new_task->_static_dependencies;
+            ForeachGroupDependency(group, { dependencies.data(), dependencies.size() }, [&](const TaskDependency& dependency) {
+                ctx.work_group->dependencies.add(dependency);
+            });
             collect_units(&ctx, v);
         };
         sugoiS_batch(new_task->storage,
@@ -175,33 +294,160 @@ void WorkUnitGenerator::process(skr::RC<TaskSignature> new_task)
             auto& ctx = *(CollectContext*)u;
             ctx.work_group = &ctx.new_task->_work_groups.try_add_default(group).value();
             ctx.work_group->group = group;
-            for (auto dependency : ctx.new_task->_static_dependencies)
+            const auto& dependencies = ctx.new_task->_static_dependencies;
+            ForeachGroupDependency(group, { dependencies.data(), dependencies.size() }, [&](const TaskDependency& dependency) {
+                ctx.work_group->dependencies.add(dependency);
+            });
+            collect_group(ctx, group);
+        };
+        if (groups_ready)
+        {
+            for (auto& [group, work_group] : new_task->_work_groups)
             {
-                // can't be optimized, usually because of random accesses
-                if (dependency.mode == EDependencySyncMode::WholeTask)
-                {
-                    ctx.work_group->dependencies.add(dependency);
-                }
-                if (dependency.task->query) // from query, if two systems never operate on a same group. we can skip the denepdnecy
-                {
-                    if (bool confict = sugoiQ_match_group(dependency.task->query, group))
-                    {
-                        ctx.work_group->dependencies.add(dependency);
-                    }
-                }
-                else // from workgroup
-                {
-                    ctx.work_group->dependencies.add(dependency);
-                }
+                ctx.work_group = &work_group;
+                collect_group(ctx, const_cast<sugoi_group_t*>(group));
             }
-            sugoiQ_in_group(ctx.query, group, collect_units, &ctx);
-        };
-        sugoiQ_get_groups(ctx.query, filter_group, &ctx);
+        }
+        else
+        {
+            sugoiQ_get_groups(ctx.query, filter_group, &ctx);
+        }
     }
+    if (ctx.filter_changed)
+        sugoiQ_set_timestamp((sugoi_query_t*)ctx.query, now);
     new_task->_finish_counter.add(ctx.total_jobs);
     ctx.new_task->_work_groups.compact();
 }
 
+uint64_t TaskGraphRecorder::KeyOf(const TaskSignature& task, skr::Vector<uint64_t>& words)
+{
+    words.clear();
+    words.add((uint64_t)(uintptr_t)task.storage);
+    words.add((uint64_t)(uintptr_t)task.query);
+    words.add(task._is_run_with);
+    words.add(task.opts && task.opts->no_parallelization);
+    for (const auto& accesses : { &task.reads, &task.writes })
+    {
+        words.add(accesses->size());
+        for (const auto& access : *accesses)
+            words.add(((uint64_t)access.type << 16) | ((uint64_t)access.mode << 8) | (uint64_t)access.access_type);
+    }
+    if (task.query)
+    {
+        // queries can be destroyed and recreated at the same address, or get a new meta filter
+        const auto& q = *task.query->pimpl;
+        const auto add_set = [&](const auto& set) {
+            words.add(set.length);
+            for (SIndex i = 0; i < set.length; ++i)
+                words.add((uint64_t)set.data[i]);
+        };
+        add_set(q.filter.all);
+        add_set(q.filter.none);
+        add_set(q.filter.all_shared);
+        add_set(q.filter.none_shared);
+        add_set(q.meta.all_meta);
+        add_set(q.meta.none_meta);
+        add_set(q.meta.changed);
+        words.add((uint64_t)(uintptr_t)q.customFilter);
+        words.add((uint64_t)q.includeDisabled | ((uint64_t)q.includeDead << 1) | ((uint64_t)q.includeAlias << 2));
+    }
+    return skr_hash64_of(words.data(), words.size() * sizeof(uint64_t));
+}
+
+TaskGraphRecorder::RecordedTask* TaskGraphRecorder::find(const TaskSignature& task)
+{
+    if (task._dispatch_index >= tasks.size())
+        return nullptr;
+    auto& recorded = tasks[task._dispatch_index];
+    const auto key = KeyOf(task, scratch_words);
+    return (recorded.key == key && recorded.key_words == scratch_words) ? &recorded : nullptr;
+}
+
+void TaskGraphRecorder::replay_dependencies(const RecordedTask& recorded, TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched)
+{
+    SkrZoneScopedN("TaskGraphRecorder::ReplayDependencies");
+
+    task._static_dependencies.reserve(recorded.dependencies.size());
+    for (auto [index, mode] : recorded.dependencies)
+    {
+        const auto& dependency = dispatched[index];
+        if (!dependency->_finish.test())
+            task._static_dependencies.emplace(dependency, mode);
+    }
+    task.self_confict = recorded.self_confict;
+    stats.replayed_tasks += 1;
+}
+
+bool TaskGraphRecorder::replay_groups(const RecordedTask& recorded, TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched)
+{
+    if (!recorded.has_groups || recorded.groups_timestamp != sugoiS_get_groups_timestamp(task.storage))
+        return false;
+
+    SkrZoneScopedN("TaskGraphRecorder::ReplayGroups");
+    for (const auto& recorded_group : recorded.groups)
+    {
+        auto& work_group = task._work_groups.try_add_default(recorded_group.group).value();
+        work_group.group = recorded_group.group;
+        for (auto [index, mode] : recorded_group.dependencies)
+        {
+            const auto& dependency = dispatched[index];
+            if (!dependency->_finish.test())
+                work_group.dependencies.emplace(dependency, mode);
+        }
+    }
+    stats.replayed_groups += 1;
+    return true;
+}
+
+TaskGraphRecorder::RecordedTask& TaskGraphRecorder::record(const TaskSignature& task, skr::span<const TaskDependency> all_dependencies)
+{
+    SkrZoneScopedN("TaskGraphRecorder::Record");
+
+    // later tasks were recorded against a different prefix
+    while (tasks.size() > task._dispatch_index)
+        tasks.pop_back();
+    SKR_ASSERT(tasks.size() == task._dispatch_index);
+
+    auto& recorded = tasks.add_default().ref();
+    recorded.key = KeyOf(task, recorded.key_words);
+    recorded.self_confict = task.self_confict;
+    recorded.dependencies.reserve(all_dependencies.size());
+    for (const auto& dependency : all_dependencies)
+        recorded.dependencies.add({ dependency.task->_dispatch_index, dependency.mode });
+    stats.recorded_tasks += 1;
+    return recorded;
+}
+
+void TaskGraphRecorder::record_groups(RecordedTask& recorded, const TaskSignature& task, skr::span<const skr::RC<TaskSignature>> dispatched)
+{
+    recorded.groups.clear();
+    recorded.has_groups = !task._is_run_with && task.query;
+    if (!recorded.has_groups)
+        return;
+
+    // group dependencies are derived from all dependencies, tasks that had finished this frame may not next frame
+    StackVector<TaskDependency> dependencies;
+    dependencies.reserve(recorded.dependencies.size());
+    for (auto [index, mode] : recorded.dependencies)
+        dependencies.emplace(dispatched[index], mode);
+
+    recorded.groups_timestamp = sugoiS_get_groups_timestamp(task.storage);
+    recorded.groups.reserve(task._work_groups.size());
+    for (const auto& [group, _] : task._work_groups)
+    {
+        auto& recorded_group = recorded.groups.add_default().ref();
+        recorded_group.group = const_cast<sugoi_group_t*>(group);
+        ForeachGroupDependency(group, { dependencies.data(), dependencies.size() }, [&](const TaskDependency& dependency) {
+            recorded_group.dependencies.add({ dependency.task->_dispatch_index, dependency.mode });
+        });
+    }
+}
+
+void TaskGraphRecorder::clear()
+{
+    tasks.clear();
+}
+
 static skr::UPtr<TaskScheduler> gInstance = nullptr;
 static std::atomic_bool gInitialized = false;
 static std::mutex gInstanceMutex;
@@ -248,6 +494,8 @@ void TaskScheduler::add_task(skr::RC<TaskSignature> task)
         _clear_mtx.lock_shared();
         SKR_DEFER({ _clear_mtx.unlock_shared(); });
 
+        // defragment refuses to move rows while the storage has tasks in flight
+        task->storage->begin_task();
         _tasks.enqueue(task);
     }
 
@@ -276,6 +524,7 @@ void TaskScheduler::dispatch(skr::RC<TaskSignature> signature)
                 batch_size = std::min(batch_size, chunk_view.count);
                 const auto batch_count = (chunk_view.count + batch_size - 1) / batch_size;
                 running.add(1);
+                signature->storage->begin_task();
                 {
                     SkrZoneScopedN("DispatchUnit::ScheduleTask");
                     skr::task::schedule([
@@ -288,6 +537,7 @@ void TaskScheduler::dispatch(skr::RC<TaskSignature> signature)
                                 dep.lock().wait(false);
                         }
                         SKR_DEFER({ 
+                            signature->storage->end_task();
                             running.decrement(); 
                             unit.finish.decrement(); 
                             signature->_finish_counter.decrement(); 
@@ -332,6 +582,8 @@ void TaskScheduler::dispatch(skr::RC<TaskSignature> signature)
 
     // release the ownership so tasks can free the task from payload
     signature->task.reset(nullptr);
+    // queued by add_task, the scheduled units keep the storage busy from here
+    signature->storage->end_task();
 }
 // clang-format on
 
@@ -355,8 +607,30 @@ AsyncResult TaskScheduler::serve() SKR_NOEXCEPT
     skr::RC<TaskSignature> task;
     if (_tasks.try_dequeue(task))
     {
-        _analyzer.process(task);
-        _generator.process(task);
+        task->_dispatch_index = (uint32_t)_dispatched_tasks.size();
+        const skr::span<const skr::RC<TaskSignature>> dispatched = { _dispatched_tasks.data(), _dispatched_tasks.size() };
+        auto recorded = _recorder.enabled ? _recorder.find(*task) : nullptr;
+        if (recorded)
+        {
+            _recorder.replay_dependencies(*recorded, *task, dispatched);
+        }
+        else
+        {
+            // replayed tasks were not seen by the analyzer, catch up before analyzing this one
+            for (; _analyzed_tasks < task->_dispatch_index; ++_analyzed_tasks)
+                _analyzer.track(_dispatched_tasks[_analyzed_tasks]);
+
+            StackVector<TaskDependency> all_dependencies;
+            _analyzer.process(task, _recorder.enabled ? &all_dependencies : nullptr);
+            _analyzed_tasks = task->_dispatch_index + 1;
+            if (_recorder.enabled)
+                recorded = &_recorder.record(*task, { all_dependencies.data(), all_dependencies.size() });
+        }
+
+        const bool groups_ready = recorded && _recorder.replay_groups(*recorded, *task, dispatched);
+        _generator.process(task, groups_ready);
+        if (recorded && !groups_ready)
+            _recorder.record_groups(*recorded, *task, dispatched);
 
         dispatch(task);
         skr_atomic_fetch_add(&_enqueued_tasks, -1);
@@ -389,12 +663,20 @@ void TaskScheduler::sync_all()
     _tasks.~StackConcurrentQueue<skr::RC<TaskSignature>>();
 
     StackAllocator::Reset();
+    _analyzed_tasks = 0;
 
     new (&_analyzer.accesses) StackMap<TypeIndex, StaticDependencyAnalyzer::AccessInfo>();
     new (&_dispatched_tasks) StackVector<skr::RC<TaskSignature>>();
     new (&_tasks) StackConcurrentQueue<skr::RC<TaskSignature>>();
 }
 
+void TaskScheduler::set_task_graph_replay(bool enable)
+{
+    _recorder.enabled = enable;
+    if (!enable)
+        _recorder.clear();
+}
+
 void TaskScheduler::stop_and_exit()
 {
     flush_all();
@@ -10,7 +10,7 @@ namespace skr::ecs
 static const char* kStackAllocatorName = "ECSStackAllocator";
 
 // Implementation details
-struct StackAllocator::Impl : public skr::StackAllocator<StackAllocator::Impl>
+struct StackAllocator::Impl : public skr::ThreadLocalStackAllocator<StackAllocator::Impl>
 {
     static constexpr size_t kDefaultChunkSize = 256 * 1024; // 256KB 默认块大小
     static constexpr size_t kAlignment = 16; // 16字节对齐
@@ -21,6 +21,7 @@ struct StackAllocator::Impl : public skr::StackAllocator<StackAllocator::Impl>
 static std::unique_ptr<StackAllocator::Impl> g_pool_impl = nullptr;
 static SMutex g_instance_mutex = {};
 static bool g_initialized = false;
+static StackAllocatorStats g_last_frame_stats = {};
 
 void StackAllocator::Initialize() {
     if (g_initialized) return;
@@ -46,6 +47,7 @@ void StackAllocator::Finalize() {
         {
             g_pool_impl->finalize();
             g_pool_impl.reset();
+            g_last_frame_stats = {};
             g_initialized = false;
         }
     }
@@ -75,12 +77,8 @@ void* StackAllocator::alloc_raw(size_t count, size_t item_size, size_t item_alig
     
     size_t total_size = count * item_size;
     
-    // 添加线程安全保护，与Reset()保持一致
-    skr_mutex_acquire(&g_instance_mutex);
-    void* result = get_impl().allocate(total_size, item_align);
-    skr_mutex_release(&g_instance_mutex);
-    
-    return result;
+    // 每个线程使用自己的arena，无需加锁
+    return get_impl().allocate(total_size, item_align);
 }
 
 void StackAllocator::free_raw(void* p, size_t item_align) 
@@ -94,10 +92,19 @@ void StackAllocator::Reset()
 {
     if (g_initialized && g_pool_impl)
     {
-        skr_mutex_acquire(&g_instance_mutex);
+        g_last_frame_stats = g_pool_impl->get_stats();
         g_pool_impl->reset();
-        skr_mutex_release(&g_instance_mutex);
     }
 }
 
+StackAllocatorStats StackAllocator::GetStats()
+{
+    return (g_initialized && g_pool_impl) ? g_pool_impl->get_stats() : StackAllocatorStats{};
+}
+
+StackAllocatorStats StackAllocator::GetLastFrameStats()
+{
+    return g_last_frame_stats;
+}
+
 } // namespace skr::ecs
\ No newline at end of file
@@ -40,6 +40,7 @@ void AccessBuilder::commit() SKR_NOEXCEPT
 {
     all.sort([](auto a, auto b) { return a < b; });
     nones.sort([](auto a, auto b) { return a < b; });
+    changes.sort([](auto a, auto b) { return a < b; });
 }
 
 sugoi_query_t* AccessBuilder::create_query(sugoi_storage_t* storage) SKR_NOEXCEPT
@@ -66,6 +67,11 @@ sugoi_query_t* AccessBuilder::create_query(sugoi_storage_t* storage) SKR_NOEXCEP
             meta_filter.all_meta.data = (const sugoi_entity_t*)meta_entities.data();
             meta_filter.all_meta.length = meta_entities.size();
         }
+        if (changes.size())
+        {
+            meta_filter.changed.data = changes.data();
+            meta_filter.changed.length = changes.size();
+        }
         /*
 		if (none_meta.size())
 		{
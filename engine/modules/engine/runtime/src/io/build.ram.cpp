@@ -11,4 +11,8 @@
 #include "ram/ram_readers.cpp"
 #include "ram/ram_service.cpp"
 
+#include "processors/task_decompressor.cpp"
+
+#include "uring/uring_queue.cpp"
+
 #include "dstorage/dstorage_resolvers.cpp"
\ No newline at end of file
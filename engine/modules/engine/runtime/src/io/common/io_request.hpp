@@ -166,7 +166,7 @@ public:
         return safe_comp<CompressedBlocksComponent>()->get_compressed_blocks();
     }
 
-    void add_compressed_block(const skr_io_block_t& block) SKR_NOEXCEPT
+    void add_compressed_block(const skr_io_compressed_block_t& block) SKR_NOEXCEPT
     {
         safe_comp<CompressedBlocksComponent>()->_add_compressed_block(block);
     }
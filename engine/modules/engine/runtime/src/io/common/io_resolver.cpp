@@ -16,18 +16,35 @@ void IORequestResolverChain::dispatch(SkrAsyncServicePriority priority) SKR_NOEX
     IOBatchId batch;
     while (fetched_batches[priority].try_dequeue(batch))
     {
+        for (auto resolver : chain)
+            resolver->begin_batch(priority, batch);
         for (auto request : batch->get_requests())
         {
             if (auto pComp = io_component<IOStatusComponent>(request.get()))
             {
                 pComp->setStatus(SKR_IO_STAGE_RESOLVING);
+                auto try_cancel = [&]() {
+                    if (!runner->try_cancel(priority, request))
+                        return false;
+                    // the request leaves the pipeline here, release files opened by previous resolvers
+                    if (auto pFile = io_component<FileComponent>(request.get()))
+                        pFile->close_file();
+                    return true;
+                };
+                bool cancelled = false;
                 for (auto resolver : chain)
                 {
-                    if (!runner->try_cancel(priority, request))
-                        resolver->resolve(priority, batch, request);
+                    if ((cancelled = try_cancel()))
+                        break;
+                    resolver->resolve(priority, batch, request);
                 }
+                // the last resolver may have rejected the request too
+                if (!cancelled)
+                    try_cancel();
             }
         }
+        for (auto resolver : chain)
+            resolver->end_batch(priority, batch);
         processed_batches[priority].enqueue(batch);
         dec_processing(priority);
         inc_processed(priority);
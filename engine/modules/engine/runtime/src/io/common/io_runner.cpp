@@ -208,7 +208,7 @@ bool RunnerBase::try_cancel(SkrAsyncServicePriority priority, IORequestId rq) SK
         if (status == SKR_IO_STAGE_CANCELLED) return true;
         if (status == SKR_IO_STAGE_LOADING) return false;
 
-        if (bool cancel_requested = pComp->getCancelRequested())
+        if (pComp->getCancelRequested() || pComp->getError() != SKR_IO_ERROR_NONE)
         {
             if (pComp->getFinishStep() == SKR_ASYNC_IO_FINISH_STEP_NONE)
             {
@@ -362,7 +362,10 @@ bool RunnerBase::complete_(IIORequest* rq, SkrAsyncServicePriority priority) SKR
 {
     if (auto pStatus = io_component<IOStatusComponent>(rq))
     {
-        SKR_ASSERT(pStatus->getStatus() == SKR_IO_STAGE_LOADED);
+        // blocks failed to decode, the request ends as cancelled with the error set
+        if (pStatus->getError() != SKR_IO_ERROR_NONE)
+            return cancel_(rq, priority);
+        SKR_ASSERT(pStatus->getStatus() == SKR_IO_STAGE_LOADED || pStatus->getStatus() == SKR_IO_STAGE_DECOMPRESSED);
         pStatus->setStatus(SKR_IO_STAGE_COMPLETED);
         if (pStatus->needPollFinish())
         {
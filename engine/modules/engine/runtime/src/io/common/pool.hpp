@@ -6,6 +6,7 @@ namespace io {
 
 extern const char* kIOPoolObjectsMemoryName; 
 extern const char* kIOConcurrentQueueName;
+extern const char* kIOBufferMemoryName;
 struct IOConcurrentQueueTraits : public skr::ConcurrentQueueDefaultTraits
 {
     static const bool RECYCLE_ALLOCATED_BLOCKS = true;
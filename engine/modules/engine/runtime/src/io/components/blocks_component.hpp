@@ -37,22 +37,35 @@ struct CID<struct CompressedBlocksComponent>
 struct CompressedBlocksComponent : public IORequestComponent
 {
     CompressedBlocksComponent(IIORequest* const request) SKR_NOEXCEPT;
+    ~CompressedBlocksComponent() SKR_NOEXCEPT;
     
     skr::span<skr_io_compressed_block_t> get_compressed_blocks() SKR_NOEXCEPT 
     { 
-        SKR_UNIMPLEMENTED_FUNCTION();
-        return {}; 
+        return { blocks.data(), blocks.size() };
     }
 
-    void _add_compressed_block(const skr_io_block_t& block) SKR_NOEXCEPT 
+    void _add_compressed_block(const skr_io_compressed_block_t& block) SKR_NOEXCEPT 
     {  
-        SKR_UNIMPLEMENTED_FUNCTION();
+        blocks.add(block);
     }
 
     void _reset_compressed_blocks() SKR_NOEXCEPT 
     {
-        SKR_UNIMPLEMENTED_FUNCTION();
+        blocks.clear();
     }
+
+    bool has_compressed_blocks() const SKR_NOEXCEPT { return !blocks.is_empty(); }
+
+    // compressed bytes of all blocks are read back to back into staging, then decoded into destination
+    void allocate_staging(uint64_t n) SKR_NOEXCEPT;
+    void free_staging() SKR_NOEXCEPT;
+
+    skr::Vector<skr_io_compressed_block_t> blocks;
+    uint8_t* staging = nullptr;
+    uint64_t staging_size = 0;
+    uint8_t* destination = nullptr;
+    SAtomicU32 pending_blocks = 0;
+    SAtomicU32 failed_blocks = 0;
 };
 
 constexpr skr_guid_t CID<struct BlocksComponent>::Get()
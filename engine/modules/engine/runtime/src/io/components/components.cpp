@@ -1,6 +1,7 @@
 #include "status_component.hpp"
 #include "blocks_component.hpp"
 #include "src_components.hpp"
+#include "../common/pool.hpp"
 
 namespace skr
 {
@@ -35,6 +36,30 @@ FileComponent::FileComponent(IIORequest* const request) SKR_NOEXCEPT
 {
 }
 
+void SharedVFile::release() SKR_NOEXCEPT
+{
+    if (skr_atomic_fetch_sub_explicit(&refs, 1, skr_memory_order_acq_rel) == 1)
+    {
+        skr_vfs_fclose(file);
+        SkrDelete(this);
+    }
+}
+
+void FileComponent::close_file() SKR_NOEXCEPT
+{
+    if (shared)
+    {
+        SKR_ASSERT(shared->file == file);
+        shared->release();
+        shared = nullptr;
+    }
+    else if (file)
+    {
+        skr_vfs_fclose(file);
+    }
+    file = nullptr;
+}
+
 uint64_t FileComponent::get_fsize() const SKR_NOEXCEPT
 {
     if (file)
@@ -69,5 +94,30 @@ CompressedBlocksComponent::CompressedBlocksComponent(IIORequest* const request)
 {
 }
 
+CompressedBlocksComponent::~CompressedBlocksComponent() SKR_NOEXCEPT
+{
+    free_staging();
+}
+
+void CompressedBlocksComponent::allocate_staging(uint64_t n) SKR_NOEXCEPT
+{
+    SKR_ASSERT(!staging);
+    if (n)
+    {
+        staging = (uint8_t*)sakura_mallocN(n, kIOBufferMemoryName);
+    }
+    staging_size = n;
+}
+
+void CompressedBlocksComponent::free_staging() SKR_NOEXCEPT
+{
+    if (staging)
+    {
+        sakura_freeN(staging, kIOBufferMemoryName);
+        staging = nullptr;
+    }
+    staging_size = 0;
+}
+
 } // namespace io
 } // namespace skr
\ No newline at end of file
@@ -49,14 +49,27 @@ struct CID<struct FileComponent>
 {
     static constexpr skr_guid_t Get();
 };
+// a vfs handle opened once for the requests of a batch reading the same file, see VFSFileCacheResolver
+struct SharedVFile
+{
+    // closes the handle and frees this with the last reference
+    void release() SKR_NOEXCEPT;
+
+    skr_io_file_handle file = nullptr;
+    SAtomicU32 refs = 0;
+};
+
 struct FileComponent : public IORequestComponent
 {
     FileComponent(IIORequest* const request) SKR_NOEXCEPT;
     
     uint64_t get_fsize() const SKR_NOEXCEPT;
+    // closes the vfs handle, or drops the reference if it is shared
+    void close_file() SKR_NOEXCEPT;
 
     skr_io_file_handle file = nullptr;
     SkrDStorageFileHandle dfile = nullptr;
+    SharedVFile* shared = nullptr;
 };
 
 constexpr skr_guid_t CID<struct PathSrcComponent>::Get()
@@ -62,6 +62,17 @@ public:
         return skr_atomic_load_relaxed(&future->request_cancel);
     }
 
+    // the request is cancelled at the next cancellation point, the error tells users it was not their cancel
+    void setError(ESkrIOError error) SKR_NOEXCEPT
+    {
+        skr_atomic_store_release(&future->error, error);
+    }
+
+    ESkrIOError getError() const SKR_NOEXCEPT
+    {
+        return static_cast<ESkrIOError>(skr_atomic_load_acquire(&future->error));
+    }
+
     SkrAsyncIOFinishStep getFinishStep() const SKR_NOEXCEPT
     { 
         return (SkrAsyncIOFinishStep)skr_atomic_load_acquire(&finish_step); 
@@ -14,6 +14,12 @@ void DStorageFileResolver::resolve(SkrAsyncServicePriority priority, IOBatchId b
     auto pFile = io_component<FileComponent>(request.get());
     if (!B->can_use_dstorage) 
         return;
+    // compressed blocks are decoded on cpu, the file is opened by VFSFileResolver
+    if (auto pCompressed = io_component<CompressedBlocksComponent>(request.get()))
+    {
+        if (pCompressed->has_compressed_blocks())
+            return;
+    }
 
     if (pPath && !pFile->dfile)
     {
@@ -17,10 +17,18 @@ bool skr_io_future_t::is_loading() const SKR_NOEXCEPT
 {
     return get_status() == SKR_IO_STAGE_LOADING;
 }
+bool skr_io_future_t::is_failed() const SKR_NOEXCEPT
+{
+    return is_cancelled() && get_error() != SKR_IO_ERROR_NONE;
+}
 ESkrIOStage skr_io_future_t::get_status() const SKR_NOEXCEPT
 {
     return (ESkrIOStage)skr_atomic_load_acquire(&status);
 }
+ESkrIOError skr_io_future_t::get_error() const SKR_NOEXCEPT
+{
+    return (ESkrIOError)skr_atomic_load_acquire(&error);
+}
 
 namespace skr {
 namespace io {
@@ -53,11 +61,21 @@ IIORequestResolver::~IIORequestResolver() SKR_NOEXCEPT
 
 }
 
+void IIORequestResolver::begin_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+
+}
+
 void IIORequestResolver::resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT
 {
 
 }
 
+void IIORequestResolver::end_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+
+}
+
 IIORequestResolverChain::~IIORequestResolverChain() SKR_NOEXCEPT
 {
 
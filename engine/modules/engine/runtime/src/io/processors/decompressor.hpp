@@ -1,23 +1,47 @@
 #pragma once
 #include "SkrRT/io/io.h"
 #include "../common/processors.hpp"
+#include "../common/io_request.hpp"
 
 namespace skr { template <typename Artifact> struct IFuture; struct JobQueue; }
 
 namespace skr {
 namespace io {
+struct RunnerBase;
 
 template<typename I = IIORequestProcessor>
 struct TaskDecompressorBase : public IIODecompressor<I>
 {
     IO_RESOLVER_OBJECT_BODY
 public:
-    TaskDecompressorBase() SKR_NOEXCEPT 
+    TaskDecompressorBase() SKR_NOEXCEPT
     {
         init_counters();
     }
     virtual ~TaskDecompressorBase() SKR_NOEXCEPT {}
 };
 
+// decodes every compressed block of a request as its own job, requests without compressed blocks pass through
+struct TaskDecompressor final : public TaskDecompressorBase<IIORequestProcessor>
+{
+    TaskDecompressor(RunnerBase* runner, skr::JobQueue* job_queue) SKR_NOEXCEPT;
+    ~TaskDecompressor() SKR_NOEXCEPT;
+
+    bool fetch(SkrAsyncServicePriority priority, IORequestId request) SKR_NOEXCEPT;
+    void dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    void recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    bool poll_processed_request(SkrAsyncServicePriority priority, IORequestId& request) SKR_NOEXCEPT;
+    bool is_async(SkrAsyncServicePriority priority) const SKR_NOEXCEPT { return job_queue; }
+
+protected:
+    void finishRequest(SkrAsyncServicePriority priority, const IORequestId& request) SKR_NOEXCEPT;
+
+    RunnerBase*                      runner = nullptr;
+    skr::JobQueue*                   job_queue = nullptr;
+    IORequestQueue                   fetched_requests[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    IORequestQueue                   decompressed_requests[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    skr::Vector<skr::IFuture<bool>*> block_futures[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+};
+
 } // namespace io
-} // namespace skr
\ No newline at end of file
+} // namespace skr
@@ -0,0 +1,440 @@
+#include "SkrCore/log.h"
+#include "SkrCore/async/thread_job.hpp"
+#include "SkrBase/misc/defer.hpp"
+#include "../common/io_runnner.hpp"
+#include "decompressor.hpp"
+
+#include "libdeflate.h"
+
+// BUILT-IN METHODS
+
+namespace skr {
+namespace io {
+namespace
+{
+namespace store
+{
+bool decompress(void* usrdata, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size)
+{
+    if (src_size != dst_size)
+        return false;
+    memcpy(dst, src, src_size);
+    return true;
+}
+} // namespace store
+
+// lz4 block format, compatible with LZ4_decompress_safe/LZ4_compress_default
+namespace lz4
+{
+static constexpr uint64_t kMinMatch       = 4;
+static constexpr uint64_t kLastLiterals   = 5;
+static constexpr uint64_t kMatchFindLimit = 12;
+static constexpr uint64_t kMaxOffset      = 65535;
+static constexpr uint32_t kHashLog        = 12;
+
+SKR_FORCEINLINE uint32_t read32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+SKR_FORCEINLINE uint32_t hash(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - kHashLog);
+}
+
+SKR_FORCEINLINE uint8_t* write_length(uint8_t* op, uint64_t len)
+{
+    for (; len >= 255; len -= 255)
+        *op++ = 255;
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+uint64_t compress_bound(void* usrdata, uint64_t size)
+{
+    return size + size / 255 + 16;
+}
+
+uint64_t compress(void* usrdata, const uint8_t* src, uint64_t size, uint8_t* dst, uint64_t capacity)
+{
+    if (capacity < compress_bound(usrdata, size))
+        return 0;
+
+    uint32_t table[1u << kHashLog] = {};
+    uint8_t* op = dst;
+    uint64_t anchor = 0;
+    auto emit = [&](uint64_t literal_end, uint64_t offset, uint64_t match_len) {
+        const uint64_t literals = literal_end - anchor;
+        uint8_t* token = op++;
+        *token = (uint8_t)(std::min<uint64_t>(literals, 15) << 4);
+        if (literals >= 15)
+            op = write_length(op, literals - 15);
+        memcpy(op, src + anchor, literals);
+        op += literals;
+        if (match_len)
+        {
+            op[0] = (uint8_t)offset;
+            op[1] = (uint8_t)(offset >> 8);
+            op += 2;
+            const uint64_t len = match_len - kMinMatch;
+            *token |= (uint8_t)std::min<uint64_t>(len, 15);
+            if (len >= 15)
+                op = write_length(op, len - 15);
+        }
+    };
+    // greedy matching, the last match must start 12 bytes and end 5 bytes before the end
+    if (size > kMatchFindLimit)
+    {
+        const uint64_t limit = size - kMatchFindLimit;
+        uint64_t i = 0;
+        while (i < limit)
+        {
+            const uint32_t sequence = read32(src + i);
+            const uint32_t h = hash(sequence);
+            const uint64_t ref = table[h];
+            table[h] = (uint32_t)i;
+            if (ref < i && i - ref <= kMaxOffset && read32(src + ref) == sequence)
+            {
+                uint64_t len = kMinMatch;
+                while (i + len < size - kLastLiterals && src[ref + len] == src[i + len])
+                    ++len;
+                emit(i, i - ref, len);
+                i += len;
+                anchor = i;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+    emit(size, 0, 0);
+    return (uint64_t)(op - dst);
+}
+
+bool decompress(void* usrdata, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size)
+{
+    const uint8_t*       ip   = src;
+    const uint8_t* const iend = src + src_size;
+    uint8_t*             op   = dst;
+    uint8_t* const       oend = dst + dst_size;
+    auto read_length = [&](uint64_t& len) {
+        uint8_t b = 0;
+        do
+        {
+            if (ip >= iend)
+                return false;
+            b = *ip++;
+            len += b;
+        } while (b == 255);
+        return true;
+    };
+    while (ip < iend)
+    {
+        const uint8_t token = *ip++;
+        uint64_t literals = token >> 4;
+        if (literals == 15 && !read_length(literals))
+            return false;
+        if ((uint64_t)(iend - ip) < literals || (uint64_t)(oend - op) < literals)
+            return false;
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == iend) // last sequence carries literals only
+            break;
+
+        if (iend - ip < 2)
+            return false;
+        const uint64_t offset = (uint64_t)ip[0] | ((uint64_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint64_t)(op - dst))
+            return false;
+        uint64_t len = token & 15;
+        if (len == 15 && !read_length(len))
+            return false;
+        len += kMinMatch;
+        if ((uint64_t)(oend - op) < len)
+            return false;
+        const uint8_t* match = op - offset;
+        if (offset >= len)
+        {
+            memcpy(op, match, len);
+            op += len;
+        }
+        else // overlapped match repeats the last offset bytes
+        {
+            for (uint64_t i = 0; i < len; ++i)
+                *op++ = match[i];
+        }
+    }
+    return op == oend;
+}
+} // namespace lz4
+
+// raw deflate through libdeflate
+namespace deflate
+{
+struct ThreadDecompressor {
+    ThreadDecompressor() { decompressor = libdeflate_alloc_decompressor(); }
+    ~ThreadDecompressor() { libdeflate_free_decompressor(decompressor); }
+    libdeflate_decompressor* decompressor = nullptr;
+};
+
+uint64_t compress_bound(void* usrdata, uint64_t size)
+{
+    return libdeflate_deflate_compress_bound(nullptr, size);
+}
+
+uint64_t compress(void* usrdata, const uint8_t* src, uint64_t size, uint8_t* dst, uint64_t capacity)
+{
+    auto compressor = libdeflate_alloc_compressor(9);
+    SKR_DEFER({ libdeflate_free_compressor(compressor); });
+    return libdeflate_deflate_compress(compressor, src, size, dst, capacity);
+}
+
+bool decompress(void* usrdata, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size)
+{
+    thread_local ThreadDecompressor local;
+    size_t actual = 0;
+    const auto result = libdeflate_deflate_decompress(local.decompressor, src, src_size, dst, dst_size, &actual);
+    return (result == LIBDEFLATE_SUCCESS) && (actual == dst_size);
+}
+} // namespace deflate
+
+struct DecompressMethodRegistry {
+    DecompressMethodRegistry() SKR_NOEXCEPT
+    {
+        methods.emplace(kDecompressMethodStore, skr_io_decompress_method_desc_t{ &store::decompress, nullptr, nullptr, nullptr });
+        methods.emplace(kDecompressMethodLZ4, skr_io_decompress_method_desc_t{ &lz4::decompress, &lz4::compress, &lz4::compress_bound, nullptr });
+        methods.emplace(kDecompressMethodDeflate, skr_io_decompress_method_desc_t{ &deflate::decompress, &deflate::compress, &deflate::compress_bound, nullptr });
+    }
+
+    bool find(const skr_io_decompress_method_t& method, skr_io_decompress_method_desc_t& desc) const SKR_NOEXCEPT
+    {
+        return methods.if_contains(method, [&](const auto& kv) { desc = kv.second; });
+    }
+
+    skr::ParallelFlatHashMap<skr_guid_t, skr_io_decompress_method_desc_t, skr::Hash<skr_guid_t>> methods;
+};
+
+DecompressMethodRegistry& GetDecompressMethodRegistry() SKR_NOEXCEPT
+{
+    static DecompressMethodRegistry registry;
+    return registry;
+}
+} // namespace
+
+using namespace skr::literals;
+const skr_io_decompress_method_t kDecompressMethodStore = u8"f22b9b9c-ccf1-4ef8-869d-f852b9455a29"_guid;
+const skr_io_decompress_method_t kDecompressMethodLZ4 = u8"9f258bbe-ee3f-43f7-8a9c-658336fe90f8"_guid;
+const skr_io_decompress_method_t kDecompressMethodDeflate = u8"7d9acbf1-3cf4-4551-aaac-906c61de3875"_guid;
+
+void register_decompress_method(const skr_io_decompress_method_t& method, const skr_io_decompress_method_desc_t& desc) SKR_NOEXCEPT
+{
+    SKR_ASSERT(desc.decompress && "decompress function is required!");
+    GetDecompressMethodRegistry().methods.insert_or_assign(method, desc);
+}
+
+void unregister_decompress_method(const skr_io_decompress_method_t& method) SKR_NOEXCEPT
+{
+    GetDecompressMethodRegistry().methods.erase(method);
+}
+
+bool decompress(const skr_io_decompress_method_t& method, const uint8_t* src, uint64_t src_size, uint8_t* dst, uint64_t dst_size) SKR_NOEXCEPT
+{
+    skr_io_decompress_method_desc_t desc = {};
+    if (!GetDecompressMethodRegistry().find(method, desc))
+    {
+        SKR_LOG_ERROR(u8"IODecompress: unknown decompress method!");
+        return false;
+    }
+    return desc.decompress(desc.usrdata, src, src_size, dst, dst_size);
+}
+
+bool compress_chunked(const skr_io_decompress_method_t& method, const uint8_t* src, uint64_t size, uint64_t chunk_size, skr::Vector<uint8_t>& out) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("IOCompressChunked");
+
+    skr_io_decompress_method_desc_t desc = {};
+    if (!GetDecompressMethodRegistry().find(method, desc) || !desc.compress || !desc.compress_bound)
+    {
+        SKR_LOG_ERROR(u8"IODecompress: method does not support compression!");
+        return false;
+    }
+    SKR_ASSERT(chunk_size && chunk_size < SKR_IO_CHUNK_STORED_BIT);
+
+    skr_io_chunked_header_t header = {};
+    header.magic = SKR_IO_CHUNKED_MAGIC;
+    header.chunk_count = (uint32_t)((size + chunk_size - 1) / chunk_size);
+    header.chunk_size = chunk_size;
+    header.uncompressed_size = size;
+    header.method = method;
+
+    skr::Vector<uint32_t> sizes;
+    sizes.reserve(header.chunk_count);
+    skr::Vector<uint8_t> scratch;
+    scratch.resize_unsafe(desc.compress_bound(desc.usrdata, chunk_size));
+    const uint64_t base = out.size();
+    out.add_zeroed(sizeof(header) + sizeof(uint32_t) * header.chunk_count);
+    for (uint64_t offset = 0; offset < size; offset += chunk_size)
+    {
+        const uint64_t raw = std::min(chunk_size, size - offset);
+        const uint64_t n = desc.compress(desc.usrdata, src + offset, raw, scratch.data(), scratch.size());
+        if (n == 0 || n >= raw)
+        {
+            out.append(src + offset, raw);
+            sizes.add((uint32_t)raw | SKR_IO_CHUNK_STORED_BIT);
+        }
+        else
+        {
+            out.append(scratch.data(), n);
+            sizes.add((uint32_t)n);
+        }
+    }
+    memcpy(out.data() + base, &header, sizeof(header));
+    memcpy(out.data() + base + sizeof(header), sizes.data(), sizeof(uint32_t) * sizes.size());
+    return true;
+}
+
+} // namespace io
+} // namespace skr
+
+// TASK DECOMPRESSOR IMPLEMENTATION
+
+namespace skr {
+namespace io {
+
+using DecompressFutureLauncher = skr::FutureLauncher<bool>;
+
+TaskDecompressor::TaskDecompressor(RunnerBase* runner, skr::JobQueue* job_queue) SKR_NOEXCEPT
+    : runner(runner), job_queue(job_queue)
+{
+
+}
+
+TaskDecompressor::~TaskDecompressor() SKR_NOEXCEPT
+{
+    for (auto& futures : block_futures)
+    {
+        for (auto future : futures)
+        {
+            future->wait();
+            SkrDelete(future);
+        }
+    }
+}
+
+bool TaskDecompressor::fetch(SkrAsyncServicePriority priority, IORequestId request) SKR_NOEXCEPT
+{
+    auto pStatus = io_component<IOStatusComponent>(request.get());
+    auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+    const auto loaded = pStatus && (pStatus->getStatus() == SKR_IO_STAGE_LOADED);
+    if (loaded && pCompressed && pCompressed->has_compressed_blocks())
+    {
+        fetched_requests[priority].enqueue(request);
+        inc_processing(priority);
+    }
+    else // nothing to decode
+    {
+        decompressed_requests[priority].enqueue(request);
+        inc_processed(priority);
+    }
+    return true;
+}
+
+void TaskDecompressor::dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    IORequestId request;
+    while (fetched_requests[priority].try_dequeue(request))
+    {
+        if (runner->try_cancel(priority, request))
+        {
+            dec_processing(priority);
+            continue;
+        }
+
+        SkrZoneScopedN("DispatchDecompress");
+        auto pStatus = io_component<IOStatusComponent>(request.get());
+        auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+        pStatus->setStatus(SKR_IO_STAGE_DECOMPRESSIONG);
+
+        const auto blocks = pCompressed->get_compressed_blocks();
+        skr_atomic_store_relaxed(&pCompressed->failed_blocks, 0);
+        skr_atomic_store_release(&pCompressed->pending_blocks, (uint32_t)blocks.size());
+        auto launcher = DecompressFutureLauncher(job_queue);
+        uint64_t src_offset = 0u;
+        uint64_t dst_offset = 0u;
+        for (const auto& block : blocks)
+        {
+            block_futures[priority].add(
+                launcher.async([this, priority, request, pCompressed, block, src_offset, dst_offset]() {
+                    SkrZoneScopedN("DecompressBlockTask");
+                    const auto src = pCompressed->staging + src_offset;
+                    const auto dst = pCompressed->destination + dst_offset;
+                    const bool ok = decompress(block.decompress_method, src, block.compressed_size, dst, block.uncompressed_size);
+                    if (!ok)
+                        skr_atomic_fetch_add_relaxed(&pCompressed->failed_blocks, 1);
+                    // the last finished block hands the request over
+                    if (skr_atomic_fetch_sub_explicit(&pCompressed->pending_blocks, 1, skr_memory_order_acq_rel) == 1)
+                        finishRequest(priority, request);
+                    return ok;
+                })
+            );
+            src_offset += block.compressed_size;
+            dst_offset += block.uncompressed_size;
+        }
+        // the runner sleeps until the last block task awakes it
+        dec_processing(priority);
+    }
+}
+
+void TaskDecompressor::finishRequest(SkrAsyncServicePriority priority, const IORequestId& request) SKR_NOEXCEPT
+{
+    auto pStatus = io_component<IOStatusComponent>(request.get());
+    auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+    pCompressed->free_staging();
+    if (const auto failed = skr_atomic_load_relaxed(&pCompressed->failed_blocks))
+    {
+        SKR_LOG_ERROR(u8"TaskDecompressor: %u blocks of %s failed to decompress", failed, request->get_path());
+        pStatus->setError(SKR_IO_ERROR_DECOMPRESS_FAILED);
+    }
+    else
+    {
+        pStatus->setStatus(SKR_IO_STAGE_DECOMPRESSED);
+    }
+    decompressed_requests[priority].enqueue(request);
+    inc_processed(priority);
+    runner->awake();
+}
+
+bool TaskDecompressor::poll_processed_request(SkrAsyncServicePriority priority, IORequestId& request) SKR_NOEXCEPT
+{
+    if (decompressed_requests[priority].try_dequeue(request))
+    {
+        dec_processed(priority);
+        return request.get();
+    }
+    return false;
+}
+
+void TaskDecompressor::recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("TaskDecompressor::recycle");
+
+    auto& arr = block_futures[priority];
+    for (auto& future : arr)
+    {
+        auto status = future->wait_for(0);
+        if (status == skr::FutureStatus::Ready)
+        {
+            SkrDelete(future);
+            future = nullptr;
+        }
+    }
+    arr.remove_all_if([](skr::IFuture<bool>* future) { return (future == nullptr); });
+}
+
+} // namespace io
+} // namespace skr
@@ -48,7 +48,9 @@ void RAMIOBatch::add_request(IORequestId request, RAMIOBufferId buffer, skr_io_f
     rq->destination = buffer;
     if (auto pComp = io_component<BlocksComponent>(rq.get()))
     {
-        SKR_ASSERT(!pComp->blocks.is_empty());
+        auto pCompressed = io_component<CompressedBlocksComponent>(rq.get());
+        SKR_ASSERT(!pComp->blocks.is_empty() || (pCompressed && pCompressed->has_compressed_blocks()));
+        SKR_ASSERT(pComp->blocks.is_empty() || !pCompressed || !pCompressed->has_compressed_blocks());
     }
     addRequest(request);
 }
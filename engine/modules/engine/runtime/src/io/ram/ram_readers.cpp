@@ -45,11 +45,7 @@ void VFSRAMReader::dispatchFunction(SkrAsyncServicePriority priority, const IORe
             if (service->runner.try_cancel(priority, rq))
             {
                 // cancel...
-                if (pFile->file) 
-                {
-                    skr_vfs_fclose(pFile->file);
-                    pFile->file = nullptr;
-                }
+                pFile->close_file();
                 if (buf)
                 {
                     buf->free_buffer();
@@ -63,12 +59,25 @@ void VFSRAMReader::dispatchFunction(SkrAsyncServicePriority priority, const IORe
 
                     pStatus->setStatus(SKR_IO_STAGE_LOADING);
                     // SKR_LOG_DEBUG(u8"dispatch read request: %s", rq->path.c_str());
-                    uint64_t dst_offset = 0u;
-                    for (const auto& block : pBlocks->blocks)
+                    auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+                    if (pCompressed && pCompressed->has_compressed_blocks())
                     {
-                        const auto address = buf->get_data() + dst_offset;
-                        skr_vfs_fread(pFile->file, address, block.offset, block.size);
-                        dst_offset += block.size;
+                        uint64_t staging_offset = 0u;
+                        for (const auto& block : pCompressed->blocks)
+                        {
+                            skr_vfs_fread(pFile->file, pCompressed->staging + staging_offset, block.offset, block.compressed_size);
+                            staging_offset += block.compressed_size;
+                        }
+                    }
+                    else
+                    {
+                        uint64_t dst_offset = 0u;
+                        for (const auto& block : pBlocks->blocks)
+                        {
+                            const auto address = buf->get_data() + dst_offset;
+                            skr_vfs_fread(pFile->file, address, block.offset, block.size);
+                            dst_offset += block.size;
+                        }
                     }
                     pStatus->setStatus(SKR_IO_STAGE_LOADED);
                 }
@@ -83,8 +92,7 @@ void VFSRAMReader::dispatchFunction(SkrAsyncServicePriority priority, const IORe
             if (pFile->file)
             {
                 // SKR_LOG_DEBUG(u8"dispatch close request: %s", rq->path.c_str());
-                skr_vfs_fclose(pFile->file);
-                pFile->file = nullptr;
+                pFile->close_file();
                 loaded_requests[priority].enqueue(rq);
                 inc_processed(priority);
             }
@@ -141,6 +149,235 @@ void VFSRAMReader::recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT
 } // namespace io
 } // namespace skr
 
+// COALESCING READER IMPLEMENTATION
+
+namespace skr {
+namespace io {
+
+using CoalescingReaderFutureLauncher = skr::FutureLauncher<bool>;
+
+CoalescingRAMReader::~CoalescingRAMReader() SKR_NOEXCEPT
+{
+    for (auto i = 0; i < SKR_ASYNC_SERVICE_PRIORITY_COUNT; ++i)
+    {
+        for (auto future : read_futures[i])
+        {
+            future->wait_for(UINT32_MAX);
+            SkrDelete(future);
+        }
+        for (auto read : fetched_reads[i])
+            SkrDelete(read);
+        for (auto read : dispatched_reads[i])
+            SkrDelete(read);
+    }
+}
+
+bool CoalescingRAMReader::fetch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("Coalescing::Fetch");
+
+    // group requests by their shared handle, only files with several requests are worth merging
+    skr::Vector<FileRead> files;
+    for (auto&& request : batch->get_requests())
+    {
+        auto pStatus = io_component<IOStatusComponent>(request.get());
+        auto pFile = io_component<FileComponent>(request.get());
+        if (!pStatus || !pFile || !pFile->shared)
+            continue;
+        if (pStatus->getStatus() != SKR_IO_STAGE_RESOLVING)
+            continue;
+        FileRead* file = nullptr;
+        for (auto& f : files)
+        {
+            if (f.shared == pFile->shared)
+            {
+                file = &f;
+                break;
+            }
+        }
+        if (!file)
+        {
+            file = &files.add_default().ref();
+            file->shared = pFile->shared;
+        }
+        file->requests.add(request);
+    }
+    files.remove_all_if([](const FileRead& f) { return f.requests.size() < 2; });
+
+    if (files.is_empty())
+    {
+        processed_batches[priority].enqueue(batch);
+        inc_processed(priority);
+    }
+    else
+    {
+        auto read = SkrNew<BatchRead>();
+        read->batch = batch;
+        read->files = std::move(files);
+        skr_atomic_store_relaxed(&read->pending, (uint32_t)read->files.size());
+        fetched_reads[priority].add(read);
+        inc_processing(priority);
+    }
+    return true;
+}
+
+void CoalescingRAMReader::readFile(SkrAsyncServicePriority priority, FileRead& file) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("Coalescing::ReadFile");
+
+    struct Target {
+        uint8_t* dst;
+        uint64_t offset;
+        uint64_t size;
+    };
+    skr::Vector<Target> targets;
+    for (auto& request : file.requests)
+    {
+        auto rq = request.cast_static<RAMRequestMixin>();
+        auto buf = rq->destination.cast_static<RAMIOBuffer>();
+        if (service->runner.try_cancel(priority, rq))
+        {
+            io_component<FileComponent>(request.get())->close_file();
+            if (buf)
+            {
+                buf->free_buffer();
+            }
+            request = nullptr;
+            continue;
+        }
+        io_component<IOStatusComponent>(request.get())->setStatus(SKR_IO_STAGE_LOADING);
+        auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+        if (pCompressed && pCompressed->has_compressed_blocks())
+        {
+            uint64_t staging_offset = 0u;
+            for (const auto& block : pCompressed->blocks)
+            {
+                targets.add({ pCompressed->staging + staging_offset, block.offset, block.compressed_size });
+                staging_offset += block.compressed_size;
+            }
+        }
+        else if (auto pBlocks = io_component<BlocksComponent>(request.get()))
+        {
+            uint64_t dst_offset = 0u;
+            for (const auto& block : pBlocks->blocks)
+            {
+                targets.add({ buf->get_data() + dst_offset, block.offset, block.size });
+                dst_offset += block.size;
+            }
+        }
+    }
+    std::sort(targets.begin(), targets.end(), [](const Target& a, const Target& b) { return a.offset < b.offset; });
+
+    skr::Vector<uint8_t> scratch;
+    for (uint64_t i = 0; i < targets.size();)
+    {
+        const uint64_t begin = targets[i].offset;
+        uint64_t end = begin + targets[i].size;
+        uint64_t next = i + 1;
+        for (; next < targets.size(); ++next)
+        {
+            const auto& target = targets[next];
+            const uint64_t target_end = std::max(end, target.offset + target.size);
+            if (target.offset > end + kMaxGapSize || target_end - begin > kMaxReadSize)
+                break;
+            end = target_end;
+        }
+        if (next == i + 1)
+        {
+            skr_vfs_fread(file.shared->file, targets[i].dst, begin, targets[i].size);
+        }
+        else
+        {
+            SkrZoneScopedN("Coalescing::Scatter");
+            scratch.resize_unsafe(end - begin);
+            const uint64_t read = skr_vfs_fread(file.shared->file, scratch.data(), begin, end - begin);
+            for (uint64_t k = i; k < next; ++k)
+            {
+                const uint64_t offset = targets[k].offset - begin;
+                if (offset < read)
+                    memcpy(targets[k].dst, scratch.data() + offset, std::min(targets[k].size, read - offset));
+            }
+        }
+        i = next;
+    }
+
+    for (auto& request : file.requests)
+    {
+        if (!request)
+            continue;
+        io_component<IOStatusComponent>(request.get())->setStatus(SKR_IO_STAGE_LOADED);
+        io_component<FileComponent>(request.get())->close_file();
+    }
+}
+
+void CoalescingRAMReader::dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    for (auto read : fetched_reads[priority])
+    {
+        for (auto& file : read->files)
+        {
+            auto launcher = CoalescingReaderFutureLauncher(job_queue);
+            read_futures[priority].add(
+                launcher.async([this, read, &file, priority](){
+                    readFile(priority, file);
+                    auto batch = read->batch;
+                    if (skr_atomic_fetch_sub_explicit(&read->pending, 1, skr_memory_order_acq_rel) == 1)
+                    {
+                        processed_batches[priority].enqueue(batch);
+                        dec_processing(priority);
+                        inc_processed(priority);
+                        awakeService();
+                    }
+                    return true;
+                })
+            );
+        }
+        dispatched_reads[priority].add(read);
+    }
+    fetched_reads[priority].clear();
+}
+
+void CoalescingRAMReader::recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("CoalescingRAMReader::recycle");
+
+    auto& arr = read_futures[priority];
+    for (auto& future : arr)
+    {
+        auto status = future->wait_for(0);
+        if (status == skr::FutureStatus::Ready)
+        {
+            SkrDelete(future);
+            future = nullptr;
+        }
+    }
+    arr.remove_all_if([](skr::IFuture<bool>* future) { return (future == nullptr); });
+
+    auto& reads = dispatched_reads[priority];
+    for (auto& read : reads)
+    {
+        if (skr_atomic_load_acquire(&read->pending) == 0)
+        {
+            SkrDelete(read);
+            read = nullptr;
+        }
+    }
+    reads.remove_all_if([](BatchRead* read) { return (read == nullptr); });
+}
+
+bool CoalescingRAMReader::poll_processed_batch(SkrAsyncServicePriority priority, IOBatchId& batch) SKR_NOEXCEPT
+{
+    if (processed_batches[priority].try_dequeue(batch))
+    {
+        dec_processed(priority);
+        return batch.get();
+    }
+    return false;
+}
+
+} // namespace io
+} // namespace skr
+
 // DSTORAGE READER IMPLEMENTATION
 
 #include "../ram/ram_request.hpp"
@@ -236,6 +473,8 @@ void DStorageRAMReader::enqueueAndSubmit(SkrAsyncServicePriority priority) SKR_N
             auto rq = request.cast_static<RAMRequestMixin>();
             auto buf = rq->destination.cast_static<RAMIOBuffer>();
             auto pBlocks = io_component<BlocksComponent>(request.get());
+            if (auto pFile = io_component<FileComponent>(request.get()); pFile && !pFile->dfile)
+                continue; // opened through vfs (e.g. compressed requests), VFSRAMReader reads it
             if (auto pFile = io_component<FileComponent>(request.get()))
             {
                 if (service->runner.try_cancel(priority, rq))
@@ -308,6 +547,8 @@ void DStorageRAMReader::pollSubmitted(SkrAsyncServicePriority priority) SKR_NOEX
                 {
                     auto pFile = io_component<FileComponent>(request.get());
                     auto pStatus = io_component<IOStatusComponent>(request.get());
+                    if (!pFile->dfile)
+                        continue;
                     pStatus->setStatus(SKR_IO_STAGE_LOADED);
                     skr_dstorage_close_file(instance, pFile->dfile);
                     pFile->dfile = nullptr;
@@ -347,4 +588,296 @@ bool DStorageRAMReader::poll_processed_batch(SkrAsyncServicePriority priority, I
 }
 
 } // namespace io
-} // namespace skr
\ No newline at end of file
+} // namespace skr
+
+// IO_URING READER IMPLEMENTATION
+
+#ifdef __linux__
+#include <SkrOS/filesystem.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace skr {
+namespace io {
+
+static bool IsNativeVFS_Uring(const skr_vfs_t* vfs)
+{
+    skr_vfs_proctable_t native = {};
+    skr_vfs_get_native_procs(&native);
+    return vfs->procs.fopen == native.fopen && vfs->procs.fread == native.fread;
+}
+
+static skr::String ResolveNativePath_Uring(const skr_vfs_t* vfs, const char8_t* path)
+{
+    skr::Path p{ path };
+    if (!p.is_absolute() && vfs->mount_dir)
+    {
+        p = skr::Path{ vfs->mount_dir };
+        p /= path;
+    }
+    return p.string();
+}
+
+UringRAMReader::UringRAMReader(RAMService* service) SKR_NOEXCEPT
+    : RAMReaderBase(service)
+{
+
+}
+
+UringRAMReader::~UringRAMReader() SKR_NOEXCEPT
+{
+    for (auto i = 0; i < SKR_ASYNC_SERVICE_PRIORITY_COUNT; ++i)
+    {
+        const auto priority = (SkrAsyncServicePriority)i;
+        // the kernel may still write into request buffers, wait for every read to land
+        while (queues[i].get_in_flight())
+        {
+            queues[i].wait(queues[i].get_in_flight());
+            pollCompletions(priority);
+        }
+        for (auto read : reads[i])
+        {
+            for (auto& request : read->requests)
+            {
+                if (request.fd >= 0)
+                    close(request.fd);
+            }
+            SkrDelete(read);
+        }
+        reads[i].clear();
+        queues[i].shutdown();
+    }
+}
+
+bool UringRAMReader::initialize() SKR_NOEXCEPT
+{
+    for (auto i = 0; i < SKR_ASYNC_SERVICE_PRIORITY_COUNT; ++i)
+    {
+        if (!queues[i].initialize(kQueueDepth))
+            return false;
+    }
+    return true;
+}
+
+bool UringRAMReader::openRequest(BatchRead* read, const IORequestId& request) SKR_NOEXCEPT
+{
+    auto rq = request.cast_static<RAMRequestMixin>();
+    auto pStatus = io_component<IOStatusComponent>(request.get());
+    auto pPath = io_component<PathSrcComponent>(request.get());
+    auto pFile = io_component<FileComponent>(request.get());
+    if (!pStatus || !pPath || !pFile || !pFile->file || pFile->dfile)
+        return false;
+    if (pStatus->getStatus() != SKR_IO_STAGE_RESOLVING)
+        return false;
+    const auto vfs = pPath->get_vfs();
+    if (!vfs || !IsNativeVFS_Uring(vfs))
+        return false; // packed or virtual file systems, VFSRAMReader reads them through the vfs procs
+
+    const auto request_index = (uint32_t)read->requests.size();
+    const auto first_block = read->blocks.size();
+    bool aligned = true;
+    const auto addBlock = [&](uint8_t* dst, uint64_t offset, uint64_t size) {
+        if (!size) return;
+        aligned &= !(offset % kDirectAlignment) && !(size % kDirectAlignment) && !((uint64_t)dst % kDirectAlignment);
+        read->blocks.add({ read, request_index, dst, offset, size });
+    };
+    auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+    if (pCompressed && pCompressed->has_compressed_blocks())
+    {
+        uint64_t staging_offset = 0u;
+        for (const auto& block : pCompressed->blocks)
+        {
+            addBlock(pCompressed->staging + staging_offset, block.offset, block.compressed_size);
+            staging_offset += block.compressed_size;
+        }
+    }
+    else if (auto pBlocks = io_component<BlocksComponent>(request.get()))
+    {
+        auto buf = rq->destination.cast_static<RAMIOBuffer>();
+        uint64_t dst_offset = 0u;
+        for (const auto& block : pBlocks->blocks)
+        {
+            addBlock(buf->get_data() + dst_offset, block.offset, block.size);
+            dst_offset += block.size;
+        }
+    }
+    const auto block_count = (uint32_t)(read->blocks.size() - first_block);
+    if (!block_count)
+        return false;
+
+    const auto path = ResolveNativePath_Uring(vfs, pPath->get_path());
+    int fd = aligned ? open(path.c_str_raw(), O_RDONLY | O_CLOEXEC | O_DIRECT) : -1;
+    if (fd < 0) // O_DIRECT is not supported by every file system
+        fd = open(path.c_str_raw(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        read->blocks.resize_unsafe(first_block);
+        return false;
+    }
+    read->requests.add({ request, fd, block_count, false });
+    pStatus->setStatus(SKR_IO_STAGE_LOADING);
+    return true;
+}
+
+bool UringRAMReader::fetch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("Uring::Fetch");
+
+    // try_cancel removes requests from the batch
+    skr::Vector<IORequestId> requests;
+    requests.append(batch->get_requests());
+
+    auto read = SkrNew<BatchRead>();
+    read->batch = batch;
+    for (auto&& request : requests)
+    {
+        auto rq = request.cast_static<RAMRequestMixin>();
+        if (service->runner.try_cancel(priority, rq))
+        {
+            if (auto pFile = io_component<FileComponent>(request.get()))
+            {
+                pFile->close_file();
+            }
+            if (auto buf = rq->destination.cast_static<RAMIOBuffer>())
+            {
+                buf->free_buffer();
+            }
+            continue;
+        }
+        openRequest(read, request);
+    }
+
+    if (read->requests.is_empty())
+    {
+        SkrDelete(read);
+        processed_batches[priority].enqueue(batch);
+        inc_processed(priority);
+    }
+    else
+    {
+        read->pending = (uint32_t)read->requests.size();
+        reads[priority].add(read);
+        inc_processing(priority);
+    }
+    return true;
+}
+
+bool UringRAMReader::prepareRead(SkrAsyncServicePriority priority, BlockRead* block) SKR_NOEXCEPT
+{
+    const auto& request = block->batch->requests[block->request];
+    const auto size = (uint32_t)std::min<uint64_t>(block->size, kMaxReadSize);
+    return queues[priority].prepare_read(request.fd, block->dst, size, block->offset, (uint64_t)block);
+}
+
+void UringRAMReader::submitReads(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("Uring::Submit");
+
+    auto& retries = retry_blocks[priority];
+    while (!retries.is_empty() && prepareRead(priority, retries.at_last()))
+    {
+        retries.pop_back();
+    }
+    for (auto read : reads[priority])
+    {
+        while (read->submitted < read->blocks.size())
+        {
+            if (!prepareRead(priority, &read->blocks[read->submitted]))
+                break;
+            read->submitted += 1;
+        }
+        if (read->submitted < read->blocks.size())
+            break; // queue is full
+    }
+    queues[priority].submit();
+}
+
+void UringRAMReader::pollCompletions(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("Uring::PollCompletions");
+
+    queues[priority].poll_completions([this, priority](uint64_t user_data, int32_t result) {
+        onBlockCompleted(priority, (BlockRead*)user_data, result);
+    });
+}
+
+void UringRAMReader::onBlockCompleted(SkrAsyncServicePriority priority, BlockRead* block, int32_t result) SKR_NOEXCEPT
+{
+    auto read = block->batch;
+    auto& request = read->requests[block->request];
+    if (result <= 0)
+    {
+        // errors and unexpected eof, VFSRAMReader retries the whole request
+        request.failed = true;
+    }
+    else if ((uint64_t)result < block->size)
+    {
+        block->dst += result;
+        block->offset += result;
+        block->size -= result;
+        retry_blocks[priority].add(block);
+        return;
+    }
+
+    if (--request.pending == 0)
+        finishRequest(priority, read, request);
+}
+
+void UringRAMReader::finishRequest(SkrAsyncServicePriority priority, BatchRead* read, RequestRead& request) SKR_NOEXCEPT
+{
+    close(request.fd);
+    request.fd = -1;
+
+    auto pStatus = io_component<IOStatusComponent>(request.request.get());
+    auto pFile = io_component<FileComponent>(request.request.get());
+    if (request.failed)
+    {
+        pStatus->setStatus(SKR_IO_STAGE_RESOLVING);
+    }
+    else
+    {
+        pStatus->setStatus(SKR_IO_STAGE_LOADED);
+        pFile->close_file();
+    }
+
+    if (--read->pending == 0)
+    {
+        processed_batches[priority].enqueue(read->batch);
+        dec_processing(priority);
+        inc_processed(priority);
+    }
+}
+
+void UringRAMReader::dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    pollCompletions(priority);
+    submitReads(priority);
+}
+
+void UringRAMReader::recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT
+{
+    auto& arr = reads[priority];
+    for (auto& read : arr)
+    {
+        if (read->pending == 0)
+        {
+            SkrDelete(read);
+            read = nullptr;
+        }
+    }
+    arr.remove_all_if([](BatchRead* read) { return (read == nullptr); });
+}
+
+bool UringRAMReader::poll_processed_batch(SkrAsyncServicePriority priority, IOBatchId& batch) SKR_NOEXCEPT
+{
+    if (processed_batches[priority].try_dequeue(batch))
+    {
+        dec_processed(priority);
+        return batch.get();
+    }
+    return false;
+}
+
+} // namespace io
+} // namespace skr
+#endif
@@ -56,6 +56,46 @@ struct VFSRAMReader final : public RAMReaderBase<IIORequestProcessor> {
     skr::Vector<skr::IFuture<bool>*> loaded_futures[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
 };
 
+// reads the requests of a batch that share a vfs handle (see VFSFileCacheResolver) in one job per file.
+// blocks are sorted by offset and near-adjacent ranges are merged into single reads, then scattered
+// into the request buffers. other requests are left to the following readers
+struct CoalescingRAMReader final : public RAMReaderBase<IIOBatchProcessor> {
+    // reading a gap up to this size is cheaper than another seek + read
+    static constexpr uint64_t kMaxGapSize  = 64 * 1024;
+    static constexpr uint64_t kMaxReadSize = 8 * 1024 * 1024;
+
+    CoalescingRAMReader(RAMService* service, skr::JobQueue* job_queue) SKR_NOEXCEPT
+        : RAMReaderBase(service),
+          job_queue(job_queue)
+    {
+    }
+    ~CoalescingRAMReader() SKR_NOEXCEPT;
+
+    bool fetch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
+    void dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    void recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    bool poll_processed_batch(SkrAsyncServicePriority priority, IOBatchId& batch) SKR_NOEXCEPT;
+    bool is_async(SkrAsyncServicePriority priority) const SKR_NOEXCEPT { return job_queue; }
+
+protected:
+    struct FileRead {
+        SharedVFile*             shared = nullptr;
+        skr::Vector<IORequestId> requests;
+    };
+    struct BatchRead {
+        IOBatchId              batch = nullptr;
+        skr::Vector<FileRead>  files;
+        SAtomicU32             pending = 0;
+    };
+    void readFile(SkrAsyncServicePriority priority, FileRead& file) SKR_NOEXCEPT;
+
+    skr::JobQueue*                   job_queue = nullptr;
+    skr::Vector<BatchRead*>          fetched_reads[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    skr::Vector<BatchRead*>          dispatched_reads[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    IOBatchQueue                     processed_batches[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    skr::Vector<skr::IFuture<bool>*> read_futures[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+};
+
 } // namespace io
 } // namespace skr
 
@@ -92,4 +132,73 @@ struct SKR_RUNTIME_API DStorageRAMReader final
 };
 
 } // namespace io
-} // namespace skr
\ No newline at end of file
+} // namespace skr
+#ifdef __linux__
+#include "../uring/uring_queue.hpp"
+
+namespace skr
+{
+namespace io
+{
+
+// submits every block of a batch through io_uring and completes requests from the completion queue.
+// only files opened through the native vfs are read here (with O_DIRECT when offsets, sizes and
+// destinations are aligned), other requests and failed reads are left RESOLVING for VFSRAMReader
+struct SKR_RUNTIME_API UringRAMReader final
+    : public RAMReaderBase<IIOBatchProcessor> {
+    static constexpr uint32_t kQueueDepth      = 256;
+    static constexpr uint64_t kDirectAlignment = 4096;
+    static constexpr uint32_t kMaxReadSize     = 1u << 30;
+
+    UringRAMReader(RAMService* service) SKR_NOEXCEPT;
+    ~UringRAMReader() SKR_NOEXCEPT;
+
+    // false if io_uring is not usable on this kernel
+    bool initialize() SKR_NOEXCEPT;
+
+    bool fetch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
+    void dispatch(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    void recycle(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    bool poll_processed_batch(SkrAsyncServicePriority priority, IOBatchId& batch) SKR_NOEXCEPT;
+    bool is_async(SkrAsyncServicePriority priority) const SKR_NOEXCEPT { return false; }
+
+protected:
+    struct BatchRead;
+    struct RequestRead {
+        IORequestId request = nullptr;
+        int         fd      = -1;
+        uint32_t    pending = 0;
+        bool        failed  = false;
+    };
+    struct BlockRead {
+        BatchRead* batch   = nullptr;
+        uint32_t   request = 0;
+        uint8_t*   dst     = nullptr;
+        uint64_t   offset  = 0;
+        uint64_t   size    = 0;
+    };
+    struct BatchRead {
+        IOBatchId                batch = nullptr;
+        skr::Vector<RequestRead> requests;
+        skr::Vector<BlockRead>   blocks;
+        uint32_t                 submitted = 0;
+        uint32_t                 pending   = 0;
+    };
+
+    bool openRequest(BatchRead* read, const IORequestId& request) SKR_NOEXCEPT;
+    bool prepareRead(SkrAsyncServicePriority priority, BlockRead* block) SKR_NOEXCEPT;
+    void submitReads(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    void pollCompletions(SkrAsyncServicePriority priority) SKR_NOEXCEPT;
+    void onBlockCompleted(SkrAsyncServicePriority priority, BlockRead* block, int32_t result) SKR_NOEXCEPT;
+    void finishRequest(SkrAsyncServicePriority priority, BatchRead* read, RequestRead& request) SKR_NOEXCEPT;
+
+    UringQueue               queues[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    skr::Vector<BatchRead*>  reads[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    // short reads continue from where the kernel stopped
+    skr::Vector<BlockRead*>  retry_blocks[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+    IOBatchQueue             processed_batches[SKR_ASYNC_SERVICE_PRIORITY_COUNT];
+};
+
+} // namespace io
+} // namespace skr
+#endif
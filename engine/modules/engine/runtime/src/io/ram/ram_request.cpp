@@ -34,6 +34,10 @@ void RAMIOStatusComponent::setStatus(ESkrIOStage status) SKR_NOEXCEPT
         {
             dest->free_buffer();
         }
+        if (auto pCompressed = io_component<CompressedBlocksComponent>(rq))
+        {
+            pCompressed->free_staging();
+        }
     }
     return IOStatusComponent::setStatus(status);
 }
@@ -22,7 +22,7 @@ struct RAMRequestMixin final : public IORequestMixin<IBlocksRAMRequest,
     // components...
     RAMIOStatusComponent, 
     PathSrcComponent, FileComponent,
-    BlocksComponent>
+    BlocksComponent, CompressedBlocksComponent>
 {
     friend struct SmartPool<RAMRequestMixin, IBlocksRAMRequest>;
     ~RAMRequestMixin() SKR_NOEXCEPT;
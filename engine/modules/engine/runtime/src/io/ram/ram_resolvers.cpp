@@ -1,6 +1,8 @@
 #include "ram_resolvers.hpp"
 #include "ram_request.hpp"
 #include "ram_buffer.hpp"
+#include "SkrCore/log.h"
+#include "SkrCore/platform/vfs.h"
 
 namespace skr {
 namespace io {
@@ -26,6 +28,30 @@ void AllocateIOBufferResolver::resolve(SkrAsyncServicePriority priority, IOBatch
             }
         }
     }
+    // compressed blocks are read into staging memory and decoded into the buffer
+    auto pCompressed = io_component<CompressedBlocksComponent>(rq.get());
+    if (pCompressed && pCompressed->has_compressed_blocks())
+    {
+        uint64_t compressed_size = 0;
+        uint64_t uncompressed_size = 0;
+        for (const auto& block : pCompressed->blocks)
+        {
+            compressed_size += block.compressed_size;
+            uncompressed_size += block.uncompressed_size;
+        }
+        if (buf->get_size() == 0)
+        {
+            buf->size = uncompressed_size;
+        }
+        if (buf->get_size() < uncompressed_size)
+        {
+            SKR_LOG_ERROR(u8"IOBuffer: destination of %s holds %llu bytes, blocks decompress to %llu",
+                rq->get_path(), (unsigned long long)buf->get_size(), (unsigned long long)uncompressed_size);
+            io_component<IOStatusComponent>(rq.get())->setError(SKR_IO_ERROR_INVALID_REQUEST);
+            return;
+        }
+        pCompressed->allocate_staging(compressed_size);
+    }
     // allocate
     if (buf->get_data() == nullptr)
     {
@@ -35,6 +61,164 @@ void AllocateIOBufferResolver::resolve(SkrAsyncServicePriority priority, IOBatch
         }
         buf->allocate_buffer(buf->size);
     }
+    if (pCompressed)
+    {
+        pCompressed->destination = buf->get_data();
+    }
+}
+
+void ChunkedCompressionResolver::resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT
+{
+    auto pCompressed = io_component<CompressedBlocksComponent>(request.get());
+    if (!pCompressed || !pCompressed->has_compressed_blocks())
+        return;
+    bool chunked = false;
+    for (const auto& block : pCompressed->blocks)
+        chunked |= (block.compressed_size == 0);
+    if (!chunked)
+        return;
+
+    SkrZoneScopedN("IOChunkedCompression::ReadHeader");
+    auto pFile = io_component<FileComponent>(request.get());
+    auto reject = [&](const char8_t* reason) {
+        SKR_LOG_ERROR(u8"IOChunkedCompression: %s in %s", reason, request->get_path());
+        pCompressed->_reset_compressed_blocks();
+        io_component<IOStatusComponent>(request.get())->setError(SKR_IO_ERROR_INVALID_REQUEST);
+    };
+    if (!pFile || !pFile->file)
+    {
+        reject(u8"chunked containers are read through vfs, file is not open");
+        return;
+    }
+    const uint64_t fsize = pFile->get_fsize();
+    auto blocks = std::move(pCompressed->blocks);
+    pCompressed->_reset_compressed_blocks();
+    skr::Vector<uint32_t> sizes;
+    for (const auto& block : blocks)
+    {
+        if (block.compressed_size)
+        {
+            pCompressed->_add_compressed_block(block);
+            continue;
+        }
+        skr_io_chunked_header_t header = {};
+        if (skr_vfs_fread(pFile->file, &header, block.offset, sizeof(header)) != sizeof(header) || header.magic != SKR_IO_CHUNKED_MAGIC)
+        {
+            reject(u8"invalid chunked container");
+            return;
+        }
+        // the chunk count follows from the sizes, anything else is a corrupt or hostile header
+        const uint64_t expected_chunks = header.chunk_size ? (header.uncompressed_size + header.chunk_size - 1) / header.chunk_size : 0;
+        if (header.chunk_size == 0 || header.chunk_count > kMaxChunkCount || header.chunk_count != expected_chunks ||
+            (block.uncompressed_size && block.uncompressed_size != header.uncompressed_size))
+        {
+            reject(u8"inconsistent chunked header");
+            return;
+        }
+        const uint64_t table_size = sizeof(uint32_t) * header.chunk_count;
+        sizes.resize_unsafe(header.chunk_count);
+        if (skr_vfs_fread(pFile->file, sizes.data(), block.offset + sizeof(header), table_size) != table_size)
+        {
+            reject(u8"truncated chunk size table");
+            return;
+        }
+        const uint64_t data_offset = block.offset + sizeof(header) + table_size;
+        uint64_t data_size = 0;
+        for (uint32_t i = 0; i < header.chunk_count; ++i)
+            data_size += sizes[i] & ~SKR_IO_CHUNK_STORED_BIT;
+        if (data_offset + data_size > fsize)
+        {
+            reject(u8"chunk data exceeds the file");
+            return;
+        }
+
+        uint64_t offset = data_offset;
+        uint64_t remain = header.uncompressed_size;
+        for (uint32_t i = 0; i < header.chunk_count; ++i)
+        {
+            const bool stored = sizes[i] & SKR_IO_CHUNK_STORED_BIT;
+            const uint64_t size = sizes[i] & ~SKR_IO_CHUNK_STORED_BIT;
+            skr_io_compressed_block_t chunk = {};
+            chunk.offset = offset;
+            chunk.compressed_size = size;
+            chunk.uncompressed_size = std::min(remain, header.chunk_size);
+            chunk.decompress_method = stored ? kDecompressMethodStore : header.method;
+            if (stored && chunk.compressed_size != chunk.uncompressed_size)
+            {
+                reject(u8"stored chunk size mismatch");
+                return;
+            }
+            pCompressed->_add_compressed_block(chunk);
+            offset += size;
+            remain -= chunk.uncompressed_size;
+        }
+    }
+}
+
+VFSFileCacheResolver::~VFSFileCacheResolver() SKR_NOEXCEPT
+{
+    releaseCachedFiles();
+}
+
+void VFSFileCacheResolver::begin_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+    releaseCachedFiles();
+}
+
+void VFSFileCacheResolver::end_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT
+{
+    releaseCachedFiles();
+}
+
+void VFSFileCacheResolver::releaseCachedFiles() SKR_NOEXCEPT
+{
+    for (auto& cached : cached_files)
+    {
+        cached.shared->release();
+    }
+    cached_files.clear();
+}
+
+void VFSFileCacheResolver::resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT
+{
+    auto pPath = io_component<PathSrcComponent>(request.get());
+    auto pFile = io_component<FileComponent>(request.get());
+    if (!pPath || !pFile || pFile->dfile || pFile->file)
+        return;
+    SKR_ASSERT(pPath->get_vfs());
+
+    SharedVFile* shared = nullptr;
+    const auto vfs = pPath->get_vfs();
+    const auto path = pPath->get_path();
+    for (uint32_t i = 0; i < cached_files.size(); ++i)
+    {
+        auto& cached = cached_files[i];
+        if (cached.vfs == vfs && cached.path == path)
+        {
+            shared = cached.shared;
+            break;
+        }
+    }
+    if (!shared)
+    {
+        SkrZoneScopedN("VFSFileCache::Open");
+        auto file = skr_vfs_fopen(vfs, path, SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+        if (!file)
+            return;
+        if (cached_files.size() >= kMaxCachedFiles)
+        {
+            // drop the oldest entry, its requests keep the handle alive
+            cached_files[0].shared->release();
+            cached_files.remove_at(0);
+        }
+        shared = SkrNew<SharedVFile>();
+        shared->file = file;
+        skr_atomic_store_relaxed(&shared->refs, 1);
+        cached_files.add({ vfs, skr::String(path), shared });
+    }
+    skr_atomic_fetch_add_relaxed(&shared->refs, 1);
+    pFile->file = shared->file;
+    pFile->shared = shared;
 }
 
 ChunkingVFSReadResolver::ChunkingVFSReadResolver(uint64_t chunk_size) SKR_NOEXCEPT
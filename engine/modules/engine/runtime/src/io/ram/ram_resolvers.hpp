@@ -1,5 +1,7 @@
 #pragma once
 #include "../common/io_resolver.hpp"
+#include "../components/src_components.hpp"
+#include "SkrContainers/string.hpp"
 
 namespace skr {
 namespace io {
@@ -9,6 +11,39 @@ struct AllocateIOBufferResolver final : public IORequestResolverBase
     void resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT;
 };
 
+// expands add_compressed_block({}) into one compressed block per chunk of the container
+struct ChunkedCompressionResolver final : public IORequestResolverBase
+{
+    // upper bound of a size table read from disk, 4MB of sizes
+    static constexpr uint32_t kMaxChunkCount = 1u << 20;
+
+    void resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT;
+};
+
+// opens vfs files like VFSFileResolver, but requests of one batch reading the same file share a
+// single handle. shared handles are read by one thread at a time, CoalescingRAMReader reads every
+// request of such a file in one job
+struct VFSFileCacheResolver final : public IORequestResolverBase
+{
+    static constexpr uint32_t kMaxCachedFiles = 16;
+
+    ~VFSFileCacheResolver() SKR_NOEXCEPT;
+    void begin_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
+    void resolve(SkrAsyncServicePriority priority, IOBatchId batch, IORequestId request) SKR_NOEXCEPT;
+    void end_batch(SkrAsyncServicePriority priority, IOBatchId batch) SKR_NOEXCEPT;
+
+private:
+    void releaseCachedFiles() SKR_NOEXCEPT;
+
+    struct CachedFile {
+        skr_vfs_t*   vfs = nullptr;
+        skr::String  path;
+        SharedVFile* shared = nullptr;
+    };
+    // the cache holds a reference, so handles stay valid if requests are cancelled mid-batch
+    skr::Vector<CachedFile> cached_files;
+};
+
 struct ChunkingVFSReadResolver : public IORequestResolverBase
 {
     ChunkingVFSReadResolver(uint64_t chunk_size) SKR_NOEXCEPT;
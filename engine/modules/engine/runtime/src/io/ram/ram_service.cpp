@@ -6,6 +6,7 @@
 #include "ram_readers.hpp"
 #include "ram_batch.hpp"
 #include "ram_buffer.hpp"
+#include "../processors/decompressor.hpp"
 
 namespace skr::io {
 
@@ -28,6 +29,16 @@ inline static IOReaderId<IIOBatchProcessor> CreateBatchReader(RAMService* servic
 #endif
     return nullptr;
 }
+
+inline static IOReaderId<IIOBatchProcessor> CreateUringReader(RAMService* service, const skr_ram_io_service_desc_t* desc) SKR_NOEXCEPT
+{
+#ifdef __linux__
+    auto reader = skr::RC<UringRAMReader>::New(service);
+    if (reader->initialize())
+        return std::move(reader);
+#endif
+    return nullptr;
+}
 } // namespace RAMUtils
 
 uint32_t RAMService::global_idx = 0;
@@ -42,7 +53,11 @@ RAMService::RAMService(const skr_ram_io_service_desc_t* desc) SKR_NOEXCEPT
 
     if (desc->use_dstorage)
         runner.ds_reader = RAMUtils::CreateBatchReader(this, desc);
+    if (desc->use_io_uring && !runner.ds_reader)
+        runner.uring_reader = RAMUtils::CreateUringReader(this, desc);
     runner.vfs_reader = RAMUtils::CreateReader(this, desc);
+    runner.coalescing_reader = skr::RC<CoalescingRAMReader>::New(this, desc->io_job_queue);
+    runner.decompressor = skr::RC<TaskDecompressor>::New(&runner, desc->io_job_queue);
 
     runner.set_resolvers();
 
@@ -177,8 +192,9 @@ void RAMService::Runner::set_resolvers() SKR_NOEXCEPT
     auto chain = IIORequestResolverChain::Create().cast_static<IORequestResolverChain>();
     chain->runner = this;
 
+    // requests of a batch reading the same file share one handle and are read by coalescing_reader
     IORequestResolverId open_file = nullptr;
-    open_file = RC<VFSFileResolver>::New();
+    open_file = RC<VFSFileCacheResolver>::New();
 
     IORequestResolverId open_dfile = nullptr;
     const bool dstorage = ds_reader.get();
@@ -188,15 +204,19 @@ void RAMService::Runner::set_resolvers() SKR_NOEXCEPT
         chain->then(open_dfile);
     }
 
+    auto read_chunked = RC<ChunkedCompressionResolver>::New();
     chain->then(open_file)
+        ->then(read_chunked)
         ->then(alloc_buffer);
         
     batch_buffer = RC<IOBatchBuffer>::New(); // hold batches
 
-    batch_processors = { batch_buffer, chain };
+    batch_processors = { batch_buffer, chain, coalescing_reader };
     if (dstorage)
         batch_processors.push_back(ds_reader);
-    request_processors = { vfs_reader };
+    if (uring_reader)
+        batch_processors.push_back(uring_reader);
+    request_processors = { vfs_reader, decompressor };
 }
 
 } // namespace skr::io
\ No newline at end of file
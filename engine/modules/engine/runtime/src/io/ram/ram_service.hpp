@@ -37,7 +37,10 @@ struct RAMService final : public IRAMService
 
         IOBatchBufferId batch_buffer = nullptr;
         IOReaderId<IIORequestProcessor> vfs_reader = nullptr;
+        IOReaderId<IIOBatchProcessor> coalescing_reader = nullptr;
         IOReaderId<IIOBatchProcessor> ds_reader = nullptr;
+        IOReaderId<IIOBatchProcessor> uring_reader = nullptr;
+        IODecompressorId<IIORequestProcessor> decompressor = nullptr;
         RAMService* service = nullptr;
     };
     const skr::String name;
@@ -0,0 +1,183 @@
+#include "uring_queue.hpp"
+
+#ifdef __linux__
+    #include "SkrCore/log.h"
+    #include <string.h>
+    #include <errno.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+
+namespace skr
+{
+namespace io
+{
+
+static int uring_setup(uint32_t entries, io_uring_params* params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+static int uring_register(int fd, uint32_t opcode, void* arg, uint32_t nr_args)
+{
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static bool uring_supports_read(int fd)
+{
+    struct alignas(io_uring_probe) ProbeStorage {
+        uint8_t bytes[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)];
+    } storage = {};
+    auto probe = reinterpret_cast<io_uring_probe*>(&storage);
+    if (uring_register(fd, IORING_REGISTER_PROBE, probe, 256) < 0)
+        return false;
+    return (probe->last_op >= IORING_OP_READ) && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+}
+
+bool UringQueue::initialize(uint32_t entries) SKR_NOEXCEPT
+{
+    SKR_ASSERT(!is_valid());
+    io_uring_params params = {};
+    const int fd = uring_setup(entries, &params);
+    if (fd < 0)
+    {
+        SKR_LOG_INFO(u8"io_uring is not available (error: %s)", strerror(errno));
+        return false;
+    }
+    ring_fd    = fd;
+    sq_entries = params.sq_entries;
+    if (!uring_supports_read(fd))
+    {
+        SKR_LOG_INFO(u8"io_uring does not support IORING_OP_READ");
+        shutdown();
+        return false;
+    }
+
+    sq_size   = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_size   = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+        sq_size = cq_size = (sq_size > cq_size) ? sq_size : cq_size;
+
+    sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED)
+    {
+        sq_ptr = nullptr;
+        shutdown();
+        return false;
+    }
+    if (single_mmap)
+    {
+        cq_ptr = sq_ptr;
+    }
+    else
+    {
+        cq_ptr = mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED)
+        {
+            cq_ptr = nullptr;
+            shutdown();
+            return false;
+        }
+    }
+    auto sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes_ptr == MAP_FAILED)
+    {
+        shutdown();
+        return false;
+    }
+
+    auto sq_base = (uint8_t*)sq_ptr;
+    sq_head      = (uint32_t*)(sq_base + params.sq_off.head);
+    sq_tail      = (uint32_t*)(sq_base + params.sq_off.tail);
+    sq_mask      = (uint32_t*)(sq_base + params.sq_off.ring_mask);
+    sq_array     = (uint32_t*)(sq_base + params.sq_off.array);
+    sqes         = (io_uring_sqe*)sqes_ptr;
+
+    auto cq_base = (uint8_t*)cq_ptr;
+    cq_head      = (uint32_t*)(cq_base + params.cq_off.head);
+    cq_tail      = (uint32_t*)(cq_base + params.cq_off.tail);
+    cq_mask      = (uint32_t*)(cq_base + params.cq_off.ring_mask);
+    cqes         = (io_uring_cqe*)(cq_base + params.cq_off.cqes);
+    return true;
+}
+
+void UringQueue::shutdown() SKR_NOEXCEPT
+{
+    if (sqes)
+        munmap(sqes, sqes_size);
+    if (cq_ptr && cq_ptr != sq_ptr)
+        munmap(cq_ptr, cq_size);
+    if (sq_ptr)
+        munmap(sq_ptr, sq_size);
+    if (ring_fd >= 0)
+        close(ring_fd);
+    ring_fd    = -1;
+    sq_entries = to_submit = in_flight = 0;
+    sq_head = sq_tail = sq_mask = sq_array = nullptr;
+    cq_head = cq_tail = cq_mask = nullptr;
+    sqes    = nullptr;
+    cqes    = nullptr;
+    sq_ptr = cq_ptr = nullptr;
+}
+
+bool UringQueue::prepare_read(int fd, void* dst, uint32_t size, uint64_t offset, uint64_t user_data) SKR_NOEXCEPT
+{
+    // completions are bounded by the sq size, so the cq (twice as large) never overflows
+    if (in_flight + to_submit >= sq_entries)
+        return false;
+    const uint32_t tail = *sq_tail;
+    const uint32_t head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= sq_entries)
+        return false;
+
+    const uint32_t index = tail & *sq_mask;
+    io_uring_sqe&  sqe   = sqes[index];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode    = IORING_OP_READ;
+    sqe.fd        = fd;
+    sqe.addr      = (uint64_t)dst;
+    sqe.len       = size;
+    sqe.off       = offset;
+    sqe.user_data = user_data;
+    sq_array[index] = index;
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    to_submit += 1;
+    return true;
+}
+
+uint32_t UringQueue::submit() SKR_NOEXCEPT
+{
+    if (to_submit)
+    {
+        const int submitted = uring_enter(ring_fd, to_submit, 0, 0);
+        if (submitted > 0)
+        {
+            to_submit -= (uint32_t)submitted;
+            in_flight += (uint32_t)submitted;
+        }
+        else if (submitted < 0 && errno != EAGAIN && errno != EBUSY && errno != EINTR)
+        {
+            SKR_LOG_ERROR(u8"io_uring_enter failed (error: %s)", strerror(errno));
+        }
+    }
+    return to_submit;
+}
+
+void UringQueue::wait(uint32_t min_complete) SKR_NOEXCEPT
+{
+    if (min_complete > in_flight)
+        min_complete = in_flight;
+    if (min_complete)
+        uring_enter(ring_fd, 0, min_complete, IORING_ENTER_GETEVENTS);
+}
+
+} // namespace io
+} // namespace skr
+#endif
@@ -0,0 +1,77 @@
+#pragma once
+#include "SkrBase/config.h"
+
+#ifdef __linux__
+    #include <linux/io_uring.h>
+
+namespace skr
+{
+namespace io
+{
+
+// minimal io_uring ring driven through raw syscalls, owned by a single thread (the io runner):
+// sqes are prepared and submitted, then completions are polled without blocking
+struct UringQueue {
+    UringQueue() SKR_NOEXCEPT = default;
+    ~UringQueue() SKR_NOEXCEPT { shutdown(); }
+    UringQueue(const UringQueue&)            = delete;
+    UringQueue& operator=(const UringQueue&) = delete;
+
+    // fails when the kernel does not offer io_uring or IORING_OP_READ (e.g. < 5.6 or blocked by seccomp)
+    bool initialize(uint32_t entries) SKR_NOEXCEPT;
+    void shutdown() SKR_NOEXCEPT;
+    bool is_valid() const SKR_NOEXCEPT { return ring_fd >= 0; }
+
+    // returns false when the submission queue is full
+    bool prepare_read(int fd, void* dst, uint32_t size, uint64_t offset, uint64_t user_data) SKR_NOEXCEPT;
+    // hands every prepared sqe to the kernel, returns the number of sqes still waiting
+    uint32_t submit() SKR_NOEXCEPT;
+    // blocks until at least min_complete in-flight reads are completed
+    void wait(uint32_t min_complete) SKR_NOEXCEPT;
+
+    // f(uint64_t user_data, int32_t result) for every available completion, returns the count
+    template <typename F>
+    uint32_t poll_completions(F&& f) SKR_NOEXCEPT
+    {
+        uint32_t       head  = *cq_head;
+        const uint32_t tail  = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+        uint32_t       count = 0;
+        for (; head != tail; ++head, ++count)
+        {
+            const io_uring_cqe& cqe = cqes[head & *cq_mask];
+            f((uint64_t)cqe.user_data, (int32_t)cqe.res);
+        }
+        __atomic_store_n(cq_head, head, __ATOMIC_RELEASE);
+        in_flight -= count;
+        return count;
+    }
+
+    uint32_t get_in_flight() const SKR_NOEXCEPT { return in_flight; }
+
+private:
+    int            ring_fd    = -1;
+    uint32_t       sq_entries = 0;
+    uint32_t       to_submit  = 0;
+    uint32_t       in_flight  = 0;
+    // sq ring
+    uint32_t*      sq_head  = nullptr;
+    uint32_t*      sq_tail  = nullptr;
+    uint32_t*      sq_mask  = nullptr;
+    uint32_t*      sq_array = nullptr;
+    io_uring_sqe*  sqes     = nullptr;
+    // cq ring
+    uint32_t*      cq_head = nullptr;
+    uint32_t*      cq_tail = nullptr;
+    uint32_t*      cq_mask = nullptr;
+    io_uring_cqe*  cqes    = nullptr;
+    // mappings
+    void*          sq_ptr    = nullptr;
+    void*          cq_ptr    = nullptr;
+    uint64_t       sq_size   = 0;
+    uint64_t       cq_size   = 0;
+    uint64_t       sqes_size = 0;
+};
+
+} // namespace io
+} // namespace skr
+#endif
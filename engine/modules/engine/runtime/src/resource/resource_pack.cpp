@@ -0,0 +1,388 @@
+#include "SkrBase/misc/defer.hpp"
+#include "SkrCore/log.hpp"
+#include "SkrCore/platform/vfs.h"
+#include "SkrRT/resource/resource_pack.hpp"
+#include "SkrContainersDef/path.hpp"
+#include "SkrSerde/bin_serde.hpp"
+
+namespace skr
+{
+namespace
+{
+inline uint64_t SplitMix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+inline uint32_t PackBucketOf(uint64_t hash, uint32_t bucket_bits)
+{
+    return bucket_bits ? (uint32_t)(hash >> (64 - bucket_bits)) : 0u;
+}
+
+inline bool PackGuidLess(const skr_guid_t& a, const skr_guid_t& b)
+{
+    if (a.storage0 != b.storage0) return a.storage0 < b.storage0;
+    if (a.storage1 != b.storage1) return a.storage1 < b.storage1;
+    if (a.storage2 != b.storage2) return a.storage2 < b.storage2;
+    return a.storage3 < b.storage3;
+}
+
+inline bool PackGuidEqual(const skr_guid_t& a, const skr_guid_t& b)
+{
+    return a.storage0 == b.storage0 && a.storage1 == b.storage1 && a.storage2 == b.storage2 && a.storage3 == b.storage3;
+}
+
+inline uint64_t PackAlign(uint64_t v, uint64_t alignment)
+{
+    return (v + alignment - 1) & ~(alignment - 1);
+}
+
+struct PackLayout {
+    uint64_t buckets_offset;
+    uint64_t entries_offset;
+    uint64_t dependencies_offset;
+    uint64_t toc_size;
+};
+
+inline PackLayout PackLayoutOf(uint32_t entry_count, uint32_t bucket_bits, uint32_t dependency_count)
+{
+    PackLayout layout;
+    layout.buckets_offset      = sizeof(SResourcePackHeader);
+    layout.entries_offset      = PackAlign(layout.buckets_offset + ((1ull << bucket_bits) + 1) * sizeof(uint32_t), 16);
+    layout.dependencies_offset = layout.entries_offset + (uint64_t)entry_count * sizeof(SResourcePackEntry);
+    layout.toc_size            = layout.dependencies_offset + (uint64_t)dependency_count * sizeof(skr_guid_t);
+    return layout;
+}
+
+// checks the table of contents against itself and the pack file, so lookups and reads stay inside both
+const char8_t* ValidatePackToc(const SResourcePackHeader& header, const uint32_t* buckets, const SResourcePackEntry* entries, uint64_t file_size)
+{
+    const uint32_t bucket_count = 1u << header.bucket_bits;
+    if (buckets[0] != 0 || buckets[bucket_count] != header.entry_count)
+        return u8"bucket table does not cover the entries";
+    for (uint32_t b = 0; b < bucket_count; ++b)
+    {
+        if (buckets[b] > buckets[b + 1])
+            return u8"bucket table is not sorted";
+        for (uint32_t i = buckets[b]; i < buckets[b + 1]; ++i)
+        {
+            const auto& entry = entries[i];
+            if (PackBucketOf(ResourcePackHash(entry.guid), header.bucket_bits) != b)
+                return u8"entry is stored in the wrong bucket";
+            if (i > buckets[b] && !PackGuidLess(entries[i - 1].guid, entry.guid))
+                return u8"bucket entries are not sorted";
+            if ((uint64_t)entry.dependency_offset + entry.dependency_count > header.dependency_count)
+                return u8"entry dependencies are out of range";
+            if (entry.data_size && (entry.data_offset < header.toc_size || entry.data_offset > file_size || entry.data_size > file_size - entry.data_offset))
+                return u8"entry data is out of the pack file";
+        }
+    }
+    return nullptr;
+}
+
+bool ReadLooseHeader(skr_vfs_t* vfs, const skr::String& path, SResourceHeader& header)
+{
+    auto file = skr_vfs_fopen(vfs, path.c_str(), SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+    if (!file) return false;
+    SKR_DEFER({ skr_vfs_fclose(file); });
+    const auto size = (uint64_t)skr_vfs_fsize(file);
+    skr::Vector<uint8_t> buffer;
+    buffer.resize_unsafe(size);
+    if (skr_vfs_fread(file, buffer.data(), 0, size) != size)
+        return false;
+    skr::archive::BinSpanReader reader = { buffer, 0 };
+    SBinaryReader               archive{ reader };
+    return bin_read(&archive, header);
+}
+} // namespace
+
+uint64_t ResourcePackHash(const skr_guid_t& guid)
+{
+    const uint64_t lo = ((uint64_t)guid.storage0 << 32) | guid.storage1;
+    const uint64_t hi = ((uint64_t)guid.storage2 << 32) | guid.storage3;
+    return SplitMix64(lo ^ SplitMix64(hi));
+}
+
+// builder
+
+void ResourcePackBuilder::Add(const SResourceHeader& header, skr::span<const uint8_t> data)
+{
+    auto& item = items.add_default().ref();
+    item.guid = header.guid;
+    item.type = header.type;
+    item.version = header.version;
+    for (const auto& dep : header.dependencies)
+        item.dependencies.add(dep.get_serialized());
+    item.data.append(data.data(), data.size());
+    item.data_size = data.size();
+}
+
+bool ResourcePackBuilder::AddLooseResource(skr_vfs_t* vfs, skr_guid_t guid)
+{
+    SResourceHeader header;
+    const auto headerPath = skr::format(u8"{}.rh", guid);
+    if (!ReadLooseHeader(vfs, headerPath, header))
+    {
+        SKR_LOG_FMT_ERROR(u8"[ResourcePackBuilder] failed to read resource header! guid: {}", guid);
+        return false;
+    }
+    skr::Path resourcePath{ headerPath };
+    resourcePath.replace_extension(u8".bin");
+    auto data = skr_vfs_fopen(vfs, resourcePath.string().c_str(), SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+    if (!data)
+    {
+        SKR_LOG_FMT_ERROR(u8"[ResourcePackBuilder] failed to open resource data! guid: {}", guid);
+        return false;
+    }
+    const auto size = (uint64_t)skr_vfs_fsize(data);
+    skr_vfs_fclose(data);
+
+    auto& item = items.add_default().ref();
+    item.guid = header.guid;
+    item.type = header.type;
+    item.version = header.version;
+    for (const auto& dep : header.dependencies)
+        item.dependencies.add(dep.get_serialized());
+    item.source_vfs = vfs;
+    item.source_path = resourcePath.string();
+    item.data_size = size;
+    return true;
+}
+
+bool ResourcePackBuilder::Write(skr_vfs_t* vfs, const char8_t* path) const
+{
+    const auto entry_count = (uint32_t)items.size();
+    uint32_t bucket_bits = 0;
+    while (bucket_bits < 24 && (1u << bucket_bits) < entry_count)
+        ++bucket_bits;
+    uint32_t dependency_count = 0;
+    for (const auto& item : items)
+        dependency_count += (uint32_t)item.dependencies.size();
+    const auto layout = PackLayoutOf(entry_count, bucket_bits, dependency_count);
+
+    // order items by (bucket, guid)
+    skr::Vector<uint32_t> order;
+    order.reserve(entry_count);
+    for (uint32_t i = 0; i < entry_count; ++i)
+        order.add(i);
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        const auto ba = PackBucketOf(ResourcePackHash(items[a].guid), bucket_bits);
+        const auto bb = PackBucketOf(ResourcePackHash(items[b].guid), bucket_bits);
+        if (ba != bb) return ba < bb;
+        return PackGuidLess(items[a].guid, items[b].guid);
+    });
+    for (uint32_t i = 1; i < entry_count; ++i)
+    {
+        if (PackGuidEqual(items[order[i - 1]].guid, items[order[i]].guid))
+        {
+            SKR_LOG_FMT_ERROR(u8"[ResourcePackBuilder] duplicated resource in pack! guid: {}", items[order[i]].guid);
+            return false;
+        }
+    }
+
+    skr::Vector<uint8_t> toc;
+    toc.resize_zeroed(layout.toc_size);
+    auto header = (SResourcePackHeader*)toc.data();
+    header->magic = SKR_RESOURCE_PACK_MAGIC;
+    header->version = SKR_RESOURCE_PACK_VERSION;
+    header->entry_count = entry_count;
+    header->bucket_bits = bucket_bits;
+    header->dependency_count = dependency_count;
+    header->toc_size = layout.toc_size;
+    auto buckets = (uint32_t*)(toc.data() + layout.buckets_offset);
+    auto entries = (SResourcePackEntry*)(toc.data() + layout.entries_offset);
+    auto dependencies = (skr_guid_t*)(toc.data() + layout.dependencies_offset);
+
+    uint64_t data_offset = PackAlign(layout.toc_size, SKR_RESOURCE_PACK_DATA_ALIGNMENT);
+    uint32_t dependency_offset = 0;
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        const auto& item = items[order[i]];
+        auto& entry = entries[i];
+        entry.guid = item.guid;
+        entry.type = item.type;
+        entry.version = item.version;
+        entry.dependency_offset = dependency_offset;
+        entry.dependency_count = (uint32_t)item.dependencies.size();
+        entry.data_offset = data_offset;
+        entry.data_size = item.data_size;
+        for (const auto& dep : item.dependencies)
+            dependencies[dependency_offset++] = dep;
+        data_offset = PackAlign(data_offset + item.data_size, SKR_RESOURCE_PACK_DATA_ALIGNMENT);
+        buckets[PackBucketOf(ResourcePackHash(item.guid), bucket_bits) + 1] += 1;
+    }
+    for (uint32_t b = 0; b < (1u << bucket_bits); ++b)
+        buckets[b + 1] += buckets[b];
+
+    auto file = skr_vfs_fopen(vfs, path, SKR_FM_WRITE_BINARY, SKR_FILE_CREATION_ALWAYS_NEW);
+    if (!file)
+        return false;
+    SKR_DEFER({ skr_vfs_fclose(file); });
+    if (skr_vfs_fwrite(file, toc.data(), 0, toc.size()) != toc.size())
+        return false;
+    skr::Vector<uint8_t> copy_buffer;
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+        const auto& item = items[order[i]];
+        const auto& entry = entries[i];
+        if (!item.source_path.is_empty())
+        {
+            auto source = skr_vfs_fopen(item.source_vfs, item.source_path.c_str(), SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+            if (!source)
+                return false;
+            SKR_DEFER({ skr_vfs_fclose(source); });
+            constexpr uint64_t kCopyChunk = 1024 * 1024;
+            copy_buffer.resize_unsafe(std::min(kCopyChunk, item.data_size));
+            for (uint64_t copied = 0; copied < item.data_size;)
+            {
+                const auto n = std::min(kCopyChunk, item.data_size - copied);
+                if (skr_vfs_fread(source, copy_buffer.data(), copied, n) != n)
+                    return false;
+                if (skr_vfs_fwrite(file, copy_buffer.data(), entry.data_offset + copied, n) != n)
+                    return false;
+                copied += n;
+            }
+        }
+        else if (item.data_size)
+        {
+            if (skr_vfs_fwrite(file, item.data.data(), entry.data_offset, item.data_size) != item.data_size)
+                return false;
+        }
+    }
+    return true;
+}
+
+// registry
+
+PackResourceRegistry::PackResourceRegistry(skr_vfs_t* vfs, ResourceRegistry* fallback)
+    : vfs(vfs)
+    , fallback(fallback)
+{
+}
+
+PackResourceRegistry::~PackResourceRegistry()
+{
+    UnmountAll();
+}
+
+bool PackResourceRegistry::Mount(const char8_t* path)
+{
+    auto file = skr_vfs_fopen(vfs, path, SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
+    if (!file)
+    {
+        SKR_LOG_FMT_ERROR(u8"[PackResourceRegistry] failed to open resource pack {}!", path);
+        return false;
+    }
+    SKR_DEFER({ skr_vfs_fclose(file); });
+    SResourcePackHeader header = {};
+    if (skr_vfs_fread(file, &header, 0, sizeof(header)) != sizeof(header) ||
+        header.magic != SKR_RESOURCE_PACK_MAGIC || header.version != SKR_RESOURCE_PACK_VERSION || header.bucket_bits > 24)
+    {
+        SKR_LOG_FMT_ERROR(u8"[PackResourceRegistry] {} is not a valid resource pack!", path);
+        return false;
+    }
+    const auto file_size = (uint64_t)skr_vfs_fsize(file);
+    const auto layout = PackLayoutOf(header.entry_count, header.bucket_bits, header.dependency_count);
+    if (layout.toc_size != header.toc_size || layout.toc_size > file_size)
+    {
+        SKR_LOG_FMT_ERROR(u8"[PackResourceRegistry] corrupted table of contents in {}!", path);
+        return false;
+    }
+
+    Pack pack;
+    pack.path = path;
+    pack.toc = (uint8_t*)sakura_malloc_aligned(layout.toc_size, alignof(SResourcePackEntry));
+    if (skr_vfs_fread(file, pack.toc, 0, layout.toc_size) != layout.toc_size)
+    {
+        sakura_free_aligned(pack.toc, alignof(SResourcePackEntry));
+        SKR_LOG_FMT_ERROR(u8"[PackResourceRegistry] failed to read table of contents of {}!", path);
+        return false;
+    }
+    pack.header = (const SResourcePackHeader*)pack.toc;
+    pack.buckets = (const uint32_t*)(pack.toc + layout.buckets_offset);
+    pack.entries = (const SResourcePackEntry*)(pack.toc + layout.entries_offset);
+    pack.dependencies = (const skr_guid_t*)(pack.toc + layout.dependencies_offset);
+    if (auto error = ValidatePackToc(*pack.header, pack.buckets, pack.entries, file_size))
+    {
+        sakura_free_aligned(pack.toc, alignof(SResourcePackEntry));
+        SKR_LOG_FMT_ERROR(u8"[PackResourceRegistry] corrupted table of contents in {}: {}!", path, error);
+        return false;
+    }
+    packs.add(std::move(pack));
+    return true;
+}
+
+void PackResourceRegistry::UnmountAll()
+{
+    for (auto& pack : packs)
+        sakura_free_aligned(pack.toc, alignof(SResourcePackEntry));
+    packs.clear();
+}
+
+const SResourcePackEntry* PackResourceRegistry::Find(const skr_guid_t& guid, const Pack** outPack) const
+{
+    const auto hash = ResourcePackHash(guid);
+    for (uint64_t i = packs.size(); i > 0; --i)
+    {
+        const auto& pack = packs[i - 1];
+        const auto bucket = PackBucketOf(hash, pack.header->bucket_bits);
+        const auto begin = pack.entries + pack.buckets[bucket];
+        const auto end = pack.entries + pack.buckets[bucket + 1];
+        const auto found = std::lower_bound(begin, end, guid, [](const SResourcePackEntry& e, const skr_guid_t& g) {
+            return PackGuidLess(e.guid, g);
+        });
+        if (found != end && PackGuidEqual(found->guid, guid))
+        {
+            *outPack = &pack;
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+void PackResourceRegistry::FillHeader(const Pack& pack, const SResourcePackEntry& entry, SResourceHeader& header) const
+{
+    header.guid = entry.guid;
+    header.type = entry.type;
+    header.version = entry.version;
+    header.dependencies.clear();
+    header.dependencies.reserve(entry.dependency_count);
+    for (uint32_t i = 0; i < entry.dependency_count; ++i)
+        header.dependencies.add(SResourceHandle(pack.dependencies[entry.dependency_offset + i]));
+}
+
+bool PackResourceRegistry::FindHeader(skr_guid_t guid, SResourceHeader& header) const
+{
+    const Pack* pack = nullptr;
+    if (auto entry = Find(guid, &pack))
+    {
+        FillHeader(*pack, *entry, header);
+        return true;
+    }
+    return false;
+}
+
+bool PackResourceRegistry::RequestResourceFile(ResourceRequest* request)
+{
+    const auto guid = request->GetGuid();
+    const Pack* pack = nullptr;
+    auto entry = Find(guid, &pack);
+    if (!entry)
+        return fallback ? fallback->RequestResourceFile(request) : false;
+
+    SResourceHeader header;
+    FillHeader(*pack, *entry, header);
+    FillRequest(request, header, vfs, pack->path.c_str(), entry->data_offset, entry->data_size);
+    request->OnRequestFileFinished();
+    return true;
+}
+
+void PackResourceRegistry::CancelRequestFile(ResourceRequest* requst)
+{
+    if (fallback)
+        fallback->CancelRequestFile(requst);
+}
+} // namespace skr
@@ -196,7 +196,16 @@ void SResourceRequestImpl::_LoadDependencies()
     dependenciesLoaded = true;
     auto& dependencies = resourceRecord->header.dependencies;
     for (auto& dep : dependencies)
+    {
         dep.resolve(true, resourceRecord->id, SKR_REQUESTER_DEPENDENCY);
+        // dependencies inherit the io priority of their dependent and sit one level deeper
+        auto depRequest = static_cast<SResourceRequestImpl*>(dep.get_record()->activeRequest);
+        if (depRequest && depRequest != this)
+        {
+            depRequest->depth = std::max(depRequest->depth, depth + 1);
+            depRequest->RequestPriority(ioPriority);
+        }
+    }
 }
 
 void SResourceRequestImpl::_UnloadDependencies()
@@ -271,15 +280,22 @@ void SResourceRequestImpl::Update()
         break;
     case SKR_LOADING_PHASE_IO:
         resourceRecord->SetStatus(SKR_LOADING_STATUS_LOADING);
-        if (factory->AsyncIO())
+        if (resourceSize == 0)
+        {
+            // empty entry of a pack, there is nothing to read and a zero sized block would read to the end of the file
+            dataBlob = skr::IBlob::Create(nullptr, 0, false);
+            currentPhase = SKR_LOADING_PHASE_DESER_RESOURCE;
+        }
+        else if (factory->AsyncIO())
         {
             {
                 auto rq = ioService->open_request();
                 rq->set_vfs(vfs);
                 rq->set_path(resourceUrl.c_str());
-                rq->add_block({}); // read all
+                // a block of size 0 reads to the end of the file
+                rq->add_block({ resourceOffset, resourceSize == ResourceRegistry::kReadToEnd ? 0 : resourceSize });
                 SKR_ASSERT(dataFuture.status == 0);
-                dataBlob = ioService->request(rq, &dataFuture);
+                dataBlob = ioService->request(rq, &dataFuture, GetIOPriority());
             }
 #ifdef SKR_RESOURCE_DEV_MODE
             if (!artifactsUrl.is_empty())
@@ -289,7 +305,7 @@ void SResourceRequestImpl::Update()
                 rq->set_path(artifactsUrl.c_str());
                 rq->add_block({}); // read all
                 SKR_ASSERT(artifactsFuture.status == 0);
-                artifactsBlob = ioService->request(rq, &artifactsFuture);
+                artifactsBlob = ioService->request(rq, &artifactsFuture, GetIOPriority());
             }
 #endif
             currentPhase = SKR_LOADING_PHASE_WAITFOR_IO;
@@ -299,9 +315,9 @@ void SResourceRequestImpl::Update()
             {
                 auto file = skr_vfs_fopen(vfs, (const char8_t*)resourceUrl.c_str(), SKR_FM_READ_BINARY, SKR_FILE_CREATION_OPEN_EXISTING);
                 SKR_DEFER({ skr_vfs_fclose(file); });
-                auto fsize = skr_vfs_fsize(file);
+                auto fsize = resourceSize != ResourceRegistry::kReadToEnd ? resourceSize : skr_vfs_fsize(file) - resourceOffset;
                 dataBlob = skr::IBlob::Create(nullptr, fsize, false);
-                skr_vfs_fread(file, dataBlob->get_data(), 0, fsize);
+                skr_vfs_fread(file, dataBlob->get_data(), resourceOffset, fsize);
             }
 #ifdef SKR_RESOURCE_DEV_MODE
             if (!artifactsUrl.is_empty())
@@ -548,7 +564,7 @@ bool SResourceRequestImpl::Yielded()
     }
 }
 
-void ResourceRegistry::FillRequest(ResourceRequest* r, SResourceHeader header, skr_vfs_t* vfs, const char8_t* uri)
+void ResourceRegistry::FillRequest(ResourceRequest* r, SResourceHeader header, skr_vfs_t* vfs, const char8_t* uri, uint64_t offset, uint64_t size)
 {
     auto request = static_cast<SResourceRequestImpl*>(r);
     if (request)
@@ -558,6 +574,8 @@ void ResourceRegistry::FillRequest(ResourceRequest* r, SResourceHeader header, s
         request->resourceRecord->header.dependencies = header.dependencies;
         request->vfs = vfs;
         request->resourceUrl = uri;
+        request->resourceOffset = offset;
+        request->resourceSize = size;
     }
 }
 
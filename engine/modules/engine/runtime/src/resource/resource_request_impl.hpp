@@ -53,6 +53,19 @@ protected:
     skr_io_future_t dataFuture;
     skr::BlobId dataBlob;
     skr::String resourceUrl;
+    // sub-range of resourceUrl holding the data, ResourceRegistry::kReadToEnd reads to the end of the file
+    uint64_t resourceOffset = 0;
+    uint64_t resourceSize = ResourceRegistry::kReadToEnd;
+    // distance to the root of the load, deeper requests are updated first so they are read and
+    // installed before their dependents
+    uint32_t depth = 0;
+    // COUNT until a load sets it: the first caller picks the priority, later ones can only raise it
+    SkrAsyncServicePriority ioPriority = SKR_ASYNC_SERVICE_PRIORITY_COUNT;
+    void RequestPriority(SkrAsyncServicePriority priority) { ioPriority = std::min(ioPriority, priority); }
+    SkrAsyncServicePriority GetIOPriority() const
+    {
+        return ioPriority == SKR_ASYNC_SERVICE_PRIORITY_COUNT ? SKR_ASYNC_SERVICE_PRIORITY_NORMAL : ioPriority;
+    }
 #ifdef SKR_RESOURCE_DEV_MODE
     skr_io_future_t artifactsFuture;
     skr::BlobId artifactsBlob;
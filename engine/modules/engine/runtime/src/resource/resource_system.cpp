@@ -26,6 +26,10 @@ public:
     void Quit() final override;
 
     void LoadResource(SResourceHandle& handle, bool requireInstalled, uint64_t requester, ESkrRequesterType) final override;
+    // priority COUNT leaves the io priority of the request unset, e.g. for dependencies which
+    // inherit it from their dependent
+    void _LoadResource(SResourceHandle& handle, bool requireInstalled, uint64_t requester, ESkrRequesterType, SkrAsyncServicePriority priority);
+    void LoadResources(skr::span<SResourceHandle> handles, bool requireInstalled, uint64_t requester, ESkrRequesterType, SkrAsyncServicePriority priority) final override;
     void UnloadResource(SResourceHandle& handle) final override;
     void _UnloadResource(SResourceRecord* record);
     void FlushResource(SResourceHandle& handle) final override;
@@ -45,6 +49,7 @@ protected:
     void _DestroyRecord(SResourceRecord* record) final override;
     void _UpdateAsyncSerde();
     void _ClearFinishedRequests();
+    void _DequeueRequests();
 
     ResourceRegistry* resourceRegistry = nullptr;
     skr::io::IRAMService* ioService = nullptr;
@@ -90,7 +95,7 @@ SResourceRecord* ResourceSystemImpl::_GetOrCreateRecord(const skr_guid_t& guid)
     if (!record)
     {
         record = SkrNew<SResourceRecord>();
-        resourceIds.new_entities(&record->id, 1);
+        resourceIds.new_entities_concurrent(&record->id, 1);
         record->header.guid = guid;
         // record->header.type = type;
         resourceRecords.insert(std::make_pair(guid, record));
@@ -112,14 +117,17 @@ SResourceRecord* ResourceSystemImpl::_GetRecord(void* resource)
 
 void ResourceSystemImpl::_DestroyRecord(SResourceRecord* record)
 {
-    SMutexLock Lock(recordMutex.mMutex);
-    auto request = static_cast<SResourceRequestImpl*>(record->activeRequest);
-    if (request)
-        request->resourceRecord = nullptr;
-    resourceRecords.erase(record->header.guid);
-    if (record->resource)
-        resourceToRecord.erase(record->resource);
-    resourceIds.free_entities(&record->id, 1);
+    {
+        SMutexLock Lock(recordMutex.mMutex);
+        auto request = static_cast<SResourceRequestImpl*>(record->activeRequest);
+        if (request)
+            request->resourceRecord = nullptr;
+        resourceRecords.erase(record->header.guid);
+        if (record->resource)
+            resourceToRecord.erase(record->resource);
+    }
+    // ids are recycled through the registry's thread caches, no need to hold recordMutex
+    resourceIds.free_entities_concurrent(&record->id, 1);
     SkrDelete(record);
 }
 
@@ -156,6 +164,12 @@ void ResourceSystemImpl::UnregisterFactory(skr_guid_t type)
 }
 
 void ResourceSystemImpl::LoadResource(SResourceHandle& handle, bool requireInstalled, uint64_t requester, ESkrRequesterType requesterType)
+{
+    const auto priority = requesterType == SKR_REQUESTER_DEPENDENCY ? SKR_ASYNC_SERVICE_PRIORITY_COUNT : SKR_ASYNC_SERVICE_PRIORITY_NORMAL;
+    _LoadResource(handle, requireInstalled, requester, requesterType, priority);
+}
+
+void ResourceSystemImpl::_LoadResource(SResourceHandle& handle, bool requireInstalled, uint64_t requester, ESkrRequesterType requesterType, SkrAsyncServicePriority priority)
 {
     SKR_ASSERT(!quit);
     SKR_ASSERT(!handle.is_resolved());
@@ -171,6 +185,7 @@ void ResourceSystemImpl::LoadResource(SResourceHandle& handle, bool requireInsta
     {
         request->requireLoading = true;
         request->requestInstall = requireInstalled;
+        request->RequestPriority(priority);
     }
     else
     {
@@ -182,6 +197,7 @@ void ResourceSystemImpl::LoadResource(SResourceHandle& handle, bool requireInsta
         request->currentPhase = SKR_LOADING_PHASE_REQUEST_RESOURCE;
         request->factory = nullptr;
         request->vfs = nullptr;
+        request->RequestPriority(priority);
         record->activeRequest = request;
         record->loadingStatus = SKR_LOADING_STATUS_LOADING;
         counter.add(1);
@@ -189,6 +205,12 @@ void ResourceSystemImpl::LoadResource(SResourceHandle& handle, bool requireInsta
     }
 }
 
+void ResourceSystemImpl::LoadResources(skr::span<SResourceHandle> handles, bool requireInstalled, uint64_t requester, ESkrRequesterType requesterType, SkrAsyncServicePriority priority)
+{
+    for (auto& handle : handles)
+        _LoadResource(handle, requireInstalled, requester, requesterType, priority);
+}
+
 void ResourceSystemImpl::UnloadResource(SResourceHandle& handle)
 {
     if (quit)
@@ -340,21 +362,35 @@ void ResourceSystemImpl::_ClearFinishedRequests()
         failedRequests.end());
 }
 
-void ResourceSystemImpl::Update()
+void ResourceSystemImpl::_DequeueRequests()
 {
+    ResourceRequest* request = nullptr;
+    while (requests.try_dequeue(request))
     {
-        ResourceRequest* request = nullptr;
-        while (requests.try_dequeue(request))
-        {
-            toUpdateRequests.emplace_back(request);
-        }
-        _ClearFinishedRequests();
+        toUpdateRequests.emplace_back(request);
     }
+}
+
+void ResourceSystemImpl::Update()
+{
+    _DequeueRequests();
+    _ClearFinishedRequests();
     // TODO: time limit
+    // dependencies are requested as soon as their dependent's header is read, so requests enqueued
+    // while updating are picked up by another wave of the same update. this issues the io of a
+    // whole dependency graph at once instead of one dependency level per frame
+    static constexpr uint32_t kMaxWaves = 16;
+    size_t waveBegin = 0;
+    for (uint32_t wave = 0; wave < kMaxWaves && waveBegin < toUpdateRequests.size(); ++wave)
     {
-        for (auto req : toUpdateRequests)
+        const size_t waveEnd = toUpdateRequests.size();
+        // deepest first: dependencies submit their io and install before their dependents
+        std::stable_sort(toUpdateRequests.begin() + waveBegin, toUpdateRequests.begin() + waveEnd, [](ResourceRequest* a, ResourceRequest* b) {
+            return static_cast<SResourceRequestImpl*>(a)->depth > static_cast<SResourceRequestImpl*>(b)->depth;
+        });
+        for (size_t i = waveBegin; i < waveEnd; ++i)
         {
-            auto request = static_cast<SResourceRequestImpl*>(req);
+            auto request = static_cast<SResourceRequestImpl*>(toUpdateRequests[i]);
             uint32_t spinCounter = 0;
             ESkrLoadingPhase LastPhase;
             while (!request->Okay() && !request->AsyncSerde() && spinCounter < 16)
@@ -367,6 +403,25 @@ void ResourceSystemImpl::Update()
                     spinCounter = 0;
             };
         }
+        waveBegin = waveEnd;
+        _DequeueRequests();
+    }
+    // dependencies finished by later waves unblock their dependents, install them in topological
+    // order within this update
+    std::stable_sort(toUpdateRequests.begin(), toUpdateRequests.begin() + waveBegin, [](ResourceRequest* a, ResourceRequest* b) {
+        return static_cast<SResourceRequestImpl*>(a)->depth > static_cast<SResourceRequestImpl*>(b)->depth;
+    });
+    for (size_t i = 0; i < waveBegin; ++i)
+    {
+        auto request = static_cast<SResourceRequestImpl*>(toUpdateRequests[i]);
+        while (request->currentPhase == SKR_LOADING_PHASE_WAITFOR_LOAD_DEPENDENCIES ||
+               request->currentPhase == SKR_LOADING_PHASE_INSTALL_RESOURCE)
+        {
+            const auto LastPhase = request->currentPhase;
+            request->Update();
+            if (LastPhase == request->currentPhase)
+                break;
+        }
     }
     _UpdateAsyncSerde();
 }
@@ -119,7 +119,7 @@ sugoi::archetype_t* sugoi_storage_t::constructArchetype(const sugoi_type_set_t&
             return guid_compare_t{}(guids[lhs], guids[rhs]);
         });
     size_t caps[] = { kSmallBinSize - sizeof(sugoi_chunk_t), kFastBinSize - sizeof(sugoi_chunk_t), kLargeBinSize - sizeof(sugoi_chunk_t) };
-    const uint32_t sliceDataSize = sizeof(sugoi::slice_data_t) * archetype.type.length;
+    const uint32_t sliceDataSize = (sizeof(sugoi::slice_data_t) + sizeof(sugoi::slice_dirty_t)) * archetype.type.length;
     forloop (i, 0, 3)
     {
         uint32_t* offsets = const_cast<uint32_t*>(archetype.offsets[i]);
@@ -430,6 +430,8 @@ void sugoi_group_t::add_chunk(sugoi_chunk_t* chunk)
     size += chunk->count;
     chunk->structure = archetype;
     chunk->group = this;
+    // chunk enters this group as a whole, queries matching this group should see it as changed
+    chunk->mark_dirty(0, chunk->count, archetype->storage->timestamp());
     bool isFull      = chunk->count == chunk->get_capacity();
     if (!isFull || firstFree == (uint32_t)chunks.size())
     {
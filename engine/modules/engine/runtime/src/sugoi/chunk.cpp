@@ -39,6 +39,11 @@ void sugoi_chunk_t::init(sugoi::archetype_t* structure)
     {
         new (pData + i) sugoi::slice_data_t{};
     }
+    auto pDirty = (sugoi::slice_dirty_t*)(pData + structure->type.length);
+    for (EIndex i = 0; i < structure->type.length; ++i)
+    {
+        new (pDirty + i) sugoi::slice_dirty_t{};
+    }
 }
 
 sugoi_chunk_t::RWSlice sugoi_chunk_t::x_lock(const sugoi_type_index_t& type, const sugoi_chunk_view_t& view)
@@ -69,6 +74,28 @@ void sugoi_chunk_t::s_unlock(const sugoi_type_index_t& type, const sugoi_chunk_v
     lck.unlock_shared();
 }
 
+bool sugoi_chunk_t::try_x_lock_all()
+{
+    const auto pData = getSliceData();
+    for (uint32_t i = 0; i < structure->type.length; ++i)
+    {
+        if (!pData[i].lck.try_lock())
+        {
+            while (i > 0)
+                pData[--i].lck.unlock();
+            return false;
+        }
+    }
+    return true;
+}
+
+void sugoi_chunk_t::x_unlock_all()
+{
+    const auto pData = getSliceData();
+    for (uint32_t i = 0; i < structure->type.length; ++i)
+        pData[i].lck.unlock();
+}
+
 extern "C" {
 sugoi_group_t* sugoiC_get_group(const sugoi_chunk_t* chunk)
 {
@@ -85,6 +112,19 @@ uint32_t sugoiC_get_count(const sugoi_chunk_t* chunk)
     return chunk->count;
 }
 
+int sugoiC_get_dirty_range(const sugoi_chunk_t* chunk, sugoi_type_index_t type, sugoi_timestamp_t since, EIndex* start, EIndex* count)
+{
+    const auto slot = chunk->structure->index(type);
+    if (slot == sugoi::kInvalidSIndex)
+        return false;
+    EIndex s = 0, e = 0;
+    if (!chunk->get_dirty_range_at(slot, since, s, e))
+        return false;
+    if (start) *start = s;
+    if (count) *count = e - s;
+    return true;
+}
+
 void sugoiC_x_lock(sugoi_chunk_t* chunk, sugoi_type_index_t type)
 {
     chunk->x_lock(type, sugoi_chunk_view_t{chunk, 0, chunk->count});
@@ -798,7 +798,7 @@ auto sugoiV_get_owned(const sugoi_chunk_view_t* view, sugoi_type_index_t type)
 #endif
 
     if constexpr (!readonly)
-        chunk->set_timestamp_at(slot, structure->storage->timestamp());
+        chunk->mark_dirty_at(slot, view->start, view->count, structure->storage->timestamp());
 
     return (return_type)chunk->get_unsafe(tid, *view).start;
 }
@@ -1,5 +1,6 @@
 #include "SkrRT/sugoi/entity_registry.hpp"
 #include "SkrRT/sugoi/chunk.hpp"
+#include "SkrOS/thread.h"
 
 #ifndef forloop
 #define forloop(i, z, n) for (auto i = std::decay_t<decltype(n)>(z); i < (n); ++i)
@@ -9,9 +10,74 @@ sugoi_entity_debug_proxy_t dummy;
 namespace sugoi
 {
 
+EntityRegistry::EntityRegistry()
+{
+}
+
+EntityRegistry::~EntityRegistry()
+{
+    release_pages(0);
+}
+
+EntityRegistry::EntityRegistry(const EntityRegistry& rhs)
+{
+    *this = rhs;
+}
+
+EntityRegistry& EntityRegistry::operator=(const EntityRegistry& rhs)
+{
+    if (this == &rhs)
+        return *this;
+    release_pages(0);
+    const EIndex count = rhs.size();
+    ensure_pages(count);
+    rhs.visit_entries([&](skr::span<const Entry> page, EIndex first) {
+        memcpy(&at(first), page.data(), page.size() * sizeof(Entry));
+    });
+    entryCount.store(count, std::memory_order_release);
+    freeEntries = rhs.freeEntries;
+    forloop (i, 0, kFreeCacheCount)
+        freeEntries.append(rhs.freeCaches[i].ids);
+    forloop (i, 0, kFreeCacheCount)
+        freeCaches[i].ids.clear();
+    externalReserved = rhs.externalReserved;
+    return *this;
+}
+
+void EntityRegistry::ensure_pages(EIndex size)
+{
+    SKR_ASSERT(size <= SUGOI_ENTITY_ID_MASK + 1u);
+    const EIndex pageCount = (size + kEntryPageMask) >> kEntryPageShift;
+    forloop (i, 0, pageCount)
+    {
+        if (pages[i].load(std::memory_order_acquire) != nullptr)
+            continue;
+        // zeroed entries are free slots with version 0
+        auto page = (Entry*)sakura_calloc(kEntryPageSize, sizeof(Entry));
+        Entry* expected = nullptr;
+        if (!pages[i].compare_exchange_strong(expected, page, std::memory_order_acq_rel))
+            sakura_free(page); // another thread published this page first
+    }
+}
+
+void EntityRegistry::release_pages(EIndex firstPage)
+{
+    forloop (i, firstPage, kMaxEntryPages)
+    {
+        if (auto page = pages[i].exchange(nullptr, std::memory_order_relaxed))
+            sakura_free(page);
+    }
+}
+
+EntityRegistry::FreeCache& EntityRegistry::local_free_cache()
+{
+    const auto tid = (uint64_t)skr_current_thread_id();
+    return freeCaches[(tid ^ (tid >> 7)) % kFreeCacheCount];
+}
+
 void EntityRegistry::reserve(EIndex size)
 {
-    entries.reserve(size);
+    ensure_pages(size);
 }
 
 void EntityRegistry::reserve_free_entries(EIndex size)
@@ -21,35 +87,42 @@ void EntityRegistry::reserve_free_entries(EIndex size)
 
 void EntityRegistry::reset()
 {
-    entries.clear();
+    release_pages(0);
+    entryCount.store(0, std::memory_order_release);
     freeEntries.clear();
+    forloop (i, 0, kFreeCacheCount)
+        freeCaches[i].ids.clear();
+    externalReserved = 0;
 }
 
 void EntityRegistry::reserve_external(EIndex size)
 {
-    SKR_ASSERT(entries.size() == 0 && freeEntries.size() == 0 && externalReserved == 0);
-    entries.resize_unsafe(size);
+    SKR_ASSERT(this->size() == 0 && freeEntries.size() == 0 && externalReserved == 0);
+    ensure_pages(size);
     forloop (i, 0, size)
     {
-        entries[i] = { nullptr, 0, kEntityTransientVersion };
+        at(i) = { nullptr, 0, kEntityTransientVersion };
     }
+    entryCount.store(size, std::memory_order_release);
     externalReserved = size;
 }
 
 void EntityRegistry::shrink()
 {
-    if (entries.size() == 0)
+    flush_free_caches();
+    const EIndex count = size();
+    if (count == 0)
         return;
-    EIndex lastValid = (EIndex)(entries.size() - 1);
-    while (lastValid != 0 && entries[lastValid].chunk == nullptr)
+    EIndex lastValid = count - 1;
+    while (lastValid != 0 && at(lastValid).chunk == nullptr)
         --lastValid;
-    if (entries[lastValid].indexInChunk == 0)
+    if (at(lastValid).chunk == nullptr)
     {
-        entries.clear();
+        reset();
         return;
     }
-    entries.resize_unsafe(lastValid + 1);
-    entries.shrink();
+    entryCount.store(lastValid + 1, std::memory_order_release);
+    release_pages((lastValid >> kEntryPageShift) + 1);
     freeEntries.remove_all_if([&](EIndex i) {
         return i > lastValid;
     });
@@ -57,16 +130,19 @@ void EntityRegistry::shrink()
 
 void EntityRegistry::pack_entities(skr::Vector<EIndex>& out_map)
 {
-    out_map.resize_unsafe(entries.size());
+    const EIndex count = size();
+    out_map.resize_unsafe(count);
     freeEntries.clear();
+    forloop (i, 0, kFreeCacheCount)
+        freeCaches[i].ids.clear();
     EIndex j = 0;
-    forloop (i, 0, entries.size())
+    forloop (i, 0, count)
     {
-        if (entries[i].indexInChunk != 0)
+        if (at(i).indexInChunk != 0)
         {
             out_map[i] = j;
             if (i != j)
-                entries[j] = entries[i];
+                at(j) = at(i);
             j++;
         }
     }
@@ -83,7 +159,7 @@ void EntityRegistry::new_entities(sugoi_entity_t* dst, EIndex count)
     forloop (j, 0, rn)
     {
         auto id = freeEntries[fn - rn + j];
-        dst[i] = e_version(id, entries[id].version);
+        dst[i] = e_version(id, at(id).version);
         i++;
     }
     {
@@ -94,16 +170,17 @@ void EntityRegistry::new_entities(sugoi_entity_t* dst, EIndex count)
         return;
 
     // new entities
-    EIndex newId = static_cast<EIndex>(entries.size());
+    EIndex newId = size();
     {
         SkrZoneScopedN("ResizeEntries");
-        entries.resize_unsafe(entries.size() + count - i);
+        ensure_pages(newId + count - i);
+        entryCount.store(newId + count - i, std::memory_order_release);
     }
     {
         SkrZoneScopedN("InitializeEntryValues");
         while (i < count)
         {
-            dst[i] = e_version(newId, entries[newId].version);
+            dst[i] = e_version(newId, at(newId).version);
             i++;
             newId++;
         }
@@ -120,7 +197,7 @@ void EntityRegistry::free_entities(const sugoi_entity_t* dst, EIndex count)
     forloop (i, 0, count)
     {
         auto id = e_id(dst[i]);
-        Entry& freeData = entries[id];
+        Entry& freeData = at(id);
         SKR_ASSERT(e_version(dst[i]) == freeData.version);
         if (id < externalReserved)
         {
@@ -132,6 +209,93 @@ void EntityRegistry::free_entities(const sugoi_entity_t* dst, EIndex count)
     }
 }
 
+void EntityRegistry::new_entities_concurrent(sugoi_entity_t* dst, EIndex count)
+{
+    SkrZoneScopedN("sugoi_storage_t::new_entities_concurrent");
+
+    EIndex i = 0;
+    auto& cache = local_free_cache();
+    cache.mtx.lock();
+    if (cache.ids.size() < count)
+    {
+        // refill from the shared free list in batches to keep freeMtx cold
+        freeMtx.lock();
+        const auto want = std::max<EIndex>(count - (EIndex)cache.ids.size(), kFreeCacheBatch);
+        const auto fn = (EIndex)freeEntries.size();
+        const auto rn = std::min(fn, want);
+        cache.ids.append(freeEntries.data() + fn - rn, rn);
+        freeEntries.resize_unsafe(fn - rn);
+        freeMtx.unlock();
+    }
+    {
+        // recycle entities
+        const auto fn = (EIndex)cache.ids.size();
+        const auto rn = std::min(fn, count);
+        forloop (j, 0, rn)
+        {
+            auto id = cache.ids[fn - rn + j];
+            dst[i] = e_version(id, at(id).version);
+            i++;
+        }
+        cache.ids.resize_unsafe(fn - rn);
+    }
+    cache.mtx.unlock();
+    if (i == count)
+        return;
+
+    // new entities, pages are published before the ids are handed out
+    const EIndex newCount = count - i;
+    EIndex newId = entryCount.fetch_add(newCount, std::memory_order_acq_rel);
+    ensure_pages(newId + newCount);
+    while (i < count)
+    {
+        dst[i] = e_version(newId, at(newId).version);
+        i++;
+        newId++;
+    }
+}
+
+void EntityRegistry::free_entities_concurrent(const sugoi_entity_t* src, EIndex count)
+{
+    SkrZoneScopedN("sugoi_storage_t::free_entities_concurrent");
+
+    auto& cache = local_free_cache();
+    cache.mtx.lock();
+    cache.ids.reserve(cache.ids.size() + count);
+    forloop (i, 0, count)
+    {
+        auto id = e_id(src[i]);
+        Entry& freeData = at(id);
+        SKR_ASSERT(e_version(src[i]) == freeData.version);
+        if (id < externalReserved)
+        {
+            freeData = { nullptr, 0, kEntityTransientVersion };
+            continue;
+        }
+        freeData = { nullptr, 0, e_inc_version(freeData.version) };
+        cache.ids.add(id);
+    }
+    if (cache.ids.size() > 2 * kFreeCacheBatch)
+    {
+        // keep one batch local, hand the rest to other threads
+        const auto fn = (EIndex)cache.ids.size();
+        freeMtx.lock();
+        freeEntries.append(cache.ids.data() + kFreeCacheBatch, fn - kFreeCacheBatch);
+        freeMtx.unlock();
+        cache.ids.resize_unsafe(kFreeCacheBatch);
+    }
+    cache.mtx.unlock();
+}
+
+void EntityRegistry::flush_free_caches()
+{
+    forloop (i, 0, kFreeCacheCount)
+    {
+        freeEntries.append(freeCaches[i].ids);
+        freeCaches[i].ids.clear();
+    }
+}
+
 void EntityRegistry::fill_entities(const sugoi_chunk_view_t& view)
 {
     SkrZoneScopedN("sugoi_storage_t::fill_entities");
@@ -141,7 +305,7 @@ void EntityRegistry::fill_entities(const sugoi_chunk_view_t& view)
     {
         forloop (i, 0, view.count)
         {
-            Entry& e = entries[e_id(ents[i])];
+            Entry& e = at(e_id(ents[i]));
             e.indexInChunk = view.start + i;
             e.chunk = view.chunk;
         }
@@ -156,7 +320,7 @@ void EntityRegistry::fill_entities(const sugoi_chunk_view_t& view, const sugoi_e
     memcpy(ents, src, view.count * sizeof(sugoi_entity_t));
     forloop (i, 0, view.count)
     {
-        Entry& e = entries[e_id(src[i])];
+        Entry& e = at(e_id(src[i]));
         e.indexInChunk = view.start + i;
         e.chunk = view.chunk;
     }
@@ -170,7 +334,7 @@ void EntityRegistry::fill_entities_external(const sugoi_chunk_view_t& view, cons
     memcpy(ents, src, view.count * sizeof(sugoi_entity_t));
     forloop (i, 0, view.count)
     {
-        Entry& e = entries[e_id(src[i])];
+        Entry& e = at(e_id(src[i]));
         SKR_ASSERT(e.chunk == nullptr);
         e.indexInChunk = view.start + i;
         e.chunk = view.chunk;
@@ -189,7 +353,7 @@ void EntityRegistry::move_entities(const sugoi_chunk_view_t& view, const sugoi_c
     const sugoi_entity_t* toMove = src->get_entities() + srcIndex;
     forloop (i, 0, view.count)
     {
-        Entry& e = entries[e_id(toMove[i])];
+        Entry& e = at(e_id(toMove[i]));
         e.indexInChunk = view.start + i;
         e.chunk = view.chunk;
     }
@@ -201,15 +365,14 @@ void EntityRegistry::move_entities(const sugoi_chunk_view_t& view, EIndex srcInd
     SKR_ASSERT(srcIndex >= view.start + view.count);
     const sugoi_entity_t* toMove = view.chunk->get_entities() + srcIndex;
     forloop (i, 0, view.count)
-        entries[e_id(toMove[i])].indexInChunk = view.start + i;
+        at(e_id(toMove[i])).indexInChunk = view.start + i;
     std::memcpy((sugoi_entity_t*)view.chunk->get_entities() + view.start, toMove, view.count * sizeof(sugoi_entity_t));
 }
 
 void EntityRegistry::serialize(SBinaryWriter* writer)
 {
-    visit_entries([&](const auto& entriesView){
-        skr::bin_write(writer, (uint32_t)entriesView.size());
-    });
+    flush_free_caches();
+    skr::bin_write(writer, (uint32_t)size());
     visit_free_entries([&](const auto& freeEntriesView){
         skr::bin_write(writer, (uint32_t)freeEntriesView.size());
         writer->write(freeEntriesView.data(), sizeof(EIndex) * static_cast<uint32_t>(freeEntriesView.size()));
@@ -219,10 +382,11 @@ void EntityRegistry::serialize(SBinaryWriter* writer)
 void EntityRegistry::deserialize(SBinaryReader* reader)
 {
     // empty storage expected
-    SKR_ASSERT(entries.size() == 0);
+    SKR_ASSERT(this->size() == 0);
     uint32_t size = 0;
     skr::bin_read(reader, size);
-    entries.resize_unsafe(size);
+    ensure_pages(size);
+    entryCount.store(size, std::memory_order_release);
     uint32_t freeSize = 0;
     skr::bin_read(reader, freeSize);
     freeEntries.resize_unsafe(freeSize);
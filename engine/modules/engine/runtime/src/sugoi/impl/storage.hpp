@@ -89,7 +89,8 @@ private:
     sugoi_timestamp_t queries_timestamp = 0;
 
 public:
-    sugoi_timestamp_t storage_timestamp;
+    SAtomicU32 storage_timestamp = 1;
+    SAtomicU32 running_tasks = 0;
     
     // overload
     sugoi::OverloadData overload_data;
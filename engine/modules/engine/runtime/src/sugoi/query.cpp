@@ -99,10 +99,7 @@ bool match_chunk_changed(const sugoi_chunk_t& chunk, const sugoi_meta_filter_t&
             j++;
         else if (changed.data[i] < typeset.data[j])
             i++;
-        else if (
-            const auto timestamp = chunk.get_timestamp_at(j);
-            timestamp - filter.timestamp > 0
-        )
+        else if (chunk.changed_since_at(j, (sugoi_timestamp_t)filter.timestamp))
             return true;
         else
             (j++, i++);
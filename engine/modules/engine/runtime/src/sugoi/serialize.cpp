@@ -3,6 +3,7 @@
 #include "SkrRT/sugoi/array.hpp"
 #include "SkrRT/sugoi/type_registry.hpp"
 #include "SkrSerde/bin_serde.hpp"
+#include "SkrContainers/span.hpp"
 
 #include "SkrRT/sugoi/chunk.hpp"
 #include "chunk_view.hpp"
@@ -303,9 +304,282 @@ void sugoi_storage_t::deserialize(SBinaryReader* s)
                     entry.chunk = view.chunk;
                     entry.indexInChunk = k + view.start;
                     entry.version = e_version(ents[k]);
-                    entity_registry.entries[e_id(ents[k])] = entry;
+                    entity_registry.at(e_id(ents[k])) = entry;
                 }
             }
         }
     }
-}
\ No newline at end of file
+}
+namespace sugoi
+{
+// chunk image snapshot
+// [header] [entities] ([group type] [is image] [chunk count] (stream chunk | image chunk)*)*
+// image chunk: [pool type] [count] [heap size] [padding to page] [chunk data] [heap data]
+static constexpr uint32_t kImageMagic = 0x4D494753; // "SGIM"
+static constexpr uint32_t kImageVersion = 1;
+static constexpr uint32_t kImagePageSize = 4096;
+// array components spilled to heap are relocated through the chunk heap blob
+static constexpr uintptr_t kImageHeapTag = uintptr_t(1) << (sizeof(uintptr_t) * 8 - 1);
+
+struct image_header_t {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pageSize;
+    uint32_t groupCount;
+};
+
+struct ImageWriter {
+    SBinaryWriter* writer;
+    uint64_t offset = 0;
+    bool write(const void* data, size_t size)
+    {
+        offset += size;
+        return writer->write(data, size);
+    }
+    void pad(uint64_t align)
+    {
+        static const uint8_t zeros[kImagePageSize] = {};
+        const auto padding = (size_t)(((offset + align - 1) & ~(align - 1)) - offset);
+        write(zeros, padding);
+    }
+};
+
+static size_t chunk_data_size(pool_type_t pt)
+{
+    switch (pt)
+    {
+        case PT_small:
+            return kSmallBinSize - sizeof(sugoi_chunk_t);
+        case PT_default:
+            return kFastBinSize - sizeof(sugoi_chunk_t);
+        case PT_large:
+            return kLargeBinSize - sizeof(sugoi_chunk_t);
+    };
+    return 0;
+}
+
+// components with custom serializers own external resources and can not be copied as raw bytes
+static bool image_compatible(const archetype_t* type)
+{
+    forloop (i, 0, type->type.length)
+    {
+        if (type->callbacks[i].serialize || type->callbacks[i].deserialize)
+            return false;
+    }
+    return true;
+}
+
+// images are only valid for the same chunk layout
+static uint64_t image_layout_hash(const archetype_t* type)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](uint64_t v) {
+        hash ^= v;
+        hash *= 1099511628211ull;
+    };
+    forloop (pt, 0, 3)
+    {
+        mix(type->chunkCapacity[pt]);
+        mix(type->sliceDataOffsets[pt]);
+        forloop (i, 0, type->type.length)
+            mix(type->offsets[pt][i]);
+    }
+    forloop (i, 0, type->type.length)
+        mix(type->sizes[i]);
+    return hash;
+}
+
+template <class F>
+static void foreach_array(const archetype_t* type, char* data, pool_type_t pt, EIndex count, const F& f)
+{
+    forloop (i, 0, type->type.length)
+    {
+        const type_index_t tid = type->type.data[i];
+        if (!tid.is_buffer())
+            continue;
+        const EIndex rows = tid.is_chunk() ? 1 : count;
+        forloop (j, 0, rows)
+            f((sugoi_array_comp_t*)(data + type->offsets[pt][i] + (size_t)type->sizes[i] * j), type->sizes[i]);
+    }
+}
+} // namespace sugoi
+
+void sugoi_storage_t::serialize_image(SBinaryWriter* s)
+{
+    SkrZoneScopedN("sugoi_storage_t::serialize_image");
+    using namespace sugoi;
+
+    ImageWriter image = { s };
+    SBinaryWriter w(image);
+    pimpl->groups.read_versioned([&](auto& groups) {
+        image_header_t header = { kImageMagic, kImageVersion, kImagePageSize, (uint32_t)groups.size() };
+        image.write(&header, sizeof(header));
+        entity_registry.serialize(&w);
+        skr::Vector<char> scratch;
+        skr::Vector<char> heap;
+        for (auto& pair : groups)
+        {
+            SkrZoneScopedN("serialize group");
+            auto group = pair.second;
+            auto type = group->archetype;
+            serialize_type(group->type, &w, true);
+            const bool isImage = image_compatible(type);
+            skr::bin_write(&w, isImage);
+            skr::bin_write(&w, (uint32_t)group->chunks.size());
+            if (!isImage)
+            {
+                for (auto c : group->chunks)
+                {
+                    sugoi_chunk_view_t view = { c, 0, c->count };
+                    serialize_view(group, view, &w, nullptr, true);
+                }
+                continue;
+            }
+            skr::bin_write(&w, image_layout_hash(type));
+            for (auto c : group->chunks)
+            {
+                SkrZoneScopedN("serialize chunk image");
+                const auto size = chunk_data_size(c->pt);
+                scratch.resize_unsafe(size);
+                memcpy(scratch.data(), c->data(), size);
+                // rebase array pointers to the array itself, spilled arrays go to the heap blob
+                heap.clear();
+                foreach_array(type, scratch.data(), c->pt, c->count, [&](sugoi_array_comp_t* array, uint32_t arraySize) {
+                    const auto live = (sugoi_array_comp_t*)(c->data() + ((char*)array - scratch.data()));
+                    const auto length = (uintptr_t)((char*)live->EndX - (char*)live->BeginX);
+                    if ((char*)live->BeginX >= (char*)live && (char*)live->BeginX < (char*)live + arraySize)
+                    {
+                        array->BeginX = (void*)((char*)live->BeginX - (char*)live);
+                        array->EndX = (void*)((char*)live->EndX - (char*)live);
+                        array->CapacityX = (void*)(uintptr_t)arraySize;
+                    }
+                    else
+                    {
+                        array->BeginX = (void*)(kImageHeapTag | (uintptr_t)heap.size());
+                        array->EndX = (void*)length;
+                        array->CapacityX = (void*)length;
+                        heap.append((const char*)live->BeginX, length);
+                    }
+                });
+                skr::bin_write(&w, (uint32_t)c->pt);
+                skr::bin_write(&w, c->count);
+                skr::bin_write(&w, (uint32_t)heap.size());
+                image.pad(kImagePageSize);
+                image.write(scratch.data(), size);
+                image.write(heap.data(), heap.size());
+            }
+        } },
+        [&]() {
+            return pimpl->groups_timestamp;
+        });
+}
+
+bool sugoi_storage_t::deserialize_image(const void* data, size_t size)
+{
+    SkrZoneScopedN("sugoi_storage_t::deserialize_image");
+    using namespace sugoi;
+
+    skr::archive::BinSpanReader image = { { (const uint8_t*)data, size } };
+    SBinaryReader r(image);
+    image_header_t header = {};
+    // chunk data is aligned to the page size, it has to be a power of two
+    if (!image.read(&header, sizeof(header)) || header.magic != kImageMagic || header.version != kImageVersion ||
+        header.pageSize == 0 || (header.pageSize & (header.pageSize - 1)) != 0)
+    {
+        SKR_LOG_ERROR(u8"sugoi: invalid world image.");
+        return false;
+    }
+    {
+        SkrZoneScopedN("deserialize entities");
+        entity_registry.deserialize(&r);
+    }
+    auto fill_entries = [&](const sugoi_chunk_view_t& view) {
+        auto ents = sugoiV_get_entities(&view);
+        forloop (k, 0, view.count)
+        {
+            EntityRegistry::Entry entry;
+            entry.chunk = view.chunk;
+            entry.indexInChunk = k + view.start;
+            entry.version = e_version(ents[k]);
+            entity_registry.at(e_id(ents[k])) = entry;
+        }
+    };
+    forloop (i, 0, header.groupCount)
+    {
+        SkrZoneScopedN("deserialize group");
+        fixed_stack_scope_t _(localStack);
+        auto type = deserialize_type(localStack, &r, true);
+        auto group = allocateGroup(type);
+        bool isImage = false;
+        uint32_t chunkCount = 0;
+        skr::bin_read(&r, isImage);
+        skr::bin_read(&r, chunkCount);
+        if (!isImage)
+        {
+            forloop (j, 0, chunkCount)
+            {
+                sugoi_chunk_view_t view;
+                serialize_view(group, view, nullptr, &r, true);
+                fill_entries(view);
+            }
+            continue;
+        }
+        uint64_t layoutHash = 0;
+        skr::bin_read(&r, layoutHash);
+        auto archetype = group->archetype;
+        if (layoutHash != image_layout_hash(archetype))
+        {
+            SKR_LOG_ERROR(u8"sugoi: world image chunk layout mismatch, image is from another build.");
+            return false;
+        }
+        forloop (j, 0, chunkCount)
+        {
+            SkrZoneScopedN("deserialize chunk image");
+            uint32_t pt = 0, heapSize = 0;
+            EIndex count = 0;
+            skr::bin_read(&r, pt);
+            skr::bin_read(&r, count);
+            skr::bin_read(&r, heapSize);
+            if (pt > PT_large || count > archetype->chunkCapacity[pt])
+            {
+                SKR_LOG_ERROR(u8"sugoi: invalid chunk in world image.");
+                return false;
+            }
+            image.offset = (image.offset + header.pageSize - 1) & ~(size_t)(header.pageSize - 1);
+            const auto dataSize = chunk_data_size((pool_type_t)pt);
+            if (image.offset + dataSize + heapSize > size)
+            {
+                SKR_LOG_ERROR(u8"sugoi: truncated world image.");
+                return false;
+            }
+            const char* src = (const char*)data + image.offset;
+            const char* heap = src + dataSize;
+            image.offset += dataSize + heapSize;
+
+            auto chunk = sugoi_chunk_t::create((pool_type_t)pt);
+            memcpy(chunk->data(), src, dataSize);
+            // slice locks and versions are runtime state
+            chunk->init(archetype);
+            foreach_array(archetype, chunk->data(), chunk->pt, count, [&](sugoi_array_comp_t* array, uint32_t) {
+                const auto begin = (uintptr_t)array->BeginX;
+                if (begin & kImageHeapTag)
+                {
+                    const auto length = (size_t)(uintptr_t)array->EndX;
+                    array->BeginX = llvm_vecsmall::SmallVectorBase::allocate(length);
+                    memcpy(array->BeginX, heap + (begin & ~kImageHeapTag), length);
+                    array->CapacityX = array->EndX = (char*)array->BeginX + length;
+                }
+                else
+                {
+                    array->BeginX = (char*)array + begin;
+                    array->EndX = (char*)array + (uintptr_t)array->EndX;
+                    array->CapacityX = (char*)array + (uintptr_t)array->CapacityX;
+                }
+            });
+            chunk->count = count;
+            group->add_chunk(chunk);
+            fill_entries({ chunk, 0, count });
+        }
+    }
+    return true;
+}
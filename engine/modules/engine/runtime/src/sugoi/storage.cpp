@@ -1,5 +1,7 @@
 #include "SkrBase/atomic/atomic.h"
 #include "SkrTask/parallel_for.hpp"
+#include "SkrCore/time.h"
+#include "SkrCore/log.h"
 #include "SkrRT/sugoi/sugoi.h"
 #include "SkrRT/sugoi/set.hpp"
 #include "SkrRT/sugoi/type_registry.hpp"
@@ -56,7 +58,7 @@ void sugoi_storage_t::allocate_unsafe(sugoi_group_t* group, EIndex count, sugoi_
     while (count != 0)
     {
         // opt
-        entity_registry.reserve(entity_registry.entries.size() + count);
+        entity_registry.reserve(entity_registry.size() + count);
 
         sugoi_chunk_view_t v = allocateView(group, count);
         entity_registry.fill_entities(v);
@@ -90,7 +92,7 @@ void sugoi_storage_t::allocate_reserved_unsafe(sugoi_group_t* group, const sugoi
     while (count != 0)
     {
         // opt
-        entity_registry.reserve(entity_registry.entries.size() + count);
+        entity_registry.reserve(entity_registry.size() + count);
 
         sugoi_chunk_view_t v = allocateView(group, count);
         entity_registry.fill_entities_external(v, ents);
@@ -119,7 +121,7 @@ sugoi_chunk_view_t sugoi_storage_t::allocateView(sugoi_group_t* group, EIndex co
     EIndex start = freeChunk->count;
     EIndex allocated = std::min(count, freeChunk->get_capacity() - start);
     group->resize_chunk(freeChunk, start + allocated);
-    structuralChange(group, freeChunk);
+    structuralChange({ freeChunk, start, allocated });
     return { freeChunk, start, allocated };
 }
 
@@ -139,7 +141,7 @@ sugoi_chunk_view_t sugoi_storage_t::allocateViewStrict(sugoi_group_t* group, EIn
         freeChunk = group->new_chunk(count);
     EIndex start = freeChunk->count;
     group->resize_chunk(freeChunk, start + count);
-    structuralChange(group, freeChunk);
+    structuralChange({ freeChunk, start, count });
     return { freeChunk, start, count };
 }
 
@@ -160,9 +162,10 @@ void sugoi_storage_t::destroy_entities(const sugoi_chunk_view_t& view)
     }
 }
 
-void sugoi_storage_t::structuralChange(sugoi_group_t* group, sugoi_chunk_t* chunk)
+void sugoi_storage_t::structuralChange(const sugoi_chunk_view_t& view)
 {
-    // todo: timestamp
+    // rows are (re)filled, every slice is treated as written
+    view.chunk->mark_dirty(view.start, view.count, timestamp());
 }
 
 void sugoi_storage_t::linked_to_prefab(const sugoi_entity_t* src, uint32_t size, bool keepExternal)
@@ -486,6 +489,126 @@ void sugoi_storage_t::defragment()
         });
 }
 
+EIndex sugoi_storage_t::defragment_incremental(const sugoi_defragment_budget_t& budget)
+{
+    SkrZoneScopedN("sugoi_storage_t::defragment_incremental");
+
+    using namespace sugoi;
+    // ecs tasks do not lock slices, moving rows under them would corrupt their views
+    if (running_tasks() != 0)
+    {
+        SKR_LOG_ERROR(u8"sugoiS_defragment_incremental: %u ecs task(s) are still scheduled on the storage, call it after TaskScheduler::sync_all()!", running_tasks());
+        SKR_ASSERT(false && "defragment while ecs tasks are scheduled on the storage");
+        return 0;
+    }
+    const EIndex  maxRows  = budget.max_rows ? budget.max_rows : std::numeric_limits<EIndex>::max();
+    const int64_t deadline = budget.max_microseconds ? skr_sys_get_usec(true) + budget.max_microseconds : 0;
+    std::atomic<EIndex> moved = 0;
+    auto outOfBudget = [&]() {
+        return moved.load(std::memory_order_relaxed) >= maxRows || (deadline && skr_sys_get_usec(true) >= deadline);
+    };
+
+    pimpl->groups.read_versioned([&](auto& groups) {
+        // step 1 : pick sparse groups, least occupied first
+        struct candidate_t {
+            sugoi_group_t* group;
+            float occupancy;
+        };
+        skr::Vector<candidate_t> candidates;
+        for (auto& pair : groups)
+        {
+            auto g = pair.second;
+            if (g->chunks.size() < 2)
+                continue;
+            EIndex capacity = 0;
+            for (auto c : g->chunks)
+                capacity += c->get_capacity();
+            const float occupancy = (float)g->size / (float)capacity;
+            if (occupancy < budget.occupancy_threshold || budget.occupancy_threshold <= 0.f)
+                candidates.add({ g, occupancy });
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const candidate_t& lhs, const candidate_t& rhs) {
+            return lhs.occupancy < rhs.occupancy;
+        });
+
+        // step 2 : each group is owned by one worker, move the tail of the emptiest chunk
+        //          into the fullest chunk that still has room until no pair is left
+        skr::parallel_for(candidates.data(), candidates.data() + candidates.size(), 1, [&](candidate_t* begin, candidate_t* end) {
+            for (auto i = begin; i != end; ++i)
+            {
+                auto g = i->group;
+                while (!outOfBudget())
+                {
+                    sugoi_chunk_t* source = nullptr;
+                    sugoi_chunk_t* target = nullptr;
+                    for (auto c : g->chunks)
+                        if (!source || c->count < source->count)
+                            source = c;
+                    for (auto c : g->chunks)
+                        if (c != source && c->count < c->get_capacity() && (!target || c->count > target->count))
+                            target = c;
+                    if (!source || !target || target->count < source->count)
+                        break;
+
+                    // a structural copy may hold slices of either chunk, leave this group for the next call
+                    if (!source->try_x_lock_all())
+                        break;
+                    if (!target->try_x_lock_all())
+                    {
+                        source->x_unlock_all();
+                        break;
+                    }
+                    const EIndex wanted = std::min(source->count, target->get_capacity() - target->count);
+                    const EIndex taken = moved.fetch_add(wanted, std::memory_order_relaxed);
+                    const EIndex moveCount = taken < maxRows ? std::min(wanted, maxRows - taken) : 0;
+                    if (moveCount != wanted)
+                        moved.fetch_sub(wanted - moveCount, std::memory_order_relaxed);
+                    if (moveCount == 0)
+                    {
+                        target->x_unlock_all();
+                        source->x_unlock_all();
+                        break;
+                    }
+                    const sugoi_chunk_view_t dstView = { target, target->count, moveCount };
+                    const EIndex srcIndex = source->count - moveCount;
+                    move_view(dstView, source, srcIndex);
+                    entity_registry.move_entities(dstView, source, srcIndex);
+                    target->x_unlock_all();
+                    source->x_unlock_all();
+                    g->resize_chunk(target, target->count + moveCount);
+                    g->resize_chunk(source, srcIndex);
+                    structuralChange(dstView);
+                }
+            }
+        });
+    },
+    [&]() {
+        return pimpl->groups_timestamp;
+    });
+    return moved.load(std::memory_order_relaxed);
+}
+
+void sugoi_storage_t::get_occupancy(sugoi_occupancy_callback_t callback, void* u)
+{
+    pimpl->groups.read_versioned([&](auto& groups) {
+        for (auto& pair : groups)
+        {
+            auto g = pair.second;
+            sugoi_group_occupancy_t occupancy = {};
+            occupancy.group = g;
+            occupancy.type = g->type;
+            occupancy.entity_count = g->size;
+            occupancy.chunk_count = (uint32_t)g->chunks.size();
+            for (auto c : g->chunks)
+                occupancy.capacity += c->get_capacity();
+            callback(u, &occupancy);
+        }
+    },
+    [&]() {
+        return pimpl->groups_timestamp;
+    });
+}
+
 void sugoi_storage_t::pack_entities()
 {
     using namespace sugoi;
@@ -710,19 +833,21 @@ void sugoi_storage_t::merge(sugoi_storage_t& src)
     using namespace sugoi;
     auto& sents = src.entity_registry;
     skr::stl_vector<sugoi_entity_t> map;
-    sents.visit_entries([&](const auto& entries_view) {
-        map.resize(entries_view.size());
-        EIndex moveCount = 0;
-        for (auto& e : entries_view)
+    map.resize(sents.size());
+    EIndex moveCount = 0;
+    sents.visit_entries([&](skr::span<const EntityRegistry::Entry> page, EIndex first) {
+        for (auto& e : page)
             if (e.chunk != nullptr)
                 moveCount++;
-        skr::stl_vector<sugoi_entity_t> newEnts;
-        newEnts.resize(moveCount);
-        entity_registry.new_entities(newEnts.data(), moveCount);
-        int j = 0;
-        for (int i = 0; i < entries_view.size(); ++i)
-            if (entries_view[i].chunk != nullptr)
-                map[i] = newEnts[j++];
+    });
+    skr::stl_vector<sugoi_entity_t> newEnts;
+    newEnts.resize(moveCount);
+    entity_registry.new_entities(newEnts.data(), moveCount);
+    int j = 0;
+    sents.visit_entries([&](skr::span<const EntityRegistry::Entry> page, EIndex first) {
+        for (EIndex i = 0; i < page.size(); ++i)
+            if (page[i].chunk != nullptr)
+                map[first + i] = newEnts[j++];
     });
 
     sents.reset();
@@ -795,7 +920,7 @@ void sugoi_storage_t::merge(sugoi_storage_t& src)
                     forloop (k, 0, c->count)
                     {
                         i->m->map(ents[k]);
-                        entity_registry.entries[ents[k]] = { c, k, {} };
+                        entity_registry.at(e_id(ents[k])) = { c, k, e_version(ents[k]) };
                     }
                     iterator_ref_chunk(c, *(i->m));
                     iterator_ref_view({ c, 0, c->count }, *(i->m));
@@ -840,7 +965,7 @@ sugoi_storage_t* sugoi_storage_t::clone()
 {
     sugoi_storage_t* dst = sugoiS_create();
     dst->entity_registry = entity_registry;
-    dst->pimpl->storage_timestamp = pimpl->storage_timestamp;
+    skr_atomic_store_relaxed(&dst->pimpl->storage_timestamp, timestamp());
     pimpl->groups.read_versioned([&](auto& groups) {
         for (auto group : groups)
         {
@@ -903,7 +1028,32 @@ EIndex sugoi_storage_t::count(bool includeDisabled, bool includeDead)
 
 sugoi_timestamp_t sugoi_storage_t::timestamp() const
 {
-    return pimpl->storage_timestamp;
+    return skr_atomic_load_relaxed(&pimpl->storage_timestamp);
+}
+
+sugoi_timestamp_t sugoi_storage_t::advance_timestamp()
+{
+    return skr_atomic_fetch_add_relaxed(&pimpl->storage_timestamp, 1);
+}
+
+void sugoi_storage_t::begin_task()
+{
+    skr_atomic_fetch_add_relaxed(&pimpl->running_tasks, 1);
+}
+
+void sugoi_storage_t::end_task()
+{
+    skr_atomic_fetch_add_release(&pimpl->running_tasks, -1);
+}
+
+uint32_t sugoi_storage_t::running_tasks() const
+{
+    return skr_atomic_load_acquire(&pimpl->running_tasks);
+}
+
+sugoi_timestamp_t sugoi_storage_t::groups_timestamp() const
+{
+    return pimpl->groups_timestamp;
 }
 
 sugoi::EntityRegistry& sugoi_storage_t::getEntityRegistry()
@@ -920,7 +1070,6 @@ void sugoi_storage_t::freeView(const sugoi_chunk_view_t& view)
 {
     using namespace sugoi;
     auto group = view.chunk->group;
-    structuralChange(group, view.chunk);
     uint32_t toMove = std::min(view.count, view.chunk->count - (view.start + view.count));
     if (toMove > 0)
     {
@@ -928,6 +1077,7 @@ void sugoi_storage_t::freeView(const sugoi_chunk_view_t& view)
         EIndex srcIndex = view.chunk->count - toMove;
         entity_registry.move_entities(dstView, srcIndex);
         move_view(dstView, srcIndex);
+        structuralChange(dstView);
     }
     group->resize_chunk(view.chunk, view.chunk->count - view.count);
 }
@@ -1071,6 +1221,16 @@ void sugoiS_deserialize(sugoi_storage_t* storage, SBinaryReader* v)
     storage->deserialize(v);
 }
 
+void sugoiS_serialize_image(sugoi_storage_t* storage, SBinaryWriter* v)
+{
+    storage->serialize_image(v);
+}
+
+int sugoiS_deserialize_image(sugoi_storage_t* storage, const void* data, size_t size)
+{
+    return storage->deserialize_image(data, size);
+}
+
 int sugoiS_exist(sugoi_storage_t* storage, sugoi_entity_t ent)
 {
     return storage->exist(ent);
@@ -1117,6 +1277,16 @@ void sugoiS_defragement(sugoi_storage_t* storage)
     storage->defragment();
 }
 
+EIndex sugoiS_defragment_incremental(sugoi_storage_t* storage, const sugoi_defragment_budget_t* budget)
+{
+    return storage->defragment_incremental(budget ? *budget : sugoi_defragment_budget_t{});
+}
+
+void sugoiS_get_occupancy(sugoi_storage_t* storage, sugoi_occupancy_callback_t callback, void* u)
+{
+    storage->get_occupancy(callback, u);
+}
+
 void sugoiS_pack_entities(sugoi_storage_t* storage)
 {
     storage->pack_entities();
@@ -1172,6 +1342,16 @@ void sugoiQ_set_meta(sugoi_query_t* q, const sugoi_meta_filter_t* meta)
     }
 }
 
+void sugoiQ_set_timestamp(sugoi_query_t* q, sugoi_timestamp_t timestamp)
+{
+    q->pimpl->meta.timestamp = timestamp;
+}
+
+sugoi_timestamp_t sugoiQ_get_timestamp(const sugoi_query_t* q)
+{
+    return (sugoi_timestamp_t)q->pimpl->meta.timestamp;
+}
+
 void sugoiQ_set_custom_filter(sugoi_query_t* q, sugoi_custom_filter_callback_t callback, void* u)
 {
     q->pimpl->customFilter = callback;
@@ -1279,6 +1459,21 @@ EIndex sugoiS_count(sugoi_storage_t* storage, bool includeDisabled, bool include
     return storage->count(includeDisabled, includeDead);
 }
 
+sugoi_timestamp_t sugoiS_get_timestamp(sugoi_storage_t* storage)
+{
+    return storage->timestamp();
+}
+
+sugoi_timestamp_t sugoiS_advance_timestamp(sugoi_storage_t* storage)
+{
+    return storage->advance_timestamp();
+}
+
+sugoi_timestamp_t sugoiS_get_groups_timestamp(sugoi_storage_t* storage)
+{
+    return storage->groups_timestamp();
+}
+
 void sugoi_set_bit(uint32_t* mask, int32_t bit)
 {
     // CAS
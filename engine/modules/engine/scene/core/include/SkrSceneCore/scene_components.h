@@ -17,6 +17,7 @@ class TransformSystem;
 namespace scene
 {
 struct TransformFromRootJob;
+struct TransformGatherJob;
 } // namespace scene
 } // namespace skr
 
@@ -81,6 +82,7 @@ public:
 
 private:
     friend struct TransformFromRootJob;
+    friend struct TransformGatherJob;
     friend class ::skr::TransformSystem;
     Rotator euler;
     mutable bool dirty;
@@ -123,6 +125,7 @@ public:
 
 private:
     friend struct TransformFromRootJob;
+    friend struct TransformGatherJob;
     friend class ::skr::TransformSystem;
     Position value;
     mutable bool dirty;
@@ -175,6 +178,7 @@ public:
 
 private:
     friend struct TransformFromRootJob;
+    friend struct TransformGatherJob;
     friend class ::skr::TransformSystem;
     skr::float3 value;
     mutable bool dirty;
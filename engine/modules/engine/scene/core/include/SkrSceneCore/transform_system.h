@@ -18,10 +18,17 @@ public:
     void update() SKR_NOEXCEPT;
     Context const* get_context() const SKR_NOEXCEPT;
 
+    // hierarchy level mode: entities are bucketed by depth, levels are processed in order with each
+    // level split across the task scheduler. a child is also updated when its parent moved
+    void set_hierarchy_level_mode(bool enable) SKR_NOEXCEPT;
+
 private:
     // 正向全量脏树传播：每帧调用，处理所有标记为脏的变换树，进行批量计算
     void CalculateFromRoot() SKR_NOEXCEPT;
 
+    // 分层传播：按层级深度分桶，逐层并行计算，父节点的世界变换从上一层的连续数组中读取
+    void CalculateByLevels() SKR_NOEXCEPT;
+
     // 反向触发：反向寻找最高的脏节点，一路计算下来，并且刷新所有的子树
     void CalculateTransform(sugoi_entity_t entity) SKR_NOEXCEPT;
 
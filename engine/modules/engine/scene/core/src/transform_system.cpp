@@ -2,9 +2,11 @@
 #include "SkrSceneCore/scene_components.h"
 #include "rtm/qvvf.h"
 #include "SkrContainers/hashmap.hpp"
+#include "SkrContainers/vector.hpp"
 #include "SkrRT/ecs/world.hpp"
 #include "SkrTask/parallel_for.hpp"
 #include "SkrSceneCore/transform_system.h"
+#include "SkrCore/log.h"
 
 namespace skr::scene
 {
@@ -85,6 +87,284 @@ struct TransformFromRootJob
     skr::ecs::RandomComponentReadWrite<skr::scene::TransformComponent> transform_accessor;
 };
 
+// transform hierarchy flattened by depth, level k covers [level_offsets[k], level_offsets[k + 1])
+// and parents always live in a previous level, so a level only reads finished world transforms
+struct TransformHierarchy
+{
+    static constexpr uint32_t kNoParent = UINT32_MAX;
+    // fewest nodes per task, a node is a single matrix multiply
+    static constexpr uint32_t kMinBatchSize = 64;
+
+    // entities that are unknown or moved to another parent since last update
+    struct Change
+    {
+        sugoi_entity_t entity;
+        sugoi_entity_t parent;
+        Transform local;
+    };
+
+    void apply_changes();
+    void propagate();
+
+    skr::Vector<sugoi_entity_t> entities;
+    skr::Vector<sugoi_entity_t> parent_entities;
+    skr::Vector<uint32_t> parents;
+    skr::Vector<uint32_t> level_offsets;
+    skr::Vector<Transform> locals;
+    skr::Vector<Transform> worlds;
+    // per entity flags, written from different tasks at different slots
+    skr::Vector<uint8_t> dirty;
+    skr::Vector<uint8_t> changed;
+    skr::Vector<uint8_t> seen;
+    // read only while tasks are running, rebuilt by apply_changes
+    skr::FlatHashMap<sugoi_entity_t, uint32_t> slots;
+
+    SMutexObject changes_mutex;
+    skr::Vector<Change> changes;
+    std::atomic_uint32_t seen_count = 0;
+
+    skr::task::event_t gather_done;
+    // held by the propagation of an update, the scatter units depend on it
+    skr::task::counter_t levels_done;
+};
+
+inline Transform local_transform(const skr::scene::PositionComponent& position,
+    const skr::scene::RotationComponent* rotation,
+    const skr::scene::ScaleComponent* scale)
+{
+    const TransformComponent local(
+        position.get(),
+        rotation ? skr::QuatF(rotation->get()) : skr::QuatF(0, 0, 0, 1),
+        scale ? scale->get() : skr_float3_t{ 1, 1, 1 });
+    return local.get();
+}
+
+// reads local transforms chunk by chunk into the hierarchy and records structural changes
+struct TransformGatherJob
+{
+    void build(skr::ecs::AccessBuilder& builder)
+    {
+        builder.has<scene::TransformComponent>()
+            .read(&TransformGatherJob::positions)
+            .optional_read(&TransformGatherJob::rotations)
+            .optional_read(&TransformGatherJob::scales)
+            .optional_read(&TransformGatherJob::parent_components);
+    }
+
+    void run(skr::ecs::TaskContext& Context)
+    {
+        SkrZoneScopedN("GatherTransforms");
+        skr::Vector<TransformHierarchy::Change> local_changes;
+        uint32_t seen_count = 0;
+        for (uint32_t i = 0; i < Context.size(); i++)
+        {
+            const auto entity = (sugoi_entity_t)Context.entities()[i];
+            const auto& Position = positions[i];
+            const auto pOptionalRotation = rotations.at(i);
+            const auto pOptionalScale = scales.at(i);
+            const auto pOptionalParent = parent_components.at(i);
+            const auto parent = pOptionalParent ? (sugoi_entity_t)pOptionalParent->entity : SUGOI_NULL_ENTITY;
+            const bool dirty = check_dirty(Position, pOptionalRotation, pOptionalScale);
+
+            auto found = hierarchy->slots.find(entity);
+            const bool moved = (found == hierarchy->slots.end()) || (hierarchy->parent_entities[found->second] != parent);
+            if (moved)
+            {
+                local_changes.add({ entity, parent, local_transform(Position, pOptionalRotation, pOptionalScale) });
+            }
+            else
+            {
+                const auto slot = found->second;
+                hierarchy->seen[slot] = 1;
+                seen_count += 1;
+                if (dirty)
+                {
+                    hierarchy->locals[slot] = local_transform(Position, pOptionalRotation, pOptionalScale);
+                    hierarchy->dirty[slot] = 1;
+                }
+            }
+
+            Position.dirty = false;
+            if (pOptionalRotation)
+                pOptionalRotation->dirty = false;
+            if (pOptionalScale)
+                pOptionalScale->dirty = false;
+        }
+        hierarchy->seen_count.fetch_add(seen_count, std::memory_order_relaxed);
+        if (!local_changes.is_empty())
+        {
+            SMutexLock Lock(hierarchy->changes_mutex.mMutex);
+            hierarchy->changes.append(local_changes);
+        }
+    }
+
+    TransformHierarchy* hierarchy = nullptr;
+    skr::ecs::ComponentView<const skr::scene::PositionComponent> positions;
+    skr::ecs::ComponentView<const skr::scene::RotationComponent> rotations;
+    skr::ecs::ComponentView<const skr::scene::ScaleComponent> scales;
+    skr::ecs::ComponentView<const skr::scene::ParentComponent> parent_components;
+};
+
+// writes world transforms changed by the level pass back to the components
+struct TransformScatterJob
+{
+    void build(skr::ecs::AccessBuilder& builder)
+    {
+        builder.has<scene::PositionComponent>()
+            .write(&TransformScatterJob::transforms);
+    }
+
+    void run(skr::ecs::TaskContext& Context)
+    {
+        SkrZoneScopedN("ScatterTransforms");
+        for (uint32_t i = 0; i < Context.size(); i++)
+        {
+            const auto entity = (sugoi_entity_t)Context.entities()[i];
+            auto found = hierarchy->slots.find(entity);
+            if (found != hierarchy->slots.end() && hierarchy->changed[found->second])
+                transforms[i].set(hierarchy->worlds[found->second]);
+        }
+    }
+
+    TransformHierarchy* hierarchy = nullptr;
+    skr::ecs::ComponentView<skr::scene::TransformComponent> transforms;
+};
+
+void TransformHierarchy::apply_changes()
+{
+    SkrZoneScopedN("ApplyHierarchyChanges");
+    const auto count = seen_count.exchange(0, std::memory_order_relaxed);
+    if (changes.is_empty() && count == entities.size())
+        return; // hierarchy unchanged
+
+    struct Node
+    {
+        sugoi_entity_t entity;
+        sugoi_entity_t parent;
+        Transform local;
+        Transform world;
+        uint8_t dirty;
+        uint32_t depth;
+    };
+    skr::Vector<Node> nodes;
+    nodes.reserve(count + changes.size());
+    for (uint32_t slot = 0; slot < entities.size(); ++slot)
+    {
+        // entities not gathered this update are destroyed or lost their transform
+        if (seen[slot])
+            nodes.add({ entities[slot], parent_entities[slot], locals[slot], worlds[slot], dirty[slot], 0 });
+    }
+    for (const auto& change : changes)
+        nodes.add({ change.entity, change.parent, change.local, change.local, 1, 0 });
+    changes.clear();
+
+    skr::FlatHashMap<sugoi_entity_t, uint32_t> node_of;
+    node_of.reserve(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+        node_of[nodes[i].entity] = i;
+
+    // depth of each node, resolved iteratively along the parent chain
+    static constexpr uint32_t kUnresolved = UINT32_MAX;
+    for (auto& node : nodes)
+        node.depth = kUnresolved;
+    skr::Vector<uint32_t> chain;
+    uint32_t level_count = 0;
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        uint32_t current = i;
+        while (nodes[current].depth == kUnresolved)
+        {
+            auto parent = node_of.find(nodes[current].parent);
+            if (parent == node_of.end())
+            {
+                // parents without a transform are treated as the world origin
+                if (nodes[current].parent != SUGOI_NULL_ENTITY && !slots.contains(nodes[current].parent))
+                    nodes[current].dirty = 1;
+                nodes[current].depth = 0;
+                break;
+            }
+            chain.add(current);
+            current = parent->second;
+            if (chain.size() > nodes.size())
+            {
+                SKR_LOG_ERROR(u8"cycle in transform hierarchy");
+                nodes[current].depth = 0;
+                break;
+            }
+        }
+        for (uint64_t j = chain.size(); j > 0; --j)
+        {
+            const auto child = chain[j - 1];
+            nodes[child].depth = nodes[current].depth + 1;
+            current = child;
+        }
+        chain.clear();
+        level_count = std::max(level_count, nodes[i].depth + 1);
+    }
+
+    // counting sort by depth
+    level_offsets.clear();
+    level_offsets.resize_zeroed(level_count + 1);
+    for (const auto& node : nodes)
+        level_offsets[node.depth + 1] += 1;
+    for (uint32_t level = 0; level < level_count; ++level)
+        level_offsets[level + 1] += level_offsets[level];
+    skr::Vector<uint32_t> cursor;
+    cursor.append(level_offsets.data(), level_count);
+    skr::Vector<uint32_t> new_slot_of;
+    new_slot_of.resize_unsafe(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+        new_slot_of[i] = cursor[nodes[i].depth]++;
+
+    const auto n = nodes.size();
+    entities.resize_unsafe(n);
+    parent_entities.resize_unsafe(n);
+    parents.resize_unsafe(n);
+    locals.resize_unsafe(n);
+    worlds.resize_unsafe(n);
+    dirty.resize_unsafe(n);
+    changed.resize_zeroed(n);
+    seen.resize_zeroed(n);
+    slots.clear();
+    slots.reserve(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const auto& node = nodes[i];
+        const auto slot = new_slot_of[i];
+        auto parent = node_of.find(node.parent);
+        entities[slot] = node.entity;
+        parent_entities[slot] = node.parent;
+        parents[slot] = (parent == node_of.end()) ? kNoParent : new_slot_of[parent->second];
+        locals[slot] = node.local;
+        worlds[slot] = node.world;
+        dirty[slot] = node.dirty;
+        slots[node.entity] = slot;
+    }
+}
+
+void TransformHierarchy::propagate()
+{
+    SkrZoneScopedN("PropagateTransformLevels");
+    apply_changes();
+    for (uint64_t level = 0; level + 1 < level_offsets.size(); ++level)
+    {
+        skr::parallel_for_adaptive(level_offsets[level], level_offsets[level + 1],
+            [this](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    const auto parent = parents[i];
+                    const bool parent_changed = (parent != kNoParent) && changed[parent];
+                    changed[i] = dirty[i] || parent_changed;
+                    if (changed[i])
+                        worlds[i] = (parent != kNoParent) ? worlds[parent] * locals[i] : locals[i];
+                    dirty[i] = 0;
+                    seen[i] = 0;
+                }
+            },
+            kMinBatchSize);
+    }
+}
+
 } // namespace skr::scene
 
 namespace skr
@@ -95,6 +375,12 @@ struct skr::TransformSystem::Impl
     skr::ecs::ECSWorld* pWorld = nullptr;
     sugoi_query_t* rootJobQuery = nullptr;
     skr::TransformSystem::Context context;
+
+    bool use_levels = false;
+    bool levels_pending = false;
+    sugoi_query_t* gatherJobQuery = nullptr;
+    sugoi_query_t* scatterJobQuery = nullptr;
+    skr::scene::TransformHierarchy hierarchy;
 };
 
 TransformSystem* TransformSystem::Create(skr::ecs::ECSWorld* world) SKR_NOEXCEPT
@@ -110,6 +396,8 @@ TransformSystem* TransformSystem::Create(skr::ecs::ECSWorld* world) SKR_NOEXCEPT
 void TransformSystem::Destroy(TransformSystem* system) SKR_NOEXCEPT
 {
     SkrZoneScopedN("FinalizeTransformSystem");
+    if (system->impl->levels_pending)
+        system->impl->context.update_finish.wait(false);
     system->impl->~Impl();
     system->~TransformSystem();
     sakura_free(system);
@@ -120,9 +408,17 @@ TransformSystem::Context const* TransformSystem::get_context() const SKR_NOEXCEP
     return &impl->context;
 }
 
+void TransformSystem::set_hierarchy_level_mode(bool enable) SKR_NOEXCEPT
+{
+    impl->use_levels = enable;
+}
+
 void TransformSystem::update() SKR_NOEXCEPT
 {
-    CalculateFromRoot();
+    if (impl->use_levels)
+        CalculateByLevels();
+    else
+        CalculateFromRoot();
 }
 
 void TransformSystem::CalculateFromRoot() SKR_NOEXCEPT
@@ -134,6 +430,40 @@ void TransformSystem::CalculateFromRoot() SKR_NOEXCEPT
     impl->rootJobQuery = impl->pWorld->dispatch_task(job, UINT32_MAX, impl->rootJobQuery, std::move(options));
 }
 
+void TransformSystem::CalculateByLevels() SKR_NOEXCEPT
+{
+    auto& hierarchy = impl->hierarchy;
+    // the level arrays are shared by the tasks of one update
+    if (impl->levels_pending)
+        impl->context.update_finish.wait(false);
+    impl->levels_pending = true;
+    impl->context.update_finish.clear();
+    hierarchy.gather_done.clear();
+    hierarchy.levels_done.add(1);
+
+    skr::ecs::TaskOptions gather_options;
+    gather_options.on_finishes.add(hierarchy.gather_done);
+    scene::TransformGatherJob gather;
+    gather.hierarchy = &hierarchy;
+    impl->gatherJobQuery = impl->pWorld->dispatch_task(gather, UINT32_MAX, impl->gatherJobQuery, std::move(gather_options));
+
+    // gather -> propagate -> scatter, the propagation follows the gather finish event
+    // and the scatter units depend on levels_done like on the ecs tasks before them
+    skr::task::schedule([&hierarchy]() {
+        SKR_DEFER({ hierarchy.levels_done.decrement(); });
+        hierarchy.gather_done.wait(false);
+        hierarchy.propagate();
+    },
+        nullptr);
+
+    skr::ecs::TaskOptions scatter_options;
+    scatter_options.dependencies.add(hierarchy.levels_done);
+    scatter_options.on_finishes.add(impl->context.update_finish);
+    scene::TransformScatterJob scatter;
+    scatter.hierarchy = &hierarchy;
+    impl->scatterJobQuery = impl->pWorld->dispatch_task(scatter, UINT32_MAX, impl->scatterJobQuery, std::move(scatter_options));
+}
+
 void TransformSystem::CalculateTransform(sugoi_entity_t entity) SKR_NOEXCEPT
 {
     SkrZoneScopedN("CalculateTransform");
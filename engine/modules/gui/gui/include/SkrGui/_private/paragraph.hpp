@@ -1,6 +1,7 @@
 #pragma once
 #include "SkrGui/backend/text/paragraph.hpp"
 #include "backend/text_server/text_paragraph.h"
+#include "backend/text_server/shaped_text_cache.h"
 #ifndef __meta__
     #include "SkrGui/_private/paragraph.generated.h"
 #endif
@@ -21,6 +22,7 @@ _EmbeddedParagraph : public godot::TextParagraph,
     SKR_GENERATE_BODY(_EmbeddedParagraph)
 
     _EmbeddedParagraph();
+    ~_EmbeddedParagraph();
 
     void  clear() override;
     void  build() override;
@@ -32,7 +34,12 @@ private:
     void _draw(godot::TextServer::TextDrawProxy* proxy, const skr_float2_t& p_pos, const godot::Color& p_color, const godot::Color& p_dc_color);
 
 private:
-    Array<String> _texts = {}; // TODO. inline
-    bool          _dirty = false;
+    Array<String> _texts       = {}; // TODO. inline
+    Array<String> _built_texts = {};
+
+    // shaped text shared through godot::ShapedTextCache, rebuilt only when the key changes
+    godot::ShapedTextCacheKey           _shaped_key = {};
+    godot::Ref<godot::ShapedTextBuffer> _shaped     = {};
+    godot::RID                          _own_rid    = {};
 };
 } // namespace skr::gui
\ No newline at end of file
@@ -16,4 +16,16 @@ SKR_GUI_API void embedded_init_text_service(INativeDevice* native_device);
 SKR_GUI_API NotNull<IParagraph*> embedded_create_paragraph();
 SKR_GUI_API void                 embedded_destroy_paragraph(NotNull<IParagraph*> paragraph);
 SKR_GUI_API void                 embedded_shutdown_text_service();
+
+// shaping cache shared by every embedded paragraph
+struct EmbeddedTextCacheStats {
+    uint64_t hits      = 0;
+    uint64_t misses    = 0;
+    uint64_t evictions = 0;
+    uint64_t size      = 0;
+    double   hit_rate  = 0.0;
+};
+SKR_GUI_API EmbeddedTextCacheStats embedded_text_cache_stats();
+SKR_GUI_API void                   embedded_reset_text_cache_stats();
+SKR_GUI_API void                   embedded_set_text_cache_capacity(uint64_t capacity);
 } // namespace skr::gui
\ No newline at end of file
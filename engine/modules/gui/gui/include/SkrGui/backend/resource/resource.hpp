@@ -29,6 +29,10 @@ struct UpdatableImageDesc {
     Sizei               size      = {};
     uint32_t            mip_count = 0;
     Span<const uint8_t> data      = {};
+
+    // rows [dirty_row_begin, dirty_row_end) changed since last update, empty means the whole image
+    int32_t dirty_row_begin = 0;
+    int32_t dirty_row_end   = 0;
 };
 
 enum class EResourceState : uint32_t
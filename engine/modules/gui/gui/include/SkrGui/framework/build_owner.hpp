@@ -2,6 +2,7 @@
 #include "SkrGui/fwd_config.hpp"
 #include "SkrGui/framework/key.hpp"
 #include "SkrGui/framework/fwd_framework.hpp"
+#include "SkrOS/thread.h"
 #ifndef __meta__
     #include "SkrGui/framework/build_owner.generated.h"
 #endif
@@ -36,6 +37,17 @@ SKR_GUI_API BuildOwner final {
     inline void set_timer_manager(TimerManager* timer_manager) SKR_NOEXCEPT { _timer_manager = timer_manager; }
     inline void set_input_manager(InputManager* input_manager) SKR_NOEXCEPT { _input_manager = input_manager; }
 
+    // parallel layout
+    // dirty relayout boundaries without a dirty ancestor own disjoint subtrees, they are laid out concurrently
+    // on the task scheduler (which must be initialized), nested boundaries follow in later waves
+    // waves with less than min_nodes boundaries are laid out on the calling thread
+    inline void set_parallel_layout(bool enable, uint32_t min_nodes = 4) SKR_NOEXCEPT
+    {
+        _parallel_layout           = enable;
+        _parallel_layout_min_nodes = min_nodes;
+    }
+    inline bool parallel_layout() const SKR_NOEXCEPT { return _parallel_layout; }
+
     // register
     void register_native_window(NotNull<RenderNativeWindowElement*> native_window);
     void unregister_native_window(NotNull<RenderNativeWindowElement*> native_window);
@@ -43,12 +55,20 @@ SKR_GUI_API BuildOwner final {
     // TODO. build 过程中的 element 回收
     inline void drop_unmount_element(NotNull<Element*> element) SKR_NOEXCEPT {}
 
+private:
+    void _flush_layout_parallel();
+
 private:
     // dirty array
     Array<Element*>      _dirty_elements       = {};
     Array<RenderObject*> _nodes_needing_layout = {};
     Array<RenderObject*> _nodes_needing_paint  = {};
 
+    // parallel layout, render objects may schedule layout & paint from layout tasks
+    bool         _parallel_layout           = false;
+    uint32_t     _parallel_layout_min_nodes = 4;
+    SMutexObject _schedule_mutex            = {};
+
     // service
     TimerManager* _timer_manager = nullptr;
     InputManager* _input_manager = nullptr;
@@ -6,6 +6,8 @@
 
 namespace skr::gui
 {
+// retains the tessellated output of its canvas until it is recorded again, moving the
+// owner repaint boundary only changes the parent offset layer, the geometry is reused
 sreflect_struct(guid = "1d1fbcab-eb50-4a22-99f6-59c5f4aca3e9")
 GeometryLayer : public Layer {
     SKR_GENERATE_BODY(GeometryLayer)
@@ -13,12 +15,17 @@ GeometryLayer : public Layer {
 
     // lifecycle & tree
     // ctor -> mount <-> unmount -> destroy
+    void destroy() SKR_NOEXCEPT override;
     void attach(NotNull<BuildOwner*> owner) SKR_NOEXCEPT override;
     void visit_children(VisitFuncRef visitor) const SKR_NOEXCEPT override;
 
+    // drop retained geometry before recording again
+    void reset_canvas() SKR_NOEXCEPT;
+
     inline ICanvas* canvas() const SKR_NOEXCEPT { return _canvas; }
 
 private:
-    ICanvas* _canvas = nullptr;
+    INativeDevice* _device = nullptr;
+    ICanvas*       _canvas = nullptr;
 };
-} // namespace skr::gui
\ No newline at end of file
+} // namespace skr::gui
@@ -25,6 +25,7 @@ SKR_GUI_API Layer : virtual public skr::IObject {
     void        mark_needs_composite() SKR_NOEXCEPT;
     inline bool needs_composite() const SKR_NOEXCEPT { return _needs_composite; }
     inline void cancel_needs_composite() SKR_NOEXCEPT { _needs_composite = false; }
+    void        cancel_needs_composite_recursive() SKR_NOEXCEPT;
 
     // getter
     inline Layer*      parent() const SKR_NOEXCEPT { return _parent; }
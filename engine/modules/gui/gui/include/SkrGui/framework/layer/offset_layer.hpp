@@ -11,7 +11,14 @@ sreflect_struct(guid = "67c40c35-4cb7-48f1-b790-e29fe843c29a")
 SKR_GUI_API OffsetLayer : public ContainerLayer {
     SKR_GENERATE_BODY(OffsetLayer)
 
-    inline void    set_offset(Offsetf offset) noexcept { _offset = offset; }
+    inline void set_offset(Offsetf offset) noexcept
+    {
+        if (_offset != offset)
+        {
+            _offset = offset;
+            mark_needs_composite();
+        }
+    }
     inline Offsetf offset() const noexcept { return _offset; }
 
 private:
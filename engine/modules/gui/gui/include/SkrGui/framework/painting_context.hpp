@@ -25,11 +25,17 @@ private:
     void _start_recording() SKR_NOEXCEPT;
     void _stop_recording() SKR_NOEXCEPT;
     void _composite_child(NotNull<RenderObject*> child, Offsetf offset) SKR_NOEXCEPT;
+    void _release_recycled_layers() SKR_NOEXCEPT;
+
+    static void _take_geometry_layers(NotNull<ContainerLayer*> layer, Array<GeometryLayer*>& out) SKR_NOEXCEPT;
     void _append_layer(NotNull<Layer*> layer);
     void _paint_with_context(NotNull<RenderObject*> render_object, Offsetf offset);
 
 private:
     ContainerLayer* _container_layer = nullptr;
     GeometryLayer*  _current_layer   = nullptr;
+
+    // geometry layers removed from _container_layer, reused by _start_recording()
+    Array<GeometryLayer*> _recycled_layers = {};
 };
 } // namespace skr::gui
\ No newline at end of file
@@ -4,14 +4,18 @@
 #include "SkrGui/_private/paragraph.hpp"
 #include "backend/text_server/text_paragraph.h"
 #include "backend/text_server/font.h"
+#include "backend/text_server/mutex.h"
 
 // TODO. font service
 #include <fstream>
 namespace skr::gui
 {
 static SP<godot::FontFile> _font = nullptr;
+static godot::Mutex        _font_mutex;
 void                       _init_font()
 {
+    // paragraphs may be created from layout tasks
+    godot::MutexLock lock(_font_mutex);
     if (!_font)
     {
         std::fstream file("./../resources/font/SourceSansPro-Regular.ttf", std::ios::in | std::ios::binary);
@@ -46,6 +50,17 @@ _EmbeddedParagraph::_EmbeddedParagraph()
 {
     // TODO. font service
     _init_font();
+    _own_rid = rid;
+}
+_EmbeddedParagraph::~_EmbeddedParagraph()
+{
+    // lines refer to the shared shaped text, free them before releasing it
+    for (const godot::RID& line_rid : lines_rid)
+    {
+        TS->free_rid(line_rid);
+    }
+    lines_rid.clear();
+    rid = _own_rid;
 }
 
 void _EmbeddedParagraph::clear()
@@ -54,25 +69,38 @@ void _EmbeddedParagraph::clear()
 }
 void _EmbeddedParagraph::build()
 {
-    if (_dirty)
+    if (_shaped.is_valid() && _texts == _built_texts)
     {
-        godot::TextParagraph::clear();
+        return;
+    }
 
-        for (const auto& text : _texts)
-        {
-            auto font = _font.cast_static<godot::Font>();
-            auto ft   = godot::Ref<godot::Font>(font);
-            this->add_string(godot::String::utf8(text.c_str_raw()), ft, 42, "", {});
-        }
+    godot::ShapedTextCacheKey key = {};
+    for (const auto& text : _texts)
+    {
+        auto font = _font.cast_static<godot::Font>();
+        auto ft   = godot::Ref<godot::Font>(font);
+        key.add_run(godot::String::utf8(text.c_str_raw()), ft, 42);
+    }
+    _built_texts = _texts;
+    if (_shaped.is_valid() && key == _shaped_key)
+    {
+        return;
+    }
 
-        _shape_lines();
-        _dirty = false;
+    for (const godot::RID& line_rid : lines_rid)
+    {
+        TS->free_rid(line_rid);
     }
+    lines_rid.clear();
+    _shaped     = godot::ShapedTextCache::get()->acquire(key);
+    _shaped_key = std::move(key);
+    rid         = _shaped->get_rid();
+    lines_dirty = true;
+    _shape_lines();
 }
 void _EmbeddedParagraph::add_text(const String& text, const TextStyle& style)
 {
     _texts.add(text);
-    _dirty = true;
 }
 Sizef _EmbeddedParagraph::layout(BoxConstraints constraints)
 {
@@ -46,6 +46,11 @@ void FontAtlasImage::flush_update() SKR_NOEXCEPT
         desc.size                         = _size;
         desc.mip_count                    = 0; // TODO. mip maps
         desc.data                         = { _data.data(), _data.size() };
+        if (_image != nullptr && _dirty_row_end > _dirty_row_begin && (_dirty_row_end - _dirty_row_begin) < _size.height)
+        {
+            desc.dirty_row_begin = _dirty_row_begin;
+            desc.dirty_row_end   = _dirty_row_end;
+        }
 
         if (_image == nullptr)
         {
@@ -56,7 +61,9 @@ void FontAtlasImage::flush_update() SKR_NOEXCEPT
         {
             _image->update(desc);
         }
-        _dirty = false;
+        _dirty           = false;
+        _dirty_row_begin = 0;
+        _dirty_row_end   = 0;
     }
 }
 
@@ -5,6 +5,7 @@
 #include "backend/text_server/godot_containers.hpp"
 #include "SkrGui/backend/resource/resource.hpp" // TODO. move to cpp
 #include "SkrGui/backend/embed_services.hpp"    // TODO. move to cpp
+#include <algorithm>
 
 namespace skr::gui
 {
@@ -57,12 +58,39 @@ struct FontAtlasImage {
         mark_dirty();
         return _data;
     }
+    // only rows [row_begin, row_end) will be written, they are uploaded alone if nothing else changed
+    inline PackedByteArray& data_for_write_rows(int32_t row_begin, int32_t row_end) SKR_NOEXCEPT
+    {
+        mark_dirty_rows(row_begin, row_end);
+        return _data;
+    }
     inline void set_data(Span<const uint8_t> data)
     {
         mark_dirty();
         _data.assign(data.data(), data.size());
     }
-    inline void   mark_dirty() SKR_NOEXCEPT { _dirty = true; }
+    inline void mark_dirty() SKR_NOEXCEPT
+    {
+        _dirty           = true;
+        _dirty_row_begin = 0;
+        _dirty_row_end   = _size.height;
+    }
+    inline void mark_dirty_rows(int32_t row_begin, int32_t row_end) SKR_NOEXCEPT
+    {
+        row_begin = std::max(row_begin, 0);
+        row_end   = std::min(row_end, _size.height);
+        if (_dirty)
+        {
+            _dirty_row_begin = std::min(_dirty_row_begin, row_begin);
+            _dirty_row_end   = std::max(_dirty_row_end, row_end);
+        }
+        else
+        {
+            _dirty           = true;
+            _dirty_row_begin = row_begin;
+            _dirty_row_end   = row_end;
+        }
+    }
     void          flush_update() SKR_NOEXCEPT;
     inline Image* render_image() const SKR_NOEXCEPT
     {
@@ -80,6 +108,8 @@ private:
     PackedByteArray _data      = {};
     Image*          _image     = nullptr;
     bool            _dirty     = true;
+    int32_t         _dirty_row_begin = 0;
+    int32_t         _dirty_row_end   = 0;
     RID             _rid       = {};
 };
 } // namespace godot
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "backend/text_server/shaped_text_cache.h"
+#include "backend/text_server/hashfuncs.h"
+
+namespace godot
+{
+// key
+void ShapedTextCacheKey::add_run(const String& p_text, const Ref<Font>& p_font, int p_font_size, const String& p_language)
+{
+    ShapedTextRun run;
+    run.text      = p_text;
+    run.font      = p_font;
+    run.font_size = p_font_size;
+    run.language  = p_language;
+
+    // features are unordered, spacing changes the shaped advances as well
+    uint32_t features_hash = 0;
+    if (p_font.is_valid())
+    {
+        for (const auto& E : p_font->get_opentype_features())
+        {
+            features_hash ^= hash_fmix32(hash_murmur3_one_32(E.second, hash_murmur3_one_32(E.first)));
+        }
+        for (int i = 0; i < TextServer::SPACING_MAX; i++)
+        {
+            features_hash = hash_murmur3_one_64(p_font->get_spacing(TextServer::SpacingType(i)), features_hash);
+        }
+    }
+    run.features_hash = features_hash;
+    runs.push_back(run);
+}
+
+bool ShapedTextCacheKey::operator==(const ShapedTextCacheKey& p_b) const
+{
+    if (direction != p_b.direction || orientation != p_b.orientation || runs.size() != p_b.runs.size())
+    {
+        return false;
+    }
+    for (int i = 0; i < runs.size(); i++)
+    {
+        if (!(runs[i] == p_b.runs[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t ShapedTextCacheKeyHasher::operator()(const ShapedTextCacheKey& p_key) const
+{
+    uint32_t hash = hash_murmur3_one_32((uint32_t)p_key.direction | ((uint32_t)p_key.orientation << 8));
+    for (int i = 0; i < p_key.runs.size(); i++)
+    {
+        const auto& run = p_key.runs[i];
+        hash            = hash_murmur3_one_32(run.text.hash(), hash);
+        hash            = hash_murmur3_one_64((uint64_t)run.font.get(), hash);
+        hash            = hash_murmur3_one_32(run.font_size, hash);
+        hash            = hash_murmur3_one_32(run.features_hash, hash);
+        hash            = hash_murmur3_one_32(run.language.hash(), hash);
+    }
+    return hash_fmix32(hash);
+}
+
+// buffer
+ShapedTextBuffer::ShapedTextBuffer()
+{
+}
+ShapedTextBuffer::~ShapedTextBuffer()
+{
+    if (rid.is_valid())
+    {
+        TS->free_rid(rid);
+    }
+}
+
+// cache
+ShapedTextCache* ShapedTextCache::get()
+{
+    static ShapedTextCache _cache;
+    return &_cache;
+}
+
+Ref<ShapedTextBuffer> ShapedTextCache::acquire(const ShapedTextCacheKey& p_key)
+{
+    {
+        MutexLock lock(mutex);
+        if (cache.contains(p_key))
+        {
+            // insert() moves the entry to the front of the lru queue, lookups alone don't
+            Ref<ShapedTextBuffer> buffer = cache.lookup(p_key);
+            cache.insert(p_key, buffer);
+            ++stats.hits;
+            return buffer;
+        }
+        ++stats.misses;
+    }
+
+    // shape outside of the lock, paragraphs may be laid out from several threads
+    Ref<ShapedTextBuffer> buffer;
+    buffer.instantiate();
+    buffer->rid = TS->create_shaped_text(p_key.direction, p_key.orientation);
+    for (int i = 0; i < p_key.runs.size(); i++)
+    {
+        const auto& run = p_key.runs[i];
+        ERR_CONTINUE(run.font.is_null());
+        TS->shaped_text_add_string(buffer->rid, run.text, run.font->get_rids(), run.font_size, run.font->get_opentype_features(), run.language);
+        for (int j = 0; j < TextServer::SPACING_MAX; j++)
+        {
+            TS->shaped_text_set_spacing(buffer->rid, TextServer::SpacingType(j), run.font->get_spacing(TextServer::SpacingType(j)));
+        }
+    }
+    TS->shaped_text_shape(buffer->rid);
+
+    MutexLock lock(mutex);
+    if (cache.contains(p_key))
+    {
+        // shaped by another thread meanwhile, share its result
+        Ref<ShapedTextBuffer> shared = cache.lookup(p_key);
+        cache.insert(p_key, shared);
+        return shared;
+    }
+    const auto size_before = cache.size();
+    cache.insert(p_key, buffer);
+    if (cache.size() == size_before)
+    {
+        ++stats.evictions;
+    }
+    return buffer;
+}
+
+void ShapedTextCache::set_capacity(uint64_t p_capacity)
+{
+    MutexLock lock(mutex);
+    cache.capacity(p_capacity);
+}
+
+void ShapedTextCache::clear()
+{
+    MutexLock lock(mutex);
+    cache.clear();
+}
+
+ShapedTextCache::Stats ShapedTextCache::get_stats() const
+{
+    MutexLock lock(mutex);
+    Stats result = stats;
+    result.size  = cache.size();
+    return result;
+}
+
+void ShapedTextCache::reset_stats()
+{
+    MutexLock lock(mutex);
+    stats = {};
+}
+} // namespace godot
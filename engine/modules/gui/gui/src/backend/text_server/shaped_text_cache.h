@@ -0,0 +1,85 @@
+#pragma once
+#include "backend/text_server/text_server.h"
+#include "backend/text_server/text_line.h"
+#include "backend/text_server/text_paragraph.h"
+#include "backend/text_server/font.h"
+#include "backend/text_server/mutex.h"
+#include "SkrBase/containers/lru/lru.hpp"
+
+namespace godot
+{
+// one add_string() call of a shaped text
+struct ShapedTextRun {
+    String    text;
+    Ref<Font> font;
+    int       font_size     = 0;
+    uint32_t  features_hash = 0;
+    String    language;
+
+    bool operator==(const ShapedTextRun& p_b) const
+    {
+        return (font == p_b.font) && (font_size == p_b.font_size) && (features_hash == p_b.features_hash) && (text == p_b.text) && (language == p_b.language);
+    }
+};
+
+struct ShapedTextCacheKey {
+    Vector<ShapedTextRun>   runs;
+    TextServer::Direction   direction   = TextServer::DIRECTION_AUTO;
+    TextServer::Orientation orientation = TextServer::ORIENTATION_HORIZONTAL;
+
+    void add_run(const String& p_text, const Ref<Font>& p_font, int p_font_size, const String& p_language = "");
+
+    bool operator==(const ShapedTextCacheKey& p_b) const;
+    bool operator!=(const ShapedTextCacheKey& p_b) const { return !(*this == p_b); }
+};
+
+struct ShapedTextCacheKeyHasher {
+    size_t operator()(const ShapedTextCacheKey& p_key) const;
+};
+
+// owns a shaped text, the text server rid is freed with the last reference
+// lines created by shaped_text_substr() refer to it, so they must be freed before it is released
+class ShapedTextBuffer
+{
+public:
+    ShapedTextBuffer();
+    ~ShapedTextBuffer();
+
+    RID get_rid() const { return rid; }
+
+private:
+    friend class ShapedTextCache;
+    RID rid;
+};
+
+// shares the shaping result of identical texts (text + font + size + features + language) between
+// paragraphs, entries are evicted in lru order but stay alive while a paragraph still references them
+class ShapedTextCache
+{
+public:
+    struct Stats {
+        uint64_t hits      = 0;
+        uint64_t misses    = 0;
+        uint64_t evictions = 0;
+        uint64_t size      = 0;
+
+        double hit_rate() const { return (hits + misses) ? (double)hits / (double)(hits + misses) : 0.0; }
+    };
+
+    static ShapedTextCache* get();
+
+    Ref<ShapedTextBuffer> acquire(const ShapedTextCacheKey& p_key);
+
+    void  set_capacity(uint64_t p_capacity);
+    void  clear();
+    Stats get_stats() const;
+    void  reset_stats();
+
+private:
+    using Cache = skr::container::LRU::Cache<ShapedTextCacheKey, Ref<ShapedTextBuffer>, ShapedTextCacheKeyHasher>;
+
+    mutable Mutex mutex;
+    Cache         cache = Cache(1024);
+    Stats         stats;
+};
+} // namespace godot
@@ -1,6 +1,7 @@
 #include "SkrCore/memory/memory.h"
 #include "SkrGui/_private/paragraph.hpp"
 #include "backend/text_server_adv/text_server_adv.h"
+#include "backend/text_server/shaped_text_cache.h"
 
 namespace godot
 {
@@ -34,6 +35,27 @@ void embedded_destroy_paragraph(NotNull<IParagraph*> paragraph)
 }
 void embedded_shutdown_text_service()
 {
+    // cached shaped texts are freed by the text server
+    godot::ShapedTextCache::get()->clear();
     SkrDelete(godot::_text_server());
 }
+EmbeddedTextCacheStats embedded_text_cache_stats()
+{
+    const auto             stats  = godot::ShapedTextCache::get()->get_stats();
+    EmbeddedTextCacheStats result = {};
+    result.hits                   = stats.hits;
+    result.misses                 = stats.misses;
+    result.evictions              = stats.evictions;
+    result.size                   = stats.size;
+    result.hit_rate               = stats.hit_rate();
+    return result;
+}
+void embedded_reset_text_cache_stats()
+{
+    godot::ShapedTextCache::get()->reset_stats();
+}
+void embedded_set_text_cache_capacity(uint64_t capacity)
+{
+    godot::ShapedTextCache::get()->set_capacity(capacity);
+}
 } // namespace skr::gui
\ No newline at end of file
@@ -957,7 +957,7 @@ _WHY_GODOT_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_b
     ShelfPackTexture& tex = p_data->textures[tex_pos.index];
 
     {
-        uint8_t* wr = tex.atlas->data_for_write().ptrw();
+        uint8_t* wr = tex.atlas->data_for_write_rows(tex_pos.y, tex_pos.y + mh).ptrw();
 
         for (int i = 0; i < h; i++)
         {
@@ -1030,8 +1030,6 @@ _WHY_GODOT_INLINE_ TextServerAdvanced::FontGlyph TextServerAdvanced::rasterize_b
         }
     }
 
-    tex.atlas->mark_dirty();
-
     FontGlyph chr;
     chr.advance     = advance * p_data->scale / p_data->oversampling;
     chr.texture_idx = tex_pos.index;
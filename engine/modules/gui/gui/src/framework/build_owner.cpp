@@ -5,6 +5,7 @@
 #include "SkrGui/system/input/input_manager.hpp"
 #include "SkrGui/framework/element/render_native_window_element.hpp"
 #include "SkrGui/framework/render_object/render_native_window.hpp"
+#include "SkrTask/parallel_for.hpp"
 
 namespace skr::gui
 {
@@ -20,10 +21,12 @@ void BuildOwner::schedule_build_for(NotNull<Element*> element) SKR_NOEXCEPT
 }
 void BuildOwner::schedule_layout_for(NotNull<RenderObject*> node) SKR_NOEXCEPT
 {
+    SMutexLock lock(_schedule_mutex.mMutex);
     _nodes_needing_layout.add(node);
 }
 void BuildOwner::schedule_paint_for(NotNull<RenderObject*> node) SKR_NOEXCEPT
 {
+    SMutexLock lock(_schedule_mutex.mMutex);
     _nodes_needing_paint.add(node);
 }
 
@@ -48,6 +51,12 @@ void BuildOwner::flush_build() SKR_NOEXCEPT
 }
 void BuildOwner::flush_layout()
 {
+    if (_parallel_layout)
+    {
+        _flush_layout_parallel();
+        return;
+    }
+
     _nodes_needing_layout.sort(
     +[](RenderObject* a, RenderObject* b) {
         return a->depth() < b->depth();
@@ -65,6 +74,97 @@ void BuildOwner::flush_layout()
 
     _nodes_needing_layout.clear();
 }
+void BuildOwner::_flush_layout_parallel()
+{
+    struct _Helper {
+        static bool has_dirty_ancestor(RenderObject* node) SKR_NOEXCEPT
+        {
+            for (auto parent = node->parent(); parent; parent = parent->parent())
+            {
+                if (parent->needs_layout()) return true;
+            }
+            return false;
+        }
+        static void layout(RenderObject* node) SKR_NOEXCEPT
+        {
+            node->perform_layout();
+            node->cancel_needs_layout();
+        }
+    };
+
+    Array<RenderObject*> pending     = {};
+    Array<RenderObject*> independent = {};
+    Array<RenderObject*> nested      = {};
+    while (true)
+    {
+        // nodes may be scheduled while laying out, keep flushing until it settles
+        {
+            SMutexLock lock(_schedule_mutex.mMutex);
+            if (_nodes_needing_layout.is_empty()) break;
+            pending = std::move(_nodes_needing_layout);
+            _nodes_needing_layout.clear();
+        }
+        pending.sort(
+        +[](RenderObject* a, RenderObject* b) {
+            return a->depth() < b->depth();
+        });
+
+        while (!pending.is_empty())
+        {
+            // split into disjoint subtrees and boundaries nested in one of them
+            independent.clear();
+            nested.clear();
+            for (auto node : pending)
+            {
+                if (node->needs_layout() && node->owner() == this)
+                {
+                    (_Helper::has_dirty_ancestor(node) ? nested : independent).add(node);
+                }
+            }
+
+            // dirty ancestor never laid out by anyone, fallback to serial order
+            if (independent.is_empty())
+            {
+                for (auto node : nested)
+                {
+                    if (node->needs_layout())
+                    {
+                        _Helper::layout(node);
+                        node->mark_needs_paint();
+                    }
+                }
+                break;
+            }
+
+            // mark paint up front, walks started inside the subtrees stop at their boundary instead of
+            // racing on the shared ancestors
+            for (auto node : independent)
+            {
+                node->mark_needs_paint();
+            }
+
+            if (independent.size() < _parallel_layout_min_nodes)
+            {
+                for (auto node : independent)
+                {
+                    _Helper::layout(node);
+                }
+            }
+            else
+            {
+                skr::parallel_for(independent.begin(), independent.end(), 1,
+                    [](auto begin, auto end) {
+                        for (auto it = begin; it != end; ++it)
+                        {
+                            _Helper::layout(*it);
+                        }
+                    });
+            }
+
+            std::swap(pending, nested);
+        }
+    }
+}
 void BuildOwner::flush_paint()
 {
     _nodes_needing_paint.sort(
@@ -14,6 +14,7 @@ void ContainerLayer::add_child(NotNull<Layer*> child) SKR_NOEXCEPT
 {
     child->mount(this);
     _children.add(child);
+    mark_needs_composite();
 }
 bool ContainerLayer::has_children() const SKR_NOEXCEPT
 {
@@ -26,5 +27,6 @@ void ContainerLayer::remove_all_children() SKR_NOEXCEPT
         child->unmount();
     }
     _children.clear();
+    mark_needs_composite();
 }
 } // namespace skr::gui
\ No newline at end of file
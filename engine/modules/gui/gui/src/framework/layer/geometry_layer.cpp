@@ -1,16 +1,41 @@
 #include "SkrGui/framework/layer/geometry_layer.hpp"
 #include "SkrGui/backend/device/device.hpp"
+#include "SkrGui/backend/canvas/canvas.hpp"
 #include "SkrGui/framework/build_owner.hpp"
 
 namespace skr::gui
 {
+void GeometryLayer::destroy() SKR_NOEXCEPT
+{
+    if (_canvas)
+    {
+        _device->destroy_canvas(_canvas);
+        _canvas = nullptr;
+    }
+    Super::destroy();
+}
 void GeometryLayer::attach(NotNull<BuildOwner*> owner) SKR_NOEXCEPT
 {
     Super::attach(owner);
-    _canvas = owner->native_device()->create_canvas();
+
+    // canvas survives remount, so does the geometry recorded in it
+    if (!_canvas)
+    {
+        _device = owner->native_device();
+        _canvas = _device->create_canvas();
+    }
 }
 void GeometryLayer::visit_children(VisitFuncRef visitor) const SKR_NOEXCEPT
 {
 }
 
-} // namespace skr::gui
\ No newline at end of file
+void GeometryLayer::reset_canvas() SKR_NOEXCEPT
+{
+    if (_canvas)
+    {
+        _canvas->clear();
+    }
+    mark_needs_composite();
+}
+
+} // namespace skr::gui
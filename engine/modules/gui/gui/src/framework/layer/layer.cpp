@@ -48,6 +48,7 @@ void Layer::unmount() SKR_NOEXCEPT
     if (_parent == nullptr) { SKR_GUI_LOG_ERROR(u8"already unmounted"); }
 
     // unmount
+    if (_parent) { _parent->mark_needs_composite(); }
     _parent = nullptr;
     if (owner())
     {
@@ -58,7 +59,7 @@ void Layer::unmount() SKR_NOEXCEPT
                 obj->visit_children(_RecursiveHelper{});
             }
         };
-        this->visit_children(_RecursiveHelper{});
+        _RecursiveHelper{}(this);
     }
 }
 void Layer::destroy() SKR_NOEXCEPT
@@ -83,17 +84,24 @@ void Layer::detach() SKR_NOEXCEPT
 // dirty
 void Layer::mark_needs_composite() SKR_NOEXCEPT
 {
-    if (!_needs_composite)
+    // TODO. schedule composite
+    Layer* node = this;
+    while (node)
     {
-        // TODO. schedule composite
-        _needs_composite = true;
-    }
-
-    auto parent = _parent;
-    while (parent)
-    {
-        parent->mark_needs_composite();
+        node->_needs_composite = true;
+        node                   = node->_parent;
     }
 }
+void Layer::cancel_needs_composite_recursive() SKR_NOEXCEPT
+{
+    struct _RecursiveHelper {
+        void operator()(NotNull<Layer*> obj) const SKR_NOEXCEPT
+        {
+            obj->cancel_needs_composite();
+            obj->visit_children(_RecursiveHelper{});
+        }
+    };
+    _RecursiveHelper{}(this);
+}
 
 } // namespace skr::gui
\ No newline at end of file
@@ -42,26 +42,25 @@ void PaintingContext::add_layer(NotNull<Layer*> layer) SKR_NOEXCEPT
 }
 void PaintingContext::push_layer(NotNull<ContainerLayer*> layer, ChildPaintingCallback callback, Offsetf offset) SKR_NOEXCEPT
 {
-    if (layer->has_children())
-    {
-        layer->remove_all_children();
-    }
+    PaintingContext ctx(layer);
+    _take_geometry_layers(layer, ctx._recycled_layers);
     _stop_recording();
     _append_layer(layer);
 
-    PaintingContext ctx(layer);
     callback(ctx, offset);
     ctx._stop_recording();
+    ctx._release_recycled_layers();
 }
 
 // repaint layer or just update properties
 void PaintingContext::repaint_composited_child(NotNull<RenderObject*> child)
 {
     // update layer
-    auto child_layer = child->layer()->type_cast_fast<OffsetLayer>();
+    Array<GeometryLayer*> recycled_layers;
+    auto                  child_layer = child->layer() ? child->layer()->type_cast_fast<OffsetLayer>() : nullptr;
     if (child_layer)
     {
-        child_layer->remove_all_children();
+        _take_geometry_layers(child_layer, recycled_layers);
         child_layer = child->update_layer(child_layer);
     }
     else
@@ -73,8 +72,10 @@ void PaintingContext::repaint_composited_child(NotNull<RenderObject*> child)
 
     // paint
     PaintingContext ctx(child_layer);
+    ctx._recycled_layers = std::move(recycled_layers);
     ctx._paint_with_context(child, Offsetf::Zero());
     ctx._stop_recording();
+    ctx._release_recycled_layers();
 }
 void PaintingContext::update_layer_properties(NotNull<RenderObject*> child)
 {
@@ -90,8 +91,18 @@ bool PaintingContext::_is_recording() const SKR_NOEXCEPT
 }
 void PaintingContext::_start_recording() SKR_NOEXCEPT
 {
-    _current_layer = SkrNew<GeometryLayer>();
-    _container_layer->add_child(_current_layer);
+    // reuse layers of the last paint, keeps their canvas and avoids creating a nvg context per repaint
+    if (!_recycled_layers.is_empty())
+    {
+        _current_layer = _recycled_layers.pop_back_get();
+        _container_layer->add_child(_current_layer);
+        _current_layer->reset_canvas();
+    }
+    else
+    {
+        _current_layer = SkrNew<GeometryLayer>();
+        _container_layer->add_child(_current_layer);
+    }
 }
 void PaintingContext::_stop_recording() SKR_NOEXCEPT
 {
@@ -115,6 +126,30 @@ void PaintingContext::_composite_child(NotNull<RenderObject*> child, Offsetf off
     child_offset_layer->set_offset(offset);
     _append_layer(child_offset_layer);
 }
+void PaintingContext::_take_geometry_layers(NotNull<ContainerLayer*> layer, Array<GeometryLayer*>& out) SKR_NOEXCEPT
+{
+    if (!layer->has_children()) return;
+
+    // reversed, so pop_back() hands them out in the old paint order
+    const auto children = layer->children();
+    for (uint64_t i = children.size(); i > 0; --i)
+    {
+        if (auto geometry_layer = children[i - 1]->type_cast_fast<GeometryLayer>())
+        {
+            out.add(geometry_layer);
+        }
+    }
+    layer->remove_all_children();
+}
+void PaintingContext::_release_recycled_layers() SKR_NOEXCEPT
+{
+    for (auto layer : _recycled_layers)
+    {
+        layer->destroy();
+        SkrDelete(layer);
+    }
+    _recycled_layers.clear();
+}
 void PaintingContext::_append_layer(NotNull<Layer*> layer)
 {
     layer->unmount();
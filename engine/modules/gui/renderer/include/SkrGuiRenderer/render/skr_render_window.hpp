@@ -10,7 +10,9 @@
 namespace skr::gui
 {
 struct SkrRenderDevice;
+struct Layer;
 struct NativeWindowLayer;
+struct ICanvas;
 
 struct SKR_GUI_RENDERER_API SkrRenderWindow final {
     SkrRenderWindow(SkrRenderDevice* owner, SDL_Window* window);
@@ -20,6 +22,9 @@ struct SKR_GUI_RENDERER_API SkrRenderWindow final {
     void render(const NativeWindowLayer* layer, Sizef window_size);
     void present();
 
+    // layer tree changed, draw data is rebuilt on next render()
+    inline void mark_content_dirty() SKR_NOEXCEPT { _content_dirty = true; }
+
 private:
     void _prepare_draw_data(const NativeWindowLayer* layer, Sizef window_size);
     void _upload_draw_data();
@@ -69,6 +74,15 @@ private:
     };
     Array<DrawCommand> _commands;
 
+    void        _collect_layer(const Layer* layer, Offsetf offset);
+    void        _append_geometry(const ICanvas* canvas, Offsetf offset);
+    static bool _can_batch(const DrawCommand& last, const DrawCommand& cmd);
+
+    // batching & cache
+    uint64_t _vertex_segment_begin = 0;
+    bool     _content_dirty        = true;
+    Sizef    _content_size         = {};
+
     // buffer
     skr::render_graph::BufferHandle _vertex_buffer      = {};
     skr::render_graph::BufferHandle _index_buffer       = {};
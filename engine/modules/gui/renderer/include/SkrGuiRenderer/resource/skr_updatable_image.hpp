@@ -38,6 +38,8 @@ private:
     CGPUTextureId     _texture      = nullptr;
     CGPUTextureViewId _texture_view = nullptr;
     CGPUXBindTableId  _bind_table   = nullptr;
+    CGPUBufferId      _upload_buffer = nullptr;
+    size_t            _upload_size   = 0;
 
     UpdatableImageDesc _desc = {};
 
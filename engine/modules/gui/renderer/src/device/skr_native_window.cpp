@@ -126,6 +126,7 @@ void SkrNativeWindow::set_absolute_size(Sizef absolute) SKR_NOEXCEPT
 void SkrNativeWindow::update_content(WindowLayer* root_layer) SKR_NOEXCEPT
 {
     _native_layer = root_layer->type_cast_fast<NativeWindowLayer>();
+    if (_render_window) { _render_window->mark_content_dirty(); }
 }
 void SkrNativeWindow::take_focus() SKR_NOEXCEPT
 {
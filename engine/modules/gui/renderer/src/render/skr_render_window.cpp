@@ -13,6 +13,7 @@
 #include "SkrBase/misc/make_zeroed.hpp"
 #include "SkrGui/framework/layer/native_window_layer.hpp"
 #include "SkrBase/math.h"
+#include <limits>
 
 namespace skr::gui
 {
@@ -97,8 +98,23 @@ void SkrRenderWindow::sync_window_size()
 
 void SkrRenderWindow::render(const NativeWindowLayer* layer, Sizef window_size)
 {
-    // step1. prepare draw data
-    _prepare_draw_data(layer, window_size);
+    // step1. prepare draw data, reused until the layer tree is composited again or the window resizes
+    if (_content_dirty || window_size != _content_size)
+    {
+        _prepare_draw_data(layer, window_size);
+        _content_dirty = false;
+        _content_size  = window_size;
+
+        // textured pipelines are chosen while preparing, rebuild until every texture has finished loading
+        for (const auto& cmd : _commands)
+        {
+            if (cmd.texture && cmd.texture->state() != EResourceState::Okey)
+            {
+                _content_dirty = true;
+                break;
+            }
+        }
+    }
 
     // step2. upload draw data
     _upload_draw_data();
@@ -119,6 +135,8 @@ void SkrRenderWindow::present()
 
 void SkrRenderWindow::_prepare_draw_data(const NativeWindowLayer* layer, Sizef window_size)
 {
+    SkrZoneScopedN("PrepareDrawData");
+
     // cleanup data
     _vertices.clear();
     _indices.clear();
@@ -126,33 +144,20 @@ void SkrRenderWindow::_prepare_draw_data(const NativeWindowLayer* layer, Sizef w
     _transforms.clear();
     _projections.clear();
     _render_data.clear();
+    _vertex_segment_begin = 0;
 
-    // copy data
-    auto canvas = layer->children().data()[0]->type_cast_fast<GeometryLayer>()->canvas();
-    _vertices.assign(canvas->vertices().data(), canvas->vertices().size());
-    _indices.assign(canvas->indices().data(), canvas->indices().size());
-    for (const auto& cmd : canvas->commands())
+    // make transform, layer offsets are baked into vertices, so all commands share it
     {
-        // copy command
-        DrawCommand draw_cmd     = {};
-        draw_cmd.texture         = cmd.texture;
-        draw_cmd.index_begin     = cmd.index_begin;
-        draw_cmd.index_count     = cmd.index_count;
-        draw_cmd.texture_swizzle = cmd.texture_swizzle;
-
-        // make transform
-        auto tb_cursor = _transforms.size();
-        {
-            auto&      transform = _transforms.add_default().ref();
-            TransformF t;
-            t.scale    = { 1.f, 1.f, 1.f };
-            t.position = { 0.f, 0.f, 0.f };
-            t.rotation = QuatF(RotatorF(0.f, 0.f, 0));
-            transform  = RtmConvert<float4x4>::to_rtm(t.to_matrix());
-        }
+        auto&      transform = _transforms.add_default().ref();
+        TransformF t;
+        t.scale    = { 1.f, 1.f, 1.f };
+        t.position = { 0.f, 0.f, 0.f };
+        t.rotation = QuatF(RotatorF(0.f, 0.f, 0));
+        transform  = RtmConvert<float4x4>::to_rtm(t.to_matrix());
+    }
 
-        // make projection
-        auto               pb_cursor    = _projections.size();
+    // make projection
+    {
         auto&              projection   = _projections.add_default().ref();
         const skr_float2_t zero_point   = { window_size.width * 0.5f, window_size.height * 0.5f };
         const skr_float2_t eye_position = { zero_point.x, zero_point.y };
@@ -171,19 +176,83 @@ void SkrRenderWindow::_prepare_draw_data(const NativeWindowLayer* layer, Sizef w
             1000.f
         );
         projection = rtm::matrix_mul(rtm::matrix_cast(view), proj);
+    }
+
+    // combine retained geometry of all layers, in paint order
+    _collect_layer(layer, Offsetf::Zero());
 
-        // make render data
+    // make render data
+    for (auto& draw_cmd : _commands)
+    {
         auto  rb_cursor        = _render_data.size();
         auto& render_data      = _render_data.add_default().ref();
-        render_data.rows[0][0] = static_cast<float>(cmd.texture_swizzle.r);
-        render_data.rows[0][1] = static_cast<float>(cmd.texture_swizzle.g);
-        render_data.rows[0][2] = static_cast<float>(cmd.texture_swizzle.b);
-        render_data.rows[0][3] = static_cast<float>(cmd.texture_swizzle.a);
-
-        // record buffer info
-        draw_cmd.transform_buffer_offset   = tb_cursor * sizeof(rtm::matrix4x4f);
-        draw_cmd.projection_buffer_offset  = pb_cursor * sizeof(rtm::matrix4x4f);
+        render_data.rows[0][0] = static_cast<float>(draw_cmd.texture_swizzle.r);
+        render_data.rows[0][1] = static_cast<float>(draw_cmd.texture_swizzle.g);
+        render_data.rows[0][2] = static_cast<float>(draw_cmd.texture_swizzle.b);
+        render_data.rows[0][3] = static_cast<float>(draw_cmd.texture_swizzle.a);
+
+        draw_cmd.transform_buffer_offset   = 0;
+        draw_cmd.projection_buffer_offset  = 0;
         draw_cmd.render_data_buffer_offset = rb_cursor * sizeof(skr_float4x4_t);
+    }
+}
+void SkrRenderWindow::_collect_layer(const Layer* layer, Offsetf offset)
+{
+    if (auto geometry_layer = layer->type_cast_fast<GeometryLayer>())
+    {
+        _append_geometry(geometry_layer->canvas(), offset);
+    }
+    else if (auto container_layer = layer->type_cast_fast<ContainerLayer>())
+    {
+        if (auto offset_layer = layer->type_cast_fast<OffsetLayer>())
+        {
+            offset = offset + offset_layer->offset();
+        }
+        for (auto child : container_layer->children())
+        {
+            _collect_layer(child, offset);
+        }
+    }
+}
+void SkrRenderWindow::_append_geometry(const ICanvas* canvas, Offsetf offset)
+{
+    if (!canvas || canvas->commands().size() == 0) return;
+
+    const auto vertices = canvas->vertices();
+    const auto indices  = canvas->indices();
+
+    // indices are 16 bit, start a new vertex segment (bound with a vertex buffer offset) before they overflow
+    if (_vertices.size() - _vertex_segment_begin + vertices.size() > (uint64_t)std::numeric_limits<PaintIndex>::max() + 1)
+    {
+        _vertex_segment_begin = _vertices.size();
+    }
+    const auto index_base  = static_cast<PaintIndex>(_vertices.size() - _vertex_segment_begin);
+    const auto index_start = _indices.size();
+
+    // copy geometry, only the offset is applied, the tessellated output is reused as is
+    _vertices.reserve(_vertices.size() + vertices.size());
+    for (const auto& vertex : vertices)
+    {
+        PaintVertex v = vertex;
+        v.position.x += offset.x;
+        v.position.y += offset.y;
+        _vertices.add(v);
+    }
+    _indices.reserve(_indices.size() + indices.size());
+    for (const auto index : indices)
+    {
+        _indices.add(static_cast<PaintIndex>(index + index_base));
+    }
+
+    for (const auto& cmd : canvas->commands())
+    {
+        // copy command
+        DrawCommand draw_cmd          = {};
+        draw_cmd.texture              = cmd.texture;
+        draw_cmd.index_begin          = index_start + cmd.index_begin;
+        draw_cmd.index_count          = cmd.index_count;
+        draw_cmd.texture_swizzle      = cmd.texture_swizzle;
+        draw_cmd.vertex_buffer_offset = _vertex_segment_begin * sizeof(PaintVertex);
 
         // flag
         if (draw_cmd.texture && draw_cmd.texture->state() == EResourceState::Okey)
@@ -191,9 +260,28 @@ void SkrRenderWindow::_prepare_draw_data(const NativeWindowLayer* layer, Sizef w
             draw_cmd.pipeline_flags = ESkrPipelineFlag(draw_cmd.pipeline_flags | ESkrPipelineFlag_Textured);
         }
 
-        _commands.add(draw_cmd);
+        // batch, merge into the previous draw when nothing but the index range differs
+        if (!_commands.is_empty() && _can_batch(_commands.at_last(), draw_cmd))
+        {
+            _commands.at_last().index_count += draw_cmd.index_count;
+        }
+        else
+        {
+            _commands.add(draw_cmd);
+        }
     }
 }
+bool SkrRenderWindow::_can_batch(const DrawCommand& last, const DrawCommand& cmd)
+{
+    return last.texture == cmd.texture &&
+           last.pipeline_flags == cmd.pipeline_flags &&
+           last.vertex_buffer_offset == cmd.vertex_buffer_offset &&
+           last.index_begin + last.index_count == cmd.index_begin &&
+           last.texture_swizzle.r == cmd.texture_swizzle.r &&
+           last.texture_swizzle.g == cmd.texture_swizzle.g &&
+           last.texture_swizzle.b == cmd.texture_swizzle.b &&
+           last.texture_swizzle.a == cmd.texture_swizzle.a;
+}
 void SkrRenderWindow::_upload_draw_data()
 {
     const uint64_t vertices_size    = _vertices.size() * sizeof(PaintVertex);
@@ -426,7 +514,7 @@ void SkrRenderWindow::_render()
 
             for (const auto& cmd : _commands)
             {
-                const bool     use_texture = cmd.texture && cmd.texture->state() == skr::gui::EResourceState::Okey;
+                const bool     use_texture = (cmd.pipeline_flags & ESkrPipelineFlag_Textured) != 0;
                 SkrPipelineKey key         = { cmd.pipeline_flags, target_desc->sample_count };
                 if (pipeline_key_cache != key)
                 {
@@ -15,6 +15,10 @@ SkrUpdatableImage::~SkrUpdatableImage()
     {
         cgpu_free_texture(_cgpu_texture);
     }
+    if (_upload_buffer)
+    {
+        cgpu_free_buffer(_upload_buffer);
+    }
 }
 
 EResourceState SkrUpdatableImage::state() const SKR_NOEXCEPT
@@ -39,6 +43,11 @@ void SkrUpdatableImage::destroy()
         cgpux_free_bind_table(_bind_table);
         _cgpu_texture = nullptr;
     }
+    if (_upload_buffer)
+    {
+        cgpu_free_buffer(_upload_buffer);
+        _upload_buffer = nullptr;
+    }
     _state = EResourceState::Destroyed;
     SkrDelete(this);
 }
@@ -56,7 +65,9 @@ EdgeInsetsf SkrUpdatableImage::nine_inset() const SKR_NOEXCEPT
 }
 void SkrUpdatableImage::update(const UpdatableImageDesc& desc)
 {
-    if (_cgpu_texture && (desc.size != _desc.size || _desc.format != desc.format))
+    // same size and format reuse the texture, its view and bind table, only the upload runs again
+    const bool recreate = !_cgpu_texture || desc.size != _desc.size || _desc.format != desc.format;
+    if (_cgpu_texture && recreate)
     {
         cgpu_wait_queue_idle(_render_device->cgpu_queue());
         cgpu_free_texture(_cgpu_texture);
@@ -73,39 +84,74 @@ void SkrUpdatableImage::update(const UpdatableImageDesc& desc)
     const char8_t* color_texture_name = u8"color_texture";
 
     // create texture
-    CGPUTextureDescriptor tex_desc = {};
-    tex_desc.name = color_texture_name;
-    tex_desc.width = static_cast<uint32_t>(desc.size.width);
-    tex_desc.height = static_cast<uint32_t>(desc.size.height);
-    tex_desc.depth = 1;
-    tex_desc.usages = CGPU_TEXTURE_USAGE_SHADER_READ;
-    tex_desc.array_size = 1;
-    tex_desc.flags = CGPU_TEXTURE_FLAG_NONE;
-    tex_desc.mip_levels = 1;
-    tex_desc.format = format;
-    tex_desc.start_state = CGPU_RESOURCE_STATE_COPY_DEST;
-    tex_desc.owner_queue = queue;
-    _cgpu_texture = cgpu_create_texture(queue->device, &tex_desc);
+    if (recreate)
+    {
+        CGPUTextureDescriptor tex_desc = {};
+        tex_desc.name = color_texture_name;
+        tex_desc.width = static_cast<uint32_t>(desc.size.width);
+        tex_desc.height = static_cast<uint32_t>(desc.size.height);
+        tex_desc.depth = 1;
+        tex_desc.usages = CGPU_TEXTURE_USAGE_SHADER_READ;
+        tex_desc.array_size = 1;
+        tex_desc.flags = CGPU_TEXTURE_FLAG_NONE;
+        tex_desc.mip_levels = 1;
+        tex_desc.format = format;
+        tex_desc.start_state = CGPU_RESOURCE_STATE_COPY_DEST;
+        tex_desc.owner_queue = queue;
+        _cgpu_texture = cgpu_create_texture(queue->device, &tex_desc);
+    }
 
-    // upload data
+    // upload data, the upload buffer is kept so it still holds the last image and only dirty rows are copied
     size_t upload_size = desc.data.size();
-    CGPUCommandPoolDescriptor cmd_pool_desc = {};
-    CGPUCommandBufferDescriptor cmd_desc = {};
-    CGPUBufferDescriptor upload_buffer_desc = {};
-    upload_buffer_desc.name = u8"updatable_image_upload_buffer";
-    upload_buffer_desc.flags = CGPU_BUFFER_FLAG_PERSISTENT_MAP_BIT;
-    upload_buffer_desc.usages = CGPU_BUFFER_USAGE_NONE;
-    upload_buffer_desc.memory_usage = CGPU_MEM_USAGE_CPU_ONLY;
-    upload_buffer_desc.size = upload_size;
-    CGPUBufferId tex_upload_buffer = cgpu_create_buffer(queue->device, &upload_buffer_desc);
+    const bool partial = !recreate && _upload_buffer && _upload_size == upload_size &&
+                         desc.dirty_row_end > desc.dirty_row_begin && desc.size.height > 0;
+    if (_upload_buffer && _upload_size != upload_size)
+    {
+        cgpu_free_buffer(_upload_buffer);
+        _upload_buffer = nullptr;
+    }
+    if (!_upload_buffer)
+    {
+        CGPUBufferDescriptor upload_buffer_desc = {};
+        upload_buffer_desc.name = u8"updatable_image_upload_buffer";
+        upload_buffer_desc.flags = CGPU_BUFFER_FLAG_PERSISTENT_MAP_BIT;
+        upload_buffer_desc.usages = CGPU_BUFFER_USAGE_NONE;
+        upload_buffer_desc.memory_usage = CGPU_MEM_USAGE_CPU_ONLY;
+        upload_buffer_desc.size = upload_size;
+        _upload_buffer = cgpu_create_buffer(queue->device, &upload_buffer_desc);
+        _upload_size = upload_size;
+    }
     {
-        memcpy(tex_upload_buffer->info->cpu_mapped_address, desc.data.data(), upload_size);
+        auto dst = (uint8_t*)_upload_buffer->info->cpu_mapped_address;
+        if (partial)
+        {
+            const size_t row_pitch = upload_size / desc.size.height;
+            const size_t offset = row_pitch * desc.dirty_row_begin;
+            memcpy(dst + offset, desc.data.data() + offset, row_pitch * (desc.dirty_row_end - desc.dirty_row_begin));
+        }
+        else
+        {
+            memcpy(dst, desc.data.data(), upload_size);
+        }
     }
+    CGPUCommandPoolDescriptor cmd_pool_desc = {};
+    CGPUCommandBufferDescriptor cmd_desc = {};
     auto cpy_cmd_pool = cgpu_create_command_pool(queue, &cmd_pool_desc);
     auto cpy_cmd = cgpu_create_command_buffer(cpy_cmd_pool, &cmd_desc);
     cgpu_cmd_begin(cpy_cmd);
+    if (!recreate)
+    {
+        CGPUTextureBarrier cpy_barrier = {};
+        cpy_barrier.texture = _cgpu_texture;
+        cpy_barrier.src_state = CGPU_RESOURCE_STATE_SHADER_RESOURCE;
+        cpy_barrier.dst_state = CGPU_RESOURCE_STATE_COPY_DEST;
+        CGPUResourceBarrierDescriptor barrier_desc0 = {};
+        barrier_desc0.texture_barriers = &cpy_barrier;
+        barrier_desc0.texture_barriers_count = 1;
+        cgpu_cmd_resource_barrier(cpy_cmd, &barrier_desc0);
+    }
     CGPUBufferToTextureTransfer b2t = {};
-    b2t.src = tex_upload_buffer;
+    b2t.src = _upload_buffer;
     b2t.src_offset = 0;
     b2t.dst = _cgpu_texture;
     b2t.dst_subresource.mip_level = 0;
@@ -128,34 +174,36 @@ void SkrUpdatableImage::update(const UpdatableImageDesc& desc)
     cgpu_wait_queue_idle(queue);
     cgpu_free_command_buffer(cpy_cmd);
     cgpu_free_command_pool(cpy_cmd_pool);
-    cgpu_free_buffer(tex_upload_buffer);
 
-    // create texture view
-    CGPUTextureViewDescriptor view_desc = {};
-    view_desc.texture = _cgpu_texture;
-    view_desc.format = format;
-    view_desc.array_layer_count = 1;
-    view_desc.base_array_layer = 0;
-    view_desc.mip_level_count = 1;
-    view_desc.base_mip_level = 0;
-    view_desc.aspects = CGPU_TEXTURE_VIEW_ASPECTS_COLOR;
-    view_desc.dims = CGPU_TEXTURE_DIMENSION_2D;
-    view_desc.view_usages = CGPU_TEXTURE_VIEW_USAGE_SRV;
-    _texture_view = cgpu_create_texture_view(device, &view_desc);
+    if (recreate)
+    {
+        // create texture view
+        CGPUTextureViewDescriptor view_desc = {};
+        view_desc.texture = _cgpu_texture;
+        view_desc.format = format;
+        view_desc.array_layer_count = 1;
+        view_desc.base_array_layer = 0;
+        view_desc.mip_level_count = 1;
+        view_desc.base_mip_level = 0;
+        view_desc.aspects = CGPU_TEXTURE_VIEW_ASPECTS_COLOR;
+        view_desc.dims = CGPU_TEXTURE_DIMENSION_2D;
+        view_desc.view_usages = CGPU_TEXTURE_VIEW_USAGE_SRV;
+        _texture_view = cgpu_create_texture_view(device, &view_desc);
 
-    // create bind table
-    CGPUXBindTableDescriptor bind_table_desc = {};
-    bind_table_desc.root_signature = root_signature;
-    bind_table_desc.names = &color_texture_name;
-    bind_table_desc.names_count = 1;
-    _bind_table = cgpux_create_bind_table(device, &bind_table_desc);
+        // create bind table
+        CGPUXBindTableDescriptor bind_table_desc = {};
+        bind_table_desc.root_signature = root_signature;
+        bind_table_desc.names = &color_texture_name;
+        bind_table_desc.names_count = 1;
+        _bind_table = cgpux_create_bind_table(device, &bind_table_desc);
 
-    // update bind table
-    auto data = make_zeroed<CGPUDescriptorData>();
-    data.by_name.name = color_texture_name;
-    data.count = 1;
-    data.textures = &_texture_view;
-    cgpux_bind_table_update(_bind_table, &data, 1);
+        // update bind table
+        auto data = make_zeroed<CGPUDescriptorData>();
+        data.by_name.name = color_texture_name;
+        data.count = 1;
+        data.textures = &_texture_view;
+        cgpux_bind_table_update(_bind_table, &data, 1);
+    }
 
     // record desc
     _desc = desc;
@@ -6,6 +6,7 @@
 #include "SkrRenderGraph/backend/texture_pool.hpp"
 #include "SkrRenderGraph/backend/texture_view_pool.hpp"
 #include "SkrRenderGraph/backend/bind_table_pool.hpp"
+#include "SkrRenderGraph/phases_v2/compiled_graph.hpp"
 
 namespace skr::render_graph
 {
@@ -92,6 +93,7 @@ public:
     TexturePool& get_texture_pool() SKR_NOEXCEPT { return texture_pool; }
     TextureViewPool& get_texture_view_pool() SKR_NOEXCEPT { return texture_view_pool; }
     BufferViewPool& get_buffer_view_pool() SKR_NOEXCEPT { return buffer_view_pool; }
+    CompiledRenderGraphCache& get_compile_cache() SKR_NOEXCEPT { return compile_cache; }
 
 protected:
     virtual void initialize() SKR_NOEXCEPT final;
@@ -107,5 +109,6 @@ protected:
     BufferViewPool buffer_view_pool;
     TexturePool texture_pool;
     TextureViewPool texture_view_pool;
+    CompiledRenderGraphCache compile_cache;
 };
 } // namespace skr::render_graph
\ No newline at end of file
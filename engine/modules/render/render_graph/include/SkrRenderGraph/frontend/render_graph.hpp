@@ -75,10 +75,13 @@ public:
         RenderGraphBuilder& with_cmpt_queues(const skr::Vector<CGPUQueueId>& queues) SKR_NOEXCEPT;
         RenderGraphBuilder& with_cpy_queues(const skr::Vector<CGPUQueueId>& queues) SKR_NOEXCEPT;
         RenderGraphBuilder& enable_memory_aliasing() SKR_NOEXCEPT;
+        // number of compiled graphs kept for reuse by structural hash, 0 compiles every frame
+        RenderGraphBuilder& with_compile_cache(uint32_t capacity) SKR_NOEXCEPT;
 
     protected:
         bool memory_aliasing = false;
         bool no_backend = false;
+        uint32_t compile_cache_capacity = 4;
         ECGPUBackend api;
         CGPUDeviceId device;
         CGPUQueueId gfx_queue;
@@ -334,6 +337,12 @@ public:
     const skr::Vector<PassNode*>& get_passes() const SKR_NOEXCEPT { return passes; }
     const skr::Vector<ResourceNode*>& get_resources() const SKR_NOEXCEPT { return resources; }
 
+    // hash of passes, resources and the edges between them, graphs with the same hash compile to the same
+    // schedule, aliasing plan and barriers. imported handles, names and executors are left out
+    uint64_t get_structural_hash() const SKR_NOEXCEPT;
+    // also returns the hashed words, equal words tell an equal structure from a hash collision
+    uint64_t get_structural_hash(skr::Vector<uint64_t>& words) const SKR_NOEXCEPT;
+
 protected:
     virtual void initialize() SKR_NOEXCEPT;
     virtual void finalize() SKR_NOEXCEPT;
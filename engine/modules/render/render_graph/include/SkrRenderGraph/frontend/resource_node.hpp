@@ -13,6 +13,7 @@ class ResourceNode : public RenderGraphNode
 public:
     friend class RenderGraph;
     friend class BarrierGenerationPhase;
+    friend struct CompiledRenderGraph;
     ResourceNode(EObjectType type, uint64_t frame_index) SKR_NOEXCEPT;
     virtual ~ResourceNode() SKR_NOEXCEPT = default;
     struct LifeSpan {
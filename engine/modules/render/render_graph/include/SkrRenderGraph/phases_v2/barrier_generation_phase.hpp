@@ -85,6 +85,8 @@ struct BarrierGenerationConfig
 class SKR_RENDER_GRAPH_API BarrierGenerationPhase : public IRenderGraphPhase
 {
 public:
+    friend struct CompiledRenderGraph;
+
     BarrierGenerationPhase(
         const CrossQueueSyncAnalysis& sync_analysis,
         const MemoryAliasingPhase& aliasing_phase,
@@ -0,0 +1,161 @@
+#pragma once
+#include "SkrRenderGraph/frontend/render_graph.hpp"
+#include "queue_schedule.hpp"
+#include "schedule_reorder.hpp"
+#include "resource_lifetime_analysis.hpp"
+#include "cross_queue_sync_analysis.hpp"
+#include "memory_aliasing_phase.hpp"
+#include "barrier_generation_phase.hpp"
+#include "SkrContainersDef/vector.hpp"
+#include "SkrContainersDef/hashmap.hpp"
+
+namespace skr {
+namespace render_graph {
+
+// Results of the compile phases (queue schedule to barrier generation) of one graph structure.
+// Nodes are stored by their index in RenderGraph::get_passes() / get_resources(), so the results can be
+// rebound to the nodes of a later frame with the same RenderGraph::get_structural_hash().
+struct SKR_RENDER_GRAPH_API CompiledRenderGraph
+{
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    // records the results of phases that have just executed
+    void capture(RenderGraph* graph,
+        const QueueSchedule& queue_schedule,
+        const ExecutionReorderPhase& reorder_phase,
+        const ResourceLifetimeAnalysis& lifetime_analysis,
+        const CrossQueueSyncAnalysis& sync_analysis,
+        const MemoryAliasingPhase& aliasing_phase,
+        const BarrierGenerationPhase& barrier_phase) SKR_NOEXCEPT;
+
+    // fills the phases with the recorded results for the nodes of the current frame, instead of executing them
+    void restore(RenderGraph* graph,
+        QueueSchedule& queue_schedule,
+        ExecutionReorderPhase& reorder_phase,
+        ResourceLifetimeAnalysis& lifetime_analysis,
+        CrossQueueSyncAnalysis& sync_analysis,
+        MemoryAliasingPhase& aliasing_phase,
+        BarrierGenerationPhase& barrier_phase) const SKR_NOEXCEPT;
+
+    struct Lifetime {
+        ResourceLifetime value;
+        uint32_t resource;
+        uint32_t first_using_pass;
+        uint32_t last_using_pass;
+    };
+    struct SyncPoint {
+        CrossQueueSyncPoint value;
+        uint32_t producer_pass;
+        uint32_t consumer_pass;
+        uint32_t resource;
+    };
+    struct AliasTransition {
+        MemoryAliasTransition value;
+        uint32_t source_pass;
+        uint32_t transition_pass;
+        uint32_t from_resource;
+        uint32_t to_resource;
+    };
+    struct Bucket {
+        uint64_t total_size = 0;
+        uint64_t used_size = 0;
+        uint64_t original_total_size = 0;
+        float compression_ratio = 0.0f;
+        skr::Vector<uint32_t> aliased_resources;
+        skr::Vector<std::pair<uint32_t, uint64_t>> resource_offsets;
+    };
+    struct Barrier {
+        GPUBarrier value;
+        uint32_t resource;
+        uint32_t source_pass;
+        uint32_t target_pass;
+        AliasTransition aliasing; // only for EBarrierType::MemoryAliasing
+    };
+    struct BarrierBatch {
+        EBarrierType batch_type;
+        skr::Vector<Barrier> barriers;
+    };
+    struct PassBarriers {
+        uint32_t pass;
+        skr::Vector<BarrierBatch> batches;
+    };
+
+    uint64_t structural_hash = 0;
+    // words hashed by RenderGraph::get_structural_hash() for the captured graph, a cache hit compares them in full
+    skr::Vector<uint64_t> structural_words;
+    uint64_t last_used_frame = 0;
+
+    // QueueSchedule
+    skr::Vector<QueueInfo> all_queues;
+    skr::Vector<skr::Vector<uint32_t>> queue_schedules;
+    skr::Vector<std::pair<uint32_t, uint32_t>> pass_queue_assignments;
+    // ExecutionReorderPhase
+    skr::Vector<skr::Vector<uint32_t>> optimized_timeline;
+    // ResourceLifetimeAnalysis
+    skr::Vector<Lifetime> lifetimes;
+    skr::Vector<uint32_t> resources_by_size_desc;
+    uint64_t total_memory_requirement = 0;
+    uint32_t max_concurrent_resources = 0;
+    uint32_t total_resource_count = 0;
+    // CrossQueueSyncAnalysis
+    skr::Vector<SyncPoint> raw_sync_points;
+    skr::Vector<SyncPoint> optimized_sync_points;
+    uint32_t total_raw_syncs = 0;
+    uint32_t total_optimized_syncs = 0;
+    uint32_t sync_reduction_count = 0;
+    float sync_optimization_ratio = 0.0f;
+    // MemoryAliasingPhase
+    skr::Vector<Bucket> memory_buckets;
+    skr::Vector<std::pair<uint32_t, uint32_t>> resource_to_bucket;
+    skr::Vector<std::pair<uint32_t, uint64_t>> resource_to_offset;
+    skr::Vector<AliasTransition> alias_transitions;
+    skr::Vector<uint32_t> resources_need_aliasing_barrier;
+    uint64_t total_original_memory = 0;
+    uint64_t total_aliased_memory = 0;
+    float total_compression_ratio = 0.0f;
+    uint32_t total_aliased_resources = 0;
+    uint32_t failed_to_alias_resources = 0;
+    uint32_t total_alias_transitions = 0;
+    // BarrierGenerationPhase
+    skr::Vector<PassBarriers> pass_barriers;
+    uint32_t total_resource_barriers = 0;
+    uint32_t total_sync_barriers = 0;
+    uint32_t total_aliasing_barriers = 0;
+    uint32_t total_execution_barriers = 0;
+    uint32_t optimized_away_barriers = 0;
+    float estimated_barrier_cost = 0.0f;
+    // last state of each accessed resource, handed to the RenderGraphStateTrackers
+    skr::Vector<std::pair<uint32_t, ECGPUResourceState>> final_states;
+};
+
+// Compiled graphs by structural hash, the least recently used one is dropped when the cache is full
+struct SKR_RENDER_GRAPH_API CompiledRenderGraphCache
+{
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    ~CompiledRenderGraphCache() SKR_NOEXCEPT;
+
+    // nullptr on a miss, an entry with the same hash but other structural words is a collision and misses too
+    CompiledRenderGraph* find(uint64_t structural_hash, const skr::Vector<uint64_t>& structural_words, uint64_t frame_index) SKR_NOEXCEPT;
+    // an entry for the hash, to be filled with CompiledRenderGraph::capture()
+    CompiledRenderGraph* add(uint64_t structural_hash, const skr::Vector<uint64_t>& structural_words, uint64_t frame_index) SKR_NOEXCEPT;
+    void clear() SKR_NOEXCEPT;
+
+    void set_capacity(uint32_t capacity) SKR_NOEXCEPT;
+    uint32_t get_capacity() const SKR_NOEXCEPT { return capacity; }
+    const Stats& get_stats() const SKR_NOEXCEPT { return stats; }
+
+private:
+    void evict_oldest() SKR_NOEXCEPT;
+
+    uint32_t capacity = 0;
+    Stats stats;
+    skr::FlatHashMap<uint64_t, CompiledRenderGraph*> entries;
+};
+
+} // namespace render_graph
+} // namespace skr
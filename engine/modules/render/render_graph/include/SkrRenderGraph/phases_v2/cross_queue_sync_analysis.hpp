@@ -58,6 +58,8 @@ struct CrossQueueSyncConfig
 class SKR_RENDER_GRAPH_API CrossQueueSyncAnalysis : public IRenderGraphPhase
 {
 public:
+    friend struct CompiledRenderGraph;
+
     CrossQueueSyncAnalysis(
         const PassDependencyAnalysis& dependency_analysis,
         const QueueSchedule& queue_schedule,
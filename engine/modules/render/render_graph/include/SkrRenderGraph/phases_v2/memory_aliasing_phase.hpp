@@ -114,6 +114,8 @@ struct MemoryAliasingConfig
 class SKR_RENDER_GRAPH_API MemoryAliasingPhase : public IRenderGraphPhase
 {
 public:
+    friend struct CompiledRenderGraph;
+
     MemoryAliasingPhase(
         const PassInfoAnalysis& pass_info_analysis,
         const ResourceLifetimeAnalysis& lifetime_analysis,
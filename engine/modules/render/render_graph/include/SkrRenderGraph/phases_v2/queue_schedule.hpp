@@ -64,6 +64,8 @@ struct QueueScheduleConfig
 class SKR_RENDER_GRAPH_API QueueSchedule : public IRenderGraphPhase 
 {
 public:
+    friend struct CompiledRenderGraph;
+
     QueueSchedule(const PassDependencyAnalysis& dependency_analysis, 
                     const QueueScheduleConfig& config = {});
     ~QueueSchedule() override;
@@ -48,6 +48,8 @@ struct ResourceLifetimeResult
 class SKR_RENDER_GRAPH_API ResourceLifetimeAnalysis : public IRenderGraphPhase
 {
 public:
+    friend struct CompiledRenderGraph;
+
     ResourceLifetimeAnalysis(
         const PassInfoAnalysis& pass_info_analysis,
         const PassDependencyAnalysis& dependency_analysis,
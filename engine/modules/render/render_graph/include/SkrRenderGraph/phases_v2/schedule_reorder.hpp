@@ -32,6 +32,8 @@ struct ExecutionReorderResult {
 // The main ExecutionReorder phase
 class SKR_RENDER_GRAPH_API ExecutionReorderPhase : public IRenderGraphPhase {
 public:
+    friend struct CompiledRenderGraph;
+
     ExecutionReorderPhase(
         const PassInfoAnalysis& pass_info,
         const PassDependencyAnalysis& dependency_analysis,
@@ -4,6 +4,7 @@
 #include "SkrContainersDef/vector.hpp"
 #include "SkrContainersDef/map.hpp"
 #include "SkrContainersDef/set.hpp"
+#include "SkrContainersDef/stack_allocation.hpp"
 
 namespace skr::render_graph
 {
@@ -42,7 +43,12 @@ struct SKR_RENDER_GRAPH_API RenderGraphStackAllocator {
     
     static void Initialize();
     static void Finalize();
+    // all memory handed out before must not be used afterwards, callers make sure no thread is allocating
     static void Reset();
+    // allocations since the last Reset(), summed over the per thread arenas
+    static StackAllocatorStats GetStats();
+    // GetStats() as it was right before the last Reset()
+    static StackAllocatorStats GetLastFrameStats();
     
     struct Impl;
 };
@@ -167,6 +167,7 @@ RenderGraphBackend::RenderGraphBackend(const RenderGraphBuilder& builder)
     , cmpt_queues(builder.cmpt_queues)
     , cpy_queues(builder.cpy_queues)
 {
+    compile_cache.set_capacity(builder.compile_cache_capacity);
 }
 
 static std::atomic_uint64_t rg_count = 0;
@@ -231,6 +232,7 @@ void RenderGraphBackend::finalize() SKR_NOEXCEPT
     buffer_view_pool.finalize();
     texture_pool.finalize();
     texture_view_pool.finalize();
+    compile_cache.clear();
 }
 
 uint64_t RenderGraphBackend::get_latest_finished_frame() SKR_NOEXCEPT
@@ -293,25 +295,40 @@ uint64_t RenderGraphBackend::execute(RenderGraphProfiler* profiler) SKR_NOEXCEPT
         info_analysis.on_execute(this, &executors[executor_index], profiler);
 
         auto dependency_analysis = PassDependencyAnalysis(info_analysis);
-        dependency_analysis.on_execute(this, &executors[executor_index], profiler);
-
         auto queue_schedule = QueueSchedule(dependency_analysis);
-        queue_schedule.on_execute(this, &executors[executor_index], profiler);
-
         auto reorder_phase = ExecutionReorderPhase(info_analysis, dependency_analysis, queue_schedule);
-        reorder_phase.on_execute(this, &executors[executor_index], profiler);
-
         auto lifetime_analysis = ResourceLifetimeAnalysis(info_analysis, dependency_analysis, queue_schedule);
-        lifetime_analysis.on_execute(this, &executors[executor_index], profiler);
-
         auto ssis_phase = CrossQueueSyncAnalysis(dependency_analysis, queue_schedule);
-        ssis_phase.on_execute(this, &executors[executor_index], profiler);
-
         auto aliasing_phase = MemoryAliasingPhase(info_analysis, lifetime_analysis, ssis_phase, MemoryAliasingConfig{ .aliasing_tier = EAliasingTier::Tier0 });
-        aliasing_phase.on_execute(this, &executors[executor_index], profiler);
-
         auto barrier_phase = BarrierGenerationPhase(ssis_phase, aliasing_phase, info_analysis, reorder_phase);
-        barrier_phase.on_execute(this, &executors[executor_index], profiler);
+
+        // graphs with the same structure as a recent frame reuse its schedule, lifetimes, aliasing and barriers
+        const bool use_compile_cache = compile_cache.get_capacity() != 0;
+        skr::Vector<uint64_t> structural_words;
+        const uint64_t structural_hash = use_compile_cache ? get_structural_hash(structural_words) : 0;
+        const CompiledRenderGraph* compiled = use_compile_cache ?
+            compile_cache.find(structural_hash, structural_words, frame_index) :
+            nullptr;
+        if (compiled)
+        {
+            SkrZoneScopedN("RestoreCompiledGraph");
+            compiled->restore(this, queue_schedule, reorder_phase, lifetime_analysis, ssis_phase, aliasing_phase, barrier_phase);
+        }
+        else
+        {
+            dependency_analysis.on_execute(this, &executors[executor_index], profiler);
+            queue_schedule.on_execute(this, &executors[executor_index], profiler);
+            reorder_phase.on_execute(this, &executors[executor_index], profiler);
+            lifetime_analysis.on_execute(this, &executors[executor_index], profiler);
+            ssis_phase.on_execute(this, &executors[executor_index], profiler);
+            aliasing_phase.on_execute(this, &executors[executor_index], profiler);
+            barrier_phase.on_execute(this, &executors[executor_index], profiler);
+            if (use_compile_cache)
+            {
+                if (auto entry = compile_cache.add(structural_hash, structural_words, frame_index))
+                    entry->capture(this, queue_schedule, reorder_phase, lifetime_analysis, ssis_phase, aliasing_phase, barrier_phase);
+            }
+        }
 
         auto resource_allocation_phase = ResourceAllocationPhase(aliasing_phase, info_analysis);
         resource_allocation_phase.on_execute(this, &executors[executor_index], profiler);
@@ -26,6 +26,12 @@ RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::enable_memory_
     return *this;
 }
 
+RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_compile_cache(uint32_t capacity) SKR_NOEXCEPT
+{
+    compile_cache_capacity = capacity;
+    return *this;
+}
+
 RenderGraph::RenderGraphBuilder& RenderGraph::RenderGraphBuilder::with_gfx_queue(CGPUQueueId queue) SKR_NOEXCEPT
 {
     gfx_queue = queue;
@@ -4,6 +4,7 @@
 #include "SkrRenderGraph/frontend/node_and_edge_factory.hpp"
 
 #include "SkrProfile/profile.h"
+#include "SkrBase/misc/hash.h"
 
 #include <SkrContainers/string.hpp>
 #include <SkrContainers/hashmap.hpp>
@@ -384,6 +385,111 @@ const ECGPUResourceState RenderGraph::get_lastest_state(const BufferNode* buffer
     return result;
 }
 
+uint64_t RenderGraph::get_structural_hash() const SKR_NOEXCEPT
+{
+    skr::Vector<uint64_t> words;
+    return get_structural_hash(words);
+}
+
+uint64_t RenderGraph::get_structural_hash(skr::Vector<uint64_t>& words) const SKR_NOEXCEPT
+{
+    SkrZoneScopedN("RenderGraph::StructuralHash");
+
+    // edges refer to resources by their position, node pointers and ids change every frame
+    skr::FlatHashMap<const ResourceNode*, uint32_t> resource_indices;
+    resource_indices.reserve(resources.size());
+    for (uint32_t i = 0; i < resources.size(); i++)
+        resource_indices.emplace(resources[i], i);
+    const auto index_of = [&](const ResourceNode* resource) -> uint64_t {
+        auto it = resource_indices.find(resource);
+        return it != resource_indices.end() ? it->second : UINT32_MAX;
+    };
+
+    words.clear();
+    words.reserve(4 + resources.size() * 16 + passes.size() * 16);
+    words.add(passes.size());
+    words.add(resources.size());
+    words.add(aliasing_enabled);
+    for (const auto resource : resources)
+    {
+        words.add((uint64_t)resource->type);
+        words.add(resource->imported);
+        words.add(resource->canbe_lone);
+        // imported resources start their barriers from the imported state
+        words.add(resource->imported ? (uint64_t)resource->init_state : 0);
+        if (resource->type == EObjectType::Texture)
+        {
+            const auto& desc = static_cast<const TextureNode*>(resource)->descriptor;
+            words.add(desc.flags);
+            words.add(desc.width);
+            words.add(desc.height);
+            words.add(desc.depth);
+            words.add(desc.array_size);
+            words.add((uint64_t)desc.format);
+            words.add(desc.mip_levels);
+            words.add((uint64_t)desc.sample_count);
+            words.add(desc.sample_quality);
+            words.add((uint64_t)desc.start_state);
+            words.add(desc.usages);
+        }
+        else if (resource->type == EObjectType::Buffer)
+        {
+            const auto& desc = static_cast<const BufferNode*>(resource)->descriptor;
+            words.add(desc.size);
+            words.add(desc.usages);
+            words.add((uint64_t)desc.memory_usage);
+            words.add(desc.flags);
+            words.add((uint64_t)desc.start_state);
+            words.add(desc.prefer_on_device | (desc.prefer_on_host << 1));
+        }
+    }
+    for (const auto pass : passes)
+    {
+        words.add((uint64_t)pass->pass_type);
+        words.add((uint64_t)pass->hint_flags);
+        words.add(pass->can_be_lone);
+        words.add(pass->in_texture_edges.size() | (pass->out_texture_edges.size() << 16) | (pass->inout_texture_edges.size() << 32));
+        for (auto edge : pass->in_texture_edges)
+        {
+            words.add(index_of(edge->get_texture_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+        for (auto edge : pass->out_texture_edges)
+        {
+            words.add(index_of(edge->get_texture_node()));
+            words.add((uint64_t)edge->requested_state | ((uint64_t)edge->mrt_index << 32));
+        }
+        for (auto edge : pass->inout_texture_edges)
+        {
+            words.add(index_of(edge->get_texture_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+        words.add(pass->in_buffer_edges.size() | (pass->out_buffer_edges.size() << 16) | (pass->ppl_buffer_edges.size() << 32));
+        for (auto edge : pass->in_buffer_edges)
+        {
+            words.add(index_of(edge->get_buffer_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+        for (auto edge : pass->out_buffer_edges)
+        {
+            words.add(index_of(edge->get_buffer_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+        for (auto edge : pass->ppl_buffer_edges)
+        {
+            words.add(index_of(edge->get_buffer_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+        words.add(pass->in_acceleration_structure_edges.size());
+        for (auto edge : pass->in_acceleration_structure_edges)
+        {
+            words.add(index_of(edge->get_acceleration_structure_node()));
+            words.add((uint64_t)edge->requested_state);
+        }
+    }
+    return skr_hash64_of(words.data(), words.size() * sizeof(uint64_t));
+}
+
 void RenderGraph::add_before_execute_callback(const BeforeExecuteCallback& callback)
 {
     exec_callbacks.add(callback);
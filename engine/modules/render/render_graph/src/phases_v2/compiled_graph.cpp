@@ -0,0 +1,457 @@
+#include "SkrRenderGraph/phases_v2/compiled_graph.hpp"
+#include "SkrRenderGraph/frontend/pass_node.hpp"
+#include "SkrRenderGraph/frontend/resource_node.hpp"
+#include "SkrProfile/profile.h"
+
+namespace skr {
+namespace render_graph {
+
+namespace
+{
+struct NodeIndexer {
+    NodeIndexer(RenderGraph* graph)
+    {
+        const auto& passes = graph->get_passes();
+        const auto& resources = graph->get_resources();
+        pass_indices.reserve(passes.size());
+        resource_indices.reserve(resources.size());
+        for (uint32_t i = 0; i < passes.size(); i++)
+            pass_indices.emplace(passes[i], i);
+        for (uint32_t i = 0; i < resources.size(); i++)
+            resource_indices.emplace(resources[i], i);
+    }
+
+    uint32_t operator()(const PassNode* pass) const
+    {
+        auto it = pass_indices.find(pass);
+        return it != pass_indices.end() ? it->second : CompiledRenderGraph::kInvalidIndex;
+    }
+    uint32_t operator()(const ResourceNode* resource) const
+    {
+        auto it = resource_indices.find(resource);
+        return it != resource_indices.end() ? it->second : CompiledRenderGraph::kInvalidIndex;
+    }
+
+    skr::FlatHashMap<const PassNode*, uint32_t> pass_indices;
+    skr::FlatHashMap<const ResourceNode*, uint32_t> resource_indices;
+};
+
+struct NodeResolver {
+    NodeResolver(RenderGraph* graph)
+        : passes(graph->get_passes())
+        , resources(graph->get_resources())
+    {
+    }
+
+    PassNode* pass(uint32_t index) const
+    {
+        return index != CompiledRenderGraph::kInvalidIndex ? passes[index] : nullptr;
+    }
+    ResourceNode* resource(uint32_t index) const
+    {
+        return index != CompiledRenderGraph::kInvalidIndex ? resources[index] : nullptr;
+    }
+
+    const skr::Vector<PassNode*>& passes;
+    const skr::Vector<ResourceNode*>& resources;
+};
+
+// the stored values keep no pointers to nodes of the captured frame
+CompiledRenderGraph::SyncPoint capture_sync_point(const NodeIndexer& index_of, const CrossQueueSyncPoint& point)
+{
+    CompiledRenderGraph::SyncPoint result = { point, index_of(point.producer_pass), index_of(point.consumer_pass), index_of(point.resource) };
+    result.value.producer_pass = nullptr;
+    result.value.consumer_pass = nullptr;
+    result.value.resource = nullptr;
+    return result;
+}
+
+CrossQueueSyncPoint restore_sync_point(const NodeResolver& resolve, const CompiledRenderGraph::SyncPoint& point)
+{
+    CrossQueueSyncPoint result = point.value;
+    result.producer_pass = resolve.pass(point.producer_pass);
+    result.consumer_pass = resolve.pass(point.consumer_pass);
+    result.resource = resolve.resource(point.resource);
+    return result;
+}
+
+CompiledRenderGraph::AliasTransition capture_alias_transition(const NodeIndexer& index_of, const MemoryAliasTransition& transition)
+{
+    CompiledRenderGraph::AliasTransition result = { transition,
+        index_of(transition.source_pass), index_of(transition.transition_pass),
+        index_of(transition.from_resource), index_of(transition.to_resource) };
+    result.value.source_pass = nullptr;
+    result.value.transition_pass = nullptr;
+    result.value.from_resource = nullptr;
+    result.value.to_resource = nullptr;
+    return result;
+}
+
+MemoryAliasTransition restore_alias_transition(const NodeResolver& resolve, const CompiledRenderGraph::AliasTransition& transition)
+{
+    MemoryAliasTransition result = transition.value;
+    result.source_pass = resolve.pass(transition.source_pass);
+    result.transition_pass = resolve.pass(transition.transition_pass);
+    result.from_resource = resolve.resource(transition.from_resource);
+    result.to_resource = resolve.resource(transition.to_resource);
+    return result;
+}
+} // namespace
+
+void CompiledRenderGraph::capture(RenderGraph* graph,
+    const QueueSchedule& queue_schedule,
+    const ExecutionReorderPhase& reorder_phase,
+    const ResourceLifetimeAnalysis& lifetime_analysis,
+    const CrossQueueSyncAnalysis& sync_analysis,
+    const MemoryAliasingPhase& aliasing_phase,
+    const BarrierGenerationPhase& barrier_phase) SKR_NOEXCEPT
+{
+    SkrZoneScopedN("CaptureCompiledGraph");
+
+    const NodeIndexer index_of(graph);
+
+    // queue schedule
+    const auto& schedule = queue_schedule.schedule_result;
+    all_queues.clear();
+    all_queues.append(queue_schedule.all_queues.data(), queue_schedule.all_queues.size());
+    queue_schedules.clear();
+    for (const auto& queue : schedule.queue_schedules)
+    {
+        auto& indices = queue_schedules.add_default().ref();
+        indices.reserve(queue.size());
+        for (auto pass : queue)
+            indices.add(index_of(pass));
+    }
+    pass_queue_assignments.clear();
+    for (const auto& [pass, queue_index] : schedule.pass_queue_assignments)
+        pass_queue_assignments.add({ index_of(pass), queue_index });
+
+    // reorder
+    optimized_timeline.clear();
+    for (const auto& queue : reorder_phase.result.optimized_timeline)
+    {
+        auto& indices = optimized_timeline.add_default().ref();
+        indices.reserve(queue.size());
+        for (auto pass : queue)
+            indices.add(index_of(pass));
+    }
+
+    // lifetimes
+    const auto& lifetime_result = lifetime_analysis.lifetime_result_;
+    lifetimes.clear();
+    for (const auto& [resource, lifetime] : lifetime_result.resource_lifetimes)
+    {
+        Lifetime compiled = { lifetime, index_of(resource), index_of(lifetime.first_using_pass), index_of(lifetime.last_using_pass) };
+        compiled.value.resource = nullptr;
+        compiled.value.first_using_pass = nullptr;
+        compiled.value.last_using_pass = nullptr;
+        lifetimes.add(compiled);
+    }
+    resources_by_size_desc.clear();
+    for (auto resource : lifetime_result.resources_by_size_desc)
+        resources_by_size_desc.add(index_of(resource));
+    total_memory_requirement = lifetime_result.total_memory_requirement;
+    max_concurrent_resources = lifetime_result.max_concurrent_resources;
+    total_resource_count = lifetime_result.total_resource_count;
+
+    // cross queue sync
+    const auto& ssis_result = sync_analysis.ssis_result_;
+    raw_sync_points.clear();
+    for (const auto& point : ssis_result.raw_sync_points)
+        raw_sync_points.add(capture_sync_point(index_of, point));
+    optimized_sync_points.clear();
+    for (const auto& point : ssis_result.optimized_sync_points)
+        optimized_sync_points.add(capture_sync_point(index_of, point));
+    total_raw_syncs = ssis_result.total_raw_syncs;
+    total_optimized_syncs = ssis_result.total_optimized_syncs;
+    sync_reduction_count = ssis_result.sync_reduction_count;
+    sync_optimization_ratio = ssis_result.optimization_ratio;
+
+    // aliasing
+    const auto& aliasing_result = aliasing_phase.aliasing_result_;
+    memory_buckets.clear();
+    for (const auto& bucket : aliasing_result.memory_buckets)
+    {
+        auto& compiled = memory_buckets.add_default().ref();
+        compiled.total_size = bucket.total_size;
+        compiled.used_size = bucket.used_size;
+        compiled.original_total_size = bucket.original_total_size;
+        compiled.compression_ratio = bucket.compression_ratio;
+        for (auto resource : bucket.aliased_resources)
+            compiled.aliased_resources.add(index_of(resource));
+        for (const auto& [resource, offset] : bucket.resource_offsets)
+            compiled.resource_offsets.add({ index_of(resource), offset });
+    }
+    resource_to_bucket.clear();
+    for (const auto& [resource, bucket] : aliasing_result.resource_to_bucket)
+        resource_to_bucket.add({ index_of(resource), bucket });
+    resource_to_offset.clear();
+    for (const auto& [resource, offset] : aliasing_result.resource_to_offset)
+        resource_to_offset.add({ index_of(resource), offset });
+    alias_transitions.clear();
+    for (const auto& transition : aliasing_result.alias_transitions)
+        alias_transitions.add(capture_alias_transition(index_of, transition));
+    resources_need_aliasing_barrier.clear();
+    for (auto resource : aliasing_result.resources_need_aliasing_barrier)
+        resources_need_aliasing_barrier.add(index_of(resource));
+    total_original_memory = aliasing_result.total_original_memory;
+    total_aliased_memory = aliasing_result.total_aliased_memory;
+    total_compression_ratio = aliasing_result.total_compression_ratio;
+    total_aliased_resources = aliasing_result.total_aliased_resources;
+    failed_to_alias_resources = aliasing_result.failed_to_alias_resources;
+    total_alias_transitions = aliasing_result.total_alias_transitions;
+
+    // barriers
+    const auto& barrier_result = barrier_phase.barrier_result_;
+    pass_barriers.clear();
+    for (const auto& [pass, batches] : barrier_result.pass_barrier_batches)
+    {
+        auto& compiled_pass = pass_barriers.add_default().ref();
+        compiled_pass.pass = index_of(pass);
+        for (const auto& batch : batches)
+        {
+            auto& compiled_batch = compiled_pass.batches.add_default().ref();
+            compiled_batch.batch_type = batch.batch_type;
+            for (const auto& barrier : batch.barriers)
+            {
+                Barrier compiled = {};
+                compiled.value = barrier;
+                compiled.resource = index_of(barrier.resource);
+                compiled.source_pass = index_of(barrier.source_pass);
+                compiled.target_pass = index_of(barrier.target_pass);
+                compiled.value.resource = nullptr;
+                compiled.value.source_pass = nullptr;
+                compiled.value.target_pass = nullptr;
+                if (barrier.type == EBarrierType::MemoryAliasing)
+                {
+                    compiled.aliasing = capture_alias_transition(index_of, barrier.aliasing);
+                    compiled.value.aliasing = compiled.aliasing.value;
+                }
+                compiled_batch.barriers.add(compiled);
+            }
+        }
+    }
+    total_resource_barriers = barrier_result.total_resource_barriers;
+    total_sync_barriers = barrier_result.total_sync_barriers;
+    total_aliasing_barriers = barrier_result.total_aliasing_barriers;
+    total_execution_barriers = barrier_result.total_execution_barriers;
+    optimized_away_barriers = barrier_result.optimized_away_barriers;
+    estimated_barrier_cost = barrier_result.estimated_barrier_cost;
+
+    // the barrier phase leaves the last state of every tracked resource in its trackers
+    final_states.clear();
+    const auto& resources = graph->get_resources();
+    for (uint32_t i = 0; i < resources.size(); i++)
+    {
+        for (auto tracker : resources[i]->trackers)
+        {
+            final_states.add({ i, tracker->get_last_state() });
+            break;
+        }
+    }
+}
+
+void CompiledRenderGraph::restore(RenderGraph* graph,
+    QueueSchedule& queue_schedule,
+    ExecutionReorderPhase& reorder_phase,
+    ResourceLifetimeAnalysis& lifetime_analysis,
+    CrossQueueSyncAnalysis& sync_analysis,
+    MemoryAliasingPhase& aliasing_phase,
+    BarrierGenerationPhase& barrier_phase) const SKR_NOEXCEPT
+{
+    SkrZoneScopedN("RestoreCompiledGraph");
+
+    const NodeResolver resolve(graph);
+
+    // queue schedule
+    auto& schedule = queue_schedule.schedule_result;
+    queue_schedule.all_queues.append(all_queues.data(), all_queues.size());
+    schedule.all_queues = queue_schedule.all_queues;
+    schedule.queue_schedules.resize_default(queue_schedules.size());
+    for (uint32_t q = 0; q < queue_schedules.size(); q++)
+    {
+        auto& queue = schedule.queue_schedules[q];
+        queue.reserve(queue_schedules[q].size());
+        for (auto pass : queue_schedules[q])
+            queue.add(resolve.pass(pass));
+    }
+    for (const auto& [pass, queue_index] : pass_queue_assignments)
+        schedule.pass_queue_assignments.add(resolve.pass(pass), queue_index);
+
+    // reorder
+    auto& timeline = reorder_phase.result.optimized_timeline;
+    timeline.resize_default(optimized_timeline.size());
+    for (uint32_t q = 0; q < optimized_timeline.size(); q++)
+    {
+        timeline[q].reserve(optimized_timeline[q].size());
+        for (auto pass : optimized_timeline[q])
+            timeline[q].add(resolve.pass(pass));
+    }
+
+    // lifetimes
+    auto& lifetime_result = lifetime_analysis.lifetime_result_;
+    for (const auto& lifetime : lifetimes)
+    {
+        ResourceLifetime value = lifetime.value;
+        value.resource = resolve.resource(lifetime.resource);
+        value.first_using_pass = resolve.pass(lifetime.first_using_pass);
+        value.last_using_pass = resolve.pass(lifetime.last_using_pass);
+        lifetime_result.resource_lifetimes.add(value.resource, value);
+    }
+    for (auto resource : resources_by_size_desc)
+        lifetime_result.resources_by_size_desc.add(resolve.resource(resource));
+    lifetime_result.total_memory_requirement = total_memory_requirement;
+    lifetime_result.max_concurrent_resources = max_concurrent_resources;
+    lifetime_result.total_resource_count = total_resource_count;
+
+    // cross queue sync
+    auto& ssis_result = sync_analysis.ssis_result_;
+    for (const auto& point : raw_sync_points)
+        ssis_result.raw_sync_points.add(restore_sync_point(resolve, point));
+    for (const auto& point : optimized_sync_points)
+        ssis_result.optimized_sync_points.add(restore_sync_point(resolve, point));
+    ssis_result.total_raw_syncs = total_raw_syncs;
+    ssis_result.total_optimized_syncs = total_optimized_syncs;
+    ssis_result.sync_reduction_count = sync_reduction_count;
+    ssis_result.optimization_ratio = sync_optimization_ratio;
+
+    // aliasing
+    auto& aliasing_result = aliasing_phase.aliasing_result_;
+    aliasing_result.memory_buckets.resize_default(memory_buckets.size());
+    for (uint32_t b = 0; b < memory_buckets.size(); b++)
+    {
+        const auto& compiled = memory_buckets[b];
+        auto& bucket = aliasing_result.memory_buckets[b];
+        bucket.total_size = compiled.total_size;
+        bucket.used_size = compiled.used_size;
+        bucket.original_total_size = compiled.original_total_size;
+        bucket.compression_ratio = compiled.compression_ratio;
+        for (auto resource : compiled.aliased_resources)
+            bucket.aliased_resources.add(resolve.resource(resource));
+        for (const auto& [resource, offset] : compiled.resource_offsets)
+            bucket.resource_offsets.add(resolve.resource(resource), offset);
+    }
+    for (const auto& [resource, bucket] : resource_to_bucket)
+        aliasing_result.resource_to_bucket.add(resolve.resource(resource), bucket);
+    for (const auto& [resource, offset] : resource_to_offset)
+        aliasing_result.resource_to_offset.add(resolve.resource(resource), offset);
+    for (const auto& transition : alias_transitions)
+        aliasing_result.alias_transitions.add(restore_alias_transition(resolve, transition));
+    for (auto resource : resources_need_aliasing_barrier)
+        aliasing_result.resources_need_aliasing_barrier.insert(resolve.resource(resource));
+    aliasing_result.total_original_memory = total_original_memory;
+    aliasing_result.total_aliased_memory = total_aliased_memory;
+    aliasing_result.total_compression_ratio = total_compression_ratio;
+    aliasing_result.total_aliased_resources = total_aliased_resources;
+    aliasing_result.failed_to_alias_resources = failed_to_alias_resources;
+    aliasing_result.total_alias_transitions = total_alias_transitions;
+
+    // barriers
+    auto& barrier_result = barrier_phase.barrier_result_;
+    for (const auto& compiled_pass : pass_barriers)
+    {
+        auto& batches = barrier_result.pass_barrier_batches.try_add_default(resolve.pass(compiled_pass.pass)).value();
+        for (const auto& compiled_batch : compiled_pass.batches)
+        {
+            auto& batch = batches.add_default().ref();
+            batch.batch_type = compiled_batch.batch_type;
+            batch.barriers.reserve(compiled_batch.barriers.size());
+            for (const auto& compiled : compiled_batch.barriers)
+            {
+                GPUBarrier barrier = compiled.value;
+                barrier.resource = resolve.resource(compiled.resource);
+                barrier.source_pass = resolve.pass(compiled.source_pass);
+                barrier.target_pass = resolve.pass(compiled.target_pass);
+                if (barrier.type == EBarrierType::MemoryAliasing)
+                    barrier.aliasing = restore_alias_transition(resolve, compiled.aliasing);
+                batch.barriers.add(barrier);
+            }
+        }
+    }
+    barrier_result.total_resource_barriers = total_resource_barriers;
+    barrier_result.total_sync_barriers = total_sync_barriers;
+    barrier_result.total_aliasing_barriers = total_aliasing_barriers;
+    barrier_result.total_execution_barriers = total_execution_barriers;
+    barrier_result.optimized_away_barriers = optimized_away_barriers;
+    barrier_result.estimated_barrier_cost = estimated_barrier_cost;
+
+    for (const auto& [resource, state] : final_states)
+    {
+        for (auto tracker : resolve.resource(resource)->trackers)
+            tracker->reset(state);
+    }
+}
+
+// cache
+CompiledRenderGraphCache::~CompiledRenderGraphCache() SKR_NOEXCEPT
+{
+    clear();
+}
+
+CompiledRenderGraph* CompiledRenderGraphCache::find(uint64_t structural_hash, const skr::Vector<uint64_t>& structural_words, uint64_t frame_index) SKR_NOEXCEPT
+{
+    auto it = entries.find(structural_hash);
+    if (it == entries.end() || it->second->structural_words != structural_words)
+    {
+        stats.misses++;
+        return nullptr;
+    }
+    stats.hits++;
+    it->second->last_used_frame = frame_index;
+    return it->second;
+}
+
+CompiledRenderGraph* CompiledRenderGraphCache::add(uint64_t structural_hash, const skr::Vector<uint64_t>& structural_words, uint64_t frame_index) SKR_NOEXCEPT
+{
+    if (capacity == 0)
+        return nullptr;
+
+    CompiledRenderGraph* compiled = nullptr;
+    if (auto it = entries.find(structural_hash); it != entries.end())
+    {
+        // same hash with other structural words, replace the old structure
+        compiled = it->second;
+    }
+    else
+    {
+        if (entries.size() >= capacity)
+            evict_oldest();
+        compiled = SkrNew<CompiledRenderGraph>();
+        entries.emplace(structural_hash, compiled);
+    }
+    compiled->structural_hash = structural_hash;
+    compiled->structural_words = structural_words;
+    compiled->last_used_frame = frame_index;
+    return compiled;
+}
+
+void CompiledRenderGraphCache::clear() SKR_NOEXCEPT
+{
+    for (auto& [hash, compiled] : entries)
+        SkrDelete(compiled);
+    entries.clear();
+}
+
+void CompiledRenderGraphCache::set_capacity(uint32_t new_capacity) SKR_NOEXCEPT
+{
+    capacity = new_capacity;
+    while (entries.size() > capacity)
+        evict_oldest();
+}
+
+void CompiledRenderGraphCache::evict_oldest() SKR_NOEXCEPT
+{
+    // a handful of entries, a linear scan is enough
+    auto oldest = entries.begin();
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        if (it->second->last_used_frame < oldest->second->last_used_frame)
+            oldest = it;
+    }
+    SkrDelete(oldest->second);
+    entries.erase(oldest);
+    stats.evictions++;
+}
+
+} // namespace render_graph
+} // namespace skr
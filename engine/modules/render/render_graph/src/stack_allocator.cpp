@@ -10,7 +10,7 @@ namespace skr::render_graph
 static const char* kStackAllocatorName = "RenderGraphStackAllocator";
 
 // Implementation details
-struct RenderGraphStackAllocator::Impl : public StackAllocator<RenderGraphStackAllocator::Impl>
+struct RenderGraphStackAllocator::Impl : public ThreadLocalStackAllocator<RenderGraphStackAllocator::Impl>
 {
     static constexpr size_t kDefaultChunkSize = 64 * 1024; // 64KB 默认块大小
     static constexpr size_t kAlignment = 16; // 16字节对齐
@@ -21,6 +21,7 @@ struct RenderGraphStackAllocator::Impl : public StackAllocator<RenderGraphStackA
 static std::unique_ptr<RenderGraphStackAllocator::Impl> g_pool_impl = nullptr;
 static SMutex g_instance_mutex = {};
 static bool g_initialized = false;
+static StackAllocatorStats g_last_frame_stats = {};
 
 void RenderGraphStackAllocator::Initialize() {
     if (g_initialized) return;
@@ -47,6 +48,7 @@ void RenderGraphStackAllocator::Finalize() {
         {
             g_pool_impl->finalize();
             g_pool_impl.reset();
+            g_last_frame_stats = {};
             g_initialized = false;
             SKR_LOG_INFO(u8"RenderGraphStackAllocator finalized");
         }
@@ -77,12 +79,8 @@ void* RenderGraphStackAllocator::alloc_raw(size_t count, size_t item_size, size_
     
     size_t total_size = count * item_size;
     
-    // 添加线程安全保护，与Reset()保持一致
-    skr_mutex_acquire(&g_instance_mutex);
-    void* result = get_impl().allocate(total_size, item_align);
-    skr_mutex_release(&g_instance_mutex);
-    
-    return result;
+    // 每个线程使用自己的arena，无需加锁
+    return get_impl().allocate(total_size, item_align);
 }
 
 void RenderGraphStackAllocator::free_raw(void* p, size_t item_align) 
@@ -96,10 +94,19 @@ void RenderGraphStackAllocator::Reset()
 {
     if (g_initialized && g_pool_impl)
     {
-        skr_mutex_acquire(&g_instance_mutex);
+        g_last_frame_stats = g_pool_impl->get_stats();
         g_pool_impl->reset();
-        skr_mutex_release(&g_instance_mutex);
     }
 }
 
+StackAllocatorStats RenderGraphStackAllocator::GetStats()
+{
+    return (g_initialized && g_pool_impl) ? g_pool_impl->get_stats() : StackAllocatorStats{};
+}
+
+StackAllocatorStats RenderGraphStackAllocator::GetLastFrameStats()
+{
+    return g_last_frame_stats;
+}
+
 } // namespace skr::render_graph
\ No newline at end of file
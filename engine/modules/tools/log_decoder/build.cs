@@ -0,0 +1,14 @@
+using SB;
+using SB.Core;
+using Serilog;
+
+[TargetScript]
+public static class SkrLogDecoder
+{
+    static SkrLogDecoder()
+    {
+        Engine.Program("SkrLogDecoder")
+            .Depend(Visibility.Public, "SkrCore")
+            .AddCppFiles("**.cpp");
+    }
+}
@@ -0,0 +1,57 @@
+#include "SkrCore/log/log_binary.hpp"
+#include "SkrOS/filesystem.hpp"
+#include <cstdio>
+
+// formats a stream written by skr::logging::LogBinaryFileSink
+// usage: SkrLogDecoder <log.bin> [output.txt]
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("usage: SkrLogDecoder <log.bin> [output.txt]\n");
+        return 1;
+    }
+
+    skr::Vector<uint8_t> data;
+    if (!skr::fs::File::read_all_bytes(skr::Path((const char8_t*)argv[1]), data))
+    {
+        printf("failed to read %s\n", argv[1]);
+        return 1;
+    }
+
+    static constexpr const char8_t* kLevelNames[] = {
+        u8"TRACE", u8"DEBUG", u8"INFO", u8"WARN", u8"ERROR", u8"FATAL", u8"BACKTRACE"
+    };
+    skr::String text;
+    uint64_t    count = 0;
+    const bool  valid = skr::logging::BinaryLog::Decode(data.data(), data.size(), [&](const skr::logging::BinaryLogEntry& entry) {
+        const auto level   = (uint32_t)entry.level < sizeof(kLevelNames) / sizeof(kLevelNames[0]) ? kLevelNames[(uint32_t)entry.level] : u8"?";
+        const auto seconds = entry.ns / 1000000000;
+        const auto nanos   = entry.ns % 1000000000;
+        skr::format_to(text, u8"[{}.{:09}][{}({})] {}: {}", seconds, nanos, entry.thread_name, entry.thread_id, level, entry.message);
+        if (!entry.file.is_empty())
+            skr::format_to(text, u8" ({}:{})", entry.file, entry.line);
+        text.append(u8"\n");
+        ++count;
+    });
+    if (!valid)
+    {
+        printf("%s is not a binary log\n", argv[1]);
+        return 1;
+    }
+
+    if (argc > 2)
+    {
+        if (!skr::fs::File::write_all_text(skr::Path((const char8_t*)argv[2]), text.view()))
+        {
+            printf("failed to write %s\n", argv[2]);
+            return 1;
+        }
+        printf("decoded %llu records\n", (unsigned long long)count);
+    }
+    else
+    {
+        fwrite(text.data(), 1, text.length_buffer(), stdout);
+    }
+    return 0;
+}
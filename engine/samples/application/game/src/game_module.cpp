@@ -841,27 +841,16 @@ int SGameModule::main_module_exec(int argc, char8_t** argv)
             if (pSkinCounter)
                 pSkinCounter.wait(true);
 
-            // skin dispatch for the frame
+            // skin dispatch for the frame, scheduled as an ecs job so it waits for the anim job writing
+            // joint matrices; every job skins the instances of its views in one batch
             auto cpuSkinJob = SkrNewLambda(
                 [&](sugoi_query_t* query, sugoi_chunk_view_t* view, sugoi_type_index_t* localTypes, EIndex entityIndex) {
-                    const auto meshes = sugoi::get_component_ro<skr::MeshComponent>(view);
-                    const auto anims = sugoi::get_component_ro<skr::AnimComponent>(view);
-                    auto skins = sugoi::get_owned_rw<skr::SkinComponent>(view);
-
-                    for (uint32_t i = 0; i < view->count; i++)
-                    {
-                        auto mesh_resource = meshes[i].mesh_resource.get_resolved();
-                        if (!mesh_resource)
-                            continue;
-                        if (!skins[i].joint_remaps.empty() && !anims[i].buffers.empty())
-                        {
-                            SkrZoneScopedN("CPU Skin");
-
-                            skr_cpu_skin(skins + i, anims + i, mesh_resource);
-                        }
-                    }
+                    SkrZoneScopedN("CPU Skin");
+                    skr::CPUSkinBatch skinBatch;
+                    skinBatch.gather(view);
+                    skinBatch.run();
                 });
-            sugoiJ_schedule_ecs(skinQuery, 4, SUGOI_LAMBDA_POINTER(cpuSkinJob), nullptr, &pSkinCounter);
+            sugoiJ_schedule_ecs(skinQuery, 64, SUGOI_LAMBDA_POINTER(cpuSkinJob), nullptr, &pSkinCounter);
         }
         // [has]skr_movement_comp_t, [inout]skr::PositionComponent, [in]skr::CameraComponent
         if (bUseJob)
@@ -7,5 +7,13 @@ public static class AnimTests
 {
     static AnimTests()
     {
+        Test.UnitTest("SkinBatchTest")
+            .Depend(Visibility.Public, "SkrAnim")
+            .AddCppFiles("skin/*.cpp");
+
+        Test.UnitTest("AnimEvaluatorTest")
+            .Depend(Visibility.Public, "SkrAnim")
+            .Depend(Visibility.Public, "SkrAnimTool")
+            .AddCppFiles("evaluator/*.cpp");
     }
 }
\ No newline at end of file
@@ -0,0 +1,313 @@
+#include "SkrAnim/anim_evaluator.hpp"
+#include "SkrAnim/ozz/blending_job.h"
+#include "SkrAnim/ozz/local_to_model_job.h"
+#include "SkrAnim/ozz/sampling_job.h"
+#include "SkrAnimTool/ozz/animation_builder.h"
+#include "SkrAnimTool/ozz/raw_animation.h"
+#include "SkrAnimTool/ozz/raw_skeleton.h"
+#include "SkrAnimTool/ozz/skeleton_builder.h"
+#include "SkrTask/fib_task.hpp"
+#include "SkrCore/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <string>
+
+#include "SkrTestFramework/framework.hpp"
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+// not a multiple of 4, so the last soa joint is partially used
+static constexpr uint32_t kJointCount = 7;
+static constexpr float kDuration = 2.f;
+
+// the evaluator is checked against running the ozz jobs directly for every instance
+struct AnimEvaluatorTests
+{
+    using Pose = skr::Vector<ozz::math::Float4x4>;
+    using LocalPose = skr::Vector<ozz::math::SoaTransform>;
+
+    AnimEvaluatorTests()
+    {
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+        build_skeleton();
+        animation.animation = build_animation(0.f);
+        other_animation.animation = build_animation(1.f);
+    }
+
+    ~AnimEvaluatorTests()
+    {
+        scheduler.unbind();
+    }
+
+    // a chain of joints with a branch at the second one
+    void build_skeleton()
+    {
+        ozz::animation::offline::RawSkeleton raw;
+        raw.roots.resize(1);
+        auto* joint = &raw.roots[0];
+        for (uint32_t i = 0; i < kJointCount - 1; ++i)
+        {
+            joint->name = ("joint" + std::to_string(i)).c_str();
+            joint->transform = ozz::math::Transform::identity();
+            joint->transform.translation = ozz::math::Float3(0.f, 1.f, 0.f);
+            joint->children.resize(i == 1 ? 2 : 1);
+            if (i == 1)
+            {
+                auto& branch = joint->children[1];
+                branch.name = "branch";
+                branch.transform = ozz::math::Transform::identity();
+                branch.transform.translation = ozz::math::Float3(1.f, 0.f, 0.f);
+            }
+            joint = &joint->children[0];
+        }
+        joint->name = "tip";
+        joint->transform = ozz::math::Transform::identity();
+
+        auto built = ozz::animation::offline::SkeletonBuilder()(raw);
+        REQUIRE(built);
+        skeleton.skeleton = std::move(*built);
+        REQUIRE(skeleton.skeleton.num_joints() == kJointCount);
+    }
+
+    // every joint rotates, moves and scales with its own keys, phase tells two animations apart
+    ozz::animation::Animation build_animation(float phase)
+    {
+        ozz::animation::offline::RawAnimation raw;
+        raw.duration = kDuration;
+        raw.tracks.resize(kJointCount);
+        for (uint32_t i = 0; i < kJointCount; ++i)
+        {
+            auto& track = raw.tracks[i];
+            for (uint32_t k = 0; k <= 4; ++k)
+            {
+                const float time = kDuration * (float)k / 4.f;
+                const float angle = std::sin((float)(k + i) + phase) * 1.2f;
+                const auto axis = (i % 2) ? ozz::math::Float3(0.f, 0.f, 1.f) : ozz::math::Float3(1.f, 0.f, 0.f);
+                track.rotations.push_back({ time, ozz::math::Quaternion::FromAxisAngle(axis, angle) });
+                track.translations.push_back({ time, ozz::math::Float3(0.1f * (float)k, 1.f, phase * 0.2f) });
+                const float scale = 1.f + 0.05f * (float)((k + i) % 3);
+                track.scales.push_back({ time, ozz::math::Float3(scale, scale, scale) });
+            }
+        }
+        auto built = ozz::animation::offline::AnimationBuilder()(raw);
+        REQUIRE(built);
+        return std::move(*built);
+    }
+
+    // the evaluator wraps playback time into the animation and snaps it to the sample grid
+    static float ratio_of(const skr::AnimResource& anim, float time, float sample_rate = 0.f)
+    {
+        const float duration = anim.animation.duration();
+        time = std::fmod(time, duration);
+        if (time < 0.f)
+            time += duration;
+        if (sample_rate > 0.f)
+            time = (float)std::llround(time * sample_rate) / sample_rate;
+        return std::clamp(time / duration, 0.f, 1.f);
+    }
+
+    LocalPose sample(const skr::AnimResource& anim, float time, float sample_rate = 0.f)
+    {
+        LocalPose local;
+        local.resize_default(skeleton.skeleton.num_soa_joints());
+        ozz::animation::SamplingJob::Context context(anim.animation.num_tracks());
+        ozz::animation::SamplingJob job;
+        job.animation = &anim.animation;
+        job.context = &context;
+        job.ratio = ratio_of(anim, time, sample_rate);
+        job.output = ozz::span{ local.data(), local.size() };
+        REQUIRE(job.Run());
+        return local;
+    }
+
+    Pose to_model(const LocalPose& local)
+    {
+        Pose model;
+        model.resize_default(skeleton.skeleton.num_joints());
+        ozz::animation::LocalToModelJob job;
+        job.skeleton = &skeleton.skeleton;
+        job.input = ozz::span<const ozz::math::SoaTransform>{ local.data(), local.size() };
+        job.output = ozz::span{ model.data(), model.size() };
+        REQUIRE(job.Run());
+        return model;
+    }
+
+    Pose blend(const LocalPose& from, const LocalPose& to, float alpha)
+    {
+        LocalPose blended;
+        blended.resize_default(skeleton.skeleton.num_soa_joints());
+        ozz::animation::BlendingJob::Layer layers[2];
+        layers[0].weight = 1.f - alpha;
+        layers[0].transform = ozz::span<const ozz::math::SoaTransform>{ from.data(), from.size() };
+        layers[1].weight = alpha;
+        layers[1].transform = ozz::span<const ozz::math::SoaTransform>{ to.data(), to.size() };
+        ozz::animation::BlendingJob job;
+        job.layers = ozz::span<const ozz::animation::BlendingJob::Layer>{ layers, 2 };
+        job.rest_pose = skeleton.skeleton.joint_rest_poses();
+        job.output = ozz::span{ blended.data(), blended.size() };
+        REQUIRE(job.Run());
+        return to_model(blended);
+    }
+
+    static uint64_t mismatches(const Pose& expected, const Pose& actual)
+    {
+        if (expected.size() != actual.size())
+            return expected.size() + actual.size();
+        uint64_t count = 0;
+        for (uint64_t j = 0; j < expected.size(); ++j)
+        {
+            float lhs[16], rhs[16];
+            memcpy(lhs, &expected[j], sizeof(lhs));
+            memcpy(rhs, &actual[j], sizeof(rhs));
+            for (uint32_t c = 0; c < 16; ++c)
+                count += std::abs(lhs[c] - rhs[c]) <= 1e-4f * std::max(1.f, std::abs(lhs[c])) ? 0 : 1;
+        }
+        return count;
+    }
+
+    skr::task::scheduler_t scheduler;
+    skr::SkeletonResource skeleton;
+    skr::AnimResource animation;
+    skr::AnimResource other_animation;
+};
+
+TEST_CASE_METHOD(AnimEvaluatorTests, "SharedSamplingMatchesDirectJobs")
+{
+    // times on the sample grid are shared exactly, off grid ones snap to the nearest tick
+    const float times[] = { 0.f, 0.5f, 0.5f, 1.25f, -0.25f, 3.75f, 10.f / 60.f, 10.2f / 60.f, 1.9999f };
+    const uint32_t repeat = 11;
+
+    for (float sample_rate : { 60.f, 0.f })
+    {
+        skr::AnimEvaluator evaluator;
+        evaluator.sample_rate = sample_rate;
+        // many small batches, every instance and sample is its own task
+        evaluator.samples_per_task = 1;
+        evaluator.instances_per_task = 3;
+
+        const uint32_t count = repeat * (uint32_t)std::size(times);
+        skr::Vector<Pose> outputs;
+        outputs.resize_default(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            skr::AnimEvaluator::Request request;
+            request.animation = (i % 2) ? &animation : &other_animation;
+            request.skeleton = &skeleton;
+            request.time = times[i % std::size(times)];
+            request.output = &outputs[i];
+            evaluator.add(request);
+        }
+        evaluator.evaluate();
+
+        uint64_t wrong = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const auto& anim = (i % 2) ? animation : other_animation;
+            wrong += mismatches(to_model(sample(anim, times[i % std::size(times)], sample_rate)), outputs[i]);
+        }
+        EXPECT_EQ(wrong, 0);
+
+        // two animations, the times collapse to fewer samples than instances
+        EXPECT_EQ(evaluator.stats().requests, count);
+        EXPECT_TRUE(evaluator.stats().samplings <= 2 * (uint32_t)std::size(times));
+        EXPECT_TRUE(evaluator.stats().samplings < count);
+        EXPECT_EQ(evaluator.stats().skipped, 0);
+    }
+}
+
+TEST_CASE_METHOD(AnimEvaluatorTests, "LodMatchesBlendedDirectJobs")
+{
+    // importance -> period: 1, 2, 4, 8 (0.1 is clamped by max_period)
+    const float importances[] = { 1.f, 0.5f, 0.3f, 0.25f, 0.1f, 0.5f };
+    static constexpr uint32_t kInstanceCount = (uint32_t)std::size(importances);
+    static constexpr uint32_t kFrameCount = 40;
+    const float delta = 1.f / 30.f;
+
+    skr::AnimEvaluator evaluator;
+    evaluator.sample_rate = 0.f;
+    evaluator.max_period = 8;
+    evaluator.instances_per_task = 1;
+
+    // the schedule the evaluator documents: an update samples now and one period ahead, frames in between blend
+    struct Reference
+    {
+        uint32_t period = 0;
+        uint32_t frames = 0;
+        float from = 0.f;
+        float to = 0.f;
+    };
+    Reference references[kInstanceCount];
+    skr::AnimPlaybackState states[kInstanceCount];
+    Pose outputs[kInstanceCount];
+    uint32_t phase = 0;
+
+    uint64_t wrong = 0, skipped = 0;
+    for (uint32_t frame = 0; frame < kFrameCount; ++frame)
+    {
+        evaluator.clear();
+        for (uint32_t i = 0; i < kInstanceCount; ++i)
+        {
+            skr::AnimEvaluator::Request request;
+            request.animation = &animation;
+            request.skeleton = &skeleton;
+            request.time = 0.37f * (float)i + delta * (float)frame;
+            request.delta = delta;
+            request.importance = importances[i];
+            request.state = &states[i];
+            request.output = &outputs[i];
+            evaluator.add(request);
+        }
+        evaluator.evaluate();
+        skipped += evaluator.stats().skipped;
+
+        for (uint32_t i = 0; i < kInstanceCount; ++i)
+        {
+            const float time = 0.37f * (float)i + delta * (float)frame;
+            auto& ref = references[i];
+            uint32_t period = std::clamp((uint32_t)std::ceil(1.f / std::max(importances[i], 1.f / 8.f)), 1u, 8u);
+            Pose expected;
+            if (period == 1)
+            {
+                ref = {};
+                expected = to_model(sample(animation, time));
+            }
+            else if (ref.period != 0 && ref.frames + 1 < ref.period)
+            {
+                ref.frames += 1;
+                expected = blend(sample(animation, ref.from), sample(animation, ref.to), (float)ref.frames / (float)ref.period);
+            }
+            else
+            {
+                // the first cycle of each instance is shortened to stagger updates
+                if (ref.period == 0)
+                    period -= phase++ % period;
+                // later cycles start from the pose sampled ahead by the previous one
+                ref.from = ref.period == 0 ? time : ref.to;
+                ref.period = period;
+                ref.frames = 0;
+                ref.to = time + delta * (float)period;
+                expected = to_model(sample(animation, ref.from));
+            }
+            wrong += mismatches(expected, outputs[i]);
+        }
+    }
+    EXPECT_EQ(wrong, 0);
+    // lod instances skipped most of their samplings
+    EXPECT_TRUE(skipped > kFrameCount * 2);
+}
+
+TEST_CASE_METHOD(AnimEvaluatorTests, "ImportanceFromDistance")
+{
+    EXPECT_EQ(skr::AnimEvaluator::ImportanceFromDistance(0.f, 10.f), 1.f);
+    EXPECT_EQ(skr::AnimEvaluator::ImportanceFromDistance(10.f, 10.f), 1.f);
+    EXPECT_EQ(skr::AnimEvaluator::ImportanceFromDistance(40.f, 10.f), 0.25f);
+}
@@ -0,0 +1,257 @@
+#include "SkrAnim/components/skin_component.hpp"
+#include "SkrRenderer/resources/mesh_resource.h"
+#include "SkrRT/resource/resource_header.hpp"
+#include "SkrTask/fib_task.hpp"
+#include "SkrCore/log.h"
+
+#include <random>
+
+#include "SkrTestFramework/framework.hpp"
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+static constexpr uint32_t kAnimJointCount = 12;
+static constexpr uint32_t kSkinJointCount = 9;
+static constexpr uint32_t kInstanceCount = 5;
+// not multiples of the task size, so every primitive ends with a short range
+static constexpr uint32_t kVertexCounts[] = { 1000, 333, 1 };
+
+struct SkinBatchTests
+{
+    SkinBatchTests()
+        : rnd(0x5eed)
+    {
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+        build_mesh();
+        build_skin();
+    }
+
+    ~SkinBatchTests()
+    {
+        // the record lives on the fixture, keep the handles from unloading it through the resource system
+        skin_record.loadingStatus = SKR_LOADING_STATUS_UNLOADED;
+        scheduler.unbind();
+    }
+
+    float random(float min, float max)
+    {
+        return std::uniform_real_distribution<float>(min, max)(rnd);
+    }
+
+    void build_mesh()
+    {
+        struct Attribute
+        {
+            skr::EVertexAttribute attribute;
+            uint32_t stride;
+        };
+        const Attribute attributes[] = {
+            { skr::EVertexAttribute::POSITION, sizeof(float) * 3 },
+            { skr::EVertexAttribute::NORMAL, sizeof(float) * 3 },
+            { skr::EVertexAttribute::TANGENT, sizeof(float) * 4 },
+            { skr::EVertexAttribute::JOINTS, sizeof(uint16_t) * 4 },
+            { skr::EVertexAttribute::WEIGHTS, sizeof(float) * 4 },
+        };
+        uint64_t bin_size = 0;
+        for (auto vertex_count : kVertexCounts)
+            for (const auto& attr : attributes)
+                bin_size += vertex_count * attr.stride;
+        auto blob = skr::IBlob::CreateAligned(nullptr, bin_size, 16, false);
+
+        uint32_t offset = 0;
+        for (auto vertex_count : kVertexCounts)
+        {
+            auto& prim = mesh.primitives.add_default().ref();
+            prim.vertex_count = vertex_count;
+            for (const auto& attr : attributes)
+            {
+                auto& entry = prim.vertex_buffers.add_default().ref();
+                entry.attribute = attr.attribute;
+                entry.attribute_index = 0;
+                entry.buffer_index = 0;
+                entry.vertex_count = vertex_count;
+                entry.stride = attr.stride;
+                entry.offset = offset;
+
+                auto data = blob->get_data() + offset;
+                for (uint32_t v = 0; v < vertex_count; ++v)
+                {
+                    if (attr.attribute == skr::EVertexAttribute::JOINTS)
+                    {
+                        auto joints = (uint16_t*)data + v * 4;
+                        for (uint32_t j = 0; j < 4; ++j)
+                            joints[j] = (uint16_t)(rnd() % kSkinJointCount);
+                    }
+                    else if (attr.attribute == skr::EVertexAttribute::WEIGHTS)
+                    {
+                        auto weights = (float*)data + v * 4;
+                        float sum = 0.f;
+                        for (uint32_t j = 0; j < 4; ++j)
+                            sum += (weights[j] = random(0.1f, 1.f));
+                        for (uint32_t j = 0; j < 4; ++j)
+                            weights[j] /= sum;
+                    }
+                    else
+                    {
+                        auto values = (float*)(data + v * attr.stride);
+                        for (uint32_t c = 0; c < attr.stride / sizeof(float); ++c)
+                            values[c] = random(-1.f, 1.f);
+                        if (attr.attribute == skr::EVertexAttribute::TANGENT)
+                            values[3] = (v & 1) ? 1.f : -1.f;
+                    }
+                }
+                offset += vertex_count * attr.stride;
+            }
+        }
+        auto& bin = mesh.bins.add_default().ref();
+        bin.index = 0;
+        bin.byte_length = bin_size;
+        bin.used_with_vertex = true;
+        bin.used_with_index = false;
+        bin.blob = blob;
+    }
+
+    void build_skin()
+    {
+        for (uint32_t i = 0; i < kSkinJointCount; ++i)
+        {
+            skin_resource.joint_remaps.add(skr::SerializeConstString(u8"joint"));
+            auto inverse = ozz::math::Float4x4::Translation(ozz::math::Float3(random(-1.f, 1.f), random(-1.f, 1.f), random(-1.f, 1.f)));
+            skin_resource.inverse_bind_poses.add(reinterpret_cast<const skr_float4x4_t&>(inverse));
+        }
+        skin_record.resource = &skin_resource;
+        skin_record.loadingStatus = SKR_LOADING_STATUS_INSTALLED;
+    }
+
+    // same layout as skr_init_anim_component, without a skeleton resource
+    void init_instance(skr::SkinComponent& skin, skr::AnimComponent& anim, uint32_t seed)
+    {
+        skin.skin_resource.set_resolved(&skin_record, 0, SKR_REQUESTER_SYSTEM);
+        std::mt19937 joint_rnd(seed);
+        skin.joint_remaps.resize_zeroed(kSkinJointCount);
+        for (uint32_t i = 0; i < kSkinJointCount; ++i)
+            skin.joint_remaps[i] = (uint16_t)(joint_rnd() % kAnimJointCount);
+
+        anim.joint_matrices.resize_zeroed(kAnimJointCount);
+        for (uint32_t i = 0; i < kAnimJointCount; ++i)
+        {
+            const float angle = (float)(joint_rnd() % 628) / 100.f;
+            const float scale = 0.5f + (float)(joint_rnd() % 100) / 100.f;
+            const auto translation = ozz::math::Float3((float)(joint_rnd() % 7), (float)(joint_rnd() % 5), -(float)(joint_rnd() % 3));
+            anim.joint_matrices[i] = ozz::math::Float4x4::Translation(translation) *
+                                     ozz::math::Float4x4::FromAxisAngle(ozz::math::Float3(0.f, 1.f, 0.f), angle) *
+                                     ozz::math::Float4x4::Scaling(ozz::math::Float3(scale, scale, scale));
+        }
+
+        uint32_t buffer_size = 0;
+        anim.primitives.resize_default(mesh.primitives.size());
+        for (size_t i = 0; i < mesh.primitives.size(); ++i)
+        {
+            const auto vertex_count = mesh.primitives[i].vertex_count;
+            auto& prim = anim.primitives[i];
+            for (const auto& entry : mesh.primitives[i].vertex_buffers)
+            {
+                skr::VertexBufferEntry* out = nullptr;
+                if (entry.attribute == skr::EVertexAttribute::POSITION)
+                    out = &prim.position;
+                else if (entry.attribute == skr::EVertexAttribute::NORMAL)
+                    out = &prim.normal;
+                else if (entry.attribute == skr::EVertexAttribute::TANGENT)
+                    out = &prim.tangent;
+                if (!out)
+                    continue;
+                *out = entry;
+                out->offset = buffer_size;
+                buffer_size += vertex_count * entry.stride;
+            }
+        }
+        anim.buffers.add(skr::IBlob::CreateAligned(nullptr, buffer_size, 16, false));
+        memset(anim.buffers[0]->get_data(), 0, buffer_size);
+    }
+
+    std::mt19937 rnd;
+    skr::task::scheduler_t scheduler;
+    skr::MeshResource mesh;
+    skr::SkinResource skin_resource;
+    SResourceRecord skin_record;
+    // destroyed after the fixture body marks the record unloaded
+    skr::SkinComponent ref_skins[kInstanceCount], batch_skins[kInstanceCount];
+    skr::AnimComponent ref_anims[kInstanceCount], batch_anims[kInstanceCount];
+};
+
+static void expect_same_output(const skr::AnimComponent& expected, const skr::AnimComponent& actual)
+{
+    const auto size = expected.buffers[0]->get_size();
+    REQUIRE(size == actual.buffers[0]->get_size());
+    const auto lhs = (const float*)expected.buffers[0]->get_data();
+    const auto rhs = (const float*)actual.buffers[0]->get_data();
+    uint64_t mismatches = 0;
+    for (uint64_t i = 0; i < size / sizeof(float); ++i)
+    {
+        if (std::abs(lhs[i] - rhs[i]) > 1e-4f * std::max(1.f, std::abs(lhs[i])))
+            ++mismatches;
+    }
+    EXPECT_EQ(mismatches, 0);
+}
+
+TEST_CASE_METHOD(SkinBatchTests, "BatchMatchesPerEntitySkinning")
+{
+    for (uint32_t i = 0; i < kInstanceCount; ++i)
+    {
+        init_instance(ref_skins[i], ref_anims[i], i + 1);
+        init_instance(batch_skins[i], batch_anims[i], i + 1);
+    }
+
+    for (uint32_t i = 0; i < kInstanceCount; ++i)
+        skr_cpu_skin(&ref_skins[i], &ref_anims[i], &mesh);
+
+    // small task sizes split primitives into many ranges, the default one keeps them whole
+    for (uint32_t vertices_per_task : { 1u, 64u, 100u, skr::CPUSkinBatch::kDefaultVerticesPerTask })
+    {
+        for (uint32_t i = 0; i < kInstanceCount; ++i)
+            memset(batch_anims[i].buffers[0]->get_data(), 0, batch_anims[i].buffers[0]->get_size());
+
+        skr::CPUSkinBatch batch;
+        for (uint32_t i = 0; i < kInstanceCount; ++i)
+            batch.add(&batch_skins[i], &batch_anims[i], &mesh);
+        batch.run(vertices_per_task);
+
+        for (uint32_t i = 0; i < kInstanceCount; ++i)
+            expect_same_output(ref_anims[i], batch_anims[i]);
+    }
+}
+
+TEST_CASE_METHOD(SkinBatchTests, "BatchIsReusable")
+{
+    auto& ref_skin = ref_skins[0];
+    auto& ref_anim = ref_anims[0];
+    auto& batch_skin = batch_skins[0];
+    auto& batch_anim = batch_anims[0];
+    init_instance(ref_skin, ref_anim, 42);
+    init_instance(batch_skin, batch_anim, 42);
+
+    skr::CPUSkinBatch batch;
+    for (uint32_t frame = 0; frame < 3; ++frame)
+    {
+        // new joint matrices every frame, as the anim system writes them
+        for (uint32_t i = 0; i < kAnimJointCount; ++i)
+        {
+            const auto offset = ozz::math::Float4x4::Translation(ozz::math::Float3(0.f, (float)frame, 0.f));
+            ref_anim.joint_matrices[i] = offset * ref_anim.joint_matrices[i];
+            batch_anim.joint_matrices[i] = offset * batch_anim.joint_matrices[i];
+        }
+        skr_cpu_skin(&ref_skin, &ref_anim, &mesh);
+
+        batch.clear();
+        batch.add(&batch_skin, &batch_anim, &mesh);
+        batch.run(128);
+        expect_same_output(ref_anim, batch_anim);
+    }
+}
@@ -21,9 +21,17 @@ public static class AsyncTests
         /* seems this little toy is buggy
         Test.UnitTest("Task2Test")
             .Depend(Visibility.Public, "SkrCore")
-            .AddCppFiles("task2/**.cpp");
+            .AddCppFiles("task2/main.cpp");
         */
 
+        Test.UnitTest("Task2SchedulingTest")
+            .Depend(Visibility.Public, "SkrTask")
+            .AddCppFiles("task2/scheduling.cpp");
+
+        Test.UnitTest("ParallelForTest")
+            .Depend(Visibility.Public, "SkrTask")
+            .AddCppFiles("parallel_for/*.cpp");
+
         Test.UnitTest("MarlTest")
             .EnableUnityBuild()
             .Depend(Visibility.Public, "SkrTask")
@@ -0,0 +1,196 @@
+#include "SkrCore/log.h"
+#include "SkrTask/parallel_for.hpp"
+#include <vector>
+
+#include "SkrTestFramework/framework.hpp"
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+static constexpr uint32_t kWorkerCount = 4;
+// empty, single, not powers of two and above the grains of a task
+static constexpr size_t kSizes[] = { 0, 1, 2, 3, 7, 31, 1000, 4097, 100'003 };
+static constexpr size_t kMinGrains[] = { 1, 3, 64, 5000 };
+
+struct ParallelForTests
+{
+    ParallelForTests()
+    {
+        skr::task::scheudler_config_t config;
+        config.numThreads = kWorkerCount;
+        scheduler.initialize(config);
+        scheduler.bind();
+    }
+
+    ~ParallelForTests()
+    {
+        scheduler.unbind();
+    }
+
+    skr::task::scheduler_t scheduler;
+};
+
+// x -> a * x + b, composing them is associative but not commutative
+struct Affine
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+    bool operator==(const Affine& rhs) const { return a == rhs.a && b == rhs.b; }
+};
+static Affine then(Affine first, Affine second)
+{
+    return { second.a * first.a, second.a * first.b + second.b };
+}
+static Affine affine_of(size_t i)
+{
+    return { (uint32_t)(i * 2654435761u) | 1u, (uint32_t)(i * 40503u + 7u) };
+}
+
+TEST_CASE_METHOD(ParallelForTests, "LayoutFollowsSchedulerWorkers")
+{
+    EXPECT_EQ(skr::task::worker_count(), kWorkerCount);
+
+    uint32_t task_count, grain;
+    skr::parallel_detail::adaptive_layout(1'000'000, 1, task_count, grain);
+    EXPECT_EQ(task_count, kWorkerCount);
+    skr::parallel_detail::adaptive_layout(10, 4, task_count, grain);
+    EXPECT_EQ(task_count, 3);
+    EXPECT_EQ(grain, 4);
+}
+
+TEST_CASE_METHOD(ParallelForTests, "ForVisitsEveryIndexOnce")
+{
+    for (auto size : kSizes)
+    {
+        for (auto min_grain : kMinGrains)
+        {
+            std::vector<uint32_t> visits(size, 0);
+            skr::parallel_for_adaptive((size_t)0, size, [&](size_t first, size_t last) {
+                for (size_t i = first; i < last; ++i)
+                    visits[i] += 1;
+            },
+                min_grain);
+
+            uint64_t wrong = 0;
+            for (auto count : visits)
+                wrong += (count == 1) ? 0 : 1;
+            EXPECT_EQ(wrong, 0);
+        }
+    }
+}
+
+TEST_CASE_METHOD(ParallelForTests, "ForWithIterators")
+{
+    for (auto size : kSizes)
+    {
+        std::vector<uint64_t> values(size);
+        for (size_t i = 0; i < size; ++i)
+            values[i] = i;
+        skr::parallel_for_adaptive(values.begin(), values.end(), [](auto first, auto last) {
+            for (auto it = first; it != last; ++it)
+                *it = *it * 3 + 1;
+        });
+
+        uint64_t wrong = 0;
+        for (size_t i = 0; i < size; ++i)
+            wrong += (values[i] == i * 3 + 1) ? 0 : 1;
+        EXPECT_EQ(wrong, 0);
+    }
+}
+
+TEST_CASE_METHOD(ParallelForTests, "ReduceMatchesSerial")
+{
+    for (auto size : kSizes)
+    {
+        for (auto min_grain : kMinGrains)
+        {
+            std::vector<uint64_t> values(size);
+            uint64_t expected_sum = 0, expected_max = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                values[i] = (i * 2654435761u) % 1000;
+                expected_sum += values[i];
+                expected_max = std::max(expected_max, values[i]);
+            }
+
+            const auto sum = skr::parallel_reduce<uint64_t>(
+                values.begin(), values.end(), 7,
+                [](auto first, auto last) {
+                    uint64_t partial = 0;
+                    for (auto it = first; it != last; ++it)
+                        partial += *it;
+                    return partial;
+                },
+                [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; },
+                min_grain);
+            // the identity is folded in once
+            EXPECT_EQ(sum, expected_sum + 7);
+
+            const auto max = skr::parallel_reduce<uint64_t>(
+                values.begin(), values.end(), 0,
+                [](auto first, auto last) { return first == last ? 0 : *std::max_element(first, last); },
+                [](uint64_t lhs, uint64_t rhs) { return std::max(lhs, rhs); },
+                min_grain);
+            EXPECT_EQ(max, expected_max);
+        }
+    }
+}
+
+TEST_CASE_METHOD(ParallelForTests, "ScanMatchesSerialForNonCommutativeOp")
+{
+    for (auto size : kSizes)
+    {
+        for (auto min_grain : kMinGrains)
+        {
+            std::vector<Affine> input(size);
+            std::vector<Affine> expected(size);
+            Affine acc;
+            for (size_t i = 0; i < size; ++i)
+            {
+                input[i] = affine_of(i);
+                acc = then(acc, input[i]);
+                expected[i] = acc;
+            }
+
+            std::vector<Affine> output(size);
+            skr::parallel_scan(input.begin(), input.end(), output.begin(), Affine{}, then, min_grain);
+            uint64_t wrong = 0;
+            for (size_t i = 0; i < size; ++i)
+                wrong += (output[i] == expected[i]) ? 0 : 1;
+            EXPECT_EQ(wrong, 0);
+
+            // in place
+            skr::parallel_scan(input.begin(), input.end(), input.begin(), Affine{}, then, min_grain);
+            wrong = 0;
+            for (size_t i = 0; i < size; ++i)
+                wrong += (input[i] == expected[i]) ? 0 : 1;
+            EXPECT_EQ(wrong, 0);
+        }
+    }
+}
+
+TEST_CASE_METHOD(ParallelForTests, "RangesBeyond32Bits")
+{
+    // index ranges are packed as 32-bit values, longer ones must still be covered exactly once
+    const size_t size = (size_t)UINT32_MAX + 1000;
+    const size_t min_grain = (size_t)1 << 30;
+
+    std::atomic<uint64_t> covered = 0;
+    skr::parallel_for_adaptive((size_t)0, size, [&](size_t first, size_t last) {
+        covered += last - first;
+    },
+        min_grain);
+    EXPECT_EQ(covered.load(), size);
+
+    const auto reduced = skr::parallel_reduce<uint64_t>(
+        (size_t)0, size, 0,
+        [](size_t first, size_t last) { return (uint64_t)(last - first); },
+        [](uint64_t lhs, uint64_t rhs) { return lhs + rhs; },
+        min_grain);
+    EXPECT_EQ(reduced, size);
+}
@@ -0,0 +1,242 @@
+#include "SkrCore/log.h"
+
+#include "SkrTestFramework/framework.hpp"
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+#if __cpp_impl_coroutine
+#include "SkrTask/co_task.hpp"
+#include "SkrTask/work_stealing_deque.hpp"
+#include <thread>
+#include <vector>
+
+struct DequeItem
+{
+    uint32_t id = 0;
+};
+
+TEST_CASE("WorkStealingDequeRunsEveryItemOnce")
+{
+    // bursts larger than the initial ring, so the owner grows it while thieves read
+    static constexpr uint32_t kItemCount = 200'000;
+    static constexpr uint32_t kBurst = 1000;
+    static constexpr uint32_t kThiefCount = 3;
+
+    std::vector<std::atomic<uint32_t>> runs(kItemCount);
+    for (auto& run : runs)
+        run = 0;
+    std::atomic<uint32_t> executed = 0;
+    std::atomic<uint32_t> stolen = 0;
+    auto execute = [&](DequeItem* item) {
+        runs[item->id]++;
+        executed++;
+        SkrDelete(item);
+    };
+
+    {
+        skr::task2::WorkStealingDeque<DequeItem> deque;
+        std::vector<std::thread> thieves;
+        for (uint32_t i = 0; i < kThiefCount; ++i)
+        {
+            thieves.emplace_back([&] {
+                while (executed.load() < kItemCount)
+                {
+                    if (auto item = deque.steal())
+                    {
+                        stolen++;
+                        execute(item);
+                    }
+                }
+            });
+        }
+
+        uint32_t next = 0;
+        while (next < kItemCount)
+        {
+            const uint32_t end = std::min(next + kBurst, kItemCount);
+            for (; next < end; ++next)
+                deque.push(SkrNew<DequeItem>(DequeItem{ next }));
+            // pop half the burst, racing the thieves for the last items
+            for (uint32_t i = 0; i < kBurst / 2; ++i)
+            {
+                if (auto item = deque.pop())
+                    execute(item);
+            }
+        }
+        while (auto item = deque.pop())
+            execute(item);
+
+        for (auto& thief : thieves)
+            thief.join();
+        EXPECT_EQ(deque.pop(), nullptr);
+        EXPECT_EQ(deque.steal(), nullptr);
+    }
+
+    uint32_t wrong = 0;
+    for (auto& run : runs)
+        wrong += (run.load() == 1) ? 0 : 1;
+    EXPECT_EQ(wrong, 0);
+    EXPECT_EQ(executed.load(), kItemCount);
+    // not guaranteed by the deque, but with this many items the thieves always get some
+    EXPECT_NE(stolen.load(), 0);
+}
+
+TEST_CASE("WorkStealingDequeOrder")
+{
+    skr::task2::WorkStealingDeque<DequeItem> deque;
+    for (uint32_t i = 0; i < 600; ++i)
+        deque.push(SkrNew<DequeItem>(DequeItem{ i }));
+
+    // thieves get the oldest item, the owner the newest
+    auto oldest = deque.steal();
+    REQUIRE(oldest != nullptr);
+    EXPECT_EQ(oldest->id, 0);
+    auto newest = deque.pop();
+    REQUIRE(newest != nullptr);
+    EXPECT_EQ(newest->id, 599);
+    SkrDelete(oldest);
+    SkrDelete(newest);
+    // the rest is freed by the deque
+}
+
+TEST_CASE("PriorityLanes")
+{
+    skr::task2::scheudler_config_t config;
+    config.numThreads = 2; // the main worker only runs tasks in sync, everything else lands on worker 1
+    config.setAffinity = false;
+    skr::task2::scheduler_t scheduler;
+    scheduler.initialize(config);
+    scheduler.bind();
+
+    static constexpr uint32_t kPerLane = 64;
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::atomic<uint32_t> done = 0;
+    std::atomic<uint32_t> order = 0;
+    uint32_t ranks[3][kPerLane * 2] = {};
+
+    auto task_of = [&](uint32_t lane, uint32_t i) {
+        return [&, lane, i] {
+            ranks[lane][i] = order++;
+            done++;
+        };
+    };
+
+    // worker 1 is held by the blocker while both its queues and its local deques fill up in mixed order
+    scheduler.schedule([&] {
+        started = true;
+        while (!released.load())
+            std::this_thread::yield();
+        for (uint32_t i = 0; i < kPerLane; ++i)
+        {
+            for (uint32_t lane : { 2u, 1u, 0u })
+                skr::task2::schedule(task_of(lane, kPerLane + i), (skr::task2::task_priority_t)lane);
+        }
+    });
+    while (!started.load())
+        std::this_thread::yield();
+    for (uint32_t i = 0; i < kPerLane; ++i)
+    {
+        for (uint32_t lane : { 2u, 0u, 1u })
+            scheduler.schedule(task_of(lane, i), (skr::task2::task_priority_t)lane);
+    }
+    released = true;
+
+    // no sync here, the main worker would steal and run tasks out of the worker's order
+    while (done.load() < kPerLane * 2 * 3)
+        std::this_thread::yield();
+
+    // every high task ran before any normal one, every normal one before any background one
+    for (uint32_t lane = 0; lane + 1 < 3; ++lane)
+    {
+        uint32_t last = 0, first = UINT32_MAX;
+        for (uint32_t i = 0; i < kPerLane * 2; ++i)
+        {
+            last = std::max(last, ranks[lane][i]);
+            first = std::min(first, ranks[lane + 1][i]);
+        }
+        EXPECT_TRUE(last < first);
+    }
+
+    scheduler.unbind();
+    scheduler.shutdown();
+}
+
+TEST_CASE("WorkerGroups")
+{
+    skr::task2::scheudler_config_t config;
+    config.numThreads = 24;
+    config.workersPerGroup = 8;
+    config.setAffinity = false;
+    skr::task2::scheduler_t scheduler;
+    scheduler.initialize(config);
+
+    EXPECT_EQ(scheduler.numGroups, 3);
+    EXPECT_EQ(scheduler.group_of(0), 0);
+    EXPECT_EQ(scheduler.group_of(7), 0);
+    EXPECT_EQ(scheduler.group_of(8), 1);
+    EXPECT_EQ(scheduler.group_of(23), 2);
+
+    // own group first, rotated to start after the thief, then group 2 and group 0, each worker once
+    skr::Vector<uint32_t> victims;
+    scheduler.steal_order(9, victims);
+    REQUIRE(victims.size() == 23);
+    const uint32_t expected_own[] = { 10, 11, 12, 13, 14, 15, 8 };
+    for (uint32_t i = 0; i < 7; ++i)
+        EXPECT_EQ(victims[i], expected_own[i]);
+    for (uint32_t i = 7; i < 15; ++i)
+        EXPECT_EQ(scheduler.group_of(victims[i]), 2);
+    for (uint32_t i = 15; i < 23; ++i)
+        EXPECT_EQ(scheduler.group_of(victims[i]), 0);
+    std::vector<uint32_t> seen(24, 0);
+    for (auto victim : victims)
+        seen[victim]++;
+    for (uint32_t worker = 0; worker < 24; ++worker)
+        EXPECT_EQ(seen[worker], worker == 9 ? 0 : 1);
+
+    // groups pin to their own cores, and wrap around when there are fewer cores than workers
+    EXPECT_EQ(scheduler.group_affinity_mask(0, 32), 0xFFull);
+    EXPECT_EQ(scheduler.group_affinity_mask(1, 32), 0xFF00ull);
+    EXPECT_EQ(scheduler.group_affinity_mask(2, 32), 0xFF0000ull);
+    EXPECT_EQ(scheduler.group_affinity_mask(1, 12), 0xF0Full);
+
+    scheduler.shutdown();
+}
+
+TEST_CASE("WorkerGroupDefaults")
+{
+    {
+        skr::task2::scheudler_config_t config;
+        config.numThreads = 12;
+        config.setAffinity = false;
+        skr::task2::scheduler_t scheduler;
+        scheduler.initialize(config);
+        EXPECT_EQ(scheduler.config.workersPerGroup, 12);
+        EXPECT_EQ(scheduler.numGroups, 1);
+        scheduler.shutdown();
+    }
+    {
+        skr::task2::scheudler_config_t config;
+        config.numThreads = 20;
+        config.setAffinity = false;
+        skr::task2::scheduler_t scheduler;
+        scheduler.initialize(config);
+        EXPECT_EQ(scheduler.config.workersPerGroup, 8);
+        EXPECT_EQ(scheduler.numGroups, 3);
+        // the last group is short
+        skr::Vector<uint32_t> victims;
+        scheduler.steal_order(17, victims);
+        EXPECT_EQ(victims.size(), 19);
+        EXPECT_EQ(victims[0], 18);
+        EXPECT_EQ(victims[1], 19);
+        EXPECT_EQ(victims[2], 16);
+        scheduler.shutdown();
+    }
+}
+#endif
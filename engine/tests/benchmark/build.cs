@@ -0,0 +1,60 @@
+using SB;
+using SB.Core;
+using System.Runtime.CompilerServices;
+
+[TargetScript]
+public static class Benchmarks
+{
+    static Benchmarks()
+    {
+        var BenchmarkFramework = BuildSystem.Target("SkrBenchmarkFramework")
+            .TargetType(TargetType.Static)
+            .Depend(Visibility.Public, "SkrCore")
+            .IncludeDirs(Visibility.Public, "framework/include")
+            .AddCppFiles("framework/src/benchmark.cpp");
+
+        if (BuildSystem.TargetOS == OSPlatform.Windows)
+            BenchmarkFramework.CXFlags(Visibility.Public, "/utf-8");
+
+        Bench.Benchmark("ContainerBenchmark")
+            .AddCppFiles("containers/*.cpp");
+
+        Bench.Benchmark("SerdeBenchmark")
+            .AddCppFiles("serde/*.cpp");
+
+        Bench.Benchmark("SugoiBenchmark")
+            .Depend(Visibility.Public, "SkrRT")
+            .AddCppFiles("sugoi/*.cpp");
+
+        Engine.Program("ECSBenchmark")
+            .EnableCodegen("ecs")
+            .AddMetaHeaders("ecs/**.hpp")
+            .Depend(Visibility.Private, "SkrBenchmarkFramework")
+            .Depend(Visibility.Public, "SkrRT")
+            .AddCppFiles("ecs/*.cpp");
+
+        Bench.Benchmark("IOBenchmark")
+            .Depend(Visibility.Public, "SkrRT")
+            .AddCppFiles("io/*.cpp");
+
+        Bench.Benchmark("TaskBenchmark")
+            .Depend(Visibility.Public, "SkrTask")
+            .AddCppFiles("task/*.cpp");
+    }
+}
+
+namespace SB
+{
+    public partial class Bench : BuildSystem
+    {
+        // benchmarks are not part of `SB test`, run them with `SB run <target> --json <file>`
+        public static Target Benchmark(string Name, [CallerFilePath] string? Location = null, [CallerLineNumber] int LineNumber = 0)
+        {
+            return BuildSystem.Target(Name, Location, LineNumber)
+                .UseSharedPCH()
+                .TargetType(TargetType.Executable)
+                .Depend(Visibility.Private, "SkrBenchmarkFramework")
+                .Exception(false);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrContainers/map.hpp"
+#include "SkrContainers/string.hpp"
+
+using skr::bench::do_not_optimize;
+
+// deterministic keys so runs are comparable
+static skr::Vector<uint64_t> make_keys(uint64_t count)
+{
+    skr::Vector<uint64_t> keys;
+    keys.reserve(count);
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        keys.add(x);
+    }
+    return keys;
+}
+
+// vector
+SKR_BENCHMARK_ARGS(Vector, Add, 1 << 10, 1 << 16)
+{
+    const auto count = (uint64_t)state.arg();
+    while (state.keep_running())
+    {
+        skr::Vector<uint64_t> v;
+        for (uint64_t i = 0; i < count; ++i)
+            v.add(i);
+        do_not_optimize(v.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Vector, AddReserved, 1 << 10, 1 << 16)
+{
+    const auto count = (uint64_t)state.arg();
+    while (state.keep_running())
+    {
+        skr::Vector<uint64_t> v;
+        v.reserve(count);
+        for (uint64_t i = 0; i < count; ++i)
+            v.add(i);
+        do_not_optimize(v.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Vector, Iterate, 1 << 10, 1 << 16)
+{
+    const auto            count = (uint64_t)state.arg();
+    skr::Vector<uint64_t> v     = make_keys(count);
+    while (state.keep_running())
+    {
+        uint64_t sum = 0;
+        for (auto x : v)
+            sum += x;
+        do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * count * sizeof(uint64_t));
+}
+
+SKR_BENCHMARK_ARGS(Vector, RemoveSwap, 1 << 10, 1 << 14)
+{
+    const auto count = (uint64_t)state.arg();
+    const auto keys  = make_keys(count);
+    while (state.keep_running())
+    {
+        state.pause_timing();
+        skr::Vector<uint64_t> v = keys;
+        state.resume_timing();
+        while (!v.is_empty())
+            v.remove_at_swap(keys[v.size() - 1] % v.size());
+        do_not_optimize(v.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+// sparse hash map
+SKR_BENCHMARK_ARGS(Map, Add, 1 << 10, 1 << 16)
+{
+    const auto count = (uint64_t)state.arg();
+    const auto keys  = make_keys(count);
+    while (state.keep_running())
+    {
+        skr::Map<uint64_t, uint64_t> map;
+        for (auto key : keys)
+            map.add(key, key);
+        do_not_optimize(map.size());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Map, FindHit, 1 << 10, 1 << 16)
+{
+    const auto                   count = (uint64_t)state.arg();
+    const auto                   keys  = make_keys(count);
+    skr::Map<uint64_t, uint64_t> map;
+    for (auto key : keys)
+        map.add(key, key);
+    while (state.keep_running())
+    {
+        uint64_t sum = 0;
+        for (auto key : keys)
+            sum += map.find(key).value();
+        do_not_optimize(sum);
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Map, FindMiss, 1 << 10, 1 << 16)
+{
+    const auto                   count = (uint64_t)state.arg();
+    const auto                   keys  = make_keys(count * 2);
+    skr::Map<uint64_t, uint64_t> map;
+    for (uint64_t i = 0; i < count; ++i)
+        map.add(keys[i], keys[i]);
+    while (state.keep_running())
+    {
+        uint64_t found = 0;
+        for (uint64_t i = count; i < count * 2; ++i)
+            found += map.contains(keys[i]) ? 1 : 0;
+        do_not_optimize(found);
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Map, Remove, 1 << 10, 1 << 16)
+{
+    const auto                   count = (uint64_t)state.arg();
+    const auto                   keys  = make_keys(count);
+    skr::Map<uint64_t, uint64_t> filled;
+    for (auto key : keys)
+        filled.add(key, key);
+    while (state.keep_running())
+    {
+        state.pause_timing();
+        auto map = filled;
+        state.resume_timing();
+        for (auto key : keys)
+            map.remove(key);
+        do_not_optimize(map.size());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+// string
+SKR_BENCHMARK_ARGS(String, Append, 16, 1024)
+{
+    const auto count = (uint64_t)state.arg();
+    while (state.keep_running())
+    {
+        skr::String str;
+        for (uint64_t i = 0; i < count; ++i)
+            str.append(u8"sakura engine ");
+        do_not_optimize(str.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(String, Format, 16, 1024)
+{
+    const auto count = (uint64_t)state.arg();
+    while (state.keep_running())
+    {
+        skr::String str;
+        for (uint64_t i = 0; i < count; ++i)
+            skr::format_to(str, u8"{}: {} {:.3f};", u8"entity", i, (double)i * 0.5);
+        do_not_optimize(str.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(String, Find, 1 << 10, 1 << 16)
+{
+    const auto  count = (uint64_t)state.arg();
+    skr::String haystack;
+    for (uint64_t i = 0; i < count / 8; ++i)
+        haystack.append(u8"abcdefg ");
+    haystack.append(u8"needle");
+    while (state.keep_running())
+    {
+        auto found = haystack.find(u8"needle");
+        do_not_optimize(found);
+    }
+    state.set_bytes_processed(state.iterations() * haystack.length_buffer());
+}
+
+SKR_BENCHMARK(String, CopySmall)
+{
+    const skr::String source = u8"short string";
+    while (state.keep_running())
+    {
+        skr::String copy = source;
+        do_not_optimize(copy.data());
+    }
+    state.set_items_processed(state.iterations());
+}
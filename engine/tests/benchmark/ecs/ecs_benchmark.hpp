@@ -0,0 +1,21 @@
+#pragma once
+#include "SkrRT/sugoi/sugoi.h"
+#ifndef __meta__
+    #include "ecs_benchmark.generated.h"
+#endif
+
+sreflect_struct(
+    guid = "5b0e4c83-2f0e-4a5c-9d43-3c6a1f7e2b10"
+    ecs.comp = @enable
+)
+BenchPosition {
+    float x, y, z;
+};
+
+sreflect_struct(
+    guid = "5b0e4c83-2f0e-4a5c-9d43-3c6a1f7e2b11"
+    ecs.comp = @enable
+)
+BenchVelocity {
+    float x, y, z;
+};
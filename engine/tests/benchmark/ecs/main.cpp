@@ -0,0 +1,188 @@
+#include "ecs_benchmark.hpp"
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrCore/log.h"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrRT/ecs/world.hpp"
+#include "SkrRT/ecs/stack_allocator.hpp"
+
+static struct ProcInitializer {
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+        ::skr_log_initialize_async_worker();
+    }
+    ~ProcInitializer()
+    {
+        ::skr_log_finalize_async_worker();
+    }
+} init;
+
+// world with count moving entities, alive for one benchmark body
+struct BenchWorld {
+    BenchWorld(uint32_t count)
+        : world(scheduler)
+    {
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+        world.initialize();
+
+        struct Spawner {
+            void build(skr::ecs::ArchetypeBuilder& Builder)
+            {
+                Builder.add_component(&Spawner::positions)
+                    .add_component(&Spawner::velocities);
+            }
+            void run(skr::ecs::TaskContext& Context)
+            {
+                for (uint32_t i = 0; i < Context.size(); ++i)
+                {
+                    positions[i]  = { 0.f, 0.f, 0.f };
+                    velocities[i] = { 1.f, 0.5f, 0.25f };
+                }
+            }
+            skr::ecs::ComponentView<BenchPosition> positions;
+            skr::ecs::ComponentView<BenchVelocity> velocities;
+        } spawner;
+        world.create_entities(spawner, count);
+    }
+    ~BenchWorld()
+    {
+        world.finalize();
+        scheduler.unbind();
+    }
+
+    void sync()
+    {
+        skr::ecs::TaskScheduler::Get()->flush_all();
+        skr::ecs::TaskScheduler::Get()->sync_all();
+    }
+
+    skr::task::scheduler_t scheduler;
+    skr::ecs::ECSWorld     world;
+};
+
+struct EmptyJob {
+    void build(skr::ecs::AccessBuilder& Builder)
+    {
+        Builder.read(&EmptyJob::positions);
+    }
+    void run(skr::ecs::TaskContext& Context)
+    {
+    }
+    skr::ecs::ComponentView<const BenchPosition> positions;
+};
+
+struct MoveJob {
+    void build(skr::ecs::AccessBuilder& Builder)
+    {
+        Builder.write(&MoveJob::positions)
+            .read(&MoveJob::velocities);
+    }
+    void run(skr::ecs::TaskContext& Context)
+    {
+        for (uint32_t i = 0; i < Context.size(); ++i)
+        {
+            positions[i].x += velocities[i].x;
+            positions[i].y += velocities[i].y;
+            positions[i].z += velocities[i].z;
+        }
+    }
+    skr::ecs::ComponentView<BenchPosition>       positions;
+    skr::ecs::ComponentView<const BenchVelocity> velocities;
+};
+
+// dispatch + flush + sync of a job that does nothing, the scheduling overhead per frame
+SKR_BENCHMARK_ARGS(ECS, DispatchEmpty, 256, 4096)
+{
+    BenchWorld bench(1 << 16);
+    const auto batch = (uint32_t)state.arg();
+    EmptyJob   job;
+    auto       query = bench.world.dispatch_task(job, batch, nullptr);
+    bench.sync();
+    while (state.keep_running())
+    {
+        bench.world.dispatch_task(job, batch, query);
+        bench.sync();
+    }
+    bench.world.destroy_query(query);
+    state.set_items_processed(state.iterations());
+}
+
+// dependent chain of jobs writing the same component
+SKR_BENCHMARK_ARGS(ECS, DispatchChain, 4, 32)
+{
+    BenchWorld bench(1 << 16);
+    const auto chain = (uint32_t)state.arg();
+    MoveJob    job;
+    auto       query = bench.world.dispatch_task(job, 1024, nullptr);
+    bench.sync();
+    while (state.keep_running())
+    {
+        for (uint32_t i = 0; i < chain; ++i)
+            bench.world.dispatch_task(job, 1024, query);
+        bench.sync();
+    }
+    bench.world.destroy_query(query);
+    state.set_items_processed(state.iterations() * chain);
+}
+
+// same chain with the task graph recorded on the first frame and replayed after
+SKR_BENCHMARK_ARGS(ECS, DispatchChainReplay, 4, 32)
+{
+    BenchWorld bench(1 << 16);
+    const auto chain = (uint32_t)state.arg();
+    MoveJob    job;
+    skr::ecs::TaskScheduler::Get()->set_task_graph_replay(true);
+    auto query = bench.world.dispatch_task(job, 1024, nullptr);
+    bench.sync();
+    while (state.keep_running())
+    {
+        for (uint32_t i = 0; i < chain; ++i)
+            bench.world.dispatch_task(job, 1024, query);
+        bench.sync();
+    }
+    skr::ecs::TaskScheduler::Get()->set_task_graph_replay(false);
+    bench.world.destroy_query(query);
+    state.set_items_processed(state.iterations() * chain);
+}
+
+SKR_BENCHMARK_ARGS(ECS, MoveEntities, 1 << 14, 1 << 18)
+{
+    const auto count = (uint32_t)state.arg();
+    BenchWorld bench(count);
+    MoveJob    job;
+    auto       query = bench.world.dispatch_task(job, 1024, nullptr);
+    bench.sync();
+    while (state.keep_running())
+    {
+        bench.world.dispatch_task(job, 1024, query);
+        bench.sync();
+    }
+    bench.world.destroy_query(query);
+    state.set_items_processed(state.iterations() * count);
+}
+
+// frame scratch allocations from every worker, the pattern of task setup in the scheduler
+SKR_BENCHMARK_ARGS(ECS, StackAllocParallel, 1 << 10, 1 << 14)
+{
+    const auto             count = (uint32_t)state.arg();
+    skr::task::scheduler_t scheduler;
+    scheduler.initialize(skr::task::scheudler_config_t());
+    scheduler.bind();
+    skr::ecs::StackAllocator::Initialize();
+    skr::Vector<uint32_t> items;
+    items.resize(count, 0u);
+    while (state.keep_running())
+    {
+        skr::parallel_for(items.begin(), items.end(), 64, [](uint32_t* begin, uint32_t* end) {
+            skr::ecs::StackVector<uint64_t> scratch;
+            for (auto it = begin; it != end; ++it)
+                scratch.add(*it);
+            skr::bench::do_not_optimize(scratch.data());
+        });
+        skr::ecs::StackAllocator::Reset();
+    }
+    skr::ecs::StackAllocator::Finalize();
+    scheduler.unbind();
+    state.set_items_processed(state.iterations() * count);
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include "SkrBase/config.h"
+#include "SkrContainersDef/string.hpp"
+#include <chrono>
+#include <initializer_list>
+#if defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+#endif
+
+namespace skr::bench
+{
+// passed to every benchmark body, the timed region is the keep_running() loop:
+//
+//     SKR_BENCHMARK(Vector, Add)
+//     {
+//         // setup, not timed
+//         while (state.keep_running())
+//         {
+//             // timed
+//         }
+//         // teardown, not timed
+//     }
+struct State {
+    using Clock = std::chrono::steady_clock;
+
+    State(uint64_t iterations, int64_t arg) SKR_NOEXCEPT;
+
+    SKR_FORCEINLINE bool keep_running() SKR_NOEXCEPT
+    {
+        if (_remaining != 0) [[likely]]
+        {
+            --_remaining;
+            return true;
+        }
+        return _advance();
+    }
+
+    // excludes per iteration setup from the measurement
+    void pause_timing() SKR_NOEXCEPT;
+    void resume_timing() SKR_NOEXCEPT;
+
+    // throughput reported next to the timing, for the whole run (all iterations)
+    void set_items_processed(uint64_t items) SKR_NOEXCEPT { _items = items; }
+    void set_bytes_processed(uint64_t bytes) SKR_NOEXCEPT { _bytes = bytes; }
+    // marks the run as skipped, e.g. when a resource is unavailable on this machine
+    void skip(skr::StringView reason) SKR_NOEXCEPT;
+
+    uint64_t iterations() const SKR_NOEXCEPT { return _iterations; }
+    int64_t  arg() const SKR_NOEXCEPT { return _arg; }
+
+    uint64_t           elapsed_ns() const SKR_NOEXCEPT { return _elapsed_ns; }
+    uint64_t           items() const SKR_NOEXCEPT { return _items; }
+    uint64_t           bytes() const SKR_NOEXCEPT { return _bytes; }
+    bool               skipped() const SKR_NOEXCEPT { return _skipped; }
+    const skr::String& skip_reason() const SKR_NOEXCEPT { return _skip_reason; }
+
+private:
+    bool _advance() SKR_NOEXCEPT;
+
+    uint64_t          _remaining  = 0;
+    uint64_t          _iterations = 0;
+    int64_t           _arg        = 0;
+    bool              _started    = false;
+    bool              _paused     = false;
+    Clock::time_point _start;
+    uint64_t          _elapsed_ns = 0;
+    uint64_t          _items      = 0;
+    uint64_t          _bytes      = 0;
+    bool              _skipped    = false;
+    skr::String       _skip_reason;
+};
+
+using BenchmarkFunc = void (*)(State& state);
+
+struct Registrar {
+    // each arg registers a separate run named "<group>.<name>/<arg>"
+    Registrar(const char8_t* group, const char8_t* name, BenchmarkFunc func, std::initializer_list<int64_t> args = {}) SKR_NOEXCEPT;
+};
+
+// keeps the compiler from discarding a value that is otherwise unused
+template <typename T>
+SKR_FORCEINLINE void do_not_optimize(T const& value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    const volatile char* volatile sink = reinterpret_cast<const volatile char*>(&value);
+    (void)sink;
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// forces pending writes to memory to be considered observable
+SKR_FORCEINLINE void clobber_memory()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+} // namespace skr::bench
+
+#define SkrBenchConcat(x, y) SkrBenchConcatIndirect(x, y)
+#define SkrBenchConcatIndirect(x, y) x##y
+
+#define SKR_BENCHMARK_ARGS(group, name, ...)                                                                 \
+    static void SkrBenchConcat(_skr_bench_, SkrBenchConcat(group, SkrBenchConcat(_, name)))(               \
+    ::skr::bench::State & state);                                                                            \
+    static ::skr::bench::Registrar SkrBenchConcat(_skr_bench_reg_, SkrBenchConcat(group, SkrBenchConcat(_, name)))( \
+    u8"" #group, u8"" #name, &SkrBenchConcat(_skr_bench_, SkrBenchConcat(group, SkrBenchConcat(_, name))), { __VA_ARGS__ }); \
+    static void SkrBenchConcat(_skr_bench_, SkrBenchConcat(group, SkrBenchConcat(_, name)))(::skr::bench::State & state)
+
+#define SKR_BENCHMARK(group, name) SKR_BENCHMARK_ARGS(group, name)
@@ -0,0 +1,403 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrContainersDef/vector.hpp"
+#include "SkrContainersDef/hashmap.hpp"
+#include "SkrArchive/json/writer.h"
+#include "SkrArchive/json/reader.h"
+#include "SkrOS/filesystem.hpp"
+#include "SkrCore/log.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace skr::bench
+{
+// state
+State::State(uint64_t iterations, int64_t arg) SKR_NOEXCEPT
+    : _iterations(iterations)
+    , _arg(arg)
+{
+}
+
+bool State::_advance() SKR_NOEXCEPT
+{
+    if (!_started)
+    {
+        _started = true;
+        if (_iterations == 0)
+            return false;
+        _remaining = _iterations - 1;
+        _start     = Clock::now();
+        return true;
+    }
+    pause_timing();
+    return false;
+}
+
+void State::pause_timing() SKR_NOEXCEPT
+{
+    if (_started && !_paused)
+    {
+        _elapsed_ns += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+        _paused = true;
+    }
+}
+
+void State::resume_timing() SKR_NOEXCEPT
+{
+    if (_paused)
+    {
+        _paused = false;
+        _start  = Clock::now();
+    }
+}
+
+void State::skip(skr::StringView reason) SKR_NOEXCEPT
+{
+    _skipped     = true;
+    _skip_reason = reason;
+    _remaining   = 0;
+}
+
+// registry
+namespace
+{
+struct Entry {
+    skr::String           group;
+    skr::String           name;
+    BenchmarkFunc         func;
+    skr::Vector<int64_t>  args;
+};
+
+skr::Vector<Entry>& registry()
+{
+    static skr::Vector<Entry> entries;
+    return entries;
+}
+
+struct Options {
+    skr::String filter;
+    uint64_t    min_time_ms = 100;
+    uint32_t    repetitions = 5;
+    skr::String json;
+    skr::String baseline;
+    double      threshold = 0.05;
+    skr::String label;
+    bool        list = false;
+};
+
+struct Result {
+    skr::String name;
+    uint64_t    iterations = 0;
+    double      median     = 0.0; // ns per iteration
+    double      min        = 0.0;
+    double      mean       = 0.0;
+    double      stddev     = 0.0;
+    double      items_per_second = 0.0;
+    double      bytes_per_second = 0.0;
+    bool        skipped = false;
+    skr::String skip_reason;
+};
+
+static constexpr uint64_t kMaxIterations = 1'000'000'000;
+
+State run_once(const Entry& entry, int64_t arg, uint64_t iterations)
+{
+    State state(iterations, arg);
+    entry.func(state);
+    return state;
+}
+
+Result run(const Entry& entry, const skr::String& name, int64_t arg, const Options& options)
+{
+    Result result;
+    result.name = name;
+
+    // grow the iteration count until one run covers min_time
+    const uint64_t min_ns     = options.min_time_ms * 1'000'000;
+    uint64_t       iterations = 1;
+    for (;;)
+    {
+        const auto state = run_once(entry, arg, iterations);
+        if (state.skipped())
+        {
+            result.skipped     = true;
+            result.skip_reason = state.skip_reason();
+            return result;
+        }
+        if (state.elapsed_ns() >= min_ns || iterations >= kMaxIterations)
+            break;
+        const double scale = state.elapsed_ns() ? (double)min_ns * 1.2 / (double)state.elapsed_ns() : 100.0;
+        iterations         = std::min(kMaxIterations, std::max(iterations + 1, (uint64_t)((double)iterations * std::min(scale, 100.0))));
+    }
+    result.iterations = iterations;
+
+    skr::Vector<double> samples;
+    double              items = 0.0, bytes = 0.0, seconds = 0.0;
+    for (uint32_t i = 0; i < std::max(options.repetitions, 1u); ++i)
+    {
+        const auto state = run_once(entry, arg, iterations);
+        samples.add((double)state.elapsed_ns() / (double)iterations);
+        items += (double)state.items();
+        bytes += (double)state.bytes();
+        seconds += (double)state.elapsed_ns() * 1e-9;
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto n  = samples.size();
+    result.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) * 0.5;
+    result.min    = samples[0];
+    for (auto s : samples)
+        result.mean += s;
+    result.mean /= (double)n;
+    for (auto s : samples)
+        result.stddev += (s - result.mean) * (s - result.mean);
+    result.stddev = n > 1 ? std::sqrt(result.stddev / (double)(n - 1)) : 0.0;
+    if (seconds > 0.0)
+    {
+        result.items_per_second = items / seconds;
+        result.bytes_per_second = bytes / seconds;
+    }
+    return result;
+}
+
+skr::String format_time(double ns)
+{
+    if (ns < 1e3)
+        return skr::format(u8"{:.2f} ns", ns);
+    if (ns < 1e6)
+        return skr::format(u8"{:.2f} us", ns * 1e-3);
+    if (ns < 1e9)
+        return skr::format(u8"{:.2f} ms", ns * 1e-6);
+    return skr::format(u8"{:.2f} s", ns * 1e-9);
+}
+
+skr::String format_rate(double per_second, const char8_t* unit)
+{
+    if (per_second <= 0.0)
+        return {};
+    if (per_second >= 1e9)
+        return skr::format(u8"{:.2f} G{}/s", per_second * 1e-9, unit);
+    if (per_second >= 1e6)
+        return skr::format(u8"{:.2f} M{}/s", per_second * 1e-6, unit);
+    if (per_second >= 1e3)
+        return skr::format(u8"{:.2f} K{}/s", per_second * 1e-3, unit);
+    return skr::format(u8"{:.2f} {}/s", per_second, unit);
+}
+
+bool json_ok(skr::archive::JsonResult&& result)
+{
+    const bool ok = result.has_value();
+    result.mark_handled();
+    return ok;
+}
+
+bool write_json(const skr::String& path, const skr::String& suite, const Options& options, const skr::Vector<Result>& results)
+{
+    skr::archive::_JsonWriter writer(3);
+    json_ok(writer.StartObject(u8""));
+    json_ok(writer.WriteString(u8"suite", suite));
+    json_ok(writer.WriteString(u8"label", options.label));
+    json_ok(writer.WriteInt64(u8"timestamp", (int64_t)std::time(nullptr)));
+#ifdef NDEBUG
+    json_ok(writer.WriteString(u8"configuration", skr::StringView(u8"release")));
+#else
+    json_ok(writer.WriteString(u8"configuration", skr::StringView(u8"debug")));
+#endif
+    json_ok(writer.WriteUInt32(u8"repetitions", options.repetitions));
+    json_ok(writer.StartArray(u8"benchmarks"));
+    for (const auto& result : results)
+    {
+        if (result.skipped)
+            continue;
+        json_ok(writer.StartObject(u8""));
+        json_ok(writer.WriteString(u8"name", result.name));
+        json_ok(writer.WriteUInt64(u8"iterations", result.iterations));
+        json_ok(writer.WriteDouble(u8"ns_median", result.median));
+        json_ok(writer.WriteDouble(u8"ns_min", result.min));
+        json_ok(writer.WriteDouble(u8"ns_mean", result.mean));
+        json_ok(writer.WriteDouble(u8"ns_stddev", result.stddev));
+        json_ok(writer.WriteDouble(u8"items_per_second", result.items_per_second));
+        json_ok(writer.WriteDouble(u8"bytes_per_second", result.bytes_per_second));
+        json_ok(writer.EndObject());
+    }
+    json_ok(writer.EndArray());
+    json_ok(writer.EndObject());
+    return skr::fs::File::write_all_text(skr::Path(path.view()), writer.Write().view());
+}
+
+bool read_baseline(const skr::String& path, skr::FlatHashMap<skr::String, double, skr::Hash<skr::String>>& out)
+{
+    skr::String text;
+    if (!skr::fs::File::read_all_text(skr::Path(path.view()), text))
+        return false;
+
+    skr::archive::_JsonReader reader(text.view());
+    if (!json_ok(reader.StartObject(u8"")))
+        return false;
+    size_t count = 0;
+    if (json_ok(reader.StartArray(u8"benchmarks", count)))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!json_ok(reader.StartObject(u8"")))
+                continue;
+            skr::String name;
+            double      median = 0.0;
+            if (json_ok(reader.ReadString(u8"name", name)) && json_ok(reader.ReadDouble(u8"ns_median", median)))
+                out.insert_or_assign(name, median);
+            json_ok(reader.EndObject());
+        }
+        json_ok(reader.EndArray());
+    }
+    json_ok(reader.EndObject());
+    return true;
+}
+
+bool parse_options(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg   = argv[i];
+        auto        value = [&]() -> const char* { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (std::strcmp(arg, "--filter") == 0)
+            options.filter = (const char8_t*)value();
+        else if (std::strcmp(arg, "--min-time") == 0)
+            options.min_time_ms = std::strtoull(value(), nullptr, 10);
+        else if (std::strcmp(arg, "--repetitions") == 0)
+            options.repetitions = (uint32_t)std::strtoul(value(), nullptr, 10);
+        else if (std::strcmp(arg, "--json") == 0)
+            options.json = (const char8_t*)value();
+        else if (std::strcmp(arg, "--baseline") == 0)
+            options.baseline = (const char8_t*)value();
+        else if (std::strcmp(arg, "--threshold") == 0)
+            options.threshold = std::strtod(value(), nullptr) / 100.0;
+        else if (std::strcmp(arg, "--label") == 0)
+            options.label = (const char8_t*)value();
+        else if (std::strcmp(arg, "--list") == 0)
+            options.list = true;
+        else
+        {
+            printf(
+            "usage: %s [options]\n"
+            "  --filter <text>       run benchmarks whose name contains text\n"
+            "  --min-time <ms>       minimum time of one repetition, default 100\n"
+            "  --repetitions <n>     repetitions per benchmark, default 5\n"
+            "  --json <path>         write results as json\n"
+            "  --label <text>        stored in the json, e.g. the commit hash\n"
+            "  --baseline <path>     compare medians with a previous json\n"
+            "  --threshold <pct>     slowdown reported as a regression, default 5\n"
+            "  --list                list benchmarks and exit\n",
+            argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+Registrar::Registrar(const char8_t* group, const char8_t* name, BenchmarkFunc func, std::initializer_list<int64_t> args) SKR_NOEXCEPT
+{
+    Entry entry;
+    entry.group = group;
+    entry.name  = name;
+    entry.func  = func;
+    for (auto arg : args)
+        entry.args.add(arg);
+    registry().add(std::move(entry));
+}
+} // namespace skr::bench
+
+int main(int argc, char** argv)
+{
+    using namespace skr::bench;
+
+    Options options;
+    if (!parse_options(argc, argv, options))
+        return 1;
+
+    // runs of every registered benchmark and arg
+    struct Run {
+        const Entry* entry;
+        int64_t      arg;
+        skr::String  name;
+    };
+    skr::Vector<Run> runs;
+    for (const auto& entry : registry())
+    {
+        const auto base_name = skr::format(u8"{}.{}", entry.group, entry.name);
+        if (entry.args.is_empty())
+        {
+            runs.add({ &entry, 0, base_name });
+            continue;
+        }
+        for (auto arg : entry.args)
+            runs.add({ &entry, arg, skr::format(u8"{}/{}", base_name, arg) });
+    }
+    if (!options.filter.is_empty())
+    {
+        runs.remove_all_if([&](const Run& run) { return !run.name.contains(options.filter); });
+    }
+    if (options.list)
+    {
+        for (const auto& run : runs)
+            printf("%s\n", run.name.c_str_raw());
+        return 0;
+    }
+
+    skr::FlatHashMap<skr::String, double, skr::Hash<skr::String>> baseline;
+    if (!options.baseline.is_empty() && !read_baseline(options.baseline, baseline))
+    {
+        printf("failed to read baseline %s\n", options.baseline.c_str_raw());
+        return 1;
+    }
+
+    printf("%-48s %14s %8s %14s %16s %16s\n", "benchmark", "median", "cv", "iterations", "items", "bytes");
+    skr::Vector<Result> results;
+    uint32_t            regressions = 0;
+    for (const auto& run : runs)
+    {
+        auto result = skr::bench::run(*run.entry, run.name, run.arg, options);
+        if (result.skipped)
+        {
+            printf("%-48s skipped: %s\n", result.name.c_str_raw(), result.skip_reason.c_str_raw());
+            results.add(std::move(result));
+            continue;
+        }
+
+        const double cv = result.mean > 0.0 ? result.stddev / result.mean * 100.0 : 0.0;
+        printf("%-48s %14s %7.1f%% %14llu %16s %16s",
+               result.name.c_str_raw(),
+               format_time(result.median).c_str_raw(),
+               cv,
+               (unsigned long long)result.iterations,
+               format_rate(result.items_per_second, u8"").c_str_raw(),
+               format_rate(result.bytes_per_second, u8"B").c_str_raw());
+        if (auto found = baseline.find(result.name); found != baseline.end() && found->second > 0.0)
+        {
+            // the best sample must be slower too, a noisy median alone isn't reported
+            const double delta   = (result.median - found->second) / found->second;
+            const bool   regress = delta > options.threshold && result.min > found->second;
+            printf("  %+.1f%%%s", delta * 100.0, regress ? " REGRESSION" : "");
+            regressions += regress ? 1 : 0;
+        }
+        printf("\n");
+        results.add(std::move(result));
+    }
+
+    if (!options.json.is_empty())
+    {
+        const auto suite = argc > 0 ? skr::Path((const char8_t*)argv[0]).basename().string() : skr::String();
+        if (!write_json(options.json, suite, options, results))
+        {
+            printf("failed to write %s\n", options.json.c_str_raw());
+            return 1;
+        }
+    }
+    if (regressions)
+    {
+        printf("%u benchmark(s) regressed by more than %.1f%%\n", regressions, options.threshold * 100.0);
+        return 2;
+    }
+    return 0;
+}
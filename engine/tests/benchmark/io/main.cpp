@@ -0,0 +1,109 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrCore/log.h"
+#include "SkrCore/platform/vfs.h"
+#include "SkrOS/filesystem.hpp"
+#include "SkrOS/thread.h"
+#include "SkrRT/io/ram_io.hpp"
+#include "SkrContainers/vector.hpp"
+
+static struct ProcInitializer {
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+        ::skr_log_initialize_async_worker();
+    }
+    ~ProcInitializer()
+    {
+        ::skr_log_finalize_async_worker();
+    }
+} init;
+
+static constexpr uint32_t kFileCount = 64;
+
+// kFileCount files of file_size bytes in a temp directory under the working directory
+struct IOFiles {
+    IOFiles(uint64_t file_size)
+    {
+        skr_vfs_desc_t desc = {};
+        desc.app_name       = u8"io-benchmark";
+        desc.mount_type     = SKR_MOUNT_TYPE_ABSOLUTE;
+        vfs                 = skr_create_vfs(&desc);
+
+        skr::fs::Directory::create(skr::Path(kDirectory), true);
+        skr::Vector<uint8_t> content;
+        content.resize_unsafe(file_size);
+        for (uint64_t i = 0; i < file_size; ++i)
+            content[i] = (uint8_t)(i * 31);
+        for (uint32_t i = 0; i < kFileCount; ++i)
+        {
+            auto path = skr::format(u8"{}/file_{}.bin", kDirectory, i);
+            skr::fs::File::write_all_bytes(skr::Path(path.view()), { content.data(), content.size() });
+            paths.add(std::move(path));
+        }
+    }
+    ~IOFiles()
+    {
+        skr::fs::Directory::remove(skr::Path(kDirectory), true);
+        skr_free_vfs(vfs);
+    }
+
+    static constexpr const char8_t* kDirectory = u8"io-benchmark-tmp";
+    skr_vfs_t*                      vfs = nullptr;
+    skr::Vector<skr::String>        paths;
+};
+
+static void read_files(skr::bench::State& state, bool use_io_uring)
+{
+    const auto file_size = (uint64_t)state.arg();
+    IOFiles    files(file_size);
+
+    skr_ram_io_service_desc_t desc = {};
+    desc.name                      = u8"IOBenchmark";
+    desc.use_dstorage              = false;
+    desc.use_io_uring              = use_io_uring;
+    auto service                   = skr::io::IRAMService::create(&desc);
+    service->run();
+
+    skr::Vector<skr_io_future_t> futures;
+    skr::Vector<skr::BlobId>     blobs;
+    futures.resize_default(kFileCount);
+    blobs.resize_default(kFileCount);
+    while (state.keep_running())
+    {
+        for (uint32_t i = 0; i < kFileCount; ++i)
+        {
+            futures[i] = {};
+            auto request = service->open_request();
+            request->set_vfs(files.vfs);
+            request->set_path(files.paths[i].c_str());
+            request->add_block({}); // read all
+            blobs[i] = service->request(request, &futures[i]);
+        }
+        for (auto& future : futures)
+        {
+            while (!future.is_ready())
+                skr_thread_sleep(0);
+        }
+
+        state.pause_timing();
+        for (auto& blob : blobs)
+            blob.reset();
+        state.resume_timing();
+    }
+    service->drain();
+    skr::io::IRAMService::destroy(service);
+    state.set_items_processed(state.iterations() * kFileCount);
+    state.set_bytes_processed(state.iterations() * kFileCount * file_size);
+}
+
+SKR_BENCHMARK_ARGS(RAMIO, ReadFiles, 64 * 1024, 1024 * 1024)
+{
+    read_files(state, false);
+}
+
+#ifdef __linux__
+SKR_BENCHMARK_ARGS(RAMIO, ReadFilesIOUring, 64 * 1024, 1024 * 1024)
+{
+    read_files(state, true);
+}
+#endif
@@ -0,0 +1,202 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrContainers/string.hpp"
+#include "SkrContainers/span.hpp"
+#include "SkrSerde/bin_serde.hpp"
+#include "SkrSerde/json_serde.hpp"
+
+using skr::bench::do_not_optimize;
+
+static skr::Vector<skr::String> make_strings(uint64_t count)
+{
+    skr::Vector<skr::String> strings;
+    strings.reserve(count);
+    for (uint64_t i = 0; i < count; ++i)
+        strings.add(skr::format(u8"/game/assets/texture_{}.png", i));
+    return strings;
+}
+
+static skr::Vector<float> make_floats(uint64_t count)
+{
+    skr::Vector<float> floats;
+    floats.reserve(count);
+    for (uint64_t i = 0; i < count; ++i)
+        floats.add((float)i * 0.25f);
+    return floats;
+}
+
+// binary
+SKR_BENCHMARK_ARGS(Bin, WriteFloats, 1 << 10, 1 << 16)
+{
+    const auto                    count  = (uint64_t)state.arg();
+    const auto                    floats = make_floats(count);
+    skr::Vector<uint8_t>          buffer;
+    skr::archive::BinVectorWriter writer_impl;
+    writer_impl.buffer = &buffer;
+    SBinaryWriter writer{ writer_impl };
+    while (state.keep_running())
+    {
+        buffer.clear();
+        skr::bin_write(&writer, floats);
+        do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * buffer.size());
+}
+
+SKR_BENCHMARK_ARGS(Bin, ReadFloats, 1 << 10, 1 << 16)
+{
+    const auto                    count = (uint64_t)state.arg();
+    skr::Vector<uint8_t>          buffer;
+    skr::archive::BinVectorWriter writer_impl;
+    writer_impl.buffer = &buffer;
+    SBinaryWriter writer{ writer_impl };
+    skr::bin_write(&writer, make_floats(count));
+
+    skr::Vector<float> floats;
+    while (state.keep_running())
+    {
+        skr::archive::BinSpanReader reader_impl;
+        reader_impl.data = skr::span<const uint8_t>(buffer.data(), buffer.size());
+        SBinaryReader reader{ reader_impl };
+        skr::bin_read(&reader, floats);
+        do_not_optimize(floats.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * buffer.size());
+}
+
+SKR_BENCHMARK_ARGS(Bin, WriteStrings, 1 << 8, 1 << 14)
+{
+    const auto                    count   = (uint64_t)state.arg();
+    const auto                    strings = make_strings(count);
+    skr::Vector<uint8_t>          buffer;
+    skr::archive::BinVectorWriter writer_impl;
+    writer_impl.buffer = &buffer;
+    SBinaryWriter writer{ writer_impl };
+    while (state.keep_running())
+    {
+        buffer.clear();
+        skr::bin_write(&writer, strings);
+        do_not_optimize(buffer.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * buffer.size());
+}
+
+SKR_BENCHMARK_ARGS(Bin, ReadStrings, 1 << 8, 1 << 14)
+{
+    const auto                    count = (uint64_t)state.arg();
+    skr::Vector<uint8_t>          buffer;
+    skr::archive::BinVectorWriter writer_impl;
+    writer_impl.buffer = &buffer;
+    SBinaryWriter writer{ writer_impl };
+    skr::bin_write(&writer, make_strings(count));
+
+    while (state.keep_running())
+    {
+        skr::Vector<skr::String>    strings;
+        skr::archive::BinSpanReader reader_impl;
+        reader_impl.data = skr::span<const uint8_t>(buffer.data(), buffer.size());
+        SBinaryReader reader{ reader_impl };
+        skr::bin_read(&reader, strings);
+        do_not_optimize(strings.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * buffer.size());
+}
+
+// json
+SKR_BENCHMARK_ARGS(Json, WriteFloats, 1 << 8, 1 << 14)
+{
+    const auto count  = (uint64_t)state.arg();
+    const auto floats = make_floats(count);
+    uint64_t   bytes  = 0;
+    while (state.keep_running())
+    {
+        skr::archive::JsonWriter writer(2);
+        writer.StartObject();
+        writer.Key(u8"floats");
+        skr::json_write(&writer, floats);
+        writer.EndObject();
+        auto json = writer.Write();
+        bytes     = json.length_buffer();
+        do_not_optimize(json.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * bytes);
+}
+
+SKR_BENCHMARK_ARGS(Json, ReadFloats, 1 << 8, 1 << 14)
+{
+    const auto  count = (uint64_t)state.arg();
+    skr::String json;
+    {
+        skr::archive::JsonWriter writer(2);
+        writer.StartObject();
+        writer.Key(u8"floats");
+        skr::json_write(&writer, make_floats(count));
+        writer.EndObject();
+        json = writer.Write();
+    }
+
+    skr::Vector<float> floats;
+    while (state.keep_running())
+    {
+        skr::archive::JsonReader reader(json.view());
+        reader.StartObject();
+        reader.Key(u8"floats");
+        skr::json_read(&reader, floats);
+        reader.EndObject();
+        do_not_optimize(floats.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * json.length_buffer());
+}
+
+SKR_BENCHMARK_ARGS(Json, WriteStrings, 1 << 8, 1 << 12)
+{
+    const auto count   = (uint64_t)state.arg();
+    const auto strings = make_strings(count);
+    uint64_t   bytes   = 0;
+    while (state.keep_running())
+    {
+        skr::archive::JsonWriter writer(2);
+        writer.StartObject();
+        writer.Key(u8"strings");
+        skr::json_write(&writer, strings);
+        writer.EndObject();
+        auto json = writer.Write();
+        bytes     = json.length_buffer();
+        do_not_optimize(json.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * bytes);
+}
+
+SKR_BENCHMARK_ARGS(Json, ReadStrings, 1 << 8, 1 << 12)
+{
+    const auto  count = (uint64_t)state.arg();
+    skr::String json;
+    {
+        skr::archive::JsonWriter writer(2);
+        writer.StartObject();
+        writer.Key(u8"strings");
+        skr::json_write(&writer, make_strings(count));
+        writer.EndObject();
+        json = writer.Write();
+    }
+
+    while (state.keep_running())
+    {
+        skr::Vector<skr::String> strings;
+        skr::archive::JsonReader reader(json.view());
+        reader.StartObject();
+        reader.Key(u8"strings");
+        skr::json_read(&reader, strings);
+        reader.EndObject();
+        do_not_optimize(strings.data());
+    }
+    state.set_items_processed(state.iterations() * count);
+    state.set_bytes_processed(state.iterations() * json.length_buffer());
+}
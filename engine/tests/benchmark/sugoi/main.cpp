@@ -0,0 +1,199 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrBase/misc/make_zeroed.hpp"
+#include "SkrCore/log.h"
+#include "SkrRT/sugoi/sugoi.h"
+#include "SkrContainers/vector.hpp"
+#include <algorithm>
+
+using skr::bench::do_not_optimize;
+
+struct Position {
+    float x, y, z;
+};
+struct Velocity {
+    float x, y, z;
+};
+using Health = int;
+
+static sugoi_type_index_t type_position;
+static sugoi_type_index_t type_velocity;
+static sugoi_type_index_t type_health;
+
+static sugoi_type_index_t register_component(const char8_t* name, skr_guid_t guid, uint32_t size, uint32_t alignment)
+{
+    sugoi_type_description_t desc = make_zeroed<sugoi_type_description_t>();
+    desc.name                     = name;
+    desc.size                     = size;
+    desc.guid                     = guid;
+    desc.alignment                = alignment;
+    return sugoiT_register_type(&desc);
+}
+
+static struct ProcInitializer {
+    ProcInitializer()
+    {
+        using namespace skr::literals;
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+        ::skr_log_initialize_async_worker();
+
+        type_position = register_component(u8"bench_position", u8"{6E1C7D0B-3E0A-4F0D-9A57-1B6F4C1D2E01}"_guid, sizeof(Position), alignof(Position));
+        type_velocity = register_component(u8"bench_velocity", u8"{6E1C7D0B-3E0A-4F0D-9A57-1B6F4C1D2E02}"_guid, sizeof(Velocity), alignof(Velocity));
+        type_health   = register_component(u8"bench_health", u8"{6E1C7D0B-3E0A-4F0D-9A57-1B6F4C1D2E03}"_guid, sizeof(Health), alignof(Health));
+    }
+    ~ProcInitializer()
+    {
+        ::sugoi_shutdown();
+        ::skr_log_finalize_async_worker();
+    }
+} init;
+
+// storage with count moving entities, released with the benchmark body
+struct MovingStorage {
+    MovingStorage(EIndex count)
+        : storage(sugoiS_create())
+    {
+        sugoi_type_index_t  types[] = { type_position, type_velocity };
+        sugoi_entity_type_t entity_type;
+        entity_type.type = { types, 2 };
+        entity_type.meta = { nullptr, 0 };
+        std::sort(types, types + 2);
+        auto callback = [&](sugoi_chunk_view_t* view) {
+            auto positions  = (Position*)sugoiV_get_owned_rw(view, type_position);
+            auto velocities = (Velocity*)sugoiV_get_owned_rw(view, type_velocity);
+            for (EIndex i = 0; i < view->count; ++i)
+            {
+                positions[i]  = { 0.f, 0.f, 0.f };
+                velocities[i] = { 1.f, 0.5f, 0.25f };
+            }
+        };
+        sugoiS_allocate_type(storage, &entity_type, count, SUGOI_LAMBDA(callback));
+    }
+    ~MovingStorage()
+    {
+        ::sugoiS_release(storage);
+    }
+    sugoi_storage_t* storage;
+};
+
+SKR_BENCHMARK_ARGS(Sugoi, IterateChunks, 1 << 12, 1 << 18)
+{
+    const auto    count = (EIndex)state.arg();
+    MovingStorage moving(count);
+    auto          query = sugoiQ_from_literal(moving.storage, u8"[inout]bench_position, [in]bench_velocity");
+    while (state.keep_running())
+    {
+        auto callback = [&](sugoi_chunk_view_t* view) {
+            auto positions  = (Position*)sugoiV_get_owned_rw(view, type_position);
+            auto velocities = (const Velocity*)sugoiV_get_owned_ro(view, type_velocity);
+            for (EIndex i = 0; i < view->count; ++i)
+            {
+                positions[i].x += velocities[i].x;
+                positions[i].y += velocities[i].y;
+                positions[i].z += velocities[i].z;
+            }
+        };
+        sugoiQ_get_views(query, SUGOI_LAMBDA(callback));
+        skr::bench::clobber_memory();
+    }
+    sugoiQ_release(query);
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Sugoi, QueryViews, 1 << 12, 1 << 18)
+{
+    // query overhead alone, views are only counted
+    const auto    count = (EIndex)state.arg();
+    MovingStorage moving(count);
+    auto          query = sugoiQ_from_literal(moving.storage, u8"[in]bench_position");
+    while (state.keep_running())
+    {
+        EIndex visited  = 0;
+        auto   callback = [&](sugoi_chunk_view_t* view) { visited += view->count; };
+        sugoiQ_get_views(query, SUGOI_LAMBDA(callback));
+        do_not_optimize(visited);
+    }
+    sugoiQ_release(query);
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Sugoi, Cast, 1 << 10, 1 << 16)
+{
+    // moves every entity to {position, velocity, health} and back
+    const auto    count = (EIndex)state.arg();
+    MovingStorage moving(count);
+    auto          without = sugoiQ_from_literal(moving.storage, u8"[in]bench_position, !bench_health");
+    auto          with    = sugoiQ_from_literal(moving.storage, u8"[in]bench_health");
+
+    sugoi_delta_type_t add = make_zeroed<sugoi_delta_type_t>();
+    add.added.type         = { &type_health, 1 };
+    sugoi_delta_type_t remove = make_zeroed<sugoi_delta_type_t>();
+    remove.removed.type       = { &type_health, 1 };
+
+    skr::Vector<sugoi_chunk_view_t> views;
+    auto                            collect = [&](sugoi_chunk_view_t* view) { views.add(*view); };
+    while (state.keep_running())
+    {
+        views.clear();
+        sugoiQ_get_views(without, SUGOI_LAMBDA(collect));
+        for (auto& view : views)
+            sugoiS_cast_view_delta(moving.storage, &view, &add, nullptr, nullptr);
+
+        views.clear();
+        sugoiQ_get_views(with, SUGOI_LAMBDA(collect));
+        for (auto& view : views)
+            sugoiS_cast_view_delta(moving.storage, &view, &remove, nullptr, nullptr);
+    }
+    sugoiQ_release(without);
+    sugoiQ_release(with);
+    state.set_items_processed(state.iterations() * count * 2);
+}
+
+SKR_BENCHMARK_ARGS(Sugoi, Instantiate, 1 << 10, 1 << 16)
+{
+    const auto    count = (EIndex)state.arg();
+    MovingStorage moving(1);
+    sugoi_entity_t prefab = SUGOI_NULL_ENTITY;
+    {
+        auto callback = [&](sugoi_chunk_view_t* view) { prefab = sugoiV_get_entities(view)[0]; };
+        sugoiS_all(moving.storage, false, false, SUGOI_LAMBDA(callback));
+    }
+
+    skr::Vector<sugoi_chunk_view_t> views;
+    skr::Vector<sugoi_entity_t>     instances;
+    auto                            collect = [&](sugoi_chunk_view_t* view) { views.add(*view); };
+    while (state.keep_running())
+    {
+        views.clear();
+        sugoiS_instantiate(moving.storage, prefab, count, SUGOI_LAMBDA(collect));
+
+        state.pause_timing();
+        instances.clear();
+        for (const auto& view : views)
+            instances.append(sugoiV_get_entities(&view), view.count);
+        sugoiS_destroy_entities(moving.storage, instances.data(), (EIndex)instances.size());
+        state.resume_timing();
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Sugoi, AllocateDestroy, 1 << 10, 1 << 16)
+{
+    const auto          count   = (EIndex)state.arg();
+    auto                storage = sugoiS_create();
+    sugoi_type_index_t  types[] = { type_position, type_velocity };
+    std::sort(types, types + 2);
+    sugoi_entity_type_t entity_type;
+    entity_type.type = { types, 2 };
+    entity_type.meta = { nullptr, 0 };
+
+    skr::Vector<sugoi_entity_t> entities;
+    auto                        collect = [&](sugoi_chunk_view_t* view) { entities.append(sugoiV_get_entities(view), view->count); };
+    while (state.keep_running())
+    {
+        entities.clear();
+        sugoiS_allocate_type(storage, &entity_type, count, SUGOI_LAMBDA(collect));
+        sugoiS_destroy_entities(storage, entities.data(), (EIndex)entities.size());
+    }
+    sugoiS_release(storage);
+    state.set_items_processed(state.iterations() * count);
+}
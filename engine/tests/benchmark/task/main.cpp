@@ -0,0 +1,150 @@
+#include "SkrBenchmark/benchmark.hpp"
+#include "SkrCore/log.h"
+#include "SkrTask/parallel_for.hpp"
+#include "SkrContainers/vector.hpp"
+#include <atomic>
+
+using skr::bench::do_not_optimize;
+
+static struct ProcInitializer {
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+        ::skr_log_initialize_async_worker();
+
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+    }
+    ~ProcInitializer()
+    {
+        scheduler.unbind();
+        ::skr_log_finalize_async_worker();
+    }
+    skr::task::scheduler_t scheduler;
+} init;
+
+// cost of scheduling and joining tiny tasks, dominated by the scheduler itself
+SKR_BENCHMARK_ARGS(Task, ScheduleEmpty, 64, 4096)
+{
+    const auto count = (uint32_t)state.arg();
+    while (state.keep_running())
+    {
+        skr::task::counter_t counter;
+        counter.add(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            skr::task::schedule([counter]() mutable {
+                counter.decrement();
+            },
+                                nullptr);
+        }
+        counter.wait(true);
+    }
+    state.set_items_processed(state.iterations() * count);
+}
+
+// wake up latency of a single task signalling the main thread
+SKR_BENCHMARK(Task, EventRoundTrip)
+{
+    skr::task::event_t event;
+    while (state.keep_running())
+    {
+        event.clear();
+        skr::task::schedule([]() {}, &event);
+        event.wait(true);
+    }
+    state.set_items_processed(state.iterations());
+}
+
+// fan out with a trivial body per element, shows the batching overhead against a serial loop
+SKR_BENCHMARK_ARGS(Task, ParallelFor, 1 << 12, 1 << 20)
+{
+    const auto            count = (uint32_t)state.arg();
+    skr::Vector<float>    values;
+    std::atomic<uint64_t> touched = 0;
+    values.resize(count, 1.0f);
+    while (state.keep_running())
+    {
+        skr::parallel_for(values.begin(), values.end(), 1024, [&](float* begin, float* end) {
+            for (auto it = begin; it != end; ++it)
+                *it = *it * 0.5f + 1.0f;
+            touched.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+    }
+    do_not_optimize(touched.load());
+    state.set_items_processed(state.iterations() * count);
+}
+
+// same loop without a batch size, ranges are split only when a worker runs dry
+SKR_BENCHMARK_ARGS(Task, ParallelForAdaptive, 1 << 12, 1 << 20)
+{
+    const auto            count = (uint32_t)state.arg();
+    skr::Vector<float>    values;
+    std::atomic<uint64_t> touched = 0;
+    values.resize(count, 1.0f);
+    while (state.keep_running())
+    {
+        skr::parallel_for_adaptive(values.begin(), values.end(), [&](float* begin, float* end) {
+            for (auto it = begin; it != end; ++it)
+                *it = *it * 0.5f + 1.0f;
+            touched.fetch_add(end - begin, std::memory_order_relaxed);
+        });
+    }
+    do_not_optimize(touched.load());
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Task, ParallelReduce, 1 << 12, 1 << 20)
+{
+    const auto         count = (uint32_t)state.arg();
+    skr::Vector<float> values;
+    values.resize(count, 1.0f);
+    double sum = 0.0;
+    while (state.keep_running())
+    {
+        sum = skr::parallel_reduce(
+        values.begin(), values.end(), 0.0,
+        [](float* begin, float* end) {
+            double partial = 0.0;
+            for (auto it = begin; it != end; ++it)
+                partial += *it;
+            return partial;
+        },
+        [](double a, double b) { return a + b; });
+    }
+    do_not_optimize(sum);
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Task, ParallelScan, 1 << 12, 1 << 20)
+{
+    const auto            count = (uint32_t)state.arg();
+    skr::Vector<uint32_t> values;
+    skr::Vector<uint32_t> prefix;
+    values.resize(count, 1u);
+    prefix.resize(count, 0u);
+    while (state.keep_running())
+    {
+        skr::parallel_scan(values.begin(), values.end(), prefix.begin(), 0u, [](uint32_t a, uint32_t b) { return a + b; });
+        skr::bench::clobber_memory();
+    }
+    do_not_optimize(prefix.data());
+    state.set_items_processed(state.iterations() * count);
+}
+
+SKR_BENCHMARK_ARGS(Task, SerialFor, 1 << 12, 1 << 20)
+{
+    const auto         count = (uint32_t)state.arg();
+    skr::Vector<float> values;
+    values.resize(count, 1.0f);
+    while (state.keep_running())
+    {
+        skr::serial_for(values.begin(), values.end(), 1024, [&](float* begin, float* end) {
+            for (auto it = begin; it != end; ++it)
+                *it = *it * 0.5f + 1.0f;
+        });
+        skr::bench::clobber_memory();
+    }
+    do_not_optimize(values.data());
+    state.set_items_processed(state.iterations() * count);
+}
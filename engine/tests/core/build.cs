@@ -20,5 +20,9 @@ public static class CoreTests
 
         Test.UnitTest("DelegateTest")
             .AddCppFiles("delegate/*.cpp");
+
+        Test.UnitTest("BinaryLogTest")
+            .Depend(Visibility.Public, "SkrCore")
+            .AddCppFiles("log/*.cpp");
     }
 }
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "SkrTestFramework/framework.hpp"
+#include "SkrCore/log/log_binary.hpp"
+#include "SkrCore/memory/sp.hpp"
+#include "SkrContainers/vector.hpp"
+#include <thread>
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+// keeps the stream in memory, the buffer outlives the sink that BinaryLog::Close() destroys
+struct MemoryBinarySink : public skr::logging::LogBinarySink {
+    MemoryBinarySink(skr::Vector<uint8_t>* stream)
+        : stream(stream)
+    {
+    }
+    void write(const uint8_t* data, uint64_t size) SKR_NOEXCEPT override
+    {
+        stream->append(data, size);
+    }
+    skr::Vector<uint8_t>* stream = nullptr;
+};
+
+// digits at the start of a message
+static uint64_t leading_number(skr::StringView text)
+{
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < text.size() && text.data()[i] >= u8'0' && text.data()[i] <= u8'9'; ++i)
+        value = value * 10 + (uint64_t)(text.data()[i] - u8'0');
+    return value;
+}
+
+struct BinaryLogTests {
+    ~BinaryLogTests()
+    {
+        skr::logging::BinaryLog::Close();
+    }
+
+    // a ring of the minimum size for threads that log for the first time
+    void open(uint32_t ring_size = 64 * 1024)
+    {
+        skr::logging::BinaryLog::Open(skr::UPtr<MemoryBinarySink>::New(&stream), ring_size);
+    }
+
+    // closes the stream and returns the decoded messages of the records, skipping dropped notices
+    skr::Vector<skr::String> decode(uint64_t* dropped = nullptr)
+    {
+        skr::logging::BinaryLog::Drain();
+        skr::logging::BinaryLog::Close();
+
+        skr::Vector<skr::String> messages;
+        const bool               valid = skr::logging::BinaryLog::Decode(stream.data(), stream.size(), [&](const skr::logging::BinaryLogEntry& entry) {
+            if (entry.file.is_empty())
+            {
+                // drop notices have no site
+                if (dropped) { *dropped += leading_number(entry.message); }
+                return;
+            }
+            EXPECT_TRUE(entry.level == skr::logging::LogLevel::kWarning);
+            messages.add(skr::String(entry.message));
+        });
+        EXPECT_TRUE(valid);
+        return messages;
+    }
+
+    skr::Vector<uint8_t> stream;
+};
+
+enum ELogBinaryPlain
+{
+    kLogBinaryPlainA = 3,
+};
+enum class ELogBinaryScoped : int16_t
+{
+    Negative = -12,
+};
+
+static skr::String text_of(uint32_t i, uint32_t length)
+{
+    skr::String text;
+    for (uint32_t c = 0; c < length; ++c)
+        text.append((char8_t)(u8'a' + (i + c) % 26));
+    return text;
+}
+
+TEST_CASE_METHOD(BinaryLogTests, "EncodesEveryArgumentType")
+{
+    open();
+    const int8_t           i8   = -8;
+    const int16_t          i16  = -1616;
+    const int32_t          i32  = -323232;
+    const int64_t          i64  = INT64_MIN;
+    const uint8_t          u8v  = 250;
+    const uint16_t         u16  = 65000;
+    const uint32_t         u32  = 4000000000u;
+    const uint64_t         u64  = UINT64_MAX;
+    const float            f32  = 1.25f;
+    const double           f64  = -2.0 / 3.0;
+    const bool             b    = true;
+    const ELogBinaryPlain  e    = kLogBinaryPlainA;
+    const ELogBinaryScoped se   = ELogBinaryScoped::Negative;
+    const char*            cstr = "ascii";
+    char                   mstr[] = "mutable";
+    const char8_t*         u8s  = u8"utf-8 é中";
+    char8_t                mu8s[] = u8"mutable utf-8";
+    const skr::StringView  view = u8"view";
+    const skr::String      str  = u8"string";
+    const char*            null_str = nullptr;
+
+    SKR_LOG_BIN_WARN(u8"ints {} {} {} {}", i8, i16, i32, i64);
+    SKR_LOG_BIN_WARN(u8"uints {} {} {} {}", u8v, u16, u32, u64);
+    SKR_LOG_BIN_WARN(u8"floats {} {} {:.3f}", f32, f64, f64);
+    SKR_LOG_BIN_WARN(u8"bool {} enums {} {}", b, e, se);
+    SKR_LOG_BIN_WARN(u8"strings {} {} {} {} {} {} [{}]", cstr, (char*)mstr, u8s, (char8_t*)mu8s, view, str, null_str);
+    SKR_LOG_BIN_WARN(u8"specs {:x} {:08} {:>6} {{escaped}} {1}", u32, i32, b, u16);
+    SKR_LOG_BIN_WARN(u8"no args");
+
+    const skr::String expected[] = {
+        skr::format(u8"ints {} {} {} {}", i8, i16, i32, i64),
+        skr::format(u8"uints {} {} {} {}", u8v, u16, u32, u64),
+        skr::format(u8"floats {} {} {:.3f}", f32, f64, f64),
+        skr::format(u8"bool {} enums {} {}", b, (int64_t)e, (int64_t)se),
+        skr::format(u8"strings {} {} {} {} {} {} [{}]", cstr, (const char*)mstr, u8s, (const char8_t*)mu8s, view, str, skr::StringView()),
+        // positional indices are consumed in order
+        skr::format(u8"specs {:x} {:08} {:>6} {{escaped}} {}", u32, i32, b, u16),
+        skr::String(u8"no args"),
+    };
+
+    const auto messages = decode();
+    REQUIRE(messages.size() == sizeof(expected) / sizeof(expected[0]));
+    for (uint64_t i = 0; i < messages.size(); ++i)
+        EXPECT_EQ(messages[i], expected[i]);
+}
+
+TEST_CASE_METHOD(BinaryLogTests, "RingWrapsAround")
+{
+    // a new thread gets a ring of the minimum size, the records below wrap it many times
+    static constexpr uint32_t kRecordCount = 4000;
+    open(1);
+
+    std::thread producer([] {
+        uint64_t pending = 0;
+        for (uint32_t i = 0; i < kRecordCount; ++i)
+        {
+            // odd lengths, so records and the padding before the wrap land at every alignment
+            const auto text = text_of(i, (i * 37) % 700);
+            SKR_LOG_BIN_WARN(u8"#{} {} {}", i, text, (double)i * 0.5);
+            // drain well before the ring is full, nothing may be dropped
+            pending += text.length_buffer() + 64;
+            if (pending > 4 * 1024)
+            {
+                skr::logging::BinaryLog::Drain();
+                pending = 0;
+            }
+        }
+    });
+    producer.join();
+
+    uint64_t   dropped  = 0;
+    const auto messages = decode(&dropped);
+    EXPECT_EQ(dropped, 0);
+    REQUIRE(messages.size() == kRecordCount);
+    uint64_t wrong = 0;
+    for (uint32_t i = 0; i < kRecordCount; ++i)
+        wrong += (messages[i] == skr::format(u8"#{} {} {}", i, text_of(i, (i * 37) % 700), (double)i * 0.5)) ? 0 : 1;
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST_CASE_METHOD(BinaryLogTests, "FullRingCountsDrops")
+{
+    // no explicit drains, records either reach the stream or are reported as dropped
+    static constexpr uint32_t kRecordCount = 2000;
+    open(1);
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < kRecordCount; ++i)
+            SKR_LOG_BIN_WARN(u8"#{} {}", i, text_of(i, 500));
+    });
+    producer.join();
+
+    uint64_t   dropped  = 0;
+    const auto messages = decode(&dropped);
+    EXPECT_EQ(messages.size() + dropped, kRecordCount);
+    // records that made it are whole and in order
+    uint64_t wrong = 0;
+    int64_t  last  = -1;
+    for (const auto& message : messages)
+    {
+        const auto i = (uint32_t)leading_number(message.view().subview(1));
+        wrong += ((int64_t)i > last && message == skr::format(u8"#{} {}", i, text_of(i, 500))) ? 0 : 1;
+        last = i;
+    }
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST_CASE_METHOD(BinaryLogTests, "OversizedRecordsBypassTheRing")
+{
+    // too large for a record, it goes to the text sinks and the stream goes on without it
+    open();
+    const auto huge = text_of(0, skr::logging::BinaryLog::kMaxArgsSize + 1);
+    const auto fits = text_of(1, skr::logging::BinaryLog::kMaxArgsSize - 16);
+    SKR_LOG_BIN_WARN(u8"before");
+    SKR_LOG_BIN_WARN(u8"huge {}", huge);
+    SKR_LOG_BIN_WARN(u8"fits {}", fits);
+    SKR_LOG_BIN_WARN(u8"after {}", 42);
+
+    uint64_t   dropped  = 0;
+    const auto messages = decode(&dropped);
+    EXPECT_EQ(dropped, 0);
+    REQUIRE(messages.size() == 3);
+    EXPECT_EQ(messages[0], skr::String(u8"before"));
+    EXPECT_EQ(messages[1], skr::format(u8"fits {}", fits));
+    EXPECT_EQ(messages[2], skr::String(u8"after 42"));
+}
@@ -22,6 +22,10 @@ public static class RuntimeTests
             .Depend(Visibility.Public, "SkrRT")
             .AddCppFiles("io_service/*.cpp");
 
+        Test.UnitTest("ResourceTest")
+            .Depend(Visibility.Public, "SkrRT")
+            .AddCppFiles("resource/*.cpp");
+
         Test.UnitTest("SceneTest")
             .Depend(Visibility.Public, "SkrScene")
             .AddCppFiles("scene/*.cpp");
@@ -30,6 +34,10 @@ public static class RuntimeTests
             .Depend(Visibility.Public, "SkrRT")
             .AddCppFiles("ecs/c_style/*.cpp");
 
+        Test.UnitTest("ECSStackAllocatorTest")
+            .Depend(Visibility.Public, "SkrRT")
+            .AddCppFiles("ecs/stack_allocator/*.cpp");
+
         Engine.Program("ECSTest_CPPStyle")
             .EnableCodegen("ecs/cpp_style")
             .AddMetaHeaders("ecs/cpp_style/**.hpp")
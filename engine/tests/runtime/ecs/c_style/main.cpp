@@ -4,6 +4,8 @@
 #include "SkrTask/parallel_for.hpp"
 #include "SkrRT/sugoi/sugoi.h"
 #include "SkrRT/sugoi/array.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrSerde/bin_serde.hpp"
 #include "SkrTestFramework/framework.hpp"
 #include <memory>
 #include <algorithm>
@@ -496,6 +498,134 @@ TEST_CASE_METHOD(ECSTest, "query_overload")
     }
 }
 
+TEST_CASE_METHOD(ECSTest, "image_roundtrip")
+{
+    using TestArray = sugoi::ArrayComponent<TestComp, 10>;
+    skr::Vector<sugoi_entity_t> ents;
+    {
+        sugoi_entity_type_t entityType;
+        sugoi_type_index_t type[2] = { type_test, type_test_arr };
+        std::sort(type, type + 2);
+        entityType.type = { type, 2 };
+        entityType.meta = { nullptr, 0 };
+        auto callback = [&](sugoi_chunk_view_t* view) {
+            auto values = (TestComp*)sugoiV_get_owned_rw(view, type_test);
+            auto arrays = (TestArray*)sugoiV_get_owned_rw(view, type_test_arr);
+            for (EIndex i = 0; i < view->count; ++i)
+            {
+                const auto e = sugoiV_get_entities(view)[i];
+                values[i] = (TestComp)e;
+                // some arrays spill out of the inline storage
+                for (uint32_t j = 0; j < e % 20; ++j)
+                    arrays[i].emplace_back((TestComp)j);
+                ents.add(e);
+            }
+        };
+        sugoiS_allocate_type(storage, &entityType, 5000, SUGOI_LAMBDA(callback));
+    }
+
+    skr::Vector<uint8_t> image;
+    skr::archive::BinVectorWriter writer{ &image };
+    SBinaryWriter w(writer);
+    sugoiS_serialize_image(storage, &w);
+
+    auto loaded = sugoiS_create();
+    SKR_DEFER({ sugoiS_release(loaded); });
+    REQUIRE(sugoiS_deserialize_image(loaded, image.data(), image.size()));
+    REQUIRE(sugoiS_exist(loaded, e1));
+    for (auto e : ents)
+    {
+        sugoi_chunk_view_t view;
+        sugoiS_access(loaded, e, &view);
+        REQUIRE(view.chunk != nullptr);
+        EXPECT_EQ(*(const TestComp*)sugoiV_get_owned_ro(&view, type_test), (TestComp)e);
+        auto& array = *(const TestArray*)sugoiV_get_owned_ro(&view, type_test_arr);
+        EXPECT_EQ(array.size(), e % 20);
+        for (uint32_t j = 0; j < array.size(); ++j)
+            EXPECT_EQ(array[j], (TestComp)j);
+    }
+}
+
+TEST_CASE_METHOD(ECSTest, "image_rejects_invalid_page_size")
+{
+    skr::Vector<uint8_t> image;
+    skr::archive::BinVectorWriter writer{ &image };
+    SBinaryWriter w(writer);
+    sugoiS_serialize_image(storage, &w);
+
+    // header: magic, version, page size, group count
+    for (uint32_t pageSize : { 0u, 3000u })
+    {
+        auto corrupted = image;
+        memcpy(corrupted.data() + 2 * sizeof(uint32_t), &pageSize, sizeof(pageSize));
+        auto loaded = sugoiS_create();
+        SKR_DEFER({ sugoiS_release(loaded); });
+        EXPECT_FALSE(sugoiS_deserialize_image(loaded, corrupted.data(), corrupted.size()));
+    }
+}
+
+TEST_CASE_METHOD(ECSTest, "defragment_incremental")
+{
+    skr::Vector<sugoi_entity_t> ents;
+    {
+        sugoi_entity_type_t entityType;
+        entityType.type = { &type_test, 1 };
+        entityType.meta = { nullptr, 0 };
+        auto callback = [&](sugoi_chunk_view_t* view) {
+            auto values = (TestComp*)sugoiV_get_owned_rw(view, type_test);
+            for (EIndex i = 0; i < view->count; ++i)
+            {
+                const auto e = sugoiV_get_entities(view)[i];
+                values[i] = (TestComp)e;
+                ents.add(e);
+            }
+        };
+        sugoiS_allocate_type(storage, &entityType, 100000, SUGOI_LAMBDA(callback));
+    }
+    // leave every chunk a quarter full
+    skr::Vector<sugoi_entity_t> alive, dead;
+    for (uint32_t i = 0; i < ents.size(); ++i)
+        (i % 4 == 0 ? alive : dead).add(ents[i]);
+    sugoiS_destroy_entities(storage, dead.data(), (EIndex)dead.size());
+
+    sugoi_group_occupancy_t before = {};
+    auto getOccupancy = [&](sugoi_group_occupancy_t& result) {
+        auto callback = [&](const sugoi_group_occupancy_t* occupancy) {
+            if (occupancy->chunk_count > result.chunk_count)
+                result = *occupancy;
+        };
+        result = {};
+        sugoiS_get_occupancy(storage, SUGOI_LAMBDA(callback));
+    };
+    getOccupancy(before);
+    EXPECT_EQ(before.entity_count, (EIndex)alive.size() + 1);
+    REQUIRE(before.chunk_count > 1);
+
+    sugoi_defragment_budget_t budget = {};
+    budget.max_rows = 1000;
+    budget.occupancy_threshold = 0.9f;
+    EIndex moved = 0;
+    do
+    {
+        moved = sugoiS_defragment_incremental(storage, &budget);
+        REQUIRE(moved <= budget.max_rows);
+    } while (moved != 0);
+
+    sugoi_group_occupancy_t after = {};
+    getOccupancy(after);
+    EXPECT_EQ(after.entity_count, before.entity_count);
+    REQUIRE(after.chunk_count < before.chunk_count);
+    REQUIRE((float)after.entity_count / (float)after.capacity >= 0.5f);
+    for (auto e : alive)
+    {
+        sugoi_chunk_view_t view;
+        sugoiS_access(storage, e, &view);
+        REQUIRE(view.chunk != nullptr);
+        EXPECT_EQ(sugoiV_get_entities(&view)[0], e);
+        EXPECT_EQ(*(const TestComp*)sugoiV_get_owned_ro(&view, type_test), (TestComp)e);
+    }
+}
+
 void register_test_component()
 {
     using namespace skr::literals;
@@ -1,6 +1,7 @@
 #include "cpp_style.hpp"
 #include "SkrTask/parallel_for.hpp"
 #include "SkrRT/ecs/world.hpp"
+#include "SkrRT/ecs/command_buffer.hpp"
 #include "SkrRT/ecs/query.hpp"
 #include "SkrRT/sugoi/storage.hpp"
 
@@ -226,3 +227,114 @@ TEST_CASE_METHOD(AllocateEntites, "ParallelQueryCreate")
 
     scheduler.unbind();
 }
+
+TEST_CASE_METHOD(AllocateEntites, "ParallelEntityIds")
+{
+    SkrZoneScopedN("AllocateEntites::ParallelEntityIds");
+
+    skr::task::scheduler_t scheduler;
+    scheduler.initialize(skr::task::scheudler_config_t());
+    scheduler.bind();
+
+    static constexpr uint32_t kBatchCount = 64;
+    static constexpr uint32_t kBatchSize = 1024;
+    auto registry = std::make_unique<sugoi::EntityRegistry>();
+    skr::Vector<sugoi_entity_t> ents;
+    ents.add_zeroed(kBatchCount * kBatchSize);
+    auto allocate = [&]() {
+        skr::parallel_for(ents.data(), ents.data() + ents.size(), kBatchSize, [&](auto pbegin, auto pend) {
+            registry->new_entities_concurrent(pbegin, (EIndex)(pend - pbegin));
+        });
+    };
+
+    allocate();
+    EXPECT_EQ(registry->size(), kBatchCount * kBatchSize);
+    skr::Vector<bool> seen;
+    seen.add_zeroed(registry->size());
+    for (auto e : ents)
+    {
+        EXPECT_FALSE(seen[sugoi::e_id(e)]);
+        seen[sugoi::e_id(e)] = true;
+        EXPECT_TRUE(registry->try_get_entry(e).has_value());
+    }
+
+    // freed ids are recycled instead of growing the table
+    skr::parallel_for(ents.data(), ents.data() + ents.size(), kBatchSize, [&](auto pbegin, auto pend) {
+        registry->free_entities_concurrent(pbegin, (EIndex)(pend - pbegin));
+    });
+    allocate();
+    // only ids parked in other threads' caches may be skipped
+    const auto kCacheSlack = sugoi::EntityRegistry::kFreeCacheCount * sugoi::EntityRegistry::kFreeCacheBatch;
+    REQUIRE(registry->size() <= kBatchCount * kBatchSize + kCacheSlack);
+    seen.clear();
+    seen.add_zeroed(registry->size());
+    for (auto e : ents)
+    {
+        EXPECT_FALSE(seen[sugoi::e_id(e)]);
+        seen[sugoi::e_id(e)] = true;
+    }
+
+    scheduler.unbind();
+}
+
+TEST_CASE_METHOD(AllocateEntites, "CommandBuffer")
+{
+    SkrZoneScopedN("AllocateEntites::CommandBuffer");
+
+    skr::task::scheduler_t scheduler;
+    scheduler.initialize(skr::task::scheudler_config_t());
+    scheduler.bind();
+
+    static constexpr uint32_t kCount = 4096;
+    skr::Vector<skr::ecs::Entity> ents;
+    ents.add_default(kCount);
+    skr::ecs::EntityCommandBuffer ecb(world);
+    skr::parallel_for(ents.data(), ents.data() + ents.size(), 256, [&](auto pbegin, auto pend) {
+        for (auto it = pbegin; it != pend; ++it)
+        {
+            *it = ecb.create_entity<IntComponent>();
+            ecb.set_component(*it, IntComponent{ (int)(it - ents.data()) });
+        }
+    });
+    ecb.playback();
+    EXPECT_TRUE(ecb.empty());
+
+    auto ints = skr::ecs::QueryBuilder(&world).ReadAll<IntComponent>().commit().value();
+    auto both = skr::ecs::QueryBuilder(&world).ReadAll<IntComponent, FloatComponent>().commit().value();
+    SKR_DEFER({ sugoiQ_release(ints); sugoiQ_release(both); });
+    EXPECT_EQ(sugoiQ_get_count(ints), kCount);
+    for (uint32_t i = 0; i < kCount; i++)
+    {
+        sugoi_chunk_view_t view;
+        sugoiS_access(storage, (sugoi_entity_t)ents[i], &view);
+        EXPECT_EQ(sugoi::get_owned<const IntComponent>(&view)[0].v, (int)i);
+    }
+
+    // even entities gain a component, odd ones are destroyed
+    skr::parallel_for(ents.data(), ents.data() + ents.size(), 256, [&](auto pbegin, auto pend) {
+        for (auto it = pbegin; it != pend; ++it)
+        {
+            const auto i = it - ents.data();
+            if (i % 2 == 0)
+            {
+                ecb.add_component<FloatComponent>(*it);
+                ecb.set_component(*it, FloatComponent{ i * 2.f });
+            }
+            else
+                ecb.destroy_entity(*it);
+        }
+    });
+    ecb.playback();
+    EXPECT_EQ(sugoiQ_get_count(ints), kCount / 2);
+    EXPECT_EQ(sugoiQ_get_count(both), kCount / 2);
+    for (uint32_t i = 0; i < kCount; i += 2)
+    {
+        sugoi_chunk_view_t view;
+        sugoiS_access(storage, (sugoi_entity_t)ents[i], &view);
+        EXPECT_EQ(sugoi::get_owned<const IntComponent>(&view)[0].v, (int)i);
+        EXPECT_EQ(sugoi::get_owned<const FloatComponent>(&view)[0].v, i * 2.f);
+    }
+    EXPECT_FALSE(sugoiS_alive(storage, (sugoi_entity_t)ents[1]));
+
+    scheduler.unbind();
+}
@@ -329,4 +329,229 @@ TEST_CASE_METHOD(ECSJobs, "RandomAccess")
     world.destroy_query(q1);
     world.destroy_query(q2);
     world.destroy_query(q3);
-}
\ No newline at end of file
+}
+
+TEST_CASE_METHOD(ECSJobs, "ChangedFilter")
+{
+    static std::atomic_uint64_t visited = 0;
+    static std::atomic<skr::ecs::Entity> some_entity;
+
+    struct ReadChangedInts
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.read(&ReadChangedInts::ints)
+                .changed<IntComponent>()
+                .clip_to_dirty_rows();
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("ReadChangedInts");
+            visited += Context.size();
+            some_entity = Context.entities()[0];
+        }
+        skr::ecs::ComponentView<const IntComponent> ints;
+    } readChanged;
+
+    // first run sees every chunk
+    auto q0 = world.dispatch_task(readChanged, 0, nullptr);
+    skr::ecs::TaskScheduler::Get()->flush_all();
+    skr::ecs::TaskScheduler::Get()->sync_all();
+    EXPECT_EQ(visited, TEST_ENTITY_COUNT);
+
+    // nothing written since last run
+    visited = 0;
+    world.dispatch_task(readChanged, 0, q0);
+    skr::ecs::TaskScheduler::Get()->flush_all();
+    skr::ecs::TaskScheduler::Get()->sync_all();
+    EXPECT_EQ(visited, 0);
+
+    // write a single row
+    struct WriteOne
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.write(&WriteOne::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("WriteOne");
+            ints[0].v = ints[0].v + 1;
+        }
+        skr::ecs::ComponentView<IntComponent> ints;
+    } writeOne;
+    skr::ecs::Entity to_write = some_entity;
+    world.dispatch_task(writeOne, 0, skr::span<skr::ecs::Entity>(&to_write, 1));
+    skr::ecs::TaskScheduler::Get()->flush_all();
+    skr::ecs::TaskScheduler::Get()->sync_all();
+
+    visited = 0;
+    world.dispatch_task(readChanged, 0, q0);
+    skr::ecs::TaskScheduler::Get()->flush_all();
+    skr::ecs::TaskScheduler::Get()->sync_all();
+    EXPECT_EQ(visited, 1);
+    EXPECT_EQ(some_entity.load(), to_write);
+
+    world.destroy_query(q0);
+}
+TEST_CASE_METHOD(ECSJobs, "ReplayTaskGraph")
+{
+    static std::atomic_int expected = 0;
+
+    struct IncreaseInts
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.write(&IncreaseInts::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("IncreaseInts");
+            for (auto i = 0; i < Context.size(); i++)
+                ints[i].v = ints[i].v + 1;
+        }
+        skr::ecs::ComponentView<IntComponent> ints;
+    } increase;
+
+    struct CheckInts
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.read(&CheckInts::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("CheckInts");
+            for (auto i = 0; i < Context.size(); i++)
+                EXPECT_EQ(ints[i].v, expected.load());
+        }
+        skr::ecs::ComponentView<const IntComponent> ints;
+    } check;
+
+    auto scheduler = skr::ecs::TaskScheduler::Get();
+    scheduler->set_task_graph_replay(true);
+
+    // the first frame records, the others replay while the same tasks are dispatched
+    sugoi_query_t* q0 = nullptr;
+    sugoi_query_t* q1 = nullptr;
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        expected = frame + 1;
+        q0 = world.dispatch_task(increase, 1'280, q0);
+        q1 = world.dispatch_task(check, 1'280, q1);
+        scheduler->flush_all();
+        scheduler->sync_all();
+    }
+
+    const auto& stats = scheduler->get_task_graph_replay_stats();
+    EXPECT_EQ(stats.recorded_tasks, 2);
+    EXPECT_EQ(stats.replayed_tasks, 4);
+    EXPECT_EQ(stats.replayed_groups, 4);
+
+    scheduler->set_task_graph_replay(false);
+    world.destroy_query(q0);
+    world.destroy_query(q1);
+}
+
+TEST_CASE_METHOD(ECSJobs, "DefragmentBetweenJobs")
+{
+    static std::atomic_uint64_t visited = 0;
+    static std::atomic_uint64_t mismatches = 0;
+    static std::atomic_int expected = 0;
+
+    struct CollectEntities
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.read(&CollectEntities::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("CollectEntities");
+            SMutexLock lock(mutex->mMutex);
+            for (auto i = 0; i < Context.size(); i++)
+                entities->add(Context.entities()[i]);
+        }
+        skr::ecs::ComponentView<const IntComponent> ints;
+        skr::Vector<skr::ecs::Entity>* entities;
+        SMutexObject* mutex;
+    } collect;
+    skr::Vector<skr::ecs::Entity> entities;
+    SMutexObject mutex;
+    collect.entities = &entities;
+    collect.mutex = &mutex;
+
+    struct IncreaseInts
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.write(&IncreaseInts::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("IncreaseInts");
+            for (auto i = 0; i < Context.size(); i++)
+                ints[i].v = ints[i].v + 1;
+        }
+        skr::ecs::ComponentView<IntComponent> ints;
+    } increase;
+
+    struct CheckInts
+    {
+        void build(skr::ecs::AccessBuilder& Builder)
+        {
+            Builder.read(&CheckInts::ints);
+        }
+        void run(skr::ecs::TaskContext& Context)
+        {
+            SkrZoneScopedN("CheckInts");
+            visited += Context.size();
+            for (auto i = 0; i < Context.size(); i++)
+                if (ints[i].v != expected.load())
+                    mismatches += 1;
+        }
+        skr::ecs::ComponentView<const IntComponent> ints;
+    } check;
+
+    auto scheduler = skr::ecs::TaskScheduler::Get();
+    auto q0 = world.dispatch_task(collect, 0, nullptr);
+    scheduler->flush_all();
+    scheduler->sync_all();
+    EXPECT_EQ(entities.size(), TEST_ENTITY_COUNT);
+
+    // leave every chunk half empty
+    skr::Vector<skr::ecs::Entity> to_destroy;
+    for (uint64_t i = 0; i < entities.size(); i += 2)
+        to_destroy.add(entities[i]);
+    world.destroy_entities({ to_destroy.data(), to_destroy.size() });
+    const uint64_t alive = entities.size() - to_destroy.size();
+
+    // one frame: a job, defragment at the sync point, then a job over the moved rows
+    auto q1 = world.dispatch_task(increase, 1'280, nullptr);
+    scheduler->flush_all();
+    scheduler->sync_all();
+
+    const auto moved = sugoiS_defragment_incremental(world.get_storage(), nullptr);
+    EXPECT_NE(moved, 0);
+
+    world.dispatch_task(increase, 1'280, q1);
+    expected = 2;
+    auto q2 = world.dispatch_task(check, 1'280, nullptr);
+    scheduler->flush_all();
+    scheduler->sync_all();
+    EXPECT_EQ(visited, alive);
+    EXPECT_EQ(mismatches, 0);
+
+    // every surviving entity still resolves to its moved row
+    skr::Vector<skr::ecs::Entity> survivors;
+    for (uint64_t i = 1; i < entities.size(); i += 2)
+        survivors.add(entities[i]);
+    std::atomic_uint64_t resolved = 0;
+    auto count = [&](sugoi_chunk_view_t* view) { resolved += view->count; };
+    sugoiS_batch(world.get_storage(), (sugoi_entity_t*)survivors.data(), (EIndex)survivors.size(), SUGOI_LAMBDA(count));
+    EXPECT_EQ(resolved, alive);
+
+    world.destroy_query(q0);
+    world.destroy_query(q1);
+    world.destroy_query(q2);
+}
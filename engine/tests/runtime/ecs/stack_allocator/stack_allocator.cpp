@@ -0,0 +1,177 @@
+#include "SkrTestFramework/framework.hpp"
+#include "SkrRT/ecs/stack_allocator.hpp"
+#include "SkrContainers/vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+using skr::ecs::StackAllocator;
+
+// keeps threads alive until all of them allocated, so each of them holds its own arena
+static void arrive_and_wait(std::atomic<uint32_t>& arrived, uint32_t count)
+{
+    arrived.fetch_add(1, std::memory_order_acq_rel);
+    while (arrived.load(std::memory_order_acquire) < count)
+        std::this_thread::yield();
+}
+
+struct Block
+{
+    uint8_t* ptr = nullptr;
+    size_t size = 0;
+    uint8_t tag = 0;
+};
+
+// the allocator is a process wide singleton, every test starts with a fresh instance
+struct StackAllocatorTests
+{
+    StackAllocatorTests()
+    {
+        StackAllocator::Initialize();
+    }
+    ~StackAllocatorTests()
+    {
+        StackAllocator::Finalize();
+    }
+};
+
+TEST_CASE_METHOD(StackAllocatorTests, "ThreadsAllocateDisjointBlocks")
+{
+    static constexpr uint32_t kThreads = 8;
+    static constexpr uint32_t kBlocks = 1000;
+    skr::Vector<Block> blocks[kThreads];
+    std::atomic<uint32_t> arrived = 0;
+    skr::Vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t)
+    {
+        threads.add(std::thread([&, t] {
+            // sizes up to 1KB, more than one chunk per arena
+            for (uint32_t i = 0; i < kBlocks; ++i)
+            {
+                Block block;
+                block.size = 16 * (1 + (i * 7 + t) % 64);
+                block.ptr = StackAllocator::alloc<uint8_t>(block.size);
+                block.tag = (uint8_t)(t * 31 + i);
+                memset(block.ptr, block.tag, block.size);
+                blocks[t].add(block);
+            }
+            arrive_and_wait(arrived, kThreads);
+        }));
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    skr::Vector<Block> all;
+    size_t total_size = 0;
+    uint32_t corrupted = 0, misaligned = 0;
+    for (uint32_t t = 0; t < kThreads; ++t)
+    {
+        for (const auto& block : blocks[t])
+        {
+            misaligned += (reinterpret_cast<uintptr_t>(block.ptr) % 16) ? 1 : 0;
+            for (size_t j = 0; j < block.size; ++j)
+                corrupted += (block.ptr[j] != block.tag) ? 1 : 0;
+            total_size += block.size;
+            all.add(block);
+        }
+    }
+    EXPECT_EQ(misaligned, 0);
+    EXPECT_EQ(corrupted, 0);
+    std::sort(all.begin(), all.end(), [](const Block& a, const Block& b) { return a.ptr < b.ptr; });
+    uint32_t overlapping = 0;
+    for (uint64_t i = 1; i < all.size(); ++i)
+        overlapping += (all[i - 1].ptr + all[i - 1].size > all[i].ptr) ? 1 : 0;
+    EXPECT_EQ(overlapping, 0);
+
+    // the arenas of exited threads still count for the current frame
+    const auto stats = StackAllocator::GetStats();
+    EXPECT_EQ(stats.arena_count, kThreads);
+    EXPECT_EQ(stats.thread_count, kThreads);
+    EXPECT_EQ(stats.allocation_count, kThreads * kBlocks);
+    EXPECT_TRUE(stats.used_bytes >= total_size);
+    EXPECT_TRUE(stats.reserved_bytes >= stats.used_bytes);
+}
+
+TEST_CASE_METHOD(StackAllocatorTests, "ResetRewindsEveryArena")
+{
+    static constexpr uint32_t kThreads = 4;
+    auto first_blocks_of_threads = [] {
+        skr::Vector<uint8_t*> firsts;
+        firsts.resize_default(kThreads);
+        std::atomic<uint32_t> arrived = 0;
+        skr::Vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreads; ++t)
+        {
+            threads.add(std::thread([&, t] {
+                firsts[t] = StackAllocator::alloc<uint8_t>(64);
+                StackAllocator::alloc<uint8_t>(1024);
+                arrive_and_wait(arrived, kThreads);
+            }));
+        }
+        for (auto& thread : threads)
+            thread.join();
+        std::sort(firsts.begin(), firsts.end());
+        return firsts;
+    };
+
+    const auto frame0 = first_blocks_of_threads();
+    const auto frame0_stats = StackAllocator::GetStats();
+    EXPECT_EQ(frame0_stats.allocation_count, kThreads * 2);
+    EXPECT_EQ(frame0_stats.used_bytes, kThreads * (64 + 1024));
+
+    StackAllocator::Reset();
+    const auto last_frame = StackAllocator::GetLastFrameStats();
+    EXPECT_EQ(last_frame.epoch, frame0_stats.epoch);
+    EXPECT_EQ(last_frame.thread_count, kThreads);
+    EXPECT_EQ(last_frame.allocation_count, frame0_stats.allocation_count);
+    EXPECT_EQ(last_frame.used_bytes, frame0_stats.used_bytes);
+
+    // nothing allocated in the new frame yet, the chunks are kept
+    const auto reset_stats = StackAllocator::GetStats();
+    EXPECT_EQ(reset_stats.epoch, frame0_stats.epoch + 1);
+    EXPECT_EQ(reset_stats.thread_count, 0);
+    EXPECT_EQ(reset_stats.allocation_count, 0);
+    EXPECT_EQ(reset_stats.used_bytes, 0);
+    EXPECT_EQ(reset_stats.arena_count, kThreads);
+    EXPECT_EQ(reset_stats.reserved_bytes, frame0_stats.reserved_bytes);
+
+    // new threads take over the arenas, each rewinds to the start of its first chunk
+    const auto frame1 = first_blocks_of_threads();
+    EXPECT_TRUE(frame1 == frame0);
+    const auto frame1_stats = StackAllocator::GetStats();
+    EXPECT_EQ(frame1_stats.arena_count, kThreads);
+    EXPECT_EQ(frame1_stats.allocation_count, kThreads * 2);
+    EXPECT_EQ(frame1_stats.used_bytes, frame0_stats.used_bytes);
+    EXPECT_EQ(frame1_stats.reserved_bytes, frame0_stats.reserved_bytes);
+}
+
+TEST_CASE_METHOD(StackAllocatorTests, "ExitedThreadArenaIsReused")
+{
+    uint8_t* first = nullptr;
+    uint8_t* second = nullptr;
+    std::thread([&] { first = StackAllocator::alloc<uint8_t>(256); }).join();
+    std::thread([&] { second = StackAllocator::alloc<uint8_t>(256); }).join();
+
+    // same frame, the second thread continues behind the first one's block
+    EXPECT_TRUE(second >= first + 256);
+    const auto stats = StackAllocator::GetStats();
+    EXPECT_EQ(stats.arena_count, 1);
+    EXPECT_EQ(stats.thread_count, 1);
+    EXPECT_EQ(stats.allocation_count, 2);
+    EXPECT_EQ(stats.used_bytes, 512);
+
+    StackAllocator::Reset();
+    uint8_t* third = nullptr;
+    std::thread([&] { third = StackAllocator::alloc<uint8_t>(256); }).join();
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(StackAllocator::GetStats().arena_count, 1);
+}
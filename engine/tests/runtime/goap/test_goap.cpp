@@ -631,4 +631,71 @@ TEST_CASE_METHOD(GoapTests, "AssetCook")
         }
     }
 
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(GoapTests, "BatchPlan")
+{
+    using DynamicWorldState = skr::goap::DynamicWorldState<int, bool>;
+    using Action            = skr::goap::Action<DynamicWorldState>;
+    using Planner           = skr::goap::Planner<DynamicWorldState>;
+
+    static const int has_axe  = 1;
+    static const int has_wood = 2;
+    static const int is_warm  = 3;
+
+    // clang-format off
+    skr::Vector<Action> actions;
+    actions.emplace(u8"pickAxe", 2).ref()
+        .none_or_equal(has_axe, false)
+        .add_effect(has_axe, true);
+
+    actions.emplace(u8"chopWood", 1).ref()
+        .exist_and_equal(has_axe, true)
+        .add_effect(has_wood, true);
+
+    actions.emplace(u8"gatherBranches", 5).ref()
+        .add_effect(has_wood, true);
+
+    actions.emplace(u8"lightFire", 1).ref()
+        .exist_and_equal(has_wood, true)
+        .add_effect(is_warm, true);
+    // clang-format on
+
+    skr::task::scheduler_t scheduler;
+    scheduler.initialize(skr::task::scheudler_config_t());
+    scheduler.bind();
+    {
+        auto goal = DynamicWorldState().set(is_warm, true);
+        skr::Vector<DynamicWorldState> starts;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            starts.add(DynamicWorldState().set(has_axe, (i % 2) == 0));
+        }
+
+        skr::Vector<Planner::BatchRequest> requests;
+        for (const auto& start : starts)
+        {
+            requests.add({ &start, &goal, &actions });
+        }
+        skr::Vector<Planner::PlanType<false>> plans;
+        plans.resize_default(requests.size());
+
+        Planner planner;
+        // run twice to plan with reused workers
+        for (uint32_t round = 0; round < 2; ++round)
+        {
+            planner.plan_batch<false>({ requests.data(), requests.size() }, { plans.data(), plans.size() }, 8);
+            for (uint32_t i = 0; i < requests.size(); ++i)
+            {
+                Planner serial_planner;
+                auto    expected = serial_planner.plan(starts[i], goal, actions);
+                EXPECT_EQ(plans[i].size(), expected.size());
+                EXPECT_EQ(plans[i].size(), (i % 2) == 0 ? 2 : 3);
+                for (uint32_t j = 0; j < expected.size() && j < plans[i].size(); ++j)
+                {
+                    EXPECT_EQ(skr::StringView(plans[i][j].name()), skr::StringView(expected[j].name()));
+                }
+            }
+        }
+    }
+    scheduler.unbind();
+}
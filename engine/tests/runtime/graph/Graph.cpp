@@ -88,4 +88,116 @@ TEST_CASE_METHOD(GraphTest, "RenderGraphFrontEnd")
     },
     render_graph::RenderPassExecuteFunction());
     render_graph::RenderGraph::destroy(graph);
-}
\ No newline at end of file
+}
+TEST_CASE_METHOD(GraphTest, "RenderGraphStructuralHash")
+{
+    namespace render_graph = skr::render_graph;
+    const auto build = [](ECGPUFormat format, bool read_history) {
+        auto graph = render_graph::RenderGraph::create(
+        [](render_graph::RenderGraphBuilder& builder) {
+            builder.frontend_only();
+        });
+        auto gbuffer = graph->create_texture(
+        [=](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"gbuffer")
+            .extent(64, 64)
+            .allow_render_target()
+            .format(format);
+        });
+        auto lighting = graph->create_texture(
+        [=](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"lighting")
+            .extent(64, 64)
+            .allow_render_target()
+            .format(CGPU_FORMAT_R16G16B16A16_SFLOAT);
+        });
+        auto history = graph->create_texture(
+        [=](render_graph::RenderGraph&, render_graph::TextureBuilder& builder) {
+            builder.set_name(u8"history")
+            .extent(64, 64)
+            .format(CGPU_FORMAT_R16G16B16A16_SFLOAT);
+        });
+        graph->add_render_pass(
+        [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+            builder.set_name(u8"gbuffer_pass")
+            .write(0, gbuffer);
+        },
+        render_graph::RenderPassExecuteFunction());
+        graph->add_render_pass(
+        [=](render_graph::RenderGraph&, render_graph::RenderPassBuilder& builder) {
+            builder.set_name(u8"defer_lighting")
+            .read(u8"GBuffer", gbuffer)
+            .write(0, lighting);
+            if (read_history)
+                builder.read(u8"History", history);
+        },
+        render_graph::RenderPassExecuteFunction());
+        const auto hash = graph->get_structural_hash();
+        render_graph::RenderGraph::destroy(graph);
+        return hash;
+    };
+
+    const auto hash = build(CGPU_FORMAT_B8G8R8A8_UNORM, false);
+    // names and callbacks are not part of the structure, rebuilding the same graph gives the same hash
+    EXPECT_EQ(hash, build(CGPU_FORMAT_B8G8R8A8_UNORM, false));
+    EXPECT_NE(hash, build(CGPU_FORMAT_R8G8B8A8_UNORM, false));
+    EXPECT_NE(hash, build(CGPU_FORMAT_B8G8R8A8_UNORM, true));
+}
+
+#include "SkrRenderGraph/phases_v2/compiled_graph.hpp"
+
+TEST_CASE_METHOD(GraphTest, "CompiledRenderGraphCache")
+{
+    namespace render_graph = skr::render_graph;
+    const skr::Vector<uint64_t> words_a = { 1, 2, 3 };
+    const skr::Vector<uint64_t> words_b = { 1, 2, 4 };
+    const skr::Vector<uint64_t> words_c = { 5 };
+    const skr::Vector<uint64_t> words_d = { 6, 7 };
+    render_graph::CompiledRenderGraphCache cache;
+    const auto& stats = cache.get_stats();
+
+    // disabled until a capacity is set
+    EXPECT_EQ(cache.add(1, words_a, 0), nullptr);
+    EXPECT_EQ(cache.find(1, words_a, 0), nullptr);
+    cache.set_capacity(2);
+
+    EXPECT_EQ(cache.find(1, words_a, 0), nullptr);
+    auto compiled_a = cache.add(1, words_a, 0);
+    REQUIRE(compiled_a != nullptr);
+    EXPECT_EQ(cache.find(1, words_a, 1), compiled_a);
+    EXPECT_EQ(compiled_a->last_used_frame, 1);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+
+    // same hash with other structural words is a collision, a miss that replaces the entry when added
+    EXPECT_EQ(cache.find(1, words_b, 2), nullptr);
+    EXPECT_EQ(stats.misses, 3);
+    auto compiled_b = cache.add(1, words_b, 2);
+    REQUIRE(compiled_b != nullptr);
+    EXPECT_TRUE(compiled_b->structural_words == words_b);
+    EXPECT_EQ(cache.find(1, words_a, 3), nullptr);
+    EXPECT_EQ(cache.find(1, words_b, 3), compiled_b);
+    EXPECT_EQ(stats.evictions, 0);
+
+    // the least recently used entry goes when the cache is full
+    auto compiled_c = cache.add(2, words_c, 4);
+    REQUIRE(compiled_c != nullptr);
+    EXPECT_EQ(cache.find(1, words_b, 5), compiled_b);
+    auto compiled_d = cache.add(3, words_d, 6);
+    REQUIRE(compiled_d != nullptr);
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(cache.find(2, words_c, 7), nullptr);
+    EXPECT_EQ(cache.find(1, words_b, 7), compiled_b);
+    EXPECT_EQ(cache.find(3, words_d, 8), compiled_d);
+
+    // shrinking evicts down to the new capacity
+    cache.set_capacity(1);
+    EXPECT_EQ(stats.evictions, 2);
+    EXPECT_EQ(cache.find(1, words_b, 9), nullptr);
+    EXPECT_EQ(cache.find(3, words_d, 9), compiled_d);
+
+    EXPECT_EQ(stats.hits, 6);
+    EXPECT_EQ(stats.misses, 6);
+    cache.clear();
+    EXPECT_EQ(cache.find(3, words_d, 10), nullptr);
+}
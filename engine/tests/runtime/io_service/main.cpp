@@ -7,6 +7,7 @@
 #include "SkrCore/async/thread_job.hpp"
 #include "SkrCore/async/wait_timeout.hpp"
 #include "SkrRT/io/ram_io.hpp"
+#include "SkrContainers/vector.hpp"
 
 #include <string>
 
@@ -232,6 +233,164 @@ for (uint32_t i = 0; i < 1; i++)
         skr_io_ram_service_t::destroy(ioService);
     }
 
+    SUBCASE("decompress")
+    {
+        SkrZoneScopedN("decompress");
+
+        SKR_TEST_INFO(u8"dstorage enabled: {}", dstorage);
+
+        skr::Vector<uint8_t> raw;
+        for (uint32_t i = 0; i < 256 * 1024; i++)
+            raw.add((uint8_t)((i % 251) ^ (i / 4096)));
+
+        auto jqDesc = make_zeroed<skr::JobQueueDesc>();
+        jqDesc.thread_count = 4;
+        jqDesc.priority = SKR_THREAD_ABOVE_NORMAL;
+        jqDesc.name = u8"Tool-IOJobQueue";
+        auto io_job_queue = SkrNew<skr::JobQueue>(jqDesc);
+
+        skr_ram_io_service_desc_t ioServiceDesc = {};
+        ioServiceDesc.name = u8"Test";
+        ioServiceDesc.use_dstorage = dstorage;
+        ioServiceDesc.io_job_queue = io_job_queue;
+        auto ioService = skr_io_ram_service_t::create(&ioServiceDesc);
+        ioService->run();
+
+        const skr_io_decompress_method_t methods[] = { skr::io::kDecompressMethodLZ4, skr::io::kDecompressMethodDeflate };
+        for (const auto& method : methods)
+        {
+            skr::Vector<uint8_t> packed;
+            REQUIRE(skr::io::compress_chunked(method, raw.data(), raw.size(), 16 * 1024, packed));
+            REQUIRE(packed.size() < raw.size());
+            {
+                auto f = skr_vfs_fopen(abs_fs, u8"testfile_packed", SKR_FM_READ_WRITE, SKR_FILE_CREATION_ALWAYS_NEW);
+                skr_vfs_fwrite(f, packed.data(), 0, packed.size());
+                skr_vfs_fclose(f);
+            }
+
+            skr_io_future_t future = {};
+            skr::BlobId blob = nullptr;
+            {
+                auto rq = ioService->open_request();
+                rq->set_vfs(abs_fs);
+                rq->set_path(u8"testfile_packed");
+                rq->add_compressed_block({}); // read the whole chunked container
+                blob = ioService->request(rq, &future);
+            }
+            wait_timeout([&future]()->bool
+            {
+                return future.is_ready() || future.is_cancelled();
+            });
+            ioService->drain();
+            REQUIRE(future.is_ready());
+            REQUIRE(blob->get_size() == raw.size());
+            EXPECT_EQ(memcmp(blob->get_data(), raw.data(), raw.size()), 0);
+            EXPECT_EQ(future.get_error(), SKR_IO_ERROR_NONE);
+
+            // a broken header is rejected while resolving, undecodable chunks fail in the decompressor
+            auto read_corrupted = [&](auto&& corrupt) {
+                auto corrupted = packed;
+                corrupt(corrupted);
+                auto f = skr_vfs_fopen(abs_fs, u8"testfile_corrupted", SKR_FM_READ_WRITE, SKR_FILE_CREATION_ALWAYS_NEW);
+                skr_vfs_fwrite(f, corrupted.data(), 0, corrupted.size());
+                skr_vfs_fclose(f);
+
+                skr_io_future_t corrupted_future = {};
+                auto rq = ioService->open_request();
+                rq->set_vfs(abs_fs);
+                rq->set_path(u8"testfile_corrupted");
+                rq->add_compressed_block({});
+                auto corrupted_blob = ioService->request(rq, &corrupted_future);
+                wait_timeout([&corrupted_future]()->bool
+                {
+                    return corrupted_future.is_ready() || corrupted_future.is_cancelled();
+                });
+                ioService->drain();
+                // not cancelled by the user, the error tells why it ended
+                EXPECT_TRUE(corrupted_future.is_failed());
+                EXPECT_EQ(skr_atomic_load_acquire(&corrupted_future.request_cancel), 0);
+                return corrupted_future.get_error();
+            };
+            EXPECT_EQ(read_corrupted([](skr::Vector<uint8_t>& data) {
+                ((skr_io_chunked_header_t*)data.data())->magic = 0;
+            }), SKR_IO_ERROR_INVALID_REQUEST);
+            EXPECT_EQ(read_corrupted([](skr::Vector<uint8_t>& data) {
+                const auto chunk_count = ((skr_io_chunked_header_t*)data.data())->chunk_count;
+                const auto data_offset = sizeof(skr_io_chunked_header_t) + sizeof(uint32_t) * chunk_count;
+                memset(data.data() + data_offset, 0, data.size() - data_offset);
+            }), SKR_IO_ERROR_DECOMPRESS_FAILED);
+        }
+        skr_io_ram_service_t::destroy(ioService);
+        SkrDelete(io_job_queue);
+    }
+
+    SUBCASE("coalesce")
+    {
+        SkrZoneScopedN("coalesce");
+
+        SKR_TEST_INFO(u8"dstorage enabled: {}", dstorage);
+
+        skr::Vector<uint8_t> raw;
+        for (uint32_t i = 0; i < 512 * 1024; i++)
+            raw.add((uint8_t)((i % 253) ^ (i / 1024)));
+        {
+            auto f = skr_vfs_fopen(abs_fs, u8"testfile_bundle", SKR_FM_READ_WRITE, SKR_FILE_CREATION_ALWAYS_NEW);
+            skr_vfs_fwrite(f, raw.data(), 0, raw.size());
+            skr_vfs_fclose(f);
+        }
+
+        auto jqDesc = make_zeroed<skr::JobQueueDesc>();
+        jqDesc.thread_count = 4;
+        jqDesc.priority = SKR_THREAD_ABOVE_NORMAL;
+        jqDesc.name = u8"Tool-IOJobQueue";
+        auto io_job_queue = SkrNew<skr::JobQueue>(jqDesc);
+
+        skr_ram_io_service_desc_t ioServiceDesc = {};
+        ioServiceDesc.name = u8"Test";
+        ioServiceDesc.use_dstorage = dstorage;
+        ioServiceDesc.io_job_queue = io_job_queue;
+        auto ioService = skr_io_ram_service_t::create(&ioServiceDesc);
+        ioService->run();
+
+        // adjacent, gapped and overlapping ranges of one file, issued out of order
+        constexpr uint32_t kRequestCount = 64;
+        skr_io_future_t futures[kRequestCount] = {};
+        skr::io::RAMIOBufferId blobs[kRequestCount] = {};
+        uint64_t offsets[kRequestCount] = {};
+        uint64_t sizes[kRequestCount] = {};
+        auto batch = ioService->open_batch(kRequestCount);
+        for (uint32_t i = 0; i < kRequestCount; i++)
+        {
+            const uint32_t slot = (i * 37) % kRequestCount;
+            offsets[i] = slot * 8000 + (slot % 3) * 100;
+            sizes[i] = 4000 + (slot % 5) * 1500;
+            auto rq = ioService->open_request();
+            rq->set_vfs(abs_fs);
+            rq->set_path(u8"testfile_bundle");
+            rq->add_block({ offsets[i], sizes[i] });
+            blobs[i] = batch->add_request(rq, &futures[i]).cast_static<skr::io::IRAMIOBuffer>();
+        }
+        ioService->request(batch);
+        wait_timeout([&futures]()->bool
+        {
+            for (const auto& future : futures)
+            {
+                if (!future.is_ready())
+                    return false;
+            }
+            return true;
+        });
+        ioService->drain();
+        for (uint32_t i = 0; i < kRequestCount; i++)
+        {
+            REQUIRE(futures[i].is_ready());
+            REQUIRE(blobs[i]->get_size() == sizes[i]);
+            EXPECT_EQ(memcmp(blobs[i]->get_data(), raw.data() + offsets[i], sizes[i]), 0);
+        }
+        skr_io_ram_service_t::destroy(ioService);
+        SkrDelete(io_job_queue);
+    }
+
     #define TEST_CYCLES_COUNT 100
 
     SUBCASE("cancel")
@@ -0,0 +1,519 @@
+#include "SkrCore/log.h"
+#include "SkrCore/platform/vfs.h"
+#include "SkrCore/async/wait_timeout.hpp"
+#include "SkrOS/filesystem.hpp"
+#include "SkrContainers/span.hpp"
+#include "SkrContainers/vector.hpp"
+#include "SkrRT/io/ram_io.hpp"
+#include "SkrRT/resource/resource_system.h"
+#include "SkrRT/resource/resource_factory.h"
+#include "SkrRT/resource/resource_pack.hpp"
+#include "SkrRT/resource/local_resource_registry.hpp"
+#include "SkrTask/fib_task.hpp"
+
+#include "SkrTestFramework/framework.hpp"
+
+static struct ProcInitializer
+{
+    ProcInitializer()
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+    }
+} init;
+
+using namespace skr::literals;
+static const skr_guid_t kTestBlobType = u8"{6F0A3C5E-1B7D-4E62-9A1F-3C8B2D4E5F60}"_guid;
+
+// the payload of a test resource is its data as is, so loads can be compared byte by byte
+struct TestBlob
+{
+    skr::Vector<uint8_t> bytes;
+};
+
+struct TestBlobFactory : public skr::ResourceFactory
+{
+    skr_guid_t GetResourceType() override { return kTestBlobType; }
+    bool AsyncIO() override { return async_io; }
+    // deserialized inline by the update, no serde tasks
+    float AsyncSerdeLoadFactor() override { return 0.f; }
+    bool Deserialize(SResourceRecord* record, SBinaryReader* reader) override
+    {
+        auto blob = SkrNew<TestBlob>();
+        uint8_t byte = 0;
+        while (reader->read(&byte, 1))
+            blob->bytes.add(byte);
+        record->resource = blob;
+        record->destructor = +[](void* resource) { SkrDelete((TestBlob*)resource); };
+        return true;
+    }
+    ESkrInstallStatus Install(SResourceRecord* record) override
+    {
+        installs.add(record->header.guid);
+        return SKR_INSTALL_STATUS_SUCCEED;
+    }
+
+    bool async_io = true;
+    skr::Vector<skr_guid_t> installs;
+};
+
+static skr::Vector<uint8_t> payload_of(uint32_t seed, uint32_t size)
+{
+    skr::Vector<uint8_t> bytes;
+    for (uint32_t i = 0; i < size; ++i)
+        bytes.add((uint8_t)((seed * 131u + i * 7u) ^ (i >> 8)));
+    return bytes;
+}
+
+static skr_guid_t guid_of(uint32_t i)
+{
+    skr_guid_t guid = u8"{0B7C2A4D-0000-4C1E-8F3A-5D6E7F809100}"_guid;
+    guid.storage1 ^= i * 0x9E3779B9u;
+    guid.storage3 += i;
+    return guid;
+}
+
+static SResourceHeader header_of(const skr_guid_t& guid, std::initializer_list<skr_guid_t> dependencies, uint32_t version = 1)
+{
+    SResourceHeader header;
+    header.version = version;
+    header.guid = guid;
+    header.type = kTestBlobType;
+    for (const auto& dep : dependencies)
+        header.dependencies.add(SResourceHandle(dep));
+    return header;
+}
+
+// resources are cooked into a temporary directory mounted as a vfs, loads go through the process wide
+// resource system which can't be shut down between tests, so every test unloads what it loaded
+struct ResourceTests
+{
+    ResourceTests()
+    {
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+
+        root = skr::fs::Directory::temp() / skr::Path(u8"SkrResourceTest");
+        skr::fs::Directory::remove(root, true);
+        REQUIRE(skr::fs::Directory::create(root, true));
+        skr_vfs_desc_t vfs_desc = {};
+        vfs_desc.app_name = u8"resource-test";
+        vfs_desc.mount_type = SKR_MOUNT_TYPE_CONTENT;
+        vfs_desc.override_mount_dir = root.string().c_str();
+        vfs = skr_create_vfs(&vfs_desc);
+        REQUIRE(vfs != nullptr);
+
+        skr_ram_io_service_desc_t io_desc = {};
+        io_desc.name = u8"ResourceTest";
+        io_desc.sleep_time = 1;
+        io_desc.use_dstorage = false;
+        ram_service = skr_io_ram_service_t::create(&io_desc);
+        ram_service->run();
+
+        system = skr::GetResourceSystem();
+        system->RegisterFactory(&factory);
+    }
+
+    ~ResourceTests()
+    {
+        unload_all();
+        system->UnregisterFactory(kTestBlobType);
+        skr_io_ram_service_t::destroy(ram_service);
+        skr_free_vfs(vfs);
+        skr::fs::Directory::remove(root, true);
+        scheduler.unbind();
+    }
+
+    void write_file(const skr::String& name, skr::span<const uint8_t> data)
+    {
+        REQUIRE(skr::fs::File::write_all_bytes(root / skr::Path(name), data));
+    }
+
+    skr::Vector<uint8_t> read_file(const skr::String& name)
+    {
+        skr::Vector<uint8_t> data;
+        REQUIRE(skr::fs::File::read_all_bytes(root / skr::Path(name), data));
+        return data;
+    }
+
+    // cooked the way the local registry reads it, <guid>.rh + <guid>.bin
+    void write_loose(const SResourceHeader& header, skr::span<const uint8_t> data)
+    {
+        skr::Vector<uint8_t> buffer;
+        skr::archive::BinVectorWriter writer{ &buffer };
+        SBinaryWriter archive{ writer };
+        REQUIRE(skr::bin_write(&archive, header));
+        write_file(skr::format(u8"{}.rh", header.guid), buffer);
+        write_file(skr::format(u8"{}.bin", header.guid), data);
+    }
+
+    SResourceHandle& load(const skr_guid_t& guid, SkrAsyncServicePriority priority = SKR_ASYNC_SERVICE_PRIORITY_NORMAL)
+    {
+        auto& handle = roots.add_default().ref();
+        handle.set_guid(guid);
+        system->LoadResources({ &handle, 1 }, true, 0, SKR_REQUESTER_SYSTEM, priority);
+        return handle;
+    }
+
+    ESkrLoadingStatus status_of(const skr_guid_t& guid)
+    {
+        return system->GetResourceStatus(guid);
+    }
+
+    const TestBlob* blob_of(const skr_guid_t& guid)
+    {
+        for (auto& handle : roots)
+        {
+            if (handle.get_serialized() == guid)
+                return (const TestBlob*)handle.get_resolved(true);
+        }
+        return nullptr;
+    }
+
+    template <typename F>
+    bool update_until(F&& done)
+    {
+        return wait_timeout<u8"ResourceUpdate">([&] {
+            system->Update();
+            return done();
+        },
+            10);
+    }
+
+    // failed loads keep their error records, the test guids are never loaded again
+    bool unload_all()
+    {
+        skr::Vector<skr_guid_t> guids;
+        for (auto& handle : roots)
+        {
+            if (!handle.is_resolved())
+                continue;
+            guids.add(handle.get_serialized());
+            handle.unload();
+        }
+        roots.clear();
+        // dependencies go with their dependents, records are destroyed once their unload finished
+        const bool unloaded = update_until([&] {
+            for (const auto& guid : guids)
+            {
+                if (status_of(guid) != SKR_LOADING_STATUS_UNLOADED)
+                    return false;
+            }
+            return true;
+        });
+        system->Update();
+        factory.installs.clear();
+        return unloaded;
+    }
+
+    skr::task::scheduler_t scheduler;
+    skr::Path root;
+    skr_vfs_t* vfs = nullptr;
+    skr_io_ram_service_t* ram_service = nullptr;
+    skr::ResourceSystem* system = nullptr;
+    TestBlobFactory factory;
+    skr::Vector<SResourceHandle> roots;
+};
+
+// pack layout as documented in resource_pack.hpp
+static SResourcePackHeader& pack_header_of(skr::Vector<uint8_t>& pack)
+{
+    return *(SResourcePackHeader*)pack.data();
+}
+static uint32_t* pack_buckets_of(skr::Vector<uint8_t>& pack)
+{
+    return (uint32_t*)(pack.data() + sizeof(SResourcePackHeader));
+}
+static SResourcePackEntry* pack_entries_of(skr::Vector<uint8_t>& pack)
+{
+    const auto bucket_bytes = ((1ull << pack_header_of(pack).bucket_bits) + 1) * sizeof(uint32_t);
+    return (SResourcePackEntry*)(pack.data() + ((sizeof(SResourcePackHeader) + bucket_bytes + 15) & ~15ull));
+}
+
+TEST_CASE_METHOD(ResourceTests, "PackAnswersHeaderQueries")
+{
+    // enough entries for many buckets, a few of them with dependencies and one without data
+    static constexpr uint32_t kFillerCount = 300;
+    const auto a = guid_of(1), b = guid_of(2), c = guid_of(3), empty = guid_of(4);
+    skr::ResourcePackBuilder builder;
+    builder.Add(header_of(a, { b, c, empty }), payload_of(1, 100));
+    builder.Add(header_of(b, { c }), payload_of(2, 4096));
+    builder.Add(header_of(c, {}), payload_of(3, 1));
+    builder.Add(header_of(empty, {}), {});
+    for (uint32_t i = 0; i < kFillerCount; ++i)
+        builder.Add(header_of(guid_of(100 + i), { guid_of(100 + (i + 1) % kFillerCount) }, i), payload_of(i, i % 97));
+    REQUIRE(builder.Write(vfs, u8"headers.pack"));
+
+    skr::PackResourceRegistry registry(vfs);
+    REQUIRE(registry.Mount(u8"headers.pack"));
+
+    SResourceHeader header;
+    REQUIRE(registry.FindHeader(a, header));
+    EXPECT_EQ(header.guid, a);
+    EXPECT_EQ(header.type, kTestBlobType);
+    EXPECT_EQ(header.version, 1);
+    REQUIRE(header.dependencies.size() == 3);
+    EXPECT_EQ(header.dependencies[0].get_serialized(), b);
+    EXPECT_EQ(header.dependencies[1].get_serialized(), c);
+    EXPECT_EQ(header.dependencies[2].get_serialized(), empty);
+    REQUIRE(registry.FindHeader(empty, header));
+    EXPECT_EQ(header.dependencies.size(), 0);
+
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < kFillerCount; ++i)
+    {
+        const bool found = registry.FindHeader(guid_of(100 + i), header);
+        wrong += (found && header.version == i && header.dependencies.size() == 1 &&
+                  header.dependencies[0].get_serialized() == guid_of(100 + (i + 1) % kFillerCount))
+                     ? 0
+                     : 1;
+    }
+    EXPECT_EQ(wrong, 0);
+    EXPECT_FALSE(registry.FindHeader(guid_of(99), header));
+
+    // packs mounted later shadow earlier ones, the rest is still found in the first pack
+    skr::ResourcePackBuilder patch;
+    patch.Add(header_of(a, { c }, 2), payload_of(7, 10));
+    REQUIRE(patch.Write(vfs, u8"patch.pack"));
+    REQUIRE(registry.Mount(u8"patch.pack"));
+    REQUIRE(registry.FindHeader(a, header));
+    EXPECT_EQ(header.version, 2);
+    EXPECT_EQ(header.dependencies.size(), 1);
+    REQUIRE(registry.FindHeader(b, header));
+    EXPECT_EQ(header.dependencies.size(), 1);
+
+    // the same guid twice can't be written
+    skr::ResourcePackBuilder duplicated;
+    duplicated.Add(header_of(a, {}), payload_of(1, 1));
+    duplicated.Add(header_of(a, {}), payload_of(1, 1));
+    EXPECT_FALSE(duplicated.Write(vfs, u8"duplicated.pack"));
+}
+
+TEST_CASE_METHOD(ResourceTests, "PackRejectsCorruptedToc")
+{
+    skr::ResourcePackBuilder builder;
+    for (uint32_t i = 0; i < 5; ++i)
+        builder.Add(header_of(guid_of(i), { guid_of((i + 1) % 5) }), payload_of(i, 200));
+    REQUIRE(builder.Write(vfs, u8"valid.pack"));
+    const auto valid = read_file(u8"valid.pack");
+
+    skr::PackResourceRegistry registry(vfs);
+    REQUIRE(registry.Mount(u8"valid.pack"));
+    auto mount_modified = [&](auto&& modify) {
+        auto pack = valid;
+        modify(pack);
+        write_file(u8"corrupted.pack", pack);
+        return registry.Mount(u8"corrupted.pack");
+    };
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) { pack_header_of(pack).magic = 0; }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) { pack_header_of(pack).toc_size += 16; }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) { pack.resize_unsafe(pack_header_of(pack).toc_size - 1); }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) {
+        pack_buckets_of(pack)[1u << pack_header_of(pack).bucket_bits] -= 1;
+    }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) {
+        pack_entries_of(pack)[2].dependency_offset = pack_header_of(pack).dependency_count;
+    }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) {
+        pack_entries_of(pack)[3].data_offset = pack.size() - 8;
+    }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) {
+        // data overlapping the table of contents
+        pack_entries_of(pack)[0].data_offset = 0;
+    }));
+    EXPECT_FALSE(mount_modified([](skr::Vector<uint8_t>& pack) {
+        auto entries = pack_entries_of(pack);
+        std::swap(entries[0].guid, entries[4].guid);
+    }));
+
+    // rejected packs are not mounted, the valid one still answers
+    SResourceHeader header;
+    EXPECT_TRUE(registry.FindHeader(guid_of(2), header));
+    EXPECT_FALSE(registry.FindHeader(guid_of(5), header));
+}
+
+TEST_CASE_METHOD(ResourceTests, "PackLoadsThroughResourceSystem")
+{
+    const auto root_guid = guid_of(1), dep = guid_of(2), empty = guid_of(3), packed_loose = guid_of(4), loose = guid_of(5);
+    const auto root_data = payload_of(1, 333), dep_data = payload_of(2, 70000), packed_loose_data = payload_of(4, 1000), loose_data = payload_of(5, 517);
+
+    // loose resources: one copied into the pack by the builder, one only reachable through the fallback
+    write_loose(header_of(packed_loose, {}), packed_loose_data);
+    write_loose(header_of(loose, {}), loose_data);
+
+    skr::ResourcePackBuilder builder;
+    builder.Add(header_of(root_guid, { dep, empty }), root_data);
+    builder.Add(header_of(dep, {}), dep_data);
+    REQUIRE(builder.AddLooseResource(vfs, packed_loose));
+    // empty and last, its data offset is the end of the file
+    builder.Add(header_of(empty, {}), {});
+    REQUIRE(builder.Write(vfs, u8"load.pack"));
+
+    skr::LocalResourceRegistry local(vfs);
+    skr::PackResourceRegistry registry(vfs, &local);
+    REQUIRE(registry.Mount(u8"load.pack"));
+    system->Initialize(&registry, ram_service);
+
+    for (bool async_io : { true, false })
+    {
+        factory.async_io = async_io;
+        load(root_guid);
+        load(packed_loose);
+        load(loose);
+        EXPECT_TRUE(update_until([&] {
+            return status_of(root_guid) == SKR_LOADING_STATUS_INSTALLED && status_of(packed_loose) == SKR_LOADING_STATUS_INSTALLED &&
+                   status_of(loose) == SKR_LOADING_STATUS_INSTALLED;
+        }));
+        EXPECT_EQ(status_of(dep), SKR_LOADING_STATUS_INSTALLED);
+        EXPECT_EQ(status_of(empty), SKR_LOADING_STATUS_INSTALLED);
+
+        auto blob = blob_of(root_guid);
+        REQUIRE(blob != nullptr);
+        EXPECT_TRUE(blob->bytes == root_data);
+        blob = blob_of(packed_loose);
+        REQUIRE(blob != nullptr);
+        EXPECT_TRUE(blob->bytes == packed_loose_data);
+        // read to the end of the loose .bin
+        blob = blob_of(loose);
+        REQUIRE(blob != nullptr);
+        EXPECT_TRUE(blob->bytes == loose_data);
+
+        // dependencies are reached through the root's header
+        load(dep);
+        load(empty);
+        blob = blob_of(dep);
+        REQUIRE(blob != nullptr);
+        EXPECT_TRUE(blob->bytes == dep_data);
+        blob = blob_of(empty);
+        REQUIRE(blob != nullptr);
+        EXPECT_EQ(blob->bytes.size(), 0);
+
+        EXPECT_TRUE(unload_all());
+    }
+
+    // missing from the pack and the fallback
+    load(guid_of(6));
+    EXPECT_TRUE(update_until([&] { return status_of(guid_of(6)) == SKR_LOADING_STATUS_ERROR; }));
+    EXPECT_TRUE(unload_all());
+}
+
+TEST_CASE_METHOD(ResourceTests, "InstallsDependencyGraphInOneUpdate")
+{
+    // root -> mid -> leaf, and a dependency shared by two levels
+    const auto root_guid = guid_of(200), mid = guid_of(201), leaf = guid_of(202), shared = guid_of(203);
+    skr::ResourcePackBuilder builder;
+    builder.Add(header_of(root_guid, { mid, shared }), payload_of(200, 64));
+    builder.Add(header_of(mid, { leaf, shared }), payload_of(201, 64));
+    builder.Add(header_of(leaf, {}), payload_of(202, 64));
+    builder.Add(header_of(shared, {}), payload_of(203, 64));
+    REQUIRE(builder.Write(vfs, u8"graph.pack"));
+
+    skr::PackResourceRegistry registry(vfs);
+    REQUIRE(registry.Mount(u8"graph.pack"));
+    system->Initialize(&registry, ram_service);
+
+    // with synchronous io every level is read, loaded and installed by the waves of a single update
+    factory.async_io = false;
+    load(root_guid);
+    system->Update();
+    EXPECT_EQ(status_of(root_guid), SKR_LOADING_STATUS_INSTALLED);
+    EXPECT_EQ(status_of(mid), SKR_LOADING_STATUS_INSTALLED);
+    EXPECT_EQ(status_of(leaf), SKR_LOADING_STATUS_INSTALLED);
+    EXPECT_EQ(status_of(shared), SKR_LOADING_STATUS_INSTALLED);
+
+    // dependencies install before their dependents
+    auto install_order_of = [&](const skr_guid_t& guid) {
+        for (uint32_t i = 0; i < factory.installs.size(); ++i)
+        {
+            if (factory.installs[i] == guid)
+                return i;
+        }
+        return (uint32_t)factory.installs.size();
+    };
+    REQUIRE(factory.installs.size() == 4);
+    EXPECT_TRUE(install_order_of(leaf) < install_order_of(mid));
+    EXPECT_TRUE(install_order_of(shared) < install_order_of(mid));
+    EXPECT_TRUE(install_order_of(mid) < install_order_of(root_guid));
+
+    EXPECT_TRUE(unload_all());
+}
+
+// forwards to the real service and records the priority each file was requested with
+struct RecordingRAMService : public skr::io::IRAMService
+{
+    RecordingRAMService(skr::io::IRAMService* service)
+        : service(service)
+    {
+    }
+
+    skr::io::BlocksRAMRequestId open_request() SKR_NOEXCEPT override { return service->open_request(); }
+    skr::io::IOBatchId open_batch(uint64_t n) SKR_NOEXCEPT override { return service->open_batch(n); }
+    skr::io::RAMIOBufferId request(skr::io::IORequestId rq, skr::io::IOFuture* future, SkrAsyncServicePriority priority) SKR_NOEXCEPT override
+    {
+        requests.add({ skr::String(rq->get_path()), priority });
+        return service->request(rq, future, priority);
+    }
+    void request(skr::io::IOBatchId batch) SKR_NOEXCEPT override { service->request(batch); }
+    void cancel(skr::io::IOFuture* future) SKR_NOEXCEPT override { service->cancel(future); }
+    void stop(bool wait_drain) SKR_NOEXCEPT override { service->stop(wait_drain); }
+    void run() SKR_NOEXCEPT override { service->run(); }
+    void drain(SkrAsyncServicePriority priority) SKR_NOEXCEPT override { service->drain(priority); }
+    void set_sleep_time(uint32_t ms) SKR_NOEXCEPT override { service->set_sleep_time(ms); }
+    SkrAsyncServiceStatus get_service_status() const SKR_NOEXCEPT override { return service->get_service_status(); }
+
+    SkrAsyncServicePriority priority_of(const skr_guid_t& guid) const
+    {
+        const auto path = skr::format(u8"{}.bin", guid);
+        for (const auto& request : requests)
+        {
+            if (request.path == path)
+                return request.priority;
+        }
+        return SKR_ASYNC_SERVICE_PRIORITY_COUNT;
+    }
+
+    struct Request
+    {
+        skr::String path;
+        SkrAsyncServicePriority priority;
+    };
+    skr::io::IRAMService* service = nullptr;
+    skr::Vector<Request> requests;
+};
+
+TEST_CASE_METHOD(ResourceTests, "DependenciesInheritRequestPriority")
+{
+    // normal: normal_root -> shared, exclusive
+    // urgent: urgent_root -> urgent_dep -> urgent_leaf, and shared
+    const auto normal_root = guid_of(210), urgent_root = guid_of(211), shared = guid_of(212), exclusive = guid_of(213);
+    const auto urgent_dep = guid_of(214), urgent_leaf = guid_of(215);
+    write_loose(header_of(normal_root, { shared, exclusive }), payload_of(210, 32));
+    write_loose(header_of(urgent_root, { urgent_dep, shared }), payload_of(211, 32));
+    write_loose(header_of(shared, {}), payload_of(212, 32));
+    write_loose(header_of(exclusive, {}), payload_of(213, 32));
+    write_loose(header_of(urgent_dep, { urgent_leaf }), payload_of(214, 32));
+    write_loose(header_of(urgent_leaf, {}), payload_of(215, 32));
+
+    // loose files have a path each, so the recorded requests tell the resources apart
+    RecordingRAMService recorder(ram_service);
+    skr::LocalResourceRegistry registry(vfs);
+    system->Initialize(&registry, &recorder);
+
+    // shared is first requested by the normal root, the urgent root raises it before its io is issued
+    factory.async_io = true;
+    load(normal_root);
+    load(urgent_root, SKR_ASYNC_SERVICE_PRIORITY_URGENT);
+    EXPECT_TRUE(update_until([&] {
+        return status_of(normal_root) == SKR_LOADING_STATUS_INSTALLED && status_of(urgent_root) == SKR_LOADING_STATUS_INSTALLED;
+    }));
+
+    EXPECT_EQ(recorder.priority_of(normal_root), SKR_ASYNC_SERVICE_PRIORITY_NORMAL);
+    EXPECT_EQ(recorder.priority_of(exclusive), SKR_ASYNC_SERVICE_PRIORITY_NORMAL);
+    EXPECT_EQ(recorder.priority_of(urgent_root), SKR_ASYNC_SERVICE_PRIORITY_URGENT);
+    EXPECT_EQ(recorder.priority_of(urgent_dep), SKR_ASYNC_SERVICE_PRIORITY_URGENT);
+    EXPECT_EQ(recorder.priority_of(urgent_leaf), SKR_ASYNC_SERVICE_PRIORITY_URGENT);
+    EXPECT_EQ(recorder.priority_of(shared), SKR_ASYNC_SERVICE_PRIORITY_URGENT);
+
+    // the recorder goes out of scope before the fixture cleans up
+    EXPECT_TRUE(unload_all());
+    system->Initialize(&registry, ram_service);
+}
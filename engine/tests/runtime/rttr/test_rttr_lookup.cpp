@@ -0,0 +1,343 @@
+#include "SkrTestFramework/framework.hpp"
+#include "SkrCore/exec_static.hpp"
+#include "SkrRTTR/export/export_builder.hpp"
+#include "SkrRTTR/rttr_traits.hpp"
+#include "SkrRTTR/type.hpp"
+#include "SkrRTTR/type_registry.hpp"
+#include "SkrRTTR/export/extern_methods.hpp"
+#include <thread>
+#include <vector>
+
+// the hashed member indices and the lock-free type index are checked against the linear lookups
+namespace test_rttr_lookup
+{
+struct LookupBase {
+    void    test() {}
+    int32_t test(int32_t a) { return a; }
+
+    int32_t value;
+    float   shared;
+
+    static void make() {}
+
+    static int32_t count;
+};
+
+struct LookupOther {
+    void test(float a) {}
+    void other() {}
+
+    float shared;
+
+    static void make(float a) {}
+};
+
+// shadows and overloads names of both bases
+struct LookupDerived : LookupBase, LookupOther {
+    int32_t test(int32_t a) { return a + 1; }
+    void    own() {}
+
+    int32_t value;
+    double  extra;
+
+    static void make(int32_t a) {}
+
+    static int32_t count;
+};
+
+int32_t LookupBase::count    = 0;
+int32_t LookupDerived::count = 0;
+
+void lookup_extern(LookupDerived& object) {}
+void lookup_extern_base(LookupBase& object) {}
+} // namespace test_rttr_lookup
+
+SKR_RTTR_TYPE(test_rttr_lookup::LookupBase, "0bdf7a07-4c52-4d5c-9d59-5b1c3d1f7a10")
+SKR_RTTR_TYPE(test_rttr_lookup::LookupOther, "6d7a0c2e-33a1-4b8e-a2c6-0f8a2b6e9c21")
+SKR_RTTR_TYPE(test_rttr_lookup::LookupDerived, "b2e6f3a4-7c19-4e0d-8f5b-91d4c7a2e632")
+
+namespace test_rttr_lookup
+{
+using namespace skr;
+
+static void load_base(RTTRType* type)
+{
+    type->build_record([](RTTRRecordData* data) {
+        RTTRRecordBuilder<LookupBase> builder(data);
+        builder.basic_info();
+        builder.method<void (LookupBase::*)(), &LookupBase::test>(u8"test");
+        builder.method<int32_t (LookupBase::*)(int32_t), &LookupBase::test>(u8"test");
+        builder.field<&LookupBase::value>(u8"value");
+        builder.field<&LookupBase::shared>(u8"shared");
+        builder.static_method<void (*)(), &LookupBase::make>(u8"make");
+        builder.static_field<&LookupBase::count>(u8"count");
+        builder.extern_method<&lookup_extern_base>(u8"lookup_extern");
+    });
+}
+static void load_other(RTTRType* type)
+{
+    type->build_record([](RTTRRecordData* data) {
+        RTTRRecordBuilder<LookupOther> builder(data);
+        builder.basic_info();
+        builder.method<void (LookupOther::*)(float), &LookupOther::test>(u8"test");
+        builder.method<void (LookupOther::*)(), &LookupOther::other>(u8"other");
+        builder.field<&LookupOther::shared>(u8"shared");
+        builder.static_method<void (*)(float), &LookupOther::make>(u8"make");
+    });
+}
+static void load_derived(RTTRType* type)
+{
+    type->build_record([](RTTRRecordData* data) {
+        RTTRRecordBuilder<LookupDerived> builder(data);
+        builder.basic_info();
+        builder.bases<LookupBase, LookupOther>();
+        builder.method<int32_t (LookupDerived::*)(int32_t), &LookupDerived::test>(u8"test");
+        builder.method<void (LookupDerived::*)(), &LookupDerived::own>(u8"own");
+        builder.field<&LookupDerived::value>(u8"value");
+        builder.field<&LookupDerived::extra>(u8"extra");
+        builder.static_method<void (*)(int32_t), &LookupDerived::make>(u8"make");
+        builder.static_field<&LookupDerived::count>(u8"count");
+        builder.extern_method<&lookup_extern>(u8"lookup_extern");
+    });
+}
+
+// more guids loading the derived record, only ever loaded by the concurrent test
+static constexpr uint32_t kAliasCount = 512;
+static GUID alias_guid(uint32_t i)
+{
+    return GUID(0x6c6f6f6b, (uint16_t)(i >> 16), (uint16_t)i, { 0x9a, 0x51, 0x2e, 0x07, 0x3b, 0xc4, 0x18, 0xd6 });
+}
+} // namespace test_rttr_lookup
+
+SKR_EXEC_STATIC_CTOR
+{
+    using namespace test_rttr_lookup;
+    skr::register_type_loader(skr::type_id_of<LookupBase>(), &load_base);
+    skr::register_type_loader(skr::type_id_of<LookupOther>(), &load_other);
+    skr::register_type_loader(skr::type_id_of<LookupDerived>(), &load_derived);
+    for (uint32_t i = 0; i < kAliasCount; ++i)
+        skr::register_type_loader(alias_guid(i), &load_derived);
+};
+
+namespace test_rttr_lookup
+{
+template <typename T, typename Func>
+static void each_member(const RTTRType* type, Func&& func)
+{
+    if constexpr (std::is_same_v<T, RTTRMethodData>) { type->each_method(func); }
+    else if constexpr (std::is_same_v<T, RTTRFieldData>) { type->each_field(func); }
+    else if constexpr (std::is_same_v<T, RTTRStaticMethodData>) { type->each_static_method(func); }
+    else if constexpr (std::is_same_v<T, RTTRStaticFieldData>) { type->each_static_field(func); }
+    else { type->each_extern_method(func); }
+}
+template <typename T>
+static const T* find_member(const RTTRType* type, const RTTRTypeFindConfig& config)
+{
+    if constexpr (std::is_same_v<T, RTTRMethodData>) { return type->find_method(config); }
+    else if constexpr (std::is_same_v<T, RTTRFieldData>) { return type->find_field(config); }
+    else if constexpr (std::is_same_v<T, RTTRStaticMethodData>) { return type->find_static_method(config); }
+    else if constexpr (std::is_same_v<T, RTTRStaticFieldData>) { return type->find_static_field(config); }
+    else { return type->find_extern_method(config); }
+}
+
+// position of the found member in each_xxx() order, -1 when nothing is found
+// two types built by the same loader answer with the same positions
+template <typename T>
+static int64_t find_position(const RTTRType* type, const RTTRTypeFindConfig& config)
+{
+    const T* found    = find_member<T>(type, config);
+    int64_t  position = -1, i = 0;
+    each_member<T>(type, [&](const T* member, const RTTRType* owner) {
+        if (member == found && position < 0) { position = i; }
+        ++i;
+    });
+    return found ? position : -1;
+}
+
+struct Query {
+    Optional<StringView>        name          = {};
+    Optional<TypeSignatureView> signature     = {};
+    bool                        include_bases = true;
+};
+
+struct LookupQueries {
+    LookupQueries()
+    {
+        const StringView method_names[]        = { u8"test", u8"other", u8"own", u8"missing" };
+        const StringView field_names[]         = { u8"value", u8"shared", u8"extra", u8"missing" };
+        const StringView static_method_names[] = { u8"make", u8"missing" };
+        const StringView static_field_names[]  = { u8"count", u8"missing" };
+        const StringView extern_method_names[] = { u8"lookup_extern", CPPExternMethods::Eq, CPPExternMethods::Assign, u8"missing" };
+        const TypeSignatureView method_signatures[] = {
+            sig_void.view(), sig_int_int.view(), sig_void_float.view(), sig_void_int.view()
+        };
+        const TypeSignatureView field_signatures[] = { sig_int.view(), sig_float.view(), sig_double.view() };
+        const TypeSignatureView static_method_signatures[] = { sig_void.view(), sig_void_float.view(), sig_void_int.view() };
+
+        add(methods, method_names, method_signatures, 4);
+        add(fields, field_names, field_signatures, 3);
+        add(static_methods, static_method_names, static_method_signatures, 3);
+        add(static_fields, static_field_names, field_signatures, 3);
+        add(extern_methods, extern_method_names, nullptr, 0);
+    }
+
+    // every name and signature alone and combined, with and without bases
+    template <size_t N>
+    static void add(Vector<Query>& queries, const StringView (&names)[N], const TypeSignatureView* signatures, size_t signature_count)
+    {
+        for (bool include_bases : { true, false })
+        {
+            queries.add(Query{ .include_bases = include_bases });
+            for (size_t i = 0; i < signature_count; ++i)
+                queries.add(Query{ .signature = signatures[i], .include_bases = include_bases });
+            for (auto name : names)
+            {
+                queries.add(Query{ .name = name, .include_bases = include_bases });
+                for (size_t i = 0; i < signature_count; ++i)
+                    queries.add(Query{ .name = name, .signature = signatures[i], .include_bases = include_bases });
+            }
+        }
+    }
+
+    // positions of every query, in methods, fields, static methods, static fields, extern methods order
+    Vector<int64_t> positions(const RTTRType* type) const
+    {
+        Vector<int64_t> result;
+        run<RTTRMethodData>(type, methods, result);
+        run<RTTRFieldData>(type, fields, result);
+        run<RTTRStaticMethodData>(type, static_methods, result);
+        run<RTTRStaticFieldData>(type, static_fields, result);
+        run<RTTRExternMethodData>(type, extern_methods, result);
+        return result;
+    }
+    template <typename T>
+    static void run(const RTTRType* type, const Vector<Query>& queries, Vector<int64_t>& result)
+    {
+        for (const auto& query : queries)
+        {
+            RTTRTypeFindConfig config;
+            config.name          = query.name;
+            config.signature     = query.signature;
+            config.include_bases = query.include_bases;
+            result.add(find_position<T>(type, config));
+        }
+    }
+
+    TypeSignatureTyped<void()>         sig_void;
+    TypeSignatureTyped<int32_t(int32_t)> sig_int_int;
+    TypeSignatureTyped<void(float)>    sig_void_float;
+    TypeSignatureTyped<void(int32_t)>  sig_void_int;
+    TypeSignatureTyped<int32_t>        sig_int;
+    TypeSignatureTyped<float>          sig_float;
+    TypeSignatureTyped<double>         sig_double;
+
+    Vector<Query> methods, fields, static_methods, static_fields, extern_methods;
+};
+
+// answers of the linear search, a type that never gets its optimize data
+static Vector<int64_t> linear_positions(const LookupQueries& queries, RTTRTypeLoaderFunc loader)
+{
+    RTTRType linear;
+    loader(&linear);
+    return queries.positions(&linear);
+}
+} // namespace test_rttr_lookup
+
+TEST_CASE("test rttr hashed member lookup")
+{
+    using namespace skr;
+    using namespace test_rttr_lookup;
+
+    LookupQueries queries;
+    const std::pair<RTTRType*, RTTRTypeLoaderFunc> types[] = {
+        { type_of<LookupBase>(), &load_base },
+        { type_of<LookupOther>(), &load_other },
+        { type_of<LookupDerived>(), &load_derived },
+    };
+    for (const auto& [type, loader] : types)
+    {
+        REQUIRE(type != nullptr);
+        const auto expected = linear_positions(queries, loader);
+        const auto actual   = queries.positions(type);
+        REQUIRE(expected.size() == actual.size());
+
+        uint64_t mismatches = 0, found = 0;
+        for (uint64_t i = 0; i < expected.size(); ++i)
+        {
+            mismatches += (expected[i] == actual[i]) ? 0 : 1;
+            found += (expected[i] >= 0) ? 1 : 0;
+        }
+        EXPECT_EQ(mismatches, 0);
+        // the queries hit members, not only misses
+        EXPECT_NE(found, 0);
+    }
+
+    // shadowed names resolve to the derived members first
+    auto derived = type_of<LookupDerived>();
+    EXPECT_EQ(derived->find_field_t<int32_t>(u8"value"), derived->find_field_t<int32_t>(u8"value", ETypeSignatureCompareFlag::Strict, false));
+    EXPECT_NE(derived->find_field_t<float>(u8"shared"), nullptr);
+    EXPECT_EQ(derived->find_field_t<float>(u8"shared", ETypeSignatureCompareFlag::Strict, false), nullptr);
+}
+
+TEST_CASE("test rttr type lookup while loading")
+{
+    using namespace skr;
+    using namespace test_rttr_lookup;
+
+    static constexpr uint32_t kThreadCount = 8;
+    LookupQueries queries;
+    const auto    expected = linear_positions(queries, &load_derived);
+
+    // every thread looks up every alias in its own order, racing each other and load_all_types()
+    std::vector<std::vector<RTTRType*>> seen(kThreadCount, std::vector<RTTRType*>(kAliasCount, nullptr));
+    std::vector<uint64_t>               mismatches(kThreadCount, 0);
+    std::atomic<uint32_t>               ready = 0;
+    std::vector<std::thread>            threads;
+    for (uint32_t t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back([&, t] {
+            ++ready;
+            while (ready.load() <= kThreadCount) {}
+            for (uint32_t n = 0; n < kAliasCount; ++n)
+            {
+                const uint32_t i    = (n * (2 * t + 1) + t * 37) % kAliasCount;
+                auto           type = get_type_from_guid(alias_guid(i));
+                seen[t][i]          = type;
+                // the type may still be building its optimize data, find_xxx() must answer the same either way
+                if (type && (n % 16) == 0)
+                {
+                    mismatches[t] += (queries.positions(type) == expected) ? 0 : 1;
+                }
+            }
+        });
+    }
+    while (ready.load() < kThreadCount) {}
+    ++ready;
+    load_all_types();
+    for (auto& thread : threads)
+        thread.join();
+
+    // one type per guid, the same for every thread and for the registry
+    uint64_t wrong = 0;
+    for (uint32_t i = 0; i < kAliasCount; ++i)
+    {
+        auto type = get_type_from_guid(alias_guid(i));
+        wrong += (type != nullptr) ? 0 : 1;
+        for (uint32_t t = 0; t < kThreadCount; ++t)
+            wrong += (seen[t][i] == type) ? 0 : 1;
+        bool listed = false;
+        each_types([&](const RTTRType* each) {
+            listed = (each == type);
+            return !listed;
+        });
+        wrong += listed ? 0 : 1;
+        wrong += (queries.positions(type) == expected) ? 0 : 1;
+    }
+    EXPECT_EQ(wrong, 0);
+    for (uint32_t t = 0; t < kThreadCount; ++t)
+        EXPECT_EQ(mismatches[t], 0);
+
+    // distinct guids are distinct types
+    EXPECT_NE(get_type_from_guid(alias_guid(0)), get_type_from_guid(alias_guid(1)));
+    EXPECT_NE(get_type_from_guid(alias_guid(0)), type_of<LookupDerived>());
+}
@@ -0,0 +1,261 @@
+#include "SkrCore/log.h"
+#include "SkrContainers/vector.hpp"
+#include "SkrRT/ecs/world.hpp"
+#include "SkrSceneCore/transform_system.h"
+
+#include "SkrTestFramework/framework.hpp"
+
+// the hierarchy level mode is checked against the recursive update from the roots
+struct TransformLevelTests
+{
+    using Entity = skr::ecs::Entity;
+
+    TransformLevelTests()
+        : world(scheduler)
+    {
+        ::skr_log_set_level(SKR_LOG_LEVEL_WARN);
+        scheduler.initialize(skr::task::scheudler_config_t());
+        scheduler.bind();
+        world.initialize();
+
+        levels = skr::TransformSystem::Create(&world);
+        levels->set_hierarchy_level_mode(true);
+        reference = skr::TransformSystem::Create(&world);
+    }
+
+    ~TransformLevelTests()
+    {
+        skr::TransformSystem::Destroy(levels);
+        skr::TransformSystem::Destroy(reference);
+        world.finalize();
+        scheduler.unbind();
+    }
+
+    // deterministic local transform of the n-th spawned entity
+    static void local_of(uint32_t n, skr::scene::PositionComponent& position, skr::scene::RotationComponent& rotation, skr::scene::ScaleComponent& scale)
+    {
+        position.set((float)(n % 7) - 3.f, (float)(n % 5) * 0.5f, -(float)(n % 3));
+        rotation.set((float)(n % 11) * 3.f, (float)(n % 13) * 7.f, (float)(n % 4) * 2.f);
+        scale.set(0.9f + (float)(n % 3) * 0.05f);
+    }
+
+    skr::Vector<Entity> spawn_roots(uint32_t count)
+    {
+        struct RootSpawner
+        {
+            void build(skr::ecs::ArchetypeBuilder& Builder)
+            {
+                Builder.add_component(&RootSpawner::positions)
+                    .add_component(&RootSpawner::rotations)
+                    .add_component(&RootSpawner::scales)
+                    .add_component<skr::scene::ChildrenComponent>()
+                    .add_component<skr::scene::TransformComponent>();
+            }
+
+            void run(skr::ecs::TaskContext& Context)
+            {
+                spawned->append(Context.entities(), Context.size());
+                for (uint32_t i = 0; i < Context.size(); ++i)
+                    local_of((*counter)++, positions[i], rotations[i], scales[i]);
+            }
+
+            skr::Vector<Entity>* spawned = nullptr;
+            uint32_t* counter = nullptr;
+            skr::ecs::ComponentView<skr::scene::PositionComponent> positions;
+            skr::ecs::ComponentView<skr::scene::RotationComponent> rotations;
+            skr::ecs::ComponentView<skr::scene::ScaleComponent> scales;
+        } spawner;
+        skr::Vector<Entity> spawned;
+        spawner.spawned = &spawned;
+        spawner.counter = &spawn_counter;
+        world.create_entities(spawner, count);
+        all.append(spawned);
+        return spawned;
+    }
+
+    // the i-th child is attached to parents[i % parents.size()]
+    skr::Vector<Entity> spawn_children(const skr::Vector<Entity>& parents, uint32_t count)
+    {
+        struct ChildSpawner
+        {
+            void build(skr::ecs::ArchetypeBuilder& Builder)
+            {
+                Builder.add_component(&ChildSpawner::positions)
+                    .add_component(&ChildSpawner::rotations)
+                    .add_component(&ChildSpawner::scales)
+                    .add_component(&ChildSpawner::parent_components)
+                    .add_component<skr::scene::ChildrenComponent>()
+                    .add_component<skr::scene::TransformComponent>()
+                    .access(&ChildSpawner::children_writer);
+            }
+
+            void run(skr::ecs::TaskContext& Context)
+            {
+                for (uint32_t i = 0; i < Context.size(); ++i)
+                {
+                    const auto parent = (*parents)[spawned->size() % parents->size()];
+                    const auto entity = Context.entities()[i];
+                    local_of((*counter)++, positions[i], rotations[i], scales[i]);
+                    parent_components[i].entity = parent;
+                    children_writer[parent].push_back(skr::scene::ChildrenComponent{ .entity = entity });
+                    spawned->add(entity);
+                }
+            }
+
+            const skr::Vector<Entity>* parents = nullptr;
+            skr::Vector<Entity>* spawned = nullptr;
+            uint32_t* counter = nullptr;
+            skr::ecs::ComponentView<skr::scene::PositionComponent> positions;
+            skr::ecs::ComponentView<skr::scene::RotationComponent> rotations;
+            skr::ecs::ComponentView<skr::scene::ScaleComponent> scales;
+            skr::ecs::ComponentView<skr::scene::ParentComponent> parent_components;
+            skr::ecs::RandomComponentReadWrite<skr::scene::ChildrenComponent> children_writer;
+        } spawner;
+        skr::Vector<Entity> spawned;
+        spawner.parents = &parents;
+        spawner.spawned = &spawned;
+        spawner.counter = &spawn_counter;
+        world.create_entities(spawner, count);
+        all.append(spawned);
+        return spawned;
+    }
+
+    void reparent(Entity child, Entity new_parent)
+    {
+        auto parent_accessor = world.random_readwrite<skr::scene::ParentComponent>();
+        auto children_accessor = world.random_readwrite<skr::scene::ChildrenComponent>();
+        auto& parent = parent_accessor[child];
+        auto& old_children = children_accessor[parent.entity];
+        for (auto it = old_children.begin(); it != old_children.end(); ++it)
+        {
+            if (it->entity == child)
+            {
+                old_children.erase(it);
+                break;
+            }
+        }
+        children_accessor[new_parent].push_back(skr::scene::ChildrenComponent{ .entity = child });
+        parent.entity = new_parent;
+    }
+
+    void move(Entity entity, float dx)
+    {
+        auto position_accessor = world.random_readwrite<skr::scene::PositionComponent>();
+        auto& position = position_accessor[entity];
+        auto value = position.get();
+        value.x += dx;
+        position.set(value);
+    }
+
+    void update(skr::TransformSystem* system)
+    {
+        system->update();
+        skr::ecs::TaskScheduler::Get()->flush_all();
+        skr::ecs::TaskScheduler::Get()->sync_all();
+        system->get_context()->update_finish.wait(false);
+    }
+
+    skr::Vector<skr::scene::Transform> read_transforms()
+    {
+        auto transform_accessor = world.random_read<const skr::scene::TransformComponent>();
+        skr::Vector<skr::scene::Transform> transforms;
+        transforms.reserve(all.size());
+        for (auto entity : all)
+            transforms.add(transform_accessor[entity].get());
+        return transforms;
+    }
+
+    // one frame of the level mode, then the recursive update of everything as the expected result
+    void check_frame()
+    {
+        update(levels);
+        const auto actual = read_transforms();
+
+        auto position_accessor = world.random_readwrite<skr::scene::PositionComponent>();
+        for (auto entity : all)
+        {
+            auto& position = position_accessor[entity];
+            position.set(position.get());
+        }
+        update(reference);
+        const auto expected = read_transforms();
+
+        const auto near = [](float lhs, float rhs) {
+            return std::abs(lhs - rhs) <= 1e-3f * std::max(1.f, std::abs(lhs));
+        };
+        uint64_t mismatches = 0;
+        for (uint64_t i = 0; i < all.size(); ++i)
+        {
+            const auto& lhs = expected[i];
+            const auto& rhs = actual[i];
+            const bool same =
+                near(lhs.position.x, rhs.position.x) && near(lhs.position.y, rhs.position.y) && near(lhs.position.z, rhs.position.z) &&
+                near(lhs.scale.x, rhs.scale.x) && near(lhs.scale.y, rhs.scale.y) && near(lhs.scale.z, rhs.scale.z) &&
+                near(lhs.rotation.x, rhs.rotation.x) && near(lhs.rotation.y, rhs.rotation.y) &&
+                near(lhs.rotation.z, rhs.rotation.z) && near(lhs.rotation.w, rhs.rotation.w);
+            mismatches += same ? 0 : 1;
+        }
+        EXPECT_EQ(mismatches, 0);
+    }
+
+    skr::task::scheduler_t scheduler;
+    skr::ecs::ECSWorld world;
+    skr::TransformSystem* levels = nullptr;
+    skr::TransformSystem* reference = nullptr;
+    skr::Vector<Entity> all;
+    uint32_t spawn_counter = 0;
+};
+
+TEST_CASE_METHOD(TransformLevelTests, "DeepHierarchy")
+{
+    auto level = spawn_roots(2);
+    for (uint32_t depth = 0; depth < 256; ++depth)
+        level = spawn_children(level, 2);
+    check_frame();
+
+    // unchanged frame, then a change near the roots that every descendant follows
+    check_frame();
+    move(all[0], 1.f);
+    check_frame();
+}
+
+TEST_CASE_METHOD(TransformLevelTests, "WideHierarchy")
+{
+    const auto roots = spawn_roots(4);
+    const auto children = spawn_children(roots, 10'000);
+    spawn_children(children, 20'000);
+    check_frame();
+
+    move(roots[1], -2.f);
+    move(children[123], 3.f);
+    check_frame();
+}
+
+TEST_CASE_METHOD(TransformLevelTests, "ReparentBetweenFrames")
+{
+    const auto roots = spawn_roots(3);
+    auto chain = spawn_children({ roots[0] }, 1);
+    skr::Vector<Entity> deep = chain;
+    for (uint32_t depth = 0; depth < 32; ++depth)
+    {
+        chain = spawn_children(chain, 1);
+        deep.append(chain);
+    }
+    const auto wide = spawn_children({ roots[1] }, 500);
+    const auto leaves = spawn_children(wide, 2'000);
+    check_frame();
+
+    // a subtree of the chain goes under a wide node, it and its descendants change depth
+    reparent(deep[10], wide[7]);
+    check_frame();
+
+    // a wide node goes deep into the chain, a leaf moves to the last root, and a moved parent in the same frame
+    reparent(wide[3], deep[20]);
+    reparent(leaves[42], roots[2]);
+    move(wide[7], 5.f);
+    check_frame();
+
+    // back to the original parent
+    reparent(deep[10], deep[9]);
+    check_frame();
+}